@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+#coding=utf-8
+
+'''
+Compare two reports written by CocosBenchmark and fail on regressions.
+
+  compare.py baseline.json current.json --threshold 0.1
+
+A timing regresses when its median grew by more than the threshold and by
+more than --min-delta microseconds, which keeps noise on tiny steps out.
+Changed draw call, instance or triangle counts always fail, the scenes
+are generated from a seed so they only change with the pipeline itself.
+'''
+
+import argparse, json, sys
+
+COUNTERS = ('drawCalls', 'instances', 'triangles', 'renderObjects', 'shadowObjects')
+
+def load(path):
+  with open(path) as f:
+    report = json.load(f)
+  if report.get('version') != 1:
+    raise ValueError('%s: unsupported report version' % path)
+  entries = dict((scene['name'], scene) for scene in report['scenes'])
+  # micro benchmarks have timings only
+  entries.update((micro['name'], micro) for micro in report.get('micro', []))
+  return entries
+
+def compare(baseline, current, threshold, min_delta, metric):
+  failures = []
+  for name in sorted(current):
+    if name not in baseline:
+      print('%-16s new scene, skipped' % name)
+      continue
+    base = baseline[name]
+    cur = current[name]
+    if base.get('config') != cur.get('config'):
+      print('%-16s config differs, skipped' % name)
+      continue
+
+    for counter in COUNTERS:
+      if 'counters' not in cur or 'counters' not in base:
+        break
+      if base['counters'][counter] != cur['counters'][counter]:
+        failures.append('%s: %s %d -> %d' % (name, counter, base['counters'][counter], cur['counters'][counter]))
+
+    for step in sorted(cur['timings']):
+      if step not in base['timings']:
+        continue
+      before = base['timings'][step][metric]
+      after = cur['timings'][step][metric]
+      ratio = (after - before) / before if before > 0 else 0.0
+      status = ''
+      if ratio > threshold and after - before > min_delta:
+        status = 'REGRESSION'
+        failures.append('%s: %s %.2fus -> %.2fus (%+.1f%%)' % (name, step, before, after, ratio * 100))
+      elif ratio < -threshold and before - after > min_delta:
+        status = 'improved'
+      print('%-16s %-18s %10.2f %10.2f %+7.1f%% %s' % (name, step, before, after, ratio * 100, status))
+
+  return failures
+
+def main():
+  parser = argparse.ArgumentParser(description='Compare pipeline benchmark reports.')
+  parser.add_argument('baseline')
+  parser.add_argument('current')
+  parser.add_argument('--threshold', type=float, default=0.1, help='allowed relative slowdown (default 0.1)')
+  parser.add_argument('--min-delta', type=float, default=5.0, help='ignore slowdowns below this many microseconds')
+  parser.add_argument('--metric', default='median', choices=['min', 'median', 'p95', 'mean'])
+  args = parser.parse_args()
+
+  failures = compare(load(args.baseline), load(args.current), args.threshold, args.min_delta, args.metric)
+  if failures:
+    print('\n%d regression(s):' % len(failures))
+    for failure in failures:
+      print('  ' + failure)
+    sys.exit(1)
+  print('\nno regressions')
+
+if __name__ == '__main__':
+  main()
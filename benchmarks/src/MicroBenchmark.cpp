@@ -0,0 +1,257 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "MicroBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "cocos/base/JobSystem.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/manual/jsb_conversions.h"
+#include "cocos/renderer/core/Core.h"
+
+namespace cc {
+namespace benchmark {
+
+namespace {
+constexpr uint32_t PROPERTY_ACCESSES = 10000;
+constexpr uint32_t BINDING_CALLS = 1000;
+constexpr uint32_t PARALLEL_FOR_SIZE = 1 << 20;
+constexpr uint32_t PARALLEL_FOR_GRAIN = 4096;
+
+// names known at compile time hit the cached v8 strings, std::string names create a new one every time
+void runPropertyAccess(const BenchmarkOptions &options, MicroResult *result) {
+    se::AutoHandleScope hs;
+    se::HandleObject obj(se::Object::createPlainObject());
+    const se::Value value(1.0);
+    const std::string stringName = "position";
+    se::Value out;
+
+    const uint32_t total = options.warmup + options.iterations;
+    Samples setLiteral("setLiteralName", total);
+    Samples getLiteral("getLiteralName", total);
+    Samples setString("setStringName", total);
+    Samples getString("getStringName", total);
+
+    for (uint32_t i = 0; i < total; ++i) {
+        const bool record = i >= options.warmup;
+        setLiteral.measure(record, [&]() {
+            for (uint32_t n = 0; n < PROPERTY_ACCESSES; ++n) obj->setProperty("position", value);
+        });
+        getLiteral.measure(record, [&]() {
+            for (uint32_t n = 0; n < PROPERTY_ACCESSES; ++n) obj->getProperty("position", &out);
+        });
+        setString.measure(record, [&]() {
+            for (uint32_t n = 0; n < PROPERTY_ACCESSES; ++n) obj->setProperty(stringName, value);
+        });
+        getString.measure(record, [&]() {
+            for (uint32_t n = 0; n < PROPERTY_ACCESSES; ++n) obj->getProperty(stringName, &out);
+        });
+    }
+
+    for (const auto *samples : {&setLiteral, &getLiteral, &setString, &getString}) {
+        result->timings.push_back(samples->stats());
+    }
+}
+
+// the gfx bindings the engine calls most, each function makes n calls with the arguments the engine passes,
+// objects are created from plain js objects and destroyed right away so that only the binding is timed
+const char *GFX_BINDING_SCRIPT =
+    "(function (device, c) {"
+    "  var bufferInfo = {usage: c.BUFFER_UNIFORM | c.BUFFER_TRANSFER_DST, memUsage: c.MEMORY_HOST | c.MEMORY_DEVICE, size: 256, stride: 256};"
+    "  var vertexBufferInfo = {usage: c.BUFFER_VERTEX | c.BUFFER_TRANSFER_DST, memUsage: c.MEMORY_DEVICE, size: 4096, stride: 16};"
+    "  var textureInfo = {type: c.TEX2D, usage: c.TEXTURE_SAMPLED | c.TEXTURE_TRANSFER_DST, format: c.RGBA8, width: 64, height: 64};"
+    "  var targetInfo = {type: c.TEX2D, usage: c.TEXTURE_COLOR_ATTACHMENT, format: c.RGBA8, width: 64, height: 64};"
+    "  var ub = device.createBuffer(bufferInfo, false);"
+    "  var vb = device.createBuffer(vertexBufferInfo, false);"
+    "  var tex = device.createTexture(textureInfo, false);"
+    "  var target = device.createTexture(targetInfo, false);"
+    "  var layout = device.createDescriptorSetLayout({bindings: ["
+    "    {binding: 0, descriptorType: c.UNIFORM_BUFFER, count: 1, stageFlags: c.STAGE_ALL},"
+    "    {binding: 1, descriptorType: c.SAMPLER, count: 1, stageFlags: c.STAGE_ALL}]});"
+    "  var setInfo = {layout: layout};"
+    "  var set = device.createDescriptorSet(setInfo);"
+    "  var iaInfo = {attributes: [{name: 'a_position', format: c.RGB32F}], vertexBuffers: [vb]};"
+    "  var ia = device.createInputAssembler(iaInfo);"
+    "  var renderPass = device.createRenderPass({colorAttachments: [{format: c.RGBA8}], depthStencilAttachment: {}, subPasses: []});"
+    "  var fbInfo = {renderPass: renderPass, colorTextures: [target]};"
+    "  var framebuffer = device.createFramebuffer(fbInfo);"
+    "  var cmd = device.commandBuffer;"
+    "  var uniforms = new Float32Array(64);"
+    "  var pixels = new Uint8Array(64 * 64 * 4);"
+    "  var regions = [{texExtent: {width: 64, height: 64, depth: 1}, texSubres: {mipLevel: 0, baseArrayLayer: 0, layerCount: 1}}];"
+    "  var viewport = {left: 0, top: 0, width: 64, height: 64, minDepth: 0, maxDepth: 1};"
+    "  var rect = {x: 0, y: 0, width: 64, height: 64};"
+    "  var clearColors = [{x: 0, y: 0, z: 0, w: 1}];"
+    "  var drawInfo = {};"
+    "  var i;"
+    "  return {"
+    "    createBuffer: function (n) { for (i = 0; i < n; ++i) device.createBuffer(bufferInfo, false).destroy(); },"
+    "    createTexture: function (n) { for (i = 0; i < n; ++i) device.createTexture(textureInfo, false).destroy(); },"
+    "    createInputAssembler: function (n) { for (i = 0; i < n; ++i) device.createInputAssembler(iaInfo).destroy(); },"
+    "    createDescriptorSet: function (n) { for (i = 0; i < n; ++i) device.createDescriptorSet(setInfo).destroy(); },"
+    "    createFramebuffer: function (n) { for (i = 0; i < n; ++i) device.createFramebuffer(fbInfo).destroy(); },"
+    "    copyBuffersToTexture: function (n) { for (i = 0; i < n; ++i) device.copyBuffersToTexture([pixels], tex, regions); },"
+    "    bufferUpdate: function (n) { for (i = 0; i < n; ++i) ub.update(uniforms); },"
+    "    cmdUpdateBuffer: function (n) { for (i = 0; i < n; ++i) cmd.updateBuffer(ub, uniforms); },"
+    "    cmdCopyBuffersToTexture: function (n) { for (i = 0; i < n; ++i) cmd.copyBuffersToTexture([pixels], tex, regions); },"
+    "    cmdBeginEnd: function (n) { for (i = 0; i < n; ++i) { cmd.begin(); cmd.end(); } },"
+    "    cmdRenderPass: function (n) {"
+    "      for (i = 0; i < n; ++i) { cmd.beginRenderPass(renderPass, framebuffer, rect, clearColors, 1, 0); cmd.endRenderPass(); }"
+    "    },"
+    "    cmdBindInputAssembler: function (n) { for (i = 0; i < n; ++i) cmd.bindInputAssembler(ia); },"
+    "    cmdBindDescriptorSet: function (n) { for (i = 0; i < n; ++i) cmd.bindDescriptorSet(0, set); },"
+    "    cmdDraw: function (n) { for (i = 0; i < n; ++i) cmd.draw(ia); },"
+    "    cmdSetViewport: function (n) { for (i = 0; i < n; ++i) cmd.setViewport(viewport); },"
+    "    cmdSetScissor: function (n) { for (i = 0; i < n; ++i) cmd.setScissor(rect); },"
+    "    setBindBuffer: function (n) { for (i = 0; i < n; ++i) set.bindBuffer(0, ub); },"
+    "    setBindTexture: function (n) { for (i = 0; i < n; ++i) set.bindTexture(1, tex); },"
+    "    setUpdate: function (n) { for (i = 0; i < n; ++i) { set.bindBuffer(0, ub); set.update(); } },"
+    "    extractDrawInfo: function (n) { for (i = 0; i < n; ++i) ia.extractDrawInfo(drawInfo); },"
+    "    destroy: function () {"
+    "      ia.destroy(); set.destroy(); layout.destroy(); framebuffer.destroy(); renderPass.destroy();"
+    "      target.destroy(); tex.destroy(); vb.destroy(); ub.destroy();"
+    "    }"
+    "  };"
+    "})";
+
+const char *GFX_BINDINGS[] = {
+    "createBuffer", "createTexture", "createInputAssembler", "createDescriptorSet", "createFramebuffer",
+    "copyBuffersToTexture", "bufferUpdate", "cmdUpdateBuffer", "cmdCopyBuffersToTexture", "cmdBeginEnd",
+    "cmdRenderPass", "cmdBindInputAssembler", "cmdBindDescriptorSet", "cmdDraw", "cmdSetViewport",
+    "cmdSetScissor", "setBindBuffer", "setBindTexture", "setUpdate", "extractDrawInfo",
+};
+
+template <typename T>
+void setConstant(se::Object *obj, const char *name, T value) {
+    obj->setProperty(name, se::Value(static_cast<uint32_t>(value)));
+}
+
+// every sample is BINDING_CALLS calls from script, so it covers argument conversion and the native call
+void runGfxBindings(const BenchmarkOptions &options, MicroResult *result) {
+    auto *engine = se::ScriptEngine::getInstance();
+    se::AutoHandleScope hs;
+
+    se::HandleObject constants(se::Object::createPlainObject());
+    setConstant(constants.get(), "BUFFER_TRANSFER_DST", gfx::BufferUsageBit::TRANSFER_DST);
+    setConstant(constants.get(), "BUFFER_VERTEX", gfx::BufferUsageBit::VERTEX);
+    setConstant(constants.get(), "BUFFER_UNIFORM", gfx::BufferUsageBit::UNIFORM);
+    setConstant(constants.get(), "MEMORY_DEVICE", gfx::MemoryUsageBit::DEVICE);
+    setConstant(constants.get(), "MEMORY_HOST", gfx::MemoryUsageBit::HOST);
+    setConstant(constants.get(), "TEX2D", gfx::TextureType::TEX2D);
+    setConstant(constants.get(), "TEXTURE_TRANSFER_DST", gfx::TextureUsageBit::TRANSFER_DST);
+    setConstant(constants.get(), "TEXTURE_SAMPLED", gfx::TextureUsageBit::SAMPLED);
+    setConstant(constants.get(), "TEXTURE_COLOR_ATTACHMENT", gfx::TextureUsageBit::COLOR_ATTACHMENT);
+    setConstant(constants.get(), "RGBA8", gfx::Format::RGBA8);
+    setConstant(constants.get(), "RGB32F", gfx::Format::RGB32F);
+    setConstant(constants.get(), "UNIFORM_BUFFER", gfx::DescriptorType::UNIFORM_BUFFER);
+    setConstant(constants.get(), "SAMPLER", gfx::DescriptorType::SAMPLER);
+    setConstant(constants.get(), "STAGE_ALL", gfx::ShaderStageFlagBit::ALL);
+
+    se::Value factory;
+    se::Value device;
+    se::Value bindings;
+    if (!engine->evalString(GFX_BINDING_SCRIPT, -1, &factory) || !factory.isObject() ||
+        !native_ptr_to_seval(gfx::Device::getInstance(), &device) ||
+        !factory.toObject()->call({device, se::Value(constants)}, nullptr, &bindings) || !bindings.isObject()) {
+        return;
+    }
+
+    const uint32_t total = options.warmup + options.iterations;
+    const se::ValueArray args{se::Value(BINDING_CALLS)};
+    se::Value func;
+    for (const char *name : GFX_BINDINGS) {
+        if (!bindings.toObject()->getProperty(name, &func) || !func.isObject()) continue;
+        Samples samples(name, total);
+        for (uint32_t i = 0; i < total; ++i) {
+            samples.measure(i >= options.warmup, [&]() {
+                func.toObject()->call(args, bindings.toObject());
+            });
+        }
+        result->timings.push_back(samples.stats());
+    }
+
+    if (bindings.toObject()->getProperty("destroy", &func) && func.isObject()) {
+        func.toObject()->call(se::EmptyValueArray, bindings.toObject());
+    }
+}
+
+// the same parallelFor with one thread up to one per core, the calling thread always works too
+void runJobSystemScaling(const BenchmarkOptions &options, MicroResult *result) {
+    std::vector<float> values(PARALLEL_FOR_SIZE);
+    const uint32_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+    const uint32_t total = options.warmup + options.iterations;
+
+    for (uint32_t workers = 0; workers < cores; ++workers) {
+        std::unique_ptr<JobSystem> jobSystem(new JobSystem(workers));
+        Samples samples("parallelFor" + std::to_string(workers + 1) + "T", total);
+        for (uint32_t i = 0; i < total; ++i) {
+            samples.measure(i >= options.warmup, [&]() {
+                jobSystem->parallelFor(0, PARALLEL_FOR_SIZE, PARALLEL_FOR_GRAIN, [&](uint32_t first, uint32_t last) {
+                    for (uint32_t n = first; n < last; ++n) {
+                        values[n] = std::sqrt(static_cast<float>(n)) * std::sin(static_cast<float>(n));
+                    }
+                });
+            });
+        }
+        result->timings.push_back(samples.stats());
+    }
+}
+
+struct Entry {
+    const char *name;
+    void (*func)(const BenchmarkOptions &, MicroResult *);
+};
+
+const Entry ENTRIES[] = {
+    {"jsbProperty", runPropertyAccess},
+    {"jsbGfx", runGfxBindings},
+    {"jobSystem", runJobSystemScaling},
+};
+} // namespace
+
+const std::vector<std::string> &MicroBenchmark::getNames() {
+    static std::vector<std::string> names;
+    if (names.empty()) {
+        for (const auto &entry : ENTRIES) names.emplace_back(entry.name);
+    }
+    return names;
+}
+
+bool MicroBenchmark::run(const std::string &name, const BenchmarkOptions &options, MicroResult *result) {
+    for (const auto &entry : ENTRIES) {
+        if (name != entry.name) continue;
+        result->name = name;
+        result->timings.clear();
+        entry.func(options, result);
+        return true;
+    }
+    return false;
+}
+
+} // namespace benchmark
+} // namespace cc
@@ -0,0 +1,266 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "PipelineBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "cocos/base/memory/FrameAllocator.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/renderer/core/Core.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/renderer/pipeline/RenderAdditiveLightQueue.h"
+#include "cocos/renderer/pipeline/RenderQueue.h"
+#include "cocos/renderer/pipeline/forward/ForwardPipeline.h"
+#include "cocos/renderer/pipeline/forward/ForwardStage.h"
+#include "cocos/renderer/pipeline/forward/SceneCulling.h"
+#include "cocos/renderer/pipeline/helper/SharedMemory.h"
+#include "cocos/renderer/pipeline/shadow/ShadowStage.h"
+
+namespace cc {
+namespace benchmark {
+
+using namespace pipeline;
+
+namespace {
+void appendStats(std::string &out, const TimingStats &stats) {
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer), "{\"min\": %.2f, \"median\": %.2f, \"p95\": %.2f, \"mean\": %.2f}",
+             stats.min, stats.median, stats.p95, stats.mean);
+    out += buffer;
+}
+} // namespace
+
+TimingStats TimingStats::compute(std::vector<double> samples) {
+    TimingStats stats;
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+    const size_t count = samples.size();
+    double sum = 0.0;
+    for (const auto sample : samples) sum += sample;
+
+    stats.min = samples.front();
+    stats.median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5;
+    stats.p95 = samples[std::min(count - 1, static_cast<size_t>(count * 0.95))];
+    stats.mean = sum / count;
+    return stats;
+}
+
+PipelineBenchmark::PipelineBenchmark(gfx::Device *device, const BenchmarkOptions &options)
+: _device(device),
+  _options(options) {
+}
+
+SceneResult PipelineBenchmark::run(const SceneConfig &config) {
+    SceneResult result;
+    result.config = config;
+
+    auto *pipeline = CC_NEW(ForwardPipeline);
+    pipeline->initialize({});
+    pipeline->activate();
+
+    SyntheticScene scene(config, _device);
+    scene.generate(pipeline);
+
+    Camera *camera = GET_CAMERA(scene.getCameraID());
+    const vector<uint> cameras = {scene.getCameraID()};
+    auto *cmdBuff = pipeline->getCommandBuffers()[0];
+
+    // one complete frame for the counters, it also creates the shadow maps
+    pipeline->render(cameras);
+    _device->present();
+    result.drawCalls = _device->getNumDrawCalls();
+    result.instances = _device->getNumInstances();
+    result.triangles = _device->getNumTris();
+
+    // standalone stages and queues run on the same pipeline state so each step can be timed on its own
+    auto *forwardStage = CC_NEW(ForwardStage);
+    forwardStage->initialize(ForwardStage::getInitializeInfo());
+    forwardStage->activate(pipeline, nullptr);
+    auto *shadowStage = CC_NEW(ShadowStage);
+    shadowStage->initialize(ShadowStage::getInitializeInfo());
+    shadowStage->activate(pipeline, nullptr);
+    auto *lightQueue = CC_NEW(RenderAdditiveLightQueue(pipeline));
+
+    const uint defaultPhase = getPhaseID("default");
+    RenderQueue opaqueQueue({false, defaultPhase, opaqueCompareFn});
+    RenderQueue transparentQueue({true, defaultPhase, transparentCompareFn});
+    std::vector<const Light *> shadowLights;
+
+    const uint32_t total = _options.warmup + _options.iterations;
+    Samples frame("frame", total);
+    Samples culling("culling", total);
+    Samples shadowCollect("shadowCollecting", total);
+    Samples shadowRender("shadowStage", total);
+    Samples forward("forwardStage", total);
+    Samples queueInsert("queueInsert", total);
+    Samples queueSort("queueSort", total);
+    Samples queueRecord("queueRecord", total);
+    Samples additiveLights("additiveLights", total);
+
+    const bool shadowMap = config.shadows == ShadowMode::SHADOWMAP;
+    auto *framebuffer = camera->getWindow()->getFramebuffer();
+    auto *renderPass = pipeline->getOrCreateRenderPass(static_cast<gfx::ClearFlagBit>(camera->clearFlag));
+    const gfx::Rect renderArea = {0, 0, camera->width, camera->height};
+    const gfx::ColorList clearColors = {camera->clearColor};
+
+    for (uint32_t i = 0; i < total; ++i) {
+        const bool record = i >= _options.warmup;
+
+        frame.measure(record, [&]() {
+            pipeline->render(cameras);
+            _device->present();
+        });
+
+        cmdBuff->begin();
+        pipeline->updateGlobalUBO();
+        pipeline->updateCameraUBO(camera);
+
+        culling.measure(record, [&]() { sceneCulling(pipeline, camera); });
+        if (!i) result.renderObjects = static_cast<uint32_t>(pipeline->getRenderObjects().size());
+
+        if (shadowMap) {
+            shadowCollect.measure(record, [&]() {
+                lightCollecting(camera, shadowLights);
+                shadowCollecting(pipeline, camera);
+            });
+            if (!i) result.shadowObjects = static_cast<uint32_t>(pipeline->getShadowObjects().size());
+
+            shadowRender.measure(record, [&]() {
+                const auto &framebuffers = pipeline->getShadowFramebufferMap();
+                for (const auto *light : shadowLights) {
+                    if (!framebuffers.count(light)) continue;
+                    shadowStage->setUseData(light, framebuffers.at(light));
+                    shadowStage->render(camera);
+                }
+                pipeline->updateShadowUBO(camera);
+            });
+        }
+
+        forward.measure(record, [&]() { forwardStage->render(camera); });
+
+        queueInsert.measure(record, [&]() {
+            opaqueQueue.clear();
+            transparentQueue.clear();
+            for (const auto &ro : pipeline->getRenderObjects()) {
+                const auto *subModelID = ro.model->getSubModelID();
+                for (uint m = 1; m <= subModelID[0]; ++m) {
+                    const auto *subModel = ro.model->getSubModelView(subModelID[m]);
+                    for (uint p = 0; p < subModel->passCount; ++p) {
+                        if (subModel->getPassView(p)->batchingScheme) continue;
+                        if (!opaqueQueue.insertRenderPass(ro, m, p)) {
+                            transparentQueue.insertRenderPass(ro, m, p);
+                        }
+                    }
+                }
+            }
+        });
+
+        queueSort.measure(record, [&]() {
+            opaqueQueue.sort();
+            transparentQueue.sort();
+        });
+
+        queueRecord.measure(record, [&]() {
+            cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, clearColors, camera->clearDepth, camera->clearStencil);
+            cmdBuff->bindDescriptorSet(GLOBAL_SET, pipeline->getDescriptorSet());
+            opaqueQueue.recordCommandBuffer(_device, renderPass, cmdBuff);
+            transparentQueue.recordCommandBuffer(_device, renderPass, cmdBuff);
+            cmdBuff->endRenderPass();
+        });
+
+        additiveLights.measure(record, [&]() { lightQueue->gatherLightPasses(camera, cmdBuff); });
+
+        cmdBuff->end();
+        _device->getQueue()->submit(pipeline->getCommandBuffers());
+        _device->present();
+
+        pipeline->setRenderObjects(RenderObjectList());
+        pipeline->setShadowObjects(RenderObjectList());
+        FrameAllocator::resetAll();
+    }
+
+    for (const auto *samples : {&frame, &culling, &shadowCollect, &shadowRender, &forward, &queueInsert, &queueSort, &queueRecord, &additiveLights}) {
+        if (!samples->empty()) result.timings.push_back(samples->stats());
+    }
+
+    lightQueue->destroy();
+    CC_DELETE(lightQueue);
+    CC_SAFE_DESTROY(shadowStage);
+    CC_SAFE_DESTROY(forwardStage);
+
+    // the pipeline caches reference the scene's gfx objects, release them first
+    pipeline->destroy();
+    CC_DELETE(pipeline);
+    scene.destroy();
+
+    return result;
+}
+
+std::string PipelineBenchmark::toJSON(const std::vector<SceneResult> &results, const std::vector<MicroResult> &microResults) const {
+    std::string out;
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "{\n  \"version\": 1,\n  \"device\": \"%s\",\n  \"iterations\": %u,\n  \"warmup\": %u,\n  \"scenes\": [",
+             _device->getDeviceName().c_str(), _options.iterations, _options.warmup);
+    out += buffer;
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        out += i ? ",\n    {" : "\n    {";
+        out += "\n      \"name\": \"" + result.config.name + "\",";
+        out += "\n      \"config\": " + result.config.toJSON() + ",";
+        snprintf(buffer, sizeof(buffer),
+                 "\n      \"counters\": {\"drawCalls\": %u, \"instances\": %u, \"triangles\": %u, \"renderObjects\": %u, \"shadowObjects\": %u},",
+                 result.drawCalls, result.instances, result.triangles, result.renderObjects, result.shadowObjects);
+        out += buffer;
+        out += "\n      \"timings\": {";
+        for (size_t t = 0; t < result.timings.size(); ++t) {
+            out += t ? ",\n        \"" : "\n        \"";
+            out += result.timings[t].first + "\": ";
+            appendStats(out, result.timings[t].second);
+        }
+        out += "\n      }\n    }";
+    }
+    out += "\n  ],\n  \"micro\": [";
+
+    for (size_t i = 0; i < microResults.size(); ++i) {
+        const auto &result = microResults[i];
+        out += i ? ",\n    {" : "\n    {";
+        out += "\n      \"name\": \"" + result.name + "\",";
+        out += "\n      \"timings\": {";
+        for (size_t t = 0; t < result.timings.size(); ++t) {
+            out += t ? ",\n        \"" : "\n        \"";
+            out += result.timings[t].first + "\": ";
+            appendStats(out, result.timings[t].second);
+        }
+        out += "\n      }\n    }";
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+} // namespace benchmark
+} // namespace cc
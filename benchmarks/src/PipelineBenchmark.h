@@ -0,0 +1,118 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SceneGenerator.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+} // namespace gfx
+
+namespace benchmark {
+
+struct BenchmarkOptions {
+    uint32_t iterations = 100;
+    uint32_t warmup = 10;
+};
+
+// in microseconds
+struct TimingStats {
+    double min = 0.0;
+    double median = 0.0;
+    double p95 = 0.0;
+    double mean = 0.0;
+
+    static TimingStats compute(std::vector<double> samples);
+};
+
+using TimingList = std::vector<std::pair<std::string, TimingStats>>;
+
+// durations of one step over all iterations, warmup iterations are run but not recorded
+class Samples {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Samples(std::string name, uint32_t reserve) : _name(std::move(name)) { _values.reserve(reserve); }
+
+    template <typename F>
+    void measure(bool record, const F &func) {
+        const auto begin = Clock::now();
+        func();
+        if (record) add(Clock::now() - begin);
+    }
+
+    void add(Clock::duration duration) {
+        _values.push_back(std::chrono::duration<double, std::micro>(duration).count());
+    }
+
+    bool empty() const { return _values.empty(); }
+    std::pair<std::string, TimingStats> stats() const { return {_name, TimingStats::compute(_values)}; }
+
+private:
+    std::string _name;
+    std::vector<double> _values;
+};
+
+struct SceneResult {
+    SceneConfig config;
+    // counters of one full pipeline frame
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;
+    uint32_t triangles = 0;
+    uint32_t renderObjects = 0;
+    uint32_t shadowObjects = 0;
+    TimingList timings;
+};
+
+struct MicroResult {
+    std::string name;
+    TimingList timings;
+};
+
+/**
+ * Times the forward pipeline stage by stage on generated scenes.
+ * Every scene gets a fresh pipeline so that no cache outlives its scene.
+ */
+class PipelineBenchmark final {
+public:
+    PipelineBenchmark(gfx::Device *device, const BenchmarkOptions &options);
+
+    SceneResult run(const SceneConfig &config);
+
+    std::string toJSON(const std::vector<SceneResult> &results, const std::vector<MicroResult> &microResults) const;
+
+private:
+    gfx::Device *_device = nullptr;
+    BenchmarkOptions _options;
+};
+
+} // namespace benchmark
+} // namespace cc
@@ -0,0 +1,724 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "cocos/base/memory/Memory.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/renderer/core/Core.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/renderer/pipeline/forward/ForwardPipeline.h"
+#include "cocos/renderer/pipeline/helper/SharedMemory.h"
+
+namespace cc {
+namespace benchmark {
+
+using namespace pipeline;
+
+namespace {
+constexpr float PI = 3.14159265358979f;
+constexpr uint32_t VERTEX_STRIDE = 32;
+constexpr uint32_t VERTEX_COUNT = 24;
+constexpr uint32_t INDEX_COUNT = 36;
+constexpr uint32_t INSTANCED_STRIDE = 48;
+constexpr uint32_t MAX_PASS_COUNT = 4;
+constexpr uint32_t DEFAULT_PRIORITY = 128;
+const float IDENTITY_ROTATION[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+const gfx::AttributeList MESH_ATTRIBUTES = {
+    {"a_position", gfx::Format::RGB32F, false, 0, false, 0},
+    {"a_normal", gfx::Format::RGB32F, false, 0, false, 1},
+    {"a_texCoord", gfx::Format::RG32F, false, 0, false, 2},
+};
+
+void buildFrustum(const Mat4 &viewProj, Frustum *frustum) {
+    // rows of the column-major matrix
+    const float *m = viewProj.m;
+    float rows[4][4];
+    for (int r = 0; r < 4; ++r) {
+        rows[r][0] = m[r];
+        rows[r][1] = m[r + 4];
+        rows[r][2] = m[r + 8];
+        rows[r][3] = m[r + 12];
+    }
+
+    // left, right, bottom, top, near, far, normals pointing inside
+    for (int i = 0; i < 6; ++i) {
+        const float sign = i % 2 ? -1.0f : 1.0f;
+        const float *row = rows[i / 2];
+        Vec3 normal(rows[3][0] + sign * row[0], rows[3][1] + sign * row[1], rows[3][2] + sign * row[2]);
+        const float w = rows[3][3] + sign * row[3];
+        const float length = normal.length();
+        normal.scale(1.0f / length);
+        frustum->planes[i].normal = normal;
+        frustum->planes[i].distance = -w / length;
+    }
+
+    const Mat4 inverse = viewProj.getInversed();
+    for (int i = 0; i < 8; ++i) {
+        Vec4 corner(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+        inverse.transformVector(&corner);
+        frustum->vertices[i].set(corner.x / corner.w, corner.y / corner.w, corner.z / corner.w);
+    }
+}
+
+bool parseUint(const std::string &value, uint32_t *out) {
+    char *end = nullptr;
+    const unsigned long result = strtoul(value.c_str(), &end, 10);
+    if (value.empty() || *end) return false;
+    *out = static_cast<uint32_t>(result);
+    return true;
+}
+
+bool parseRatio(const std::string &value, float *out) {
+    char *end = nullptr;
+    const float result = strtof(value.c_str(), &end);
+    if (value.empty() || *end || result < 0.0f || result > 1.0f) return false;
+    *out = result;
+    return true;
+}
+
+std::vector<SceneConfig> createPresets() {
+    std::vector<SceneConfig> presets;
+    SceneConfig config;
+
+    config.name = "baseline";
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "instanced";
+    config.models = 5000;
+    config.instancedRatio = 0.8f;
+    config.materials = 8;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "batched";
+    config.models = 3000;
+    config.batchedRatio = 0.8f;
+    config.materials = 8;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "transparent";
+    config.models = 3000;
+    config.transparentRatio = 0.5f;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "lights";
+    config.models = 2000;
+    config.sphereLights = 16;
+    config.spotLights = 8;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "planar-shadows";
+    config.models = 2000;
+    config.instancedRatio = 0.3f;
+    config.shadows = ShadowMode::PLANAR;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "shadowmap";
+    config.models = 2000;
+    config.shadows = ShadowMode::SHADOWMAP;
+    config.shadowCasterRatio = 0.6f;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "ui";
+    config.models = 500;
+    config.uiBatches = 1000;
+    presets.push_back(config);
+
+    config = SceneConfig();
+    config.name = "stress";
+    config.models = 20000;
+    config.subModels = 2;
+    config.passes = 2;
+    config.instancedRatio = 0.3f;
+    config.batchedRatio = 0.1f;
+    config.transparentRatio = 0.1f;
+    config.sphereLights = 8;
+    config.spotLights = 4;
+    config.shadows = ShadowMode::SHADOWMAP;
+    config.uiBatches = 200;
+    config.extent = 400.0f;
+    presets.push_back(config);
+
+    return presets;
+}
+} // namespace
+
+const char *getShadowModeName(ShadowMode mode) {
+    switch (mode) {
+        case ShadowMode::PLANAR: return "planar";
+        case ShadowMode::SHADOWMAP: return "shadowmap";
+        default: return "none";
+    }
+}
+
+bool SceneConfig::set(const std::string &key, const std::string &value) {
+    if (key == "models") return parseUint(value, &models) && models > 0;
+    if (key == "subModels") return parseUint(value, &subModels) && subModels > 0;
+    if (key == "passes") return parseUint(value, &passes) && passes > 0 && passes <= MAX_PASS_COUNT;
+    if (key == "materials") return parseUint(value, &materials) && materials > 0;
+    if (key == "instancedRatio") return parseRatio(value, &instancedRatio);
+    if (key == "batchedRatio") return parseRatio(value, &batchedRatio);
+    if (key == "transparentRatio") return parseRatio(value, &transparentRatio);
+    if (key == "sphereLights") return parseUint(value, &sphereLights);
+    if (key == "spotLights") return parseUint(value, &spotLights);
+    if (key == "shadowCasterRatio") return parseRatio(value, &shadowCasterRatio);
+    if (key == "uiBatches") return parseUint(value, &uiBatches);
+    if (key == "seed") return parseUint(value, &seed);
+    if (key == "extent") {
+        char *end = nullptr;
+        extent = strtof(value.c_str(), &end);
+        return !value.empty() && !*end && extent > 0.0f;
+    }
+    if (key == "shadows") {
+        if (value == "none") {
+            shadows = ShadowMode::NONE;
+        } else if (value == "planar") {
+            shadows = ShadowMode::PLANAR;
+        } else if (value == "shadowmap") {
+            shadows = ShadowMode::SHADOWMAP;
+        } else {
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+std::string SceneConfig::toJSON() const {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "{\"models\": %u, \"subModels\": %u, \"passes\": %u, \"materials\": %u, "
+             "\"instancedRatio\": %.3f, \"batchedRatio\": %.3f, \"transparentRatio\": %.3f, "
+             "\"sphereLights\": %u, \"spotLights\": %u, \"shadows\": \"%s\", \"shadowCasterRatio\": %.3f, "
+             "\"uiBatches\": %u, \"extent\": %.1f, \"seed\": %u}",
+             models, subModels, passes, materials,
+             instancedRatio, batchedRatio, transparentRatio,
+             sphereLights, spotLights, getShadowModeName(shadows), shadowCasterRatio,
+             uiBatches, extent, seed);
+    return buffer;
+}
+
+const std::vector<SceneConfig> &SceneConfig::getPresets() {
+    static const std::vector<SceneConfig> presets = createPresets();
+    return presets;
+}
+
+const SceneConfig *SceneConfig::findPreset(const std::string &name) {
+    for (const auto &preset : getPresets()) {
+        if (preset.name == name) return &preset;
+    }
+    return nullptr;
+}
+
+uint32_t SyntheticScene::Random::next() {
+    // xorshift32, stable across platforms and standard libraries
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+}
+
+float SyntheticScene::Random::range(float min, float max) {
+    return min + (max - min) * static_cast<float>(next() >> 8) / static_cast<float>(1 << 24);
+}
+
+SyntheticScene::SyntheticScene(const SceneConfig &config, gfx::Device *device)
+: _config(config),
+  _device(device),
+  _random(config.seed) {
+}
+
+SyntheticScene::~SyntheticScene() {
+    destroy();
+}
+
+void SyntheticScene::generate(ForwardPipeline *pipeline) {
+    _defaultPhase = getPhaseID("default");
+    _forwardAddPhase = getPhaseID("forward-add");
+    _shadowCasterPhase = getPhaseID("shadow-caster");
+
+    createSharedResources(pipeline);
+    createEnvironment(pipeline);
+    createMaterials();
+    createModels();
+    createLights();
+    createUIBatches();
+    createCamera(pipeline);
+}
+
+void SyntheticScene::destroy() {
+    for (auto *ia : _inputAssemblers) {
+        CC_SAFE_DESTROY(ia);
+    }
+    _inputAssemblers.clear();
+    for (auto *descriptorSet : _descriptorSets) {
+        CC_SAFE_DESTROY(descriptorSet);
+    }
+    _descriptorSets.clear();
+    for (auto *shader : _shaders) {
+        CC_SAFE_DESTROY(shader);
+    }
+    _shaders.clear();
+    for (auto *attribute : _attributes) {
+        CC_DELETE(attribute);
+    }
+    _attributes.clear();
+
+    CC_SAFE_DESTROY(_framebuffer);
+    CC_SAFE_DESTROY(_pipelineLayout);
+    CC_SAFE_DESTROY(_materialLayout);
+    CC_SAFE_DESTROY(_localLayout);
+    CC_SAFE_DESTROY(_vertexBuffer);
+    CC_SAFE_DESTROY(_indexBuffer);
+}
+
+void SyntheticScene::createSharedResources(ForwardPipeline *pipeline) {
+    _materialLayout = _device->createDescriptorSetLayout({{
+        {0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::ALL},
+    }});
+    _localLayout = _device->createDescriptorSetLayout({localDescriptorSetLayout.bindings});
+    _pipelineLayout = _device->createPipelineLayout({{pipeline->getDescriptorSetLayout(), _materialLayout, _localLayout}});
+    _pipelineLayoutID = _pools.addObject(se::PoolType::PIPELINE_LAYOUT, _pipelineLayout);
+
+    gfx::RasterizerState *rasterizerState = nullptr;
+    _rasterizerStateID = _pools.alloc(se::PoolType::RASTERIZER_STATE, &rasterizerState);
+    gfx::DepthStencilState *depthStencilState = nullptr;
+    _depthStencilStateID = _pools.alloc(se::PoolType::DEPTH_STENCIL_STATE, &depthStencilState);
+
+    // blend states are read back as {isA2C, isIndepend, color, target array}
+    for (int transparent = 0; transparent < 2; ++transparent) {
+        gfx::BlendTarget *target = nullptr;
+        const uint32_t targetID = _pools.alloc(se::PoolType::BLEND_TARGET, &target);
+        if (transparent) {
+            target->blend = 1;
+            target->blendSrc = gfx::BlendFactor::SRC_ALPHA;
+            target->blendDst = gfx::BlendFactor::ONE_MINUS_SRC_ALPHA;
+        }
+
+        uint8_t *entry = nullptr;
+        const uint32_t blendStateID = _pools.allocEntry(se::PoolType::BLEND_STATE, 7 * sizeof(uint32_t), &entry);
+        reinterpret_cast<uint32_t *>(entry)[6] = _pools.allocArray(se::PoolType::BLEND_TARGET_ARRAY, {targetID});
+        (transparent ? _transparentBlendStateID : _opaqueBlendStateID) = blendStateID;
+    }
+
+    // one cube shaped mesh shared by every sub-model
+    _vertexBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        VERTEX_STRIDE * VERTEX_COUNT,
+        VERTEX_STRIDE,
+    });
+    _indexBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::INDEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        INDEX_COUNT * sizeof(uint16_t),
+        sizeof(uint16_t),
+    });
+
+    FlatBufferView *flatBuffer = nullptr;
+    const uint32_t flatBufferID = _pools.alloc(&flatBuffer);
+    uint8_t *vertices = nullptr;
+    flatBuffer->stride = VERTEX_STRIDE;
+    flatBuffer->count = VERTEX_COUNT;
+    flatBuffer->bufferID = _pools.allocRawBuffer(VERTEX_STRIDE * VERTEX_COUNT, &vertices);
+
+    RenderingSubMesh *subMesh = nullptr;
+    _subMeshID = _pools.alloc(&subMesh);
+    subMesh->flatBuffersID = _pools.allocArray(se::PoolType::FLAT_BUFFER_ARRAY, {flatBufferID});
+
+    std::vector<uint32_t> attributeIDs;
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto *attribute = CC_NEW(gfx::Attribute);
+        attribute->name = "a_matWorld" + std::to_string(i);
+        attribute->format = gfx::Format::RGBA32F;
+        attribute->isInstanced = true;
+        attribute->location = static_cast<uint>(MESH_ATTRIBUTES.size()) + i;
+        _attributes.push_back(attribute);
+        attributeIDs.push_back(_pools.addObject(se::PoolType::ATTRIBUTE, attribute));
+    }
+    _instancedAttrsID = _pools.allocArray(se::PoolType::ATTRIBUTE_ARRAY, attributeIDs);
+    _emptyAttrsID = _pools.allocArray(se::PoolType::ATTRIBUTE_ARRAY, {});
+}
+
+void SyntheticScene::createEnvironment(ForwardPipeline *pipeline) {
+    // the root has to be the first entry of its pool
+    Root *root = nullptr;
+    _pools.alloc(&root);
+    root->frameTime = 1.0f / 60.0f;
+
+    Ambient *ambient = nullptr;
+    const uint32_t ambientID = _pools.alloc(&ambient);
+    ambient->enabled = 1;
+    ambient->skyIllum = 20000.0f;
+    ambient->skyColor.set(0.2f, 0.5f, 0.8f, 1.0f);
+    ambient->groundAlbedo.set(0.2f, 0.2f, 0.2f, 1.0f);
+
+    Fog *fog = nullptr;
+    const uint32_t fogID = _pools.alloc(&fog);
+
+    Skybox *skybox = nullptr;
+    const uint32_t skyboxID = _pools.alloc(&skybox);
+
+    Shadows *shadows = nullptr;
+    const uint32_t shadowsID = _pools.alloc(&shadows);
+    shadows->enabled = _config.shadows != ShadowMode::NONE;
+    shadows->dirty = 1;
+    shadows->shadowType = static_cast<uint32_t>(_config.shadows == ShadowMode::PLANAR ? ShadowType::PLANAR : ShadowType::SHADOWMAP);
+    shadows->nearValue = 0.1f;
+    shadows->farValue = _config.extent * 4.0f;
+    shadows->aspect = 1.0f;
+    shadows->bias = 0.00001f;
+    shadows->orthoSize = _config.extent;
+    shadows->autoAdapt = 1;
+    shadows->color.set(0.0f, 0.0f, 0.0f, 0.3f);
+    shadows->size.set(1024.0f, 1024.0f);
+    shadows->normal.set(0.0f, 1.0f, 0.0f);
+    if (_config.shadows == ShadowMode::PLANAR) {
+        shadows->planarPass = createPass(_defaultPhase, 0, true, DEFAULT_PRIORITY);
+        _planarShaderID = createShader("planar-shadow");
+    }
+
+    pipeline->setAmbient(ambientID);
+    pipeline->setFog(fogID);
+    pipeline->setSkybox(skyboxID);
+    pipeline->setShadows(shadowsID);
+}
+
+uint32_t SyntheticScene::createPass(uint32_t phase, uint32_t batchingScheme, bool transparent, uint32_t priority) {
+    auto *descriptorSet = _device->createDescriptorSet({_materialLayout});
+    _descriptorSets.push_back(descriptorSet);
+
+    PassView *pass = nullptr;
+    const uint32_t passID = _pools.alloc(&pass);
+    pass->priority = priority;
+    pass->stage = static_cast<uint32_t>(RenderPassStage::DEFAULT);
+    pass->phase = phase;
+    pass->batchingScheme = batchingScheme;
+    pass->primitive = static_cast<uint32_t>(gfx::PrimitiveMode::TRIANGLE_LIST);
+    // scrambled so that the pass hashes do not line up with the other PSO hash inputs
+    pass->hash = ++_passHash * 2654435761u;
+    pass->rasterizerStateID = _rasterizerStateID;
+    pass->depthStencilStateID = _depthStencilStateID;
+    pass->blendStateID = transparent ? _transparentBlendStateID : _opaqueBlendStateID;
+    pass->descriptorSetID = _pools.addObject(se::PoolType::DESCRIPTOR_SETS, descriptorSet);
+    pass->pipelineLayoutID = _pipelineLayoutID;
+    return passID;
+}
+
+uint32_t SyntheticScene::createShader(const std::string &name) {
+    auto *shader = _device->createShader({
+        name,
+        {{gfx::ShaderStageFlagBit::VERTEX, ""}, {gfx::ShaderStageFlagBit::FRAGMENT, ""}},
+        MESH_ATTRIBUTES,
+    });
+    _shaders.push_back(shader);
+    return _pools.addObject(se::PoolType::SHADER, shader);
+}
+
+void SyntheticScene::createMaterials() {
+    const bool hasLights = _config.sphereLights || _config.spotLights;
+    const bool castShadows = _config.shadows == ShadowMode::SHADOWMAP;
+    const uint32_t extraPasses = (hasLights ? 1 : 0) + (castShadows ? 1 : 0);
+    const uint32_t forwardPasses = std::max(1u, std::min(_config.passes, MAX_PASS_COUNT - extraPasses));
+
+    auto createGroup = [&](std::vector<Material> &group, uint32_t batchingScheme, bool transparent) {
+        for (uint32_t m = 0; m < _config.materials; ++m) {
+            Material material;
+            material.transparent = transparent;
+            material.batchingScheme = batchingScheme;
+            const std::string prefix = "material" + std::to_string(_passHash) + "-";
+            for (uint32_t p = 0; p < forwardPasses; ++p) {
+                material.passIDs.push_back(createPass(_defaultPhase, batchingScheme, transparent, DEFAULT_PRIORITY + p));
+                material.shaderIDs.push_back(createShader(prefix + "forward" + std::to_string(p)));
+            }
+            if (hasLights) {
+                material.passIDs.push_back(createPass(_forwardAddPhase, batchingScheme, transparent, DEFAULT_PRIORITY));
+                material.shaderIDs.push_back(createShader(prefix + "forward-add"));
+            }
+            if (castShadows) {
+                material.passIDs.push_back(createPass(_shadowCasterPhase, batchingScheme, false, DEFAULT_PRIORITY));
+                material.shaderIDs.push_back(createShader(prefix + "shadow-caster"));
+            }
+            group.push_back(std::move(material));
+        }
+    };
+
+    createGroup(_standardMaterials, 0, false);
+    if (_config.instancedRatio > 0.0f) createGroup(_instancedMaterials, static_cast<uint32_t>(BatchingSchemes::INSTANCING), false);
+    if (_config.batchedRatio > 0.0f) createGroup(_batchedMaterials, static_cast<uint32_t>(BatchingSchemes::VB_MERGING), false);
+    if (_config.transparentRatio > 0.0f) createGroup(_transparentMaterials, 0, true);
+}
+
+const std::vector<SyntheticScene::Material> &SyntheticScene::pickGroup() {
+    const float r = _random.range(0.0f, 1.0f);
+    float threshold = _config.instancedRatio;
+    const std::vector<Material> *group = &_standardMaterials;
+    if (r < threshold) {
+        group = &_instancedMaterials;
+    } else if (r < (threshold += _config.batchedRatio)) {
+        group = &_batchedMaterials;
+    } else if (r < (threshold += _config.transparentRatio)) {
+        group = &_transparentMaterials;
+    }
+    return *group;
+}
+
+uint32_t SyntheticScene::createNode(const float *position, const float *rotation, uint32_t layer) {
+    Node *node = nullptr;
+    const uint32_t nodeID = _pools.alloc(&node);
+    node->flagsChanged = 1;
+    node->layer = layer;
+    node->worldScale.set(1.0f, 1.0f, 1.0f);
+    node->worldPosition.set(position[0], position[1], position[2]);
+    node->worldRotation.set(rotation[0], rotation[1], rotation[2], rotation[3]);
+    Mat4::fromRT(node->worldRotation, node->worldPosition, &node->worldMatrix);
+    return nodeID;
+}
+
+uint32_t SyntheticScene::createAABB(const float *center, const float *halfExtents) {
+    AABB *aabb = nullptr;
+    const uint32_t aabbID = _pools.alloc(&aabb);
+    aabb->center.set(center[0], center[1], center[2]);
+    aabb->halfExtents.set(halfExtents[0], halfExtents[1], halfExtents[2]);
+    return aabbID;
+}
+
+uint32_t SyntheticScene::createSubModel(const Material &material) {
+    auto *descriptorSet = _device->createDescriptorSet({_localLayout});
+    _descriptorSets.push_back(descriptorSet);
+    auto *ia = _device->createInputAssembler({MESH_ATTRIBUTES, {_vertexBuffer}, _indexBuffer});
+    _inputAssemblers.push_back(ia);
+
+    SubModelView *subModel = nullptr;
+    const uint32_t subModelID = _pools.alloc(&subModel);
+    subModel->priority = DEFAULT_PRIORITY;
+    subModel->passCount = static_cast<uint32_t>(material.passIDs.size());
+    for (uint32_t p = 0; p < subModel->passCount; ++p) {
+        subModel->passID[p] = material.passIDs[p];
+        subModel->shaderID[p] = material.shaderIDs[p];
+    }
+    subModel->planarShaderID = _planarShaderID;
+    subModel->descriptorSetID = _pools.addObject(se::PoolType::DESCRIPTOR_SETS, descriptorSet);
+    subModel->inputAssemblerID = _pools.addObject(se::PoolType::INPUT_ASSEMBLER, ia);
+    subModel->subMeshID = _subMeshID;
+    return subModelID;
+}
+
+void SyntheticScene::createModels() {
+    const float extent = _config.extent;
+    std::vector<uint32_t> modelIDs;
+    modelIDs.reserve(_config.models);
+
+    for (uint32_t i = 0; i < _config.models; ++i) {
+        const float position[3] = {_random.range(-extent, extent), _random.range(-extent, extent), _random.range(-extent, extent)};
+        const float halfExtents[3] = {_random.range(0.5f, 3.0f), _random.range(0.5f, 3.0f), _random.range(0.5f, 3.0f)};
+        const uint32_t nodeID = createNode(position, IDENTITY_ROTATION, static_cast<uint32_t>(LayerList::DEFAULT));
+
+        // sub-models of a model share the batching category, not the material
+        const auto &group = pickGroup();
+        std::vector<uint32_t> subModelIDs;
+        for (uint32_t s = 0; s < _config.subModels; ++s) {
+            subModelIDs.push_back(createSubModel(group[_random.next() % group.size()]));
+        }
+
+        ModelView *model = nullptr;
+        modelIDs.push_back(_pools.alloc(&model));
+        model->enabled = 1;
+        model->castShadow = _config.shadows != ShadowMode::NONE && _random.range(0.0f, 1.0f) < _config.shadowCasterRatio;
+        model->receiveShadow = 1;
+        model->worldBoundsID = createAABB(position, halfExtents);
+        model->nodeID = nodeID;
+        model->transformID = nodeID;
+        model->subModelsID = _pools.allocArray(se::PoolType::SUB_MODEL_ARRAY, subModelIDs);
+        model->instancedAttrsID = _emptyAttrsID;
+
+        if (&group == &_instancedMaterials) {
+            // the first three rows of the world matrix, like the builtin instanced shaders expect
+            uint8_t *data = nullptr;
+            model->instancedBufferID = _pools.allocRawBuffer(INSTANCED_STRIDE, &data);
+            auto *rows = reinterpret_cast<float *>(data);
+            const Mat4 &world = GET_NODE(nodeID)->worldMatrix;
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 4; ++c) {
+                    rows[r * 4 + c] = world.m[c * 4 + r];
+                }
+            }
+            model->instancedAttrsID = _instancedAttrsID;
+        }
+    }
+
+    _modelsID = _pools.allocArray(se::PoolType::MODEL_ARRAY, modelIDs);
+}
+
+void SyntheticScene::createLights() {
+    // the main light points down and away from the camera
+    const float angle = -PI / 3.0f;
+    const float mainRotation[4] = {std::sin(angle * 0.5f), 0.0f, 0.0f, std::cos(angle * 0.5f)};
+    const float origin[3] = {0.0f, 0.0f, 0.0f};
+
+    Light *mainLight = nullptr;
+    _mainLightID = _pools.alloc(&mainLight);
+    mainLight->luminance = 65000.0f;
+    mainLight->nodeID = createNode(origin, mainRotation, static_cast<uint32_t>(LayerList::DEFAULT));
+    mainLight->lightType = static_cast<uint32_t>(LightType::DIRECTIONAL);
+    mainLight->direction.set(0.0f, std::sin(angle), -std::cos(angle));
+    mainLight->color.set(1.0f, 1.0f, 1.0f);
+
+    const float extent = _config.extent;
+    const float spotAngle = PI / 3.0f;
+    // spot lights look straight down
+    const float spotRotation[4] = {std::sin(-PI / 4.0f), 0.0f, 0.0f, std::cos(-PI / 4.0f)};
+
+    std::vector<uint32_t> sphereLightIDs;
+    std::vector<uint32_t> spotLightIDs;
+    for (uint32_t i = 0; i < _config.sphereLights + _config.spotLights; ++i) {
+        const bool isSpot = i >= _config.sphereLights;
+        const float position[3] = {_random.range(-extent, extent), _random.range(-extent, extent), _random.range(-extent, extent)};
+        const float range = _random.range(extent * 0.1f, extent * 0.3f);
+        const float halfExtents[3] = {range, range, range};
+
+        Light *light = nullptr;
+        const uint32_t lightID = _pools.alloc(&light);
+        light->luminance = 1700.0f;
+        light->range = range;
+        light->position.set(position[0], position[1], position[2]);
+        light->color.set(_random.range(0.5f, 1.0f), _random.range(0.5f, 1.0f), _random.range(0.5f, 1.0f));
+        light->aabbID = createAABB(position, halfExtents);
+        light->nodeID = createNode(position, isSpot ? spotRotation : IDENTITY_ROTATION, static_cast<uint32_t>(LayerList::DEFAULT));
+
+        if (isSpot) {
+            light->lightType = static_cast<uint32_t>(LightType::SPOT);
+            light->spotAngle = spotAngle;
+            light->direction.set(0.0f, -1.0f, 0.0f);
+
+            Frustum *frustum = nullptr;
+            light->frustumID = _pools.alloc(&frustum);
+            Mat4 viewProj;
+            Mat4::createPerspective(spotAngle, light->aspect, 0.001f, range, &viewProj);
+            viewProj.multiply(GET_NODE(light->nodeID)->worldMatrix.getInversed());
+            buildFrustum(viewProj, frustum);
+            spotLightIDs.push_back(lightID);
+        } else {
+            light->lightType = static_cast<uint32_t>(LightType::SPHERE);
+            sphereLightIDs.push_back(lightID);
+        }
+    }
+
+    _sphereLightsID = _pools.allocArray(se::PoolType::LIGHT_ARRAY, sphereLightIDs);
+    _spotLightsID = _pools.allocArray(se::PoolType::LIGHT_ARRAY, spotLightIDs);
+}
+
+void SyntheticScene::createUIBatches() {
+    std::vector<uint32_t> batchIDs;
+    if (_config.uiBatches) {
+        auto *descriptorSet = _device->createDescriptorSet({_localLayout});
+        _descriptorSets.push_back(descriptorSet);
+        auto *ia = _device->createInputAssembler({MESH_ATTRIBUTES, {_vertexBuffer}, _indexBuffer});
+        _inputAssemblers.push_back(ia);
+
+        const uint32_t passID = createPass(_defaultPhase, 0, true, DEFAULT_PRIORITY);
+        const uint32_t shaderID = createShader("ui-sprite");
+        const uint32_t descriptorSetID = _pools.addObject(se::PoolType::DESCRIPTOR_SETS, descriptorSet);
+        const uint32_t iaID = _pools.addObject(se::PoolType::INPUT_ASSEMBLER, ia);
+
+        for (uint32_t i = 0; i < _config.uiBatches; ++i) {
+            UIBatch *batch = nullptr;
+            batchIDs.push_back(_pools.alloc(&batch));
+            batch->visFlags = static_cast<uint32_t>(LayerList::DEFAULT);
+            batch->passCount = 1;
+            batch->passID[0] = passID;
+            batch->shaderID[0] = shaderID;
+            batch->descriptorSetID = descriptorSetID;
+            batch->inputAssemblerID = iaID;
+        }
+    }
+    _uiBatchesID = _pools.allocArray(se::PoolType::UI_BATCH_ARRAY, batchIDs);
+}
+
+void SyntheticScene::createCamera(ForwardPipeline *pipeline) {
+    Scene *scene = nullptr;
+    _sceneID = _pools.alloc(&scene);
+    scene->mainLightID = _mainLightID;
+    scene->modelsID = _modelsID;
+    scene->sphereLights = _sphereLightsID;
+    scene->spotLights = _spotLightsID;
+    scene->uiBatches = _uiBatchesID;
+
+    const auto clearFlags = gfx::ClearFlagBit::ALL;
+    _framebuffer = _device->createFramebuffer({pipeline->getOrCreateRenderPass(clearFlags)});
+
+    RenderWindow *window = nullptr;
+    const uint32_t windowID = _pools.alloc(&window);
+    window->hasOnScreenAttachments = 1;
+    window->framebufferID = _pools.addObject(se::PoolType::FRAMEBUFFER, _framebuffer);
+
+    // looking down -Z from the front face of the model volume, roughly half of it is visible
+    const float position[3] = {0.0f, 0.0f, _config.extent};
+    const uint32_t nodeID = createNode(position, IDENTITY_ROTATION, static_cast<uint32_t>(LayerList::DEFAULT));
+    const Node *node = GET_NODE(nodeID);
+
+    Camera *camera = nullptr;
+    _cameraID = _pools.alloc(&camera);
+    camera->width = _device->getWidth();
+    camera->height = _device->getHeight();
+    camera->exposure = 1.0f;
+    camera->clearFlag = static_cast<uint32_t>(clearFlags);
+    camera->clearDepth = 1.0f;
+    camera->visibility = CAMERA_DEFAULT_MASK;
+    camera->nodeID = nodeID;
+    camera->sceneID = _sceneID;
+    camera->windowID = windowID;
+    camera->forward.set(0.0f, 0.0f, -1.0f);
+    camera->position = node->worldPosition;
+    camera->viewportWidth = 1.0f;
+    camera->viewportHeight = 1.0f;
+    camera->clearColor = {0.1f, 0.1f, 0.1f, 1.0f};
+
+    const float aspect = static_cast<float>(camera->width) / static_cast<float>(camera->height);
+    Mat4::createPerspective(PI / 3.0f, aspect, 0.1f, _config.extent * 4.0f, &camera->matProj);
+    camera->matProjInv = camera->matProj.getInversed();
+    camera->matView = node->worldMatrix.getInversed();
+    Mat4::multiply(camera->matProj, camera->matView, &camera->matViewProj);
+    camera->matViewProjInv = camera->matViewProj.getInversed();
+
+    Frustum *frustum = nullptr;
+    camera->frustumID = _pools.alloc(&frustum);
+    buildFrustum(camera->matViewProj, frustum);
+}
+
+} // namespace benchmark
+} // namespace cc
@@ -0,0 +1,182 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ScenePools.h"
+
+namespace cc {
+namespace gfx {
+class Buffer;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class Framebuffer;
+class InputAssembler;
+class PipelineLayout;
+class Shader;
+struct Attribute;
+} // namespace gfx
+
+namespace pipeline {
+class ForwardPipeline;
+} // namespace pipeline
+
+namespace benchmark {
+
+enum class ShadowMode {
+    NONE,
+    PLANAR,
+    SHADOWMAP,
+};
+
+struct SceneConfig {
+    std::string name;
+    uint32_t models = 1000;
+    uint32_t subModels = 1;           // per model
+    uint32_t passes = 1;              // forward passes per sub-model
+    uint32_t materials = 16;          // per batching category
+    float instancedRatio = 0.0f;      // share of models drawn through instancing
+    float batchedRatio = 0.0f;        // share of models drawn through vb-merging
+    float transparentRatio = 0.0f;    // share of models in the transparent queue
+    uint32_t sphereLights = 0;
+    uint32_t spotLights = 0;
+    ShadowMode shadows = ShadowMode::NONE;
+    float shadowCasterRatio = 0.5f;
+    uint32_t uiBatches = 0;
+    float extent = 200.0f;            // models are scattered in a cube of this half size
+    uint32_t seed = 1;
+
+    bool set(const std::string &key, const std::string &value);
+    std::string toJSON() const;
+
+    static const std::vector<SceneConfig> &getPresets();
+    static const SceneConfig *findPreset(const std::string &name);
+};
+
+const char *getShadowModeName(ShadowMode mode);
+
+/**
+ * Builds a deterministic scene straight into the DOP pools: models, sub-models,
+ * passes, lights and a camera, plus the gfx objects they reference.
+ * The same config and seed always produce the same scene.
+ */
+class SyntheticScene final {
+public:
+    SyntheticScene(const SceneConfig &config, gfx::Device *device);
+    ~SyntheticScene();
+
+    SyntheticScene(const SyntheticScene &) = delete;
+    SyntheticScene &operator=(const SyntheticScene &) = delete;
+
+    void generate(pipeline::ForwardPipeline *pipeline);
+    // gfx objects have to go before the pipeline caches that reference them are rebuilt
+    void destroy();
+
+    inline uint32_t getCameraID() const { return _cameraID; }
+    inline const SceneConfig &getConfig() const { return _config; }
+
+private:
+    struct Material {
+        bool transparent = false;
+        uint32_t batchingScheme = 0;
+        std::vector<uint32_t> passIDs;
+        std::vector<uint32_t> shaderIDs;
+    };
+
+    class Random {
+    public:
+        explicit Random(uint32_t seed) : _state(seed ? seed : 0x9e3779b9) {}
+        uint32_t next();
+        float range(float min, float max);
+
+    private:
+        uint32_t _state;
+    };
+
+    void createSharedResources(pipeline::ForwardPipeline *pipeline);
+    void createEnvironment(pipeline::ForwardPipeline *pipeline);
+    void createMaterials();
+    void createModels();
+    void createLights();
+    void createUIBatches();
+    void createCamera(pipeline::ForwardPipeline *pipeline);
+
+    uint32_t createPass(uint32_t phase, uint32_t batchingScheme, bool transparent, uint32_t priority);
+    uint32_t createShader(const std::string &name);
+    uint32_t createNode(const float *position, const float *rotation, uint32_t layer);
+    uint32_t createAABB(const float *center, const float *halfExtents);
+    uint32_t createSubModel(const Material &material);
+    const std::vector<Material> &pickGroup();
+
+    SceneConfig _config;
+    gfx::Device *_device = nullptr;
+    ScenePools _pools;
+    Random _random;
+
+    gfx::DescriptorSetLayout *_materialLayout = nullptr;
+    gfx::DescriptorSetLayout *_localLayout = nullptr;
+    gfx::PipelineLayout *_pipelineLayout = nullptr;
+    gfx::Buffer *_vertexBuffer = nullptr;
+    gfx::Buffer *_indexBuffer = nullptr;
+    gfx::Framebuffer *_framebuffer = nullptr;
+    std::vector<gfx::Shader *> _shaders;
+    std::vector<gfx::DescriptorSet *> _descriptorSets;
+    std::vector<gfx::InputAssembler *> _inputAssemblers;
+    std::vector<gfx::Attribute *> _attributes;
+
+    std::vector<Material> _standardMaterials;
+    std::vector<Material> _instancedMaterials;
+    std::vector<Material> _batchedMaterials;
+    std::vector<Material> _transparentMaterials;
+
+    uint32_t _defaultPhase = 0;
+    uint32_t _forwardAddPhase = 0;
+    uint32_t _shadowCasterPhase = 0;
+    uint32_t _passHash = 0;
+
+    uint32_t _rasterizerStateID = 0;
+    uint32_t _depthStencilStateID = 0;
+    uint32_t _opaqueBlendStateID = 0;
+    uint32_t _transparentBlendStateID = 0;
+    uint32_t _pipelineLayoutID = 0;
+    uint32_t _subMeshID = 0;
+    uint32_t _instancedAttrsID = 0;
+    uint32_t _emptyAttrsID = 0;
+    uint32_t _planarShaderID = 0;
+
+    uint32_t _mainLightID = 0;
+    uint32_t _sphereLightsID = 0;
+    uint32_t _spotLightsID = 0;
+    uint32_t _modelsID = 0;
+    uint32_t _uiBatchesID = 0;
+    uint32_t _sceneID = 0;
+    uint32_t _cameraID = 0;
+};
+
+} // namespace benchmark
+} // namespace cc
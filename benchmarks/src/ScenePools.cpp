@@ -0,0 +1,163 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "ScenePools.h"
+
+#include <cstring>
+
+#include "cocos/base/Macros.h"
+#include "cocos/bindings/dop/BufferAllocator.h"
+#include "cocos/bindings/dop/BufferPool.h"
+#include "cocos/bindings/dop/ObjectPool.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+
+namespace cc {
+namespace benchmark {
+
+namespace {
+constexpr uint32_t OBJECT_POOL_FLAG = 1 << 29;
+
+se::Class *getHandleClass() {
+    // a bare class without constructor, the wrappers only carry the native pointer
+    static se::Class *cls = nullptr;
+    if (!cls) {
+        cls = se::Class::create("BenchmarkHandle", se::ScriptEngine::getInstance()->getGlobalObject(), nullptr, nullptr);
+        cls->install();
+    }
+    return cls;
+}
+} // namespace
+
+ScenePools::ScenePools() = default;
+
+ScenePools::~ScenePools() {
+    for (auto *wrapper : _wrappers) {
+        wrapper->clearPrivateData();
+        wrapper->decRef();
+    }
+    _wrappers.clear();
+
+    for (auto &pair : _objectPools) {
+        delete pair.second.pool;
+        pair.second.jsArray->unroot();
+        pair.second.jsArray->decRef();
+    }
+    _objectPools.clear();
+
+    // the allocators release their buffers once these are no longer rooted
+    for (auto *obj : _rooted) {
+        obj->unroot();
+    }
+    _rooted.clear();
+
+    for (auto &pair : _arrayPools) {
+        delete pair.second.allocator;
+    }
+    _arrayPools.clear();
+
+    for (auto &pair : _entryPools) {
+        delete pair.second.pool;
+    }
+    _entryPools.clear();
+}
+
+void ScenePools::keepAlive(se::Object *obj) {
+    // the pools only hold references, nothing on the script side keeps the buffers reachable
+    obj->root();
+    _rooted.push_back(obj);
+}
+
+uint32_t ScenePools::allocEntry(se::PoolType type, uint32_t bytesPerEntry, uint8_t **out) {
+    auto &entryPool = _entryPools[type];
+    if (!entryPool.pool) {
+        entryPool.pool = new se::BufferPool(type, ENTRY_BITS, bytesPerEntry);
+        entryPool.bytesPerEntry = bytesPerEntry;
+    }
+    CCASSERT(entryPool.bytesPerEntry == bytesPerEntry, "ScenePools: entry size mismatch");
+
+    const uint32_t chunk = entryPool.count >> ENTRY_BITS;
+    const uint32_t entry = entryPool.count & ((1 << ENTRY_BITS) - 1);
+    if (!entry) {
+        keepAlive(entryPool.pool->allocateNewChunk());
+    }
+    ++entryPool.count;
+
+    const uint32_t handle = se::BufferPool::getPoolFlag() | (chunk << ENTRY_BITS) | entry;
+    *out = entryPool.pool->getTypedObject<uint8_t>(handle);
+    return handle;
+}
+
+uint32_t ScenePools::allocBuffer(se::PoolType type, uint32_t bytes, uint8_t **out) {
+    auto &arrayPool = _arrayPools[type];
+    if (!arrayPool.allocator) {
+        arrayPool.allocator = new se::BufferAllocator(type);
+    }
+
+    // index 0 is left unused so that a zero handle never resolves
+    const uint32_t index = ++arrayPool.count;
+    se::Object *obj = arrayPool.allocator->alloc(index, bytes);
+    keepAlive(obj);
+
+    size_t len = 0;
+    obj->getArrayBufferData(out, &len);
+    return index;
+}
+
+uint32_t ScenePools::allocArray(se::PoolType type, const std::vector<uint32_t> &handles) {
+    uint8_t *data = nullptr;
+    const auto count = static_cast<uint32_t>(handles.size());
+    const uint32_t index = allocBuffer(type, (count + 1) * sizeof(uint32_t), &data);
+
+    auto *array = reinterpret_cast<uint32_t *>(data);
+    array[0] = count;
+    if (count) {
+        memcpy(array + 1, handles.data(), count * sizeof(uint32_t));
+    }
+    return index;
+}
+
+uint32_t ScenePools::allocRawBuffer(uint32_t bytes, uint8_t **out) {
+    return allocBuffer(se::PoolType::RAW_BUFFER, bytes, out);
+}
+
+uint32_t ScenePools::addObject(se::PoolType type, void *object) {
+    se::AutoHandleScope hs;
+
+    auto &objectPool = _objectPools[type];
+    if (!objectPool.pool) {
+        objectPool.jsArray = se::Object::createArrayObject(0);
+        objectPool.jsArray->root();
+        objectPool.pool = new se::ObjectPool(type, objectPool.jsArray);
+    }
+
+    se::Object *wrapper = se::Object::createObjectWithClass(getHandleClass());
+    wrapper->setPrivateData(object);
+    _wrappers.push_back(wrapper);
+
+    const uint32_t index = ++objectPool.count;
+    objectPool.jsArray->setArrayElement(index, se::Value(wrapper));
+    return OBJECT_POOL_FLAG | index;
+}
+
+} // namespace benchmark
+} // namespace cc
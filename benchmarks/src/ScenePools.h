@@ -0,0 +1,104 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <new>
+#include <vector>
+
+#include "cocos/bindings/dop/PoolType.h"
+
+namespace se {
+class BufferAllocator;
+class BufferPool;
+class Object;
+class ObjectPool;
+} // namespace se
+
+namespace cc {
+namespace benchmark {
+
+/**
+ * Owns the native side of the DOP pools the pipeline reads from.
+ * Entries are laid out exactly like the ones the script side allocates,
+ * so the pipeline resolves handles through the regular GET_* accessors.
+ * The script engine has to be running for the whole lifetime of the pools.
+ */
+class ScenePools final {
+public:
+    ScenePools();
+    ~ScenePools();
+
+    ScenePools(const ScenePools &) = delete;
+    ScenePools &operator=(const ScenePools &) = delete;
+
+    template <typename T>
+    uint32_t alloc(T **out) {
+        return alloc<T>(T::type, out);
+    }
+
+    template <typename T>
+    uint32_t alloc(se::PoolType type, T **out) {
+        uint8_t *entry = nullptr;
+        const uint32_t handle = allocEntry(type, sizeof(T), &entry);
+        *out = new (entry) T();
+        return handle;
+    }
+
+    uint32_t allocEntry(se::PoolType type, uint32_t bytesPerEntry, uint8_t **out);
+    uint32_t allocArray(se::PoolType type, const std::vector<uint32_t> &handles);
+    uint32_t allocRawBuffer(uint32_t bytes, uint8_t **out);
+    uint32_t addObject(se::PoolType type, void *object);
+
+private:
+    struct EntryPool {
+        se::BufferPool *pool = nullptr;
+        uint32_t bytesPerEntry = 0;
+        uint32_t count = 0;
+    };
+    struct ArrayPool {
+        se::BufferAllocator *allocator = nullptr;
+        uint32_t count = 0;
+    };
+    struct ObjectArray {
+        se::ObjectPool *pool = nullptr;
+        se::Object *jsArray = nullptr;
+        uint32_t count = 0;
+    };
+
+    uint32_t allocBuffer(se::PoolType type, uint32_t bytes, uint8_t **out);
+    void keepAlive(se::Object *obj);
+
+    static constexpr uint32_t ENTRY_BITS = 10;
+
+    std::map<se::PoolType, EntryPool> _entryPools;
+    std::map<se::PoolType, ArrayPool> _arrayPools;
+    std::map<se::PoolType, ObjectArray> _objectPools;
+    std::vector<se::Object *> _rooted;
+    std::vector<se::Object *> _wrappers;
+};
+
+} // namespace benchmark
+} // namespace cc
@@ -0,0 +1,244 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "MicroBenchmark.h"
+#include "PipelineBenchmark.h"
+#include "SceneGenerator.h"
+#include "cocos/base/JobSystem.h"
+#include "cocos/base/memory/Memory.h"
+#include "cocos/bindings/auto/jsb_gfx_auto.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/manual/jsb_classtype.h"
+#include "cocos/bindings/manual/jsb_gfx_manual.h"
+#include "cocos/platform/Application.h"
+#include "cocos/renderer/gfx-empty/GFXEmpty.h"
+
+using namespace cc::benchmark;
+
+namespace {
+constexpr uint32_t WIDTH = 1280;
+constexpr uint32_t HEIGHT = 720;
+
+// stands in for the phase registry of the script pipeline, every new phase gets the next bit
+const char *PHASE_SCRIPT =
+    "var nr = nr || {};"
+    "(function () {"
+    "  var phases = {}, count = 0;"
+    "  nr.getPhaseID = function (name) {"
+    "    if (!(name in phases)) phases[name] = 1 << count++;"
+    "    return phases[name];"
+    "  };"
+    "})();";
+
+struct Options {
+    BenchmarkOptions benchmark;
+    std::vector<std::string> scenes;
+    std::vector<std::string> micro;
+    std::vector<std::pair<std::string, std::string>> overrides;
+    std::string output = "pipeline-benchmark.json";
+    bool list = false;
+};
+
+void printUsage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --scene <name[,name...]>  scenes to run, all presets by default\n"
+           "  --micro <name[,name...]>  micro benchmarks to run, all by default\n"
+           "                            only the kinds named are run when either option is given\n"
+           "  --set <key=value>         override a config field of every selected scene\n"
+           "  --iterations <n>          measured frames per scene (default 100)\n"
+           "  --warmup <n>              frames run before measuring (default 10)\n"
+           "  --output <file>           json report (default pipeline-benchmark.json)\n"
+           "  --list                    print the presets and exit\n",
+           name);
+}
+
+void splitNames(const std::string &names, std::vector<std::string> *out) {
+    size_t begin = 0;
+    while (begin <= names.size()) {
+        const size_t end = std::min(names.find(',', begin), names.size());
+        if (end > begin) out->push_back(names.substr(begin, end - begin));
+        begin = end + 1;
+    }
+}
+
+bool parseOptions(int argc, char **argv, Options *options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--list") {
+            options->list = true;
+        } else if (arg == "--scene" && hasValue) {
+            splitNames(argv[++i], &options->scenes);
+        } else if (arg == "--micro" && hasValue) {
+            splitNames(argv[++i], &options->micro);
+        } else if (arg == "--set" && hasValue) {
+            const std::string pair = argv[++i];
+            const size_t split = pair.find('=');
+            if (split == std::string::npos) {
+                fprintf(stderr, "--set expects key=value, got '%s'\n", pair.c_str());
+                return false;
+            }
+            options->overrides.emplace_back(pair.substr(0, split), pair.substr(split + 1));
+        } else if (arg == "--iterations" && hasValue) {
+            options->benchmark.iterations = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options->benchmark.warmup = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (arg == "--output" && hasValue) {
+            options->output = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    if (!options->benchmark.iterations) {
+        fprintf(stderr, "--iterations must be at least 1\n");
+        return false;
+    }
+    return true;
+}
+
+bool collectScenes(const Options &options, std::vector<SceneConfig> *scenes) {
+    if (options.scenes.empty() && options.micro.empty()) {
+        *scenes = SceneConfig::getPresets();
+    }
+    for (const auto &name : options.scenes) {
+        const SceneConfig *preset = SceneConfig::findPreset(name);
+        if (!preset) {
+            fprintf(stderr, "unknown scene '%s', see --list\n", name.c_str());
+            return false;
+        }
+        scenes->push_back(*preset);
+    }
+    for (auto &scene : *scenes) {
+        for (const auto &pair : options.overrides) {
+            if (!scene.set(pair.first, pair.second)) {
+                fprintf(stderr, "invalid override %s=%s\n", pair.first.c_str(), pair.second.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool collectMicro(const Options &options, std::vector<std::string> *names) {
+    if (options.scenes.empty() && options.micro.empty()) {
+        *names = MicroBenchmark::getNames();
+    }
+    const auto &known = MicroBenchmark::getNames();
+    for (const auto &name : options.micro) {
+        if (std::find(known.begin(), known.end(), name) == known.end()) {
+            fprintf(stderr, "unknown micro benchmark '%s', see --list\n", name.c_str());
+            return false;
+        }
+        names->push_back(name);
+    }
+    return true;
+}
+
+void printTimings(const TimingList &timings) {
+    for (const auto &timing : timings) {
+        printf("  %-18s median %10.2f us  p95 %10.2f us  min %10.2f us\n",
+               timing.first.c_str(), timing.second.median, timing.second.p95, timing.second.min);
+    }
+}
+
+void printResult(const SceneResult &result) {
+    printf("%-16s %6u models  %6u draws  %7u instances  %9u tris  %6u visible\n",
+           result.config.name.c_str(), result.config.models, result.drawCalls, result.instances, result.triangles, result.renderObjects);
+    printTimings(result.timings);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, &options)) return 1;
+
+    if (options.list) {
+        for (const auto &preset : SceneConfig::getPresets()) {
+            printf("%-16s %s\n", preset.name.c_str(), preset.toJSON().c_str());
+        }
+        for (const auto &name : MicroBenchmark::getNames()) {
+            printf("%-16s micro\n", name.c_str());
+        }
+        return 0;
+    }
+
+    std::vector<SceneConfig> scenes;
+    std::vector<std::string> micro;
+    if (!collectScenes(options, &scenes) || !collectMicro(options, &micro)) return 1;
+
+    int ret = 0;
+    {
+        // the pipeline needs an application for the frame counter and the script engine for the DOP pools,
+        // the gfx bindings are only there for the micro benchmarks
+        cc::Application app(WIDTH, HEIGHT);
+        auto *engine = se::ScriptEngine::getInstance();
+        engine->addBeforeInitHook([]() { JSBClassType::init(); });
+        engine->addRegisterCallback(register_all_gfx);
+        engine->addRegisterCallback(register_all_gfx_manual);
+        engine->start();
+        {
+            se::AutoHandleScope hs;
+            engine->evalString(PHASE_SCRIPT);
+        }
+
+        auto *device = CC_NEW(cc::gfx::EmptyDevice);
+        device->initialize({0, WIDTH, HEIGHT, WIDTH, HEIGHT, nullptr});
+
+        PipelineBenchmark benchmark(device, options.benchmark);
+        std::vector<SceneResult> results;
+        for (const auto &scene : scenes) {
+            results.push_back(benchmark.run(scene));
+            printResult(results.back());
+        }
+        std::vector<MicroResult> microResults;
+        for (const auto &name : micro) {
+            microResults.emplace_back();
+            MicroBenchmark::run(name, options.benchmark, &microResults.back());
+            printf("%-16s micro\n", name.c_str());
+            printTimings(microResults.back().timings);
+        }
+
+        FILE *file = fopen(options.output.c_str(), "w");
+        if (file) {
+            const std::string json = benchmark.toJSON(results, microResults);
+            fwrite(json.data(), 1, json.size(), file);
+            fclose(file);
+            printf("results written to %s\n", options.output.c_str());
+        } else {
+            fprintf(stderr, "failed to write %s\n", options.output.c_str());
+            ret = 1;
+        }
+
+        CC_SAFE_DESTROY(device);
+        cc::JobSystem::destroyInstance();
+    }
+    return ret;
+}
@@ -26,6 +26,10 @@
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/Log.h"
+#include "base/memory/AllocProfiler.h"
+#include "base/LoadScheduler.h"
+#include "base/Scheduler.h"
+#include "platform/Application.h"
 
 #include <condition_variable>
 #include <queue>
@@ -109,6 +113,7 @@ public:
 
 private:
     void threadFunc() {
+        CC_MEM_TAG_SCOPE(AUDIO);
         while (true) {
             std::function<void()> task = nullptr;
             {
@@ -522,10 +527,12 @@ AudioProfile *AudioEngine::getProfile(const std::string &name) {
     }
 }
 
-void AudioEngine::preload(const std::string &filePath, std::function<void(bool isSuccess)> callback) {
+uint32_t AudioEngine::preload(const std::string &filePath, std::function<void(bool isSuccess)> callback) {
     if (!isEnabled()) {
-        callback(false);
-        return;
+        if (callback) {
+            callback(false);
+        }
+        return LoadScheduler::INVALID_REQUEST;
     }
 
     lazyInit();
@@ -535,11 +542,46 @@ void AudioEngine::preload(const std::string &filePath, std::function<void(bool i
             if (callback) {
                 callback(false);
             }
-            return;
+            return LoadScheduler::INVALID_REQUEST;
         }
 
-        _audioEngineImpl->preload(filePath, callback);
+        // preloads share the decode slots with other asset loads, so they can't starve what a scene needs first
+        auto *scheduler = LoadScheduler::getInstance();
+        LoadScheduler::RequestId id = scheduler->createRequest(0, [callback]() {
+            if (callback) {
+                callback(false);
+            }
+        });
+        scheduler->submitAsync(id, LoadScheduler::Stage::DECODE, [filePath, callback, id](const std::function<void()> &done) {
+            Application::getInstance()->getScheduler()->performFunctionInCocosThread([=]() {
+                if (!_audioEngineImpl || !LoadScheduler::getInstance()->isAlive(id)) {
+                    done();
+                    return;
+                }
+                auto onLoaded = [=](bool isSuccess) {
+                    done();
+                    bool isAlive = LoadScheduler::getInstance()->isAlive(id);
+                    LoadScheduler::getInstance()->finish(id);
+                    if (isAlive && callback) {
+                        callback(isSuccess);
+                    }
+                };
+#if CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_MAC_OSX || CC_PLATFORM == CC_PLATFORM_WINDOWS
+                // load callbacks are posted back to the cocos thread a frame later, play callbacks run on the
+                // decoding thread as soon as the data is ready, so the slot goes back to other loads right away
+                AudioCache *audioCache = _audioEngineImpl->preload(filePath, onLoaded);
+                if (audioCache) {
+                    audioCache->addPlayCallback(done);
+                }
+#else
+                // the decoder reports back from its own thread once it's done
+                _audioEngineImpl->preload(filePath, onLoaded);
+#endif
+            });
+        });
+        return id;
     }
+    return LoadScheduler::INVALID_REQUEST;
 }
 
 void AudioEngine::addTask(const std::function<void()> &task) {
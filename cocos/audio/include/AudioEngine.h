@@ -286,15 +286,19 @@ public:
     /**
      * Preload audio file.
      * @param filePath The file path of an audio.
+     * @return The LoadScheduler request id of the load.
      */
-    static void preload(const std::string &filePath) { preload(filePath, nullptr); }
+    static uint32_t preload(const std::string &filePath) { return preload(filePath, nullptr); }
 
     /**
      * Preload audio file.
      * @param filePath The file path of an audio.
      * @param callback A callback which will be called after loading is finished.
+     * @return The LoadScheduler request id, it can be passed to LoadScheduler::setPriority and LoadScheduler::cancel
+     * (jsb.setLoadPriority and jsb.cancelLoad in script). 0 if the file couldn't be scheduled.
+     * @note Loading is scheduled by LoadScheduler, callback gets false if the load is canceled.
      */
-    static void preload(const std::string &filePath, std::function<void(bool isSuccess)> callback);
+    static uint32_t preload(const std::string &filePath, std::function<void(bool isSuccess)> callback);
 
     /**
      * Gets playing audio count.
@@ -1,6 +1,8 @@
 #ifndef CC_CORE_KERNEL_CACHED_ARRAY_H_
 #define CC_CORE_KERNEL_CACHED_ARRAY_H_
 
+#include <climits>
+
 namespace cc {
 
 template <typename T>
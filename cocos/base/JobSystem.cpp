@@ -0,0 +1,258 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/JobSystem.h"
+
+namespace cc {
+
+namespace {
+JobSystem *instance = nullptr;
+
+struct WorkerContext {
+    const JobSystem *owner = nullptr;
+    uint32_t index = 0;
+    uint32_t seed = 0;
+};
+thread_local WorkerContext tlsContext;
+
+uint32_t nextRandom(uint32_t &seed) {
+    // xorshift, good enough to spread steal attempts
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+} // namespace
+
+void TaskGroup::add() {
+    for (auto *group = this; group; group = group->_parent) {
+        group->_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void TaskGroup::done() {
+    // a waiter may destroy the group as soon as its count drops to 0, so read the parent first
+    auto *group = this;
+    while (group) {
+        auto *parent = group->_parent;
+        group->_pending.fetch_sub(1, std::memory_order_acq_rel);
+        group = parent;
+    }
+}
+
+bool JobSystem::WorkStealingDeque::push(Task *task) {
+    int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    int64_t top = _top.load(std::memory_order_acquire);
+    if (bottom - top >= CAPACITY) {
+        return false;
+    }
+    _buffer[bottom & (CAPACITY - 1)].store(task, std::memory_order_relaxed);
+    _bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+JobSystem::Task *JobSystem::WorkStealingDeque::pop() {
+    int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Task *task = _buffer[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // last task, race against thieves
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+JobSystem::Task *JobSystem::WorkStealingDeque::steal() {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    Task *task = _buffer[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+JobSystem *JobSystem::getInstance() {
+    if (!instance) {
+        uint32_t cores = std::thread::hardware_concurrency();
+        // leave the core of the creating thread alone
+        instance = new JobSystem(std::max(cores, 2U) - 1);
+    }
+    return instance;
+}
+
+void JobSystem::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+JobSystem::JobSystem(uint32_t workerNum) {
+    for (uint32_t i = 0; i <= workerNum; ++i) {
+        _deques.emplace_back(new WorkStealingDeque());
+    }
+    tlsContext = {this, 0, 0x9e3779b9U};
+
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        _threads.emplace_back(&JobSystem::threadFunc, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop.store(true);
+    }
+    _sleepCV.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+
+    for (auto &deque : _deques) {
+        while (Task *task = deque->pop()) {
+            delete task;
+        }
+    }
+    for (Task *task : _injectionQueue) {
+        delete task;
+    }
+
+    if (tlsContext.owner == this) {
+        tlsContext = {};
+    }
+}
+
+void JobSystem::run(TaskGroup &group, const std::function<void()> &func) {
+    group.add();
+    auto *task = new Task{func, &group};
+
+    if (tlsContext.owner == this) {
+        if (!_deques[tlsContext.index]->push(task)) {
+            // deque is full, run it inline instead of growing
+            execute(task);
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        _injectionQueue.push_back(task);
+        _injectionSize.fetch_add(1, std::memory_order_release);
+    }
+    notify();
+}
+
+void JobSystem::wait(TaskGroup &group) {
+    uint32_t index = tlsContext.owner == this ? tlsContext.index : UINT32_MAX;
+    while (!group.isDone()) {
+        Task *task = findTask(index);
+        if (task) {
+            execute(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::notify() {
+    _epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleepingNum.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCV.notify_one();
+    }
+}
+
+void JobSystem::execute(Task *task) {
+    task->func();
+    TaskGroup *group = task->group;
+    delete task;
+    group->done();
+}
+
+JobSystem::Task *JobSystem::findTask(uint32_t index) {
+    if (index < _deques.size()) {
+        if (Task *task = _deques[index]->pop()) {
+            return task;
+        }
+    }
+
+    if (_injectionSize.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        if (!_injectionQueue.empty()) {
+            Task *task = _injectionQueue.front();
+            _injectionQueue.pop_front();
+            _injectionSize.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    auto count = static_cast<uint32_t>(_deques.size());
+    uint32_t seed = tlsContext.seed ? tlsContext.seed : 0x9e3779b9U;
+    uint32_t start = nextRandom(seed) % count;
+    tlsContext.seed = seed;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t victim = (start + i) % count;
+        if (victim == index) continue;
+        if (Task *task = _deques[victim]->steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::threadFunc(uint32_t index) {
+    tlsContext = {this, index, 0x9e3779b9U * (index + 1)};
+
+    while (!_stop.load(std::memory_order_acquire)) {
+        uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+        if (Task *task = findTask(index)) {
+            execute(task);
+            continue;
+        }
+
+        // sleep until something is pushed after the failed search
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingNum.fetch_add(1, std::memory_order_seq_cst);
+        _sleepCV.wait(lock, [&]() {
+            return _stop.load(std::memory_order_relaxed) || _epoch.load(std::memory_order_seq_cst) != epoch;
+        });
+        _sleepingNum.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,165 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cc {
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * Tracks a set of tasks run by JobSystem. A group with a parent is counted as pending work of the parent,
+ * so waiting on the parent also waits for the children.
+ * @note Groups must outlive their tasks, wait() on them before destruction.
+ */
+class CC_DLL TaskGroup {
+public:
+    TaskGroup() = default;
+    explicit TaskGroup(TaskGroup *parent) : _parent(parent) {}
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    inline bool isDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    void add();
+    void done();
+
+    TaskGroup *_parent = nullptr;
+    std::atomic<int> _pending{0};
+};
+
+/**
+ * Short-lived CPU tasks scheduled on per-worker lock-free deques with work stealing.
+ * Tasks pushed by a worker go to its own deque, tasks from other threads go to a shared
+ * injection queue. Blocking work such as file or network access belongs to ThreadPool.
+ */
+class CC_DLL JobSystem {
+public:
+    // @note The first call should come from the cocos thread, it helps running tasks while waiting
+    static JobSystem *getInstance();
+    static void destroyInstance();
+
+    // The constructing thread takes part in running tasks while it waits
+    explicit JobSystem(uint32_t workerNum);
+    ~JobSystem();
+
+    void run(TaskGroup &group, const std::function<void()> &task);
+
+    // Runs pending tasks on the calling thread until the group is done
+    void wait(TaskGroup &group);
+
+    /*
+     * Calls func(begin, end) for sub ranges of [begin, end) in parallel and waits for them.
+     * @param grain The max size of each sub range
+     */
+    template <typename Func>
+    void parallelFor(uint32_t begin, uint32_t end, uint32_t grain, const Func &func);
+
+    // Gets worker number, the thread which created the JobSystem isn't counted
+    inline uint32_t getWorkerNum() const { return static_cast<uint32_t>(_threads.size()); }
+
+private:
+    struct Task {
+        std::function<void()> func;
+        TaskGroup *group = nullptr;
+    };
+
+    // Chase-Lev deque, the owner pushes and pops at the bottom while thieves steal from the top
+    class WorkStealingDeque {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+        bool push(Task *task);
+        Task *pop();
+        Task *steal();
+
+    private:
+        // keep top and bottom on separate cache lines, thieves only touch top
+        std::atomic<int64_t> _top{0};
+        char _padding[64 - sizeof(std::atomic<int64_t>)];
+        std::atomic<int64_t> _bottom{0};
+        std::atomic<Task *> _buffer[CAPACITY];
+    };
+
+    void threadFunc(uint32_t index);
+    Task *findTask(uint32_t index);
+    void execute(Task *task);
+    void notify();
+
+    // deque 0 belongs to the thread that created the JobSystem, deque i + 1 to worker i
+    std::vector<std::unique_ptr<WorkStealingDeque>> _deques;
+    std::vector<std::thread> _threads;
+
+    std::mutex _injectionMutex;
+    std::deque<Task *> _injectionQueue;
+    std::atomic<uint32_t> _injectionSize{0};
+
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCV;
+    std::atomic<uint64_t> _epoch{0};
+    std::atomic<int> _sleepingNum{0};
+    std::atomic<bool> _stop{false};
+};
+
+template <typename Func>
+void JobSystem::parallelFor(uint32_t begin, uint32_t end, uint32_t grain, const Func &func) {
+    if (begin >= end) return;
+    grain = std::max(grain, 1U);
+    if (end - begin <= grain || _threads.empty()) {
+        func(begin, end);
+        return;
+    }
+
+    TaskGroup group;
+    for (uint32_t first = begin; first < end; first += grain) {
+        uint32_t last = std::min(first + grain, end);
+        run(group, [&func, first, last]() { func(first, last); });
+    }
+    wait(group);
+}
+
+// end of base group
+/// @}
+
+} // namespace cc
@@ -0,0 +1,256 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/LoadScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+
+namespace cc {
+
+namespace {
+LoadScheduler *instance = nullptr;
+
+constexpr int DEFAULT_THREAD_NUM = 4;
+constexpr int DEFAULT_CONCURRENCY[] = {
+    6, // NETWORK
+    2, // IO
+    2, // DECODE
+};
+} // namespace
+
+LoadScheduler *LoadScheduler::getInstance() {
+    if (!instance) {
+        instance = new LoadScheduler(DEFAULT_THREAD_NUM);
+    }
+    return instance;
+}
+
+void LoadScheduler::destroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+LoadScheduler::LoadScheduler(int threadNum) {
+    for (int i = 0; i < static_cast<int>(Stage::COUNT); ++i) {
+        _stages[i].limit = DEFAULT_CONCURRENCY[i];
+    }
+    for (int i = 0; i < threadNum; ++i) {
+        _threads.emplace_back(&LoadScheduler::threadFunc, this);
+    }
+}
+
+LoadScheduler::~LoadScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+LoadScheduler::RequestId LoadScheduler::createRequest(int priority, const std::function<void()> &onCanceled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    RequestId id = _nextId++;
+    if (_nextId == INVALID_REQUEST) ++_nextId;
+    _requests[id] = {priority, onCanceled};
+    return id;
+}
+
+void LoadScheduler::submit(RequestId id, Stage stage, const std::function<void()> &job) {
+    submitAsync(id, stage, [job](const std::function<void()> &done) {
+        job();
+        done();
+    });
+}
+
+void LoadScheduler::submitAsync(RequestId id, Stage stage, const AsyncJob &job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stop || _requests.find(id) == _requests.end()) {
+            return;
+        }
+        _stages[static_cast<int>(stage)].jobs.push_back({id, _nextSeq++, job});
+    }
+    _cv.notify_one();
+}
+
+void LoadScheduler::finish(RequestId id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _requests.erase(id);
+}
+
+void LoadScheduler::cancel(RequestId id) {
+    std::function<void()> onCanceled;
+    std::vector<Job> dropped;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = _requests.find(id);
+        if (iter == _requests.end()) {
+            return;
+        }
+        onCanceled = std::move(iter->second.onCanceled);
+        _requests.erase(iter);
+
+        for (auto &stage : _stages) {
+            auto removed = std::stable_partition(stage.jobs.begin(), stage.jobs.end(), [id](const Job &job) { return job.id != id; });
+            std::move(removed, stage.jobs.end(), std::back_inserter(dropped));
+            stage.jobs.erase(removed, stage.jobs.end());
+        }
+    }
+    // jobs may own resources whose destructors call back into the scheduler, so drop them unlocked
+    dropped.clear();
+    if (onCanceled) {
+        onCanceled();
+    }
+}
+
+void LoadScheduler::cancelAll() {
+    std::vector<std::function<void()>> callbacks;
+    std::vector<Job> dropped;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto &request : _requests) {
+            if (request.second.onCanceled) {
+                callbacks.push_back(std::move(request.second.onCanceled));
+            }
+        }
+        _requests.clear();
+
+        for (auto &stage : _stages) {
+            std::move(stage.jobs.begin(), stage.jobs.end(), std::back_inserter(dropped));
+            stage.jobs.clear();
+        }
+    }
+    dropped.clear();
+    for (auto &callback : callbacks) {
+        callback();
+    }
+}
+
+bool LoadScheduler::isAlive(RequestId id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _requests.find(id) != _requests.end();
+}
+
+void LoadScheduler::setPriority(RequestId id, int priority) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _requests.find(id);
+    if (iter != _requests.end()) {
+        iter->second.priority = priority;
+    }
+}
+
+void LoadScheduler::setConcurrency(Stage stage, int count) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stages[static_cast<int>(stage)].limit = std::max(count, 1);
+    }
+    _cv.notify_all();
+}
+
+int LoadScheduler::getConcurrency(Stage stage) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stages[static_cast<int>(stage)].limit;
+}
+
+int LoadScheduler::getPendingJobNum() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t count = 0;
+    for (const auto &stage : _stages) {
+        count += stage.jobs.size();
+    }
+    return static_cast<int>(count);
+}
+
+bool LoadScheduler::popJob(Job &job, Stage &stage) {
+    // priorities can change at any time, so pick the best job by scanning instead of keeping a heap
+    StageQueue *bestStage = nullptr;
+    size_t bestIndex = 0;
+    int bestPriority = 0;
+    uint64_t bestSeq = 0;
+
+    for (int i = 0; i < static_cast<int>(Stage::COUNT); ++i) {
+        auto &queue = _stages[i];
+        if (queue.running >= queue.limit) {
+            continue;
+        }
+        for (size_t j = 0; j < queue.jobs.size(); ++j) {
+            const auto &candidate = queue.jobs[j];
+            auto request = _requests.find(candidate.id);
+            int priority = request != _requests.end() ? request->second.priority : 0;
+            if (!bestStage || priority > bestPriority || (priority == bestPriority && candidate.seq < bestSeq)) {
+                bestStage = &queue;
+                bestIndex = j;
+                bestPriority = priority;
+                bestSeq = candidate.seq;
+                stage = static_cast<Stage>(i);
+            }
+        }
+    }
+
+    if (!bestStage) {
+        return false;
+    }
+    job = std::move(bestStage->jobs[bestIndex]);
+    bestStage->jobs.erase(bestStage->jobs.begin() + bestIndex);
+    ++bestStage->running;
+    return true;
+}
+
+void LoadScheduler::releaseSlot(Stage stage) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_stages[static_cast<int>(stage)].running;
+    }
+    _cv.notify_one();
+}
+
+void LoadScheduler::threadFunc() {
+    while (true) {
+        Job job;
+        Stage stage = Stage::COUNT;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [&]() { return _stop || popJob(job, stage); });
+            if (_stop) {
+                return;
+            }
+        }
+
+        auto released = std::make_shared<std::atomic<bool>>(false);
+        job.callback([this, stage, released]() {
+            if (!released->exchange(true)) {
+                releaseSlot(stage);
+            }
+        });
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,141 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cc {
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * Schedules asset loading work by request priority with a concurrency limit per stage.
+ * A request is split into jobs, one per stage (download, file read, decode...). Pending jobs of
+ * the highest priority request run first, and canceling a request drops all of its pending jobs.
+ */
+class CC_DLL LoadScheduler {
+public:
+    enum class Stage {
+        NETWORK = 0,
+        IO,
+        DECODE,
+        COUNT
+    };
+
+    using RequestId = uint32_t;
+    // calls to done() release the stage slot, it may be called from any thread
+    using AsyncJob = std::function<void(const std::function<void()> & /*done*/)>;
+
+    static constexpr RequestId INVALID_REQUEST = 0;
+
+    static LoadScheduler *getInstance();
+    // @note Asynchronous jobs must have called done() before the instance is destroyed
+    static void destroyInstance();
+
+    /*
+     * Creates a request, jobs with higher priority are run first.
+     * @param onCanceled Invoked on the thread calling cancel() if the request is canceled before finish() is called
+     */
+    RequestId createRequest(int priority, const std::function<void()> &onCanceled = nullptr);
+
+    /*
+     * Runs a job on a worker thread, the stage slot is released when the job returns.
+     * @note Jobs of a canceled or unknown request are discarded
+     */
+    void submit(RequestId id, Stage stage, const std::function<void()> &job);
+
+    // Runs a job which starts asynchronous work, the stage slot is held until done() is called
+    void submitAsync(RequestId id, Stage stage, const AsyncJob &job);
+
+    // Marks the request as completed, it can't be canceled after this
+    void finish(RequestId id);
+
+    void cancel(RequestId id);
+    void cancelAll();
+
+    // Checks if the request is neither canceled nor finished, running jobs could use it to stop early
+    bool isAlive(RequestId id) const;
+
+    void setPriority(RequestId id, int priority);
+
+    // Sets the max number of jobs running in a stage, synchronous jobs are also bound by the worker thread number
+    void setConcurrency(Stage stage, int count);
+    int getConcurrency(Stage stage) const;
+
+    // Gets the number of jobs waiting for a slot
+    int getPendingJobNum() const;
+
+private:
+    struct Job {
+        RequestId id = INVALID_REQUEST;
+        uint64_t seq = 0;
+        AsyncJob callback;
+    };
+
+    struct Request {
+        int priority = 0;
+        std::function<void()> onCanceled;
+    };
+
+    struct StageQueue {
+        std::vector<Job> jobs;
+        int limit = 1;
+        int running = 0;
+    };
+
+    LoadScheduler(int threadNum);
+    ~LoadScheduler();
+
+    void threadFunc();
+    bool popJob(Job &job, Stage &stage);
+    void releaseSlot(Stage stage);
+
+    std::vector<std::thread> _threads;
+    std::unordered_map<RequestId, Request> _requests;
+    StageQueue _stages[static_cast<int>(Stage::COUNT)];
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    RequestId _nextId = 1;
+    uint64_t _nextSeq = 0;
+    bool _stop = false;
+};
+
+// end of base group
+/// @}
+
+} // namespace cc
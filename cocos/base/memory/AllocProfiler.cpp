@@ -0,0 +1,476 @@
+#include "AllocProfiler.h"
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #if !defined(NOMINMAX) && defined(_MSC_VER)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <unwind.h>
+    #if (CC_PLATFORM == CC_PLATFORM_MAC_OSX) || (CC_PLATFORM == CC_PLATFORM_MAC_IOS)
+        #include <mach-o/dyld.h>
+    #else
+        #include <link.h>
+        #include <unistd.h>
+    #endif
+#endif
+
+namespace cc {
+
+namespace {
+
+constexpr int      TAG_COUNT        = static_cast<int>(MemTag::COUNT);
+constexpr int      MAX_STACK_DEPTH  = 32;
+constexpr uint16_t TRACE_VERSION    = 1;
+constexpr size_t   SAMPLE_SLOT_NUM  = 65536; // power of two
+constexpr size_t   SAMPLE_MAX_PROBE = 64;
+constexpr uintptr_t EMPTY_SLOT      = 0;
+constexpr uintptr_t TOMBSTONE_SLOT  = 1;
+constexpr size_t   LIVE_SHARD_NUM   = 64; // power of two
+
+const char *const TAG_NAMES[TAG_COUNT] = {"default", "gfx", "pipeline", "middleware", "network", "audio", "script"};
+
+// Counters are written by the owning thread only, the snapshot thread reads them relaxed
+struct ThreadState {
+    std::atomic<uint64_t> allocCount[TAG_COUNT];
+    std::atomic<uint64_t> allocBytes[TAG_COUNT];
+    std::atomic<uint64_t> freeCount[TAG_COUNT];
+    int64_t               bytesUntilSample = 0;
+    uint64_t              rng              = 0;
+    bool                  reentered        = false;
+};
+
+std::mutex                 statesMutex;
+std::vector<ThreadState *> states;
+AllocProfiler::TagStats    retiredStats[TAG_COUNT];
+
+std::mutex                           traceMutex;
+FILE *                               traceFile = nullptr;
+uint32_t                             sampleInterval = 0;
+std::chrono::steady_clock::time_point startTime;
+
+std::thread             snapshotThread;
+std::mutex              snapshotMutex;
+std::condition_variable snapshotCV;
+bool                    snapshotStop = false;
+
+std::atomic<uintptr_t> sampledPtrs[SAMPLE_SLOT_NUM];
+
+// Tags of the live allocations, a free is counted under the tag its block was allocated with.
+// The maps allocate through std::allocator which is not profiled.
+struct LiveShard {
+    std::mutex                             mutex;
+    std::unordered_map<uintptr_t, uint8_t> tags;
+};
+LiveShard liveShards[LIVE_SHARD_NUM];
+
+thread_local MemTag        currentTag  = MemTag::DEFAULT;
+thread_local ThreadState *stateTLS    = nullptr;
+thread_local bool          stateRetired = false;
+
+inline void inc(std::atomic<uint64_t> &counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+uint64_t nextRandom(uint64_t &state) {
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+// Exponentially distributed gaps keep the sampling unbiased across allocation sizes
+int64_t nextSampleGap(ThreadState *state) {
+    double u = static_cast<double>(nextRandom(state->rng) >> 11) * (1.0 / 9007199254740992.0);
+    if (u <= 0.0) u = 1e-12;
+    return static_cast<int64_t>(-std::log(u) * sampleInterval) + 1;
+}
+
+void retireState(ThreadState *state) {
+    std::lock_guard<std::mutex> lock(statesMutex);
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        retiredStats[i].allocCount += state->allocCount[i].load(std::memory_order_relaxed);
+        retiredStats[i].allocBytes += state->allocBytes[i].load(std::memory_order_relaxed);
+        retiredStats[i].freeCount += state->freeCount[i].load(std::memory_order_relaxed);
+    }
+    for (auto iter = states.begin(); iter != states.end(); ++iter) {
+        if (*iter == state) {
+            states.erase(iter);
+            break;
+        }
+    }
+}
+
+struct ThreadStateReaper {
+    ~ThreadStateReaper() {
+        ThreadState *state = stateTLS;
+        stateRetired       = true;
+        stateTLS           = nullptr;
+        if (state) {
+            retireState(state);
+            delete state;
+        }
+    }
+};
+thread_local ThreadStateReaper stateReaper;
+
+ThreadState *getThreadState() {
+    if (stateTLS) return stateTLS;
+    // allocations from other thread_local destructors after ours are not counted
+    if (stateRetired) return nullptr;
+
+    auto *state = new ThreadState();
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        state->allocCount[i].store(0, std::memory_order_relaxed);
+        state->allocBytes[i].store(0, std::memory_order_relaxed);
+        state->freeCount[i].store(0, std::memory_order_relaxed);
+    }
+    state->rng = reinterpret_cast<uintptr_t>(state) ^
+                 static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^ 0x9E3779B97F4A7C15ULL;
+    if (!state->rng) state->rng = 1;
+    state->bytesUntilSample = nextSampleGap(state);
+
+    (void)&stateReaper; // instantiates the reaper of this thread
+    stateTLS = state;
+
+    std::lock_guard<std::mutex> lock(statesMutex);
+    states.push_back(state);
+    return state;
+}
+
+inline size_t hashPtr(uintptr_t ptr) {
+    return static_cast<size_t>((ptr >> 4) * 0x9E3779B97F4A7C15ULL >> 32) & (SAMPLE_SLOT_NUM - 1);
+}
+
+inline LiveShard &getLiveShard(uintptr_t ptr) {
+    return liveShards[hashPtr(ptr) & (LIVE_SHARD_NUM - 1)];
+}
+
+void clearLiveTags() {
+    for (auto &shard : liveShards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.tags.clear();
+    }
+}
+
+bool insertSampled(uintptr_t ptr) {
+    size_t slot = hashPtr(ptr);
+    for (size_t i = 0; i < SAMPLE_MAX_PROBE; ++i, slot = (slot + 1) & (SAMPLE_SLOT_NUM - 1)) {
+        uintptr_t cur = sampledPtrs[slot].load(std::memory_order_relaxed);
+        if (cur == EMPTY_SLOT || cur == TOMBSTONE_SLOT) {
+            if (sampledPtrs[slot].compare_exchange_strong(cur, ptr, std::memory_order_relaxed)) return true;
+        }
+    }
+    return false;
+}
+
+bool removeSampled(uintptr_t ptr) {
+    size_t slot = hashPtr(ptr);
+    for (size_t i = 0; i < SAMPLE_MAX_PROBE; ++i, slot = (slot + 1) & (SAMPLE_SLOT_NUM - 1)) {
+        uintptr_t cur = sampledPtrs[slot].load(std::memory_order_relaxed);
+        if (cur == EMPTY_SLOT) return false;
+        if (cur == ptr) {
+            return sampledPtrs[slot].compare_exchange_strong(cur, TOMBSTONE_SLOT, std::memory_order_relaxed);
+        }
+    }
+    return false;
+}
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+
+int captureStack(uint64_t *pcs, int maxDepth) {
+    void *frames[MAX_STACK_DEPTH];
+    int   depth = CaptureStackBackTrace(2, static_cast<DWORD>(maxDepth), frames, nullptr);
+    for (int i = 0; i < depth; ++i) pcs[i] = reinterpret_cast<uintptr_t>(frames[i]);
+    return depth;
+}
+
+#else
+
+struct UnwindContext {
+    uint64_t *pcs;
+    int       depth;
+    int       skip;
+    int       maxDepth;
+};
+
+_Unwind_Reason_Code unwindCallback(struct _Unwind_Context *context, void *arg) {
+    auto *    ctx = static_cast<UnwindContext *>(arg);
+    uintptr_t pc  = _Unwind_GetIP(context);
+    if (!pc) return _URC_END_OF_STACK;
+    if (ctx->skip > 0) {
+        --ctx->skip;
+        return _URC_NO_REASON;
+    }
+    ctx->pcs[ctx->depth++] = pc;
+    return ctx->depth >= ctx->maxDepth ? _URC_END_OF_STACK : _URC_NO_REASON;
+}
+
+__attribute__((noinline)) int captureStack(uint64_t *pcs, int maxDepth) {
+    // skips captureStack and recordAlloc, the policies are mostly inlined into the caller
+    UnwindContext ctx{pcs, 0, 2, maxDepth};
+    _Unwind_Backtrace(unwindCallback, &ctx);
+    return ctx.depth;
+}
+
+#endif
+
+uint64_t elapsedNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
+
+// Records are written in host byte order, all supported targets are little-endian
+template <typename T>
+inline void writeValue(T value) {
+    fwrite(&value, sizeof(T), 1, traceFile);
+}
+
+void writeString(const char *str, size_t maxLength) {
+    size_t length = strlen(str);
+    if (length > maxLength) length = maxLength;
+    if (maxLength > 0xff) {
+        writeValue(static_cast<uint16_t>(length));
+    } else {
+        writeValue(static_cast<uint8_t>(length));
+    }
+    fwrite(str, 1, length, traceFile);
+}
+
+void writeModule(uint64_t bias, uint64_t begin, uint64_t end, const char *path) {
+    writeValue('M');
+    writeValue(bias);
+    writeValue(begin);
+    writeValue(end);
+    writeString(path, 0xffff);
+}
+
+// Module records let the host tool map sampled pcs back to binaries, must hold traceMutex
+void writeModules() {
+#if (CC_PLATFORM == CC_PLATFORM_MAC_OSX) || (CC_PLATFORM == CC_PLATFORM_MAC_IOS)
+    uint32_t count = _dyld_image_count();
+    for (uint32_t i = 0; i < count; ++i) {
+        const char *name = _dyld_get_image_name(i);
+        // the end of Mach-O images is not tracked, the tool picks the closest preceding image
+        writeModule(static_cast<uint64_t>(_dyld_get_image_vmaddr_slide(i)),
+                    reinterpret_cast<uintptr_t>(_dyld_get_image_header(i)), 0, name ? name : "");
+    }
+#elif (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+    dl_iterate_phdr([](struct dl_phdr_info *info, size_t, void *) -> int {
+        uint64_t begin = UINT64_MAX;
+        uint64_t end   = 0;
+        for (int i = 0; i < info->dlpi_phnum; ++i) {
+            const auto &phdr = info->dlpi_phdr[i];
+            if (phdr.p_type != PT_LOAD) continue;
+            uint64_t segBegin = info->dlpi_addr + phdr.p_vaddr;
+            uint64_t segEnd   = segBegin + phdr.p_memsz;
+            if (segBegin < begin) begin = segBegin;
+            if (segEnd > end) end = segEnd;
+        }
+        if (begin >= end) return 0;
+
+        const char *path = info->dlpi_name;
+        char        exePath[1024];
+        if (!path || !path[0]) {
+            // the main executable is reported without a name
+            ssize_t length = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+            exePath[length > 0 ? length : 0] = '\0';
+            path                             = exePath;
+        }
+        writeModule(info->dlpi_addr, begin, end, path);
+        return 0;
+    },
+                    nullptr);
+#endif
+}
+
+void writeSnapshot() {
+    AllocProfiler::TagStats stats[TAG_COUNT];
+    AllocProfiler::getStats(stats);
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (!traceFile) return;
+    writeValue('N');
+    writeValue(elapsedNanoseconds());
+    writeValue(static_cast<uint8_t>(TAG_COUNT));
+    for (const auto &tagStats : stats) {
+        writeValue(tagStats.allocCount);
+        writeValue(tagStats.allocBytes);
+        writeValue(tagStats.freeCount);
+    }
+    fflush(traceFile);
+}
+
+void snapshotLoop(uint32_t intervalMs) {
+    std::unique_lock<std::mutex> lock(snapshotMutex);
+    while (!snapshotStop) {
+        snapshotCV.wait_for(lock, std::chrono::milliseconds(intervalMs));
+        if (snapshotStop) break;
+        lock.unlock();
+        writeSnapshot();
+        lock.lock();
+    }
+}
+
+} // namespace
+
+std::atomic<bool> AllocProfiler::_enabled{false};
+
+bool AllocProfiler::start(const std::string &tracePath, uint32_t interval, uint32_t snapshotIntervalMs) {
+    std::lock_guard<std::mutex> startLock(snapshotMutex);
+    if (_enabled.load(std::memory_order_relaxed)) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        traceFile = fopen(tracePath.c_str(), "wb");
+        if (!traceFile) return false;
+
+        sampleInterval = interval ? interval : 1;
+        startTime      = std::chrono::steady_clock::now();
+        for (auto &slot : sampledPtrs) slot.store(EMPTY_SLOT, std::memory_order_relaxed);
+        clearLiveTags();
+
+        fwrite("CCAP", 1, 4, traceFile);
+        writeValue(TRACE_VERSION);
+        writeValue(static_cast<uint8_t>(TAG_COUNT));
+        writeValue(static_cast<uint8_t>(0));
+        writeValue(sampleInterval);
+        for (const char *name : TAG_NAMES) writeString(name, 0xff);
+        writeModules();
+    }
+
+    // threads registered by an earlier run keep their sample gaps, only the interval changes
+    _enabled.store(true, std::memory_order_release);
+
+    snapshotStop   = false;
+    snapshotThread = std::thread(snapshotLoop, snapshotIntervalMs ? snapshotIntervalMs : 1000);
+    return true;
+}
+
+void AllocProfiler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        if (!_enabled.load(std::memory_order_relaxed)) return;
+        _enabled.store(false, std::memory_order_release);
+        snapshotStop = true;
+    }
+    snapshotCV.notify_all();
+    if (snapshotThread.joinable()) snapshotThread.join();
+
+    writeSnapshot();
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceFile) {
+        // modules loaded while profiling
+        writeModules();
+        fclose(traceFile);
+        traceFile = nullptr;
+    }
+    // frees are no longer recorded, the blocks still alive would never leave the maps
+    clearLiveTags();
+}
+
+void AllocProfiler::recordAlloc(void *ptr, size_t size) {
+    if (!ptr) return;
+    ThreadState *state = getThreadState();
+    if (!state || state->reentered) return;
+
+    auto tag = static_cast<int>(currentTag);
+    inc(state->allocCount[tag], 1);
+    inc(state->allocBytes[tag], size);
+    {
+        auto &                      shard = getLiveShard(reinterpret_cast<uintptr_t>(ptr));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.tags[reinterpret_cast<uintptr_t>(ptr)] = static_cast<uint8_t>(tag);
+    }
+
+    state->bytesUntilSample -= static_cast<int64_t>(size);
+    if (state->bytesUntilSample > 0) return;
+
+    state->reentered        = true;
+    state->bytesUntilSample = nextSampleGap(state);
+
+    uint64_t pcs[MAX_STACK_DEPTH];
+    int      depth = captureStack(pcs, MAX_STACK_DEPTH);
+    bool     tracked = insertSampled(reinterpret_cast<uintptr_t>(ptr));
+
+    {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        if (traceFile) {
+            writeValue('S');
+            writeValue(elapsedNanoseconds());
+            writeValue(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+            writeValue(static_cast<uint64_t>(size));
+            // the high bit marks samples whose free will not be reported
+            writeValue(static_cast<uint8_t>(tag | (tracked ? 0 : 0x80)));
+            writeValue(static_cast<uint8_t>(depth));
+            fwrite(pcs, sizeof(uint64_t), depth, traceFile);
+        }
+    }
+    state->reentered = false;
+}
+
+void AllocProfiler::recordFree(void *ptr) {
+    if (!ptr) return;
+    ThreadState *state = getThreadState();
+    if (!state || state->reentered) return;
+
+    int tag;
+    {
+        auto &                      shard = getLiveShard(reinterpret_cast<uintptr_t>(ptr));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto                        iter = shard.tags.find(reinterpret_cast<uintptr_t>(ptr));
+        // blocks allocated before start() were not counted either
+        if (iter == shard.tags.end()) return;
+        tag = iter->second;
+        shard.tags.erase(iter);
+    }
+    inc(state->freeCount[tag], 1);
+
+    if (!removeSampled(reinterpret_cast<uintptr_t>(ptr))) return;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (traceFile) {
+        writeValue('F');
+        writeValue(elapsedNanoseconds());
+        writeValue(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+    }
+}
+
+void AllocProfiler::snapshot() {
+    if (isEnabled()) writeSnapshot();
+}
+
+void AllocProfiler::getStats(TagStats (&stats)[static_cast<int>(MemTag::COUNT)]) {
+    std::lock_guard<std::mutex> lock(statesMutex);
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        stats[i] = retiredStats[i];
+        for (const ThreadState *state : states) {
+            stats[i].allocCount += state->allocCount[i].load(std::memory_order_relaxed);
+            stats[i].allocBytes += state->allocBytes[i].load(std::memory_order_relaxed);
+            stats[i].freeCount += state->freeCount[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+MemTag AllocProfiler::getTag() {
+    return currentTag;
+}
+
+void AllocProfiler::setTag(MemTag tag) {
+    currentTag = tag;
+}
+
+} // namespace cc
@@ -0,0 +1,99 @@
+#ifndef CC_CORE_ALLOC_PROFILER_H_
+#define CC_CORE_ALLOC_PROFILER_H_
+
+#include "base/Macros.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// compiled in for all build types, it costs one relaxed load per allocation until started
+#ifndef CC_ALLOC_PROFILER
+    #define CC_ALLOC_PROFILER 1
+#endif
+
+namespace cc {
+
+enum class MemTag : uint8_t {
+    DEFAULT = 0,
+    GFX,
+    PIPELINE,
+    MIDDLEWARE,
+    NETWORK,
+    AUDIO,
+    SCRIPT,
+    COUNT
+};
+
+/** Sampling allocation profiler for release builds.
+	@par
+	Every allocation made through the allocation policies is counted per thread
+	and per MemTag. Roughly once per sampleInterval bytes an allocation is sampled
+	with its call stack and written to a binary trace, frees of sampled pointers are
+	written as well. A free is counted under the tag the block was allocated with,
+	not the tag of the freeing thread. Counter snapshots of all threads are written periodically.
+	tools/alloc-profiler turns the trace into folded stacks for flame graphs.
+*/
+class CC_DLL AllocProfiler {
+public:
+    struct TagStats {
+        uint64_t allocCount = 0;
+        uint64_t allocBytes = 0;
+        uint64_t freeCount = 0;
+    };
+
+    static bool start(const std::string &tracePath, uint32_t sampleInterval = 512 * 1024, uint32_t snapshotIntervalMs = 1000);
+    static void stop();
+
+    static CC_INLINE bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    static void recordAlloc(void *ptr, size_t size);
+    static void recordFree(void *ptr);
+
+    // Writes the counters of all threads to the trace
+    static void snapshot();
+    static void getStats(TagStats (&stats)[static_cast<int>(MemTag::COUNT)]);
+
+    static MemTag getTag();
+    static void setTag(MemTag tag);
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+// Tags allocations made by the current thread in this scope
+class MemTagScope {
+public:
+    explicit MemTagScope(MemTag tag) : _prev(AllocProfiler::getTag()) { AllocProfiler::setTag(tag); }
+    ~MemTagScope() { AllocProfiler::setTag(_prev); }
+
+    MemTagScope(const MemTagScope &) = delete;
+    MemTagScope &operator=(const MemTagScope &) = delete;
+
+private:
+    MemTag _prev;
+};
+
+} // namespace cc
+
+#if CC_ALLOC_PROFILER
+    #define CC_PROFILE_ALLOC(ptr, size)                      \
+        do {                                                 \
+            if (::cc::AllocProfiler::isEnabled()) {          \
+                ::cc::AllocProfiler::recordAlloc(ptr, size); \
+            }                                                \
+        } while (0)
+    #define CC_PROFILE_FREE(ptr)                    \
+        do {                                        \
+            if (::cc::AllocProfiler::isEnabled()) { \
+                ::cc::AllocProfiler::recordFree(ptr); \
+            }                                       \
+        } while (0)
+    #define CC_MEM_TAG_SCOPE(tag) ::cc::MemTagScope __memTagScope(::cc::MemTag::tag)
+#else
+    #define CC_PROFILE_ALLOC(ptr, size)
+    #define CC_PROFILE_FREE(ptr)
+    #define CC_MEM_TAG_SCOPE(tag)
+#endif
+
+#endif // CC_CORE_ALLOC_PROFILER_H_
@@ -0,0 +1,114 @@
+#include "FrameAllocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+namespace cc {
+
+namespace {
+constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+std::mutex allocatorsMutex;
+std::vector<FrameAllocator *> allocators;
+FrameAllocator::Stats lastFrameStats;
+
+struct ThreadLocalAllocator {
+    ThreadLocalAllocator() {
+        std::lock_guard<std::mutex> lock(allocatorsMutex);
+        allocators.push_back(&allocator);
+    }
+    ~ThreadLocalAllocator() {
+        std::lock_guard<std::mutex> lock(allocatorsMutex);
+        allocators.erase(std::find(allocators.begin(), allocators.end(), &allocator));
+    }
+    FrameAllocator allocator;
+};
+} // namespace
+
+FrameAllocator *FrameAllocator::getThreadLocal() {
+    static thread_local ThreadLocalAllocator instance;
+    return &instance.allocator;
+}
+
+void FrameAllocator::resetAll() {
+    std::lock_guard<std::mutex> lock(allocatorsMutex);
+    Stats frameStats;
+    for (auto *allocator : allocators) {
+        const auto &stats = allocator->getStats();
+        frameStats.allocations += stats.allocations;
+        frameStats.usedBytes += stats.usedBytes;
+        frameStats.capacity += stats.capacity;
+        allocator->reset();
+    }
+    lastFrameStats = frameStats;
+}
+
+FrameAllocator::Stats FrameAllocator::getLastFrameStats() {
+    std::lock_guard<std::mutex> lock(allocatorsMutex);
+    return lastFrameStats;
+}
+
+FrameAllocator::FrameAllocator() = default;
+
+FrameAllocator::~FrameAllocator() {
+    for (auto &block : _blocks) {
+        free(block.data);
+    }
+}
+
+void *FrameAllocator::allocate(size_t bytes, size_t alignment) {
+    ++_stats.allocations;
+    _stats.usedBytes += bytes;
+
+    if (!_blocks.empty()) {
+        auto &block = _blocks.back();
+        size_t aligned = (reinterpret_cast<uintptr_t>(block.data) + _offset + alignment - 1) & ~(alignment - 1);
+        size_t offset = aligned - reinterpret_cast<uintptr_t>(block.data);
+        if (offset + bytes <= block.size) {
+            _offset = offset + bytes;
+            return block.data + offset;
+        }
+    }
+    return allocateFromNewBlock(bytes, alignment);
+}
+
+void *FrameAllocator::allocateFromNewBlock(size_t bytes, size_t alignment) {
+    size_t size = std::max(DEFAULT_BLOCK_SIZE, bytes + alignment);
+    if (!_blocks.empty()) {
+        size = std::max(size, _blocks.back().size * 2);
+    }
+    auto *data = static_cast<uint8_t *>(malloc(size));
+    if (!data) {
+        throw std::bad_alloc();
+    }
+    _blocks.push_back({data, size});
+    _stats.capacity += size;
+
+    size_t aligned = (reinterpret_cast<uintptr_t>(data) + alignment - 1) & ~(alignment - 1);
+    size_t offset = aligned - reinterpret_cast<uintptr_t>(data);
+    _offset = offset + bytes;
+    return data + offset;
+}
+
+void FrameAllocator::reset() {
+    if (_blocks.size() > 1) {
+        // merge into one block big enough for the whole frame
+        size_t size = 0;
+        for (auto &block : _blocks) {
+            size += block.size;
+            free(block.data);
+        }
+        _blocks.clear();
+        auto *data = static_cast<uint8_t *>(malloc(size));
+        if (data) {
+            _blocks.push_back({data, size});
+        }
+        _stats.capacity = data ? size : 0;
+    }
+    _offset = 0;
+    _stats.allocations = 0;
+    _stats.usedBytes = 0;
+}
+
+} // namespace cc
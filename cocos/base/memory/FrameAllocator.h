@@ -0,0 +1,132 @@
+#ifndef CC_CORE_FRAME_ALLOC_H_
+#define CC_CORE_FRAME_ALLOC_H_
+
+#include "base/Macros.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cc {
+
+/**	A linear allocator for memory which only lives until the end of the frame.
+	@par
+	Allocation bumps a pointer and deallocation does nothing, all memory is
+	recycled at once by FrameAllocator::resetAll(). Each thread has its own
+	instance, so no locking is needed. When a frame needs more than one block,
+	the blocks are merged into one on reset, so steady state frames don't touch
+	the heap at all.
+	@note Memory handed out must not be used after resetAll() is called.
+*/
+class CC_DLL FrameAllocator {
+public:
+    struct Stats {
+        uint32_t allocations = 0;
+        size_t usedBytes = 0;
+        size_t capacity = 0;
+    };
+
+    // Gets the allocator of the calling thread
+    static FrameAllocator *getThreadLocal();
+
+    // Resets the allocators of all threads, call it at frame end when no one is using frame memory
+    static void resetAll();
+
+    // Gets the total stats of all threads for the last finished frame
+    static Stats getLastFrameStats();
+
+    FrameAllocator();
+    ~FrameAllocator();
+    FrameAllocator(const FrameAllocator &) = delete;
+    FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void reset();
+
+    inline const Stats &getStats() const { return _stats; }
+
+private:
+    struct Block {
+        uint8_t *data = nullptr;
+        size_t size = 0;
+    };
+
+    void *allocateFromNewBlock(size_t bytes, size_t alignment);
+
+    std::vector<Block> _blocks;
+    size_t _offset = 0;
+    Stats _stats;
+};
+
+/**	STL allocator adapter for FrameAllocator, it binds the allocator of the
+	thread constructing it. The containers must be cleared or assigned before
+	being used in a later frame.
+*/
+template <typename T>
+class FrameStlAllocator {
+public:
+    typedef T value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <typename U>
+    struct rebind {
+        typedef FrameStlAllocator<U> other;
+    };
+
+    inline FrameStlAllocator() : _allocator(FrameAllocator::getThreadLocal()) {}
+    inline explicit FrameStlAllocator(FrameAllocator *allocator) : _allocator(allocator) {}
+
+    template <typename U>
+    inline FrameStlAllocator(FrameStlAllocator<U> const &other) : _allocator(other.getAllocator()) {}
+
+    inline pointer allocate(size_type count) {
+        return static_cast<pointer>(_allocator->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    inline void deallocate(pointer, size_type) {}
+
+    size_type max_size() const throw() {
+        return size_t(-1) / sizeof(T);
+    }
+
+    template <typename Up, typename... Args>
+    void construct(Up *p, Args &&... args) {
+        ::new ((void *)p) Up(std::forward<Args>(args)...);
+    }
+
+    template <typename Up>
+    void destroy(Up *p) {
+        p->~Up();
+    }
+
+    inline FrameAllocator *getAllocator() const { return _allocator; }
+
+private:
+    FrameAllocator *_allocator = nullptr;
+};
+
+template <typename T, typename U>
+inline bool operator==(FrameStlAllocator<T> const &l, FrameStlAllocator<U> const &r) {
+    return l.getAllocator() == r.getAllocator();
+}
+
+template <typename T, typename U>
+inline bool operator!=(FrameStlAllocator<T> const &l, FrameStlAllocator<U> const &r) {
+    return l.getAllocator() != r.getAllocator();
+}
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+} // namespace cc
+
+#endif // CC_CORE_FRAME_ALLOC_H_
@@ -1,5 +1,6 @@
 #include "CoreStd.h"
 #include "JeAlloc.h"
+#include "AllocProfiler.h"
 #include "MemTracker.h"
 
 #if (CC_MEMORY_ALLOCATOR == CC_MEMORY_ALLOCATOR_JEMALLOC)
@@ -43,6 +44,7 @@ CC_DECL_MALLOC void *JeAllocImpl::AllocBytes(size_t count, const char *file, int
     (void)line;
     (void)func;
     #endif
+    CC_PROFILE_ALLOC(ptr, count);
     return ptr;
 }
 
@@ -83,7 +85,11 @@ CC_DECL_MALLOC void *JeAllocImpl::ReallocBytes(void *ptr, size_t count, const ch
     (void)file;
     (void)line;
     (void)func;
-    return je_realloc(ptr, count);
+    void *nptr = je_realloc(ptr, count);
+    // a failed realloc leaves the old block alive, only a shrink to zero frees it
+    if (ptr && (nptr || !count)) CC_PROFILE_FREE(ptr);
+    if (nptr && count) CC_PROFILE_ALLOC(nptr, count);
+    return nptr;
     #endif
 }
 
@@ -99,6 +105,7 @@ CC_DECL_MALLOC void *JeAllocImpl::AllocBytesAligned(size_t align, size_t count,
     (void)line;
     (void)func;
     #endif
+    CC_PROFILE_ALLOC(ptr, count);
     return ptr;
 }
 
@@ -110,6 +117,7 @@ void JeAllocImpl::DeallocBytes(void *ptr) {
     CheckOverflowFree(ptr);
     MemTracker::Instance()->RecordFree(ptr);
     #endif
+    CC_PROFILE_FREE(ptr);
     je_free(ptr);
 }
 
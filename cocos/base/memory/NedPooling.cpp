@@ -1,5 +1,6 @@
 #include "CoreStd.h"
 #include "NedPooling.h"
+#include "AllocProfiler.h"
 #include "MemTracker.h"
 
 #if (CC_MEMORY_ALLOCATOR == CC_MEMORY_ALLOCATOR_NEDPOOLING)
@@ -132,6 +133,7 @@ CC_DECL_MALLOC void *NedPoolingImpl::AllocBytes(size_t count, const char *file,
     (void)line;
     (void)func;
     #endif
+    CC_PROFILE_ALLOC(ptr, count);
     return ptr;
 }
 
@@ -168,7 +170,11 @@ CC_DECL_MALLOC void *NedPoolingImpl::ReallocBytes(void *ptr, size_t count, const
         }
     }
     #else
-    return nedPoolingIntern::InternalRealloc(ptr, count);
+    void *nptr = nedPoolingIntern::InternalRealloc(ptr, count);
+    // a failed realloc leaves the old block alive, only a shrink to zero frees it
+    if (ptr && (nptr || !count)) CC_PROFILE_FREE(ptr);
+    if (nptr && count) CC_PROFILE_ALLOC(nptr, count);
+    return nptr;
     #endif
 }
 
@@ -183,6 +189,7 @@ CC_DECL_MALLOC void *NedPoolingImpl::AllocBytesAligned(size_t align, size_t coun
     (void)line;
     (void)func;
     #endif
+    CC_PROFILE_ALLOC(ptr, count);
     return ptr;
 }
 
@@ -194,6 +201,7 @@ void NedPoolingImpl::DeallocBytes(void *ptr) {
     #ifdef CC_MEMORY_TRACKER
     MemTracker::Instance()->RecordFree(ptr);
     #endif
+    CC_PROFILE_FREE(ptr);
     nedPoolingIntern::InternalFree(ptr);
 }
 
@@ -3,6 +3,7 @@
 
 #if (CC_MEMORY_ALLOCATOR == CC_MEMORY_ALLOCATOR_STD)
 
+    #include "AllocProfiler.h"
     #include "base/Macros.h"
     #include <limits>
     #include <stdlib.h>
@@ -29,6 +30,7 @@ public:
     #ifdef CC_MEMORY_TRACKER
         MemTracker::Instance()->RecordAlloc(ptr, count, file, line, func);
     #endif
+        CC_PROFILE_ALLOC(ptr, count);
         return ptr;
     }
 
@@ -72,7 +74,11 @@ public:
             }
         }
     #else
-        return realloc(ptr, count);
+        void *nptr = realloc(ptr, count);
+        // a failed realloc leaves the old block alive, only a shrink to zero frees it
+        if (ptr && (nptr || !count)) CC_PROFILE_FREE(ptr);
+        if (nptr && count) CC_PROFILE_ALLOC(nptr, count);
+        return nptr;
     #endif
     }
 
@@ -80,6 +86,7 @@ public:
     #ifdef CC_MEMORY_TRACKER
         MemTracker::Instance()->RecordFree(ptr);
     #endif
+        CC_PROFILE_FREE(ptr);
         free(ptr);
     }
 
@@ -106,6 +113,7 @@ public:
     #ifdef CC_MEMORY_TRACKER
         MemTracker::Instance()->RecordAlloc(ptr, count, file, line, func);
     #endif
+        CC_PROFILE_ALLOC(ptr, count);
         return ptr;
     }
 
@@ -113,6 +121,7 @@ public:
     #ifdef CC_MEMORY_TRACKER
         MemTracker::Instance()->RecordFree(ptr);
     #endif
+        CC_PROFILE_FREE(ptr);
 
     #ifdef _MSC_VER
         _aligned_free(ptr);
@@ -476,7 +476,10 @@ static bool js_audio_AudioEngine_preload(se::State& s)
             } while(false)
             ;
             if (!ok) { ok = true; break; }
-            cc::AudioEngine::preload(arg0.value(), arg1.value());
+            unsigned int result = cc::AudioEngine::preload(arg0.value(), arg1.value());
+            ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+            SE_PRECONDITION2(ok, false, "js_audio_AudioEngine_preload : Error processing arguments");
+            SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
             return true;
         }
     } while (false);
@@ -485,7 +488,10 @@ static bool js_audio_AudioEngine_preload(se::State& s)
             HolderType<std::string, true> arg0 = {};
             ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
             if (!ok) { ok = true; break; }
-            cc::AudioEngine::preload(arg0.value());
+            unsigned int result = cc::AudioEngine::preload(arg0.value());
+            ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+            SE_PRECONDITION2(ok, false, "js_audio_AudioEngine_preload : Error processing arguments");
+            SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
             return true;
         }
     } while (false);
@@ -5763,6 +5763,44 @@ static bool js_dragonbones_CCArmatureDisplay_getSharedBufferOffset(se::State& s)
 }
 SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_getSharedBufferOffset)
 
+static bool js_dragonbones_CCArmatureDisplay_getSkippedPoseCount(se::State& s)
+{
+    dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
+    SE_PRECONDITION2(cobj, false, "js_dragonbones_CCArmatureDisplay_getSkippedPoseCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getSkippedPoseCount();
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_dragonbones_CCArmatureDisplay_getSkippedPoseCount : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_getSkippedPoseCount)
+
+static bool js_dragonbones_CCArmatureDisplay_getSkippedRenderCount(se::State& s)
+{
+    dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
+    SE_PRECONDITION2(cobj, false, "js_dragonbones_CCArmatureDisplay_getSkippedRenderCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        unsigned int result = cobj->getSkippedRenderCount();
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_dragonbones_CCArmatureDisplay_getSkippedRenderCount : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_getSkippedRenderCount)
+
 static bool js_dragonbones_CCArmatureDisplay_hasDBEventListener(se::State& s)
 {
     dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
@@ -5835,6 +5873,22 @@ static bool js_dragonbones_CCArmatureDisplay_removeDBEventListener(se::State& s)
 }
 SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_removeDBEventListener)
 
+static bool js_dragonbones_CCArmatureDisplay_resetSkippedCount(se::State& s)
+{
+    dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
+    SE_PRECONDITION2(cobj, false, "js_dragonbones_CCArmatureDisplay_resetSkippedCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        cobj->resetSkippedCount();
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_resetSkippedCount)
+
 static bool js_dragonbones_CCArmatureDisplay_setAttachEnabled(se::State& s)
 {
     dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
@@ -5898,6 +5952,25 @@ static bool js_dragonbones_CCArmatureDisplay_setColor(se::State& s)
 }
 SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_setColor)
 
+static bool js_dragonbones_CCArmatureDisplay_setCullingEnabled(se::State& s)
+{
+    dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
+    SE_PRECONDITION2(cobj, false, "js_dragonbones_CCArmatureDisplay_setCullingEnabled : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        HolderType<bool, false> arg0 = {};
+        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_dragonbones_CCArmatureDisplay_setCullingEnabled : Error processing arguments");
+        cobj->setCullingEnabled(arg0.value());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_setCullingEnabled)
+
 static bool js_dragonbones_CCArmatureDisplay_setDBEventCallback(se::State& s)
 {
     dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
@@ -5965,6 +6038,27 @@ static bool js_dragonbones_CCArmatureDisplay_setDebugBonesEnabled(se::State& s)
 }
 SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_setDebugBonesEnabled)
 
+static bool js_dragonbones_CCArmatureDisplay_setLowDetailUpdate(se::State& s)
+{
+    dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
+    SE_PRECONDITION2(cobj, false, "js_dragonbones_CCArmatureDisplay_setLowDetailUpdate : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        HolderType<float, false> arg0 = {};
+        HolderType<int, false> arg1 = {};
+        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
+        ok &= sevalue_to_native(args[1], &arg1, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_dragonbones_CCArmatureDisplay_setLowDetailUpdate : Error processing arguments");
+        cobj->setLowDetailUpdate(arg0.value(), arg1.value());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_dragonbones_CCArmatureDisplay_setLowDetailUpdate)
+
 static bool js_dragonbones_CCArmatureDisplay_setOpacityModifyRGB(se::State& s)
 {
     dragonBones::CCArmatureDisplay* cobj = SE_THIS_OBJECT<dragonBones::CCArmatureDisplay>(s);
@@ -6041,13 +6135,18 @@ bool js_register_dragonbones_CCArmatureDisplay(se::Object* obj)
     cls->defineFunction("getParamsBuffer", _SE(js_dragonbones_CCArmatureDisplay_getParamsBuffer));
     cls->defineFunction("getRootDisplay", _SE(js_dragonbones_CCArmatureDisplay_getRootDisplay));
     cls->defineFunction("getSharedBufferOffset", _SE(js_dragonbones_CCArmatureDisplay_getSharedBufferOffset));
+    cls->defineFunction("getSkippedPoseCount", _SE(js_dragonbones_CCArmatureDisplay_getSkippedPoseCount));
+    cls->defineFunction("getSkippedRenderCount", _SE(js_dragonbones_CCArmatureDisplay_getSkippedRenderCount));
     cls->defineFunction("hasDBEventListener", _SE(js_dragonbones_CCArmatureDisplay_hasDBEventListener));
     cls->defineFunction("removeDBEventListener", _SE(js_dragonbones_CCArmatureDisplay_removeDBEventListener));
+    cls->defineFunction("resetSkippedCount", _SE(js_dragonbones_CCArmatureDisplay_resetSkippedCount));
     cls->defineFunction("setAttachEnabled", _SE(js_dragonbones_CCArmatureDisplay_setAttachEnabled));
     cls->defineFunction("setBatchEnabled", _SE(js_dragonbones_CCArmatureDisplay_setBatchEnabled));
     cls->defineFunction("setColor", _SE(js_dragonbones_CCArmatureDisplay_setColor));
+    cls->defineFunction("setCullingEnabled", _SE(js_dragonbones_CCArmatureDisplay_setCullingEnabled));
     cls->defineFunction("setDBEventCallback", _SE(js_dragonbones_CCArmatureDisplay_setDBEventCallback));
     cls->defineFunction("setDebugBonesEnabled", _SE(js_dragonbones_CCArmatureDisplay_setDebugBonesEnabled));
+    cls->defineFunction("setLowDetailUpdate", _SE(js_dragonbones_CCArmatureDisplay_setLowDetailUpdate));
     cls->defineFunction("setOpacityModifyRGB", _SE(js_dragonbones_CCArmatureDisplay_setOpacityModifyRGB));
     cls->defineStaticFunction("create", _SE(js_dragonbones_CCArmatureDisplay_create));
     cls->defineFinalizeFunction(_SE(js_dragonBones_CCArmatureDisplay_finalize));
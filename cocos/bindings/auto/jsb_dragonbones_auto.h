@@ -369,13 +369,18 @@ SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getDebugData);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getParamsBuffer);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getRootDisplay);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getSharedBufferOffset);
+SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getSkippedPoseCount);
+SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_getSkippedRenderCount);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_hasDBEventListener);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_removeDBEventListener);
+SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_resetSkippedCount);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setAttachEnabled);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setBatchEnabled);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setColor);
+SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setCullingEnabled);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setDBEventCallback);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setDebugBonesEnabled);
+SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setLowDetailUpdate);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_setOpacityModifyRGB);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_create);
 SE_DECLARE_FUNC(js_dragonbones_CCArmatureDisplay_CCArmatureDisplay);
@@ -247,6 +247,25 @@ bool js_register_editor_support_Texture2D(se::Object* obj)
 se::Object* __jsb_cc_middleware_SharedBufferManager_proto = nullptr;
 se::Class* __jsb_cc_middleware_SharedBufferManager_class = nullptr;
 
+static bool js_editor_support_SharedBufferManager_getChunkCount(se::State& s)
+{
+    cc::middleware::SharedBufferManager* cobj = SE_THIS_OBJECT<cc::middleware::SharedBufferManager>(s);
+    SE_PRECONDITION2(cobj, false, "js_editor_support_SharedBufferManager_getChunkCount : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        size_t result = cobj->getChunkCount();
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_editor_support_SharedBufferManager_getChunkCount : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    return false;
+}
+SE_BIND_FUNC(js_editor_support_SharedBufferManager_getChunkCount)
+
 static bool js_editor_support_SharedBufferManager_getSharedBuffer(se::State& s)
 {
     cc::middleware::SharedBufferManager* cobj = SE_THIS_OBJECT<cc::middleware::SharedBufferManager>(s);
@@ -266,6 +285,28 @@ static bool js_editor_support_SharedBufferManager_getSharedBuffer(se::State& s)
 }
 SE_BIND_FUNC(js_editor_support_SharedBufferManager_getSharedBuffer)
 
+static bool js_editor_support_SharedBufferManager_getSharedBufferChunk(se::State& s)
+{
+    cc::middleware::SharedBufferManager* cobj = SE_THIS_OBJECT<cc::middleware::SharedBufferManager>(s);
+    SE_PRECONDITION2(cobj, false, "js_editor_support_SharedBufferManager_getSharedBufferChunk : Invalid Native Object");
+    const auto& args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        HolderType<size_t, false> arg0 = {};
+        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_editor_support_SharedBufferManager_getSharedBufferChunk : Error processing arguments");
+        se_object_ptr result = cobj->getSharedBufferChunk(arg0.value());
+        ok &= nativevalue_to_se(result, s.rval(), nullptr /*ctx*/);
+        SE_PRECONDITION2(ok, false, "js_editor_support_SharedBufferManager_getSharedBufferChunk : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_editor_support_SharedBufferManager_getSharedBufferChunk)
+
 static bool js_editor_support_SharedBufferManager_setResizeCallback(se::State& s)
 {
     cc::middleware::SharedBufferManager* cobj = SE_THIS_OBJECT<cc::middleware::SharedBufferManager>(s);
@@ -346,7 +387,9 @@ bool js_register_editor_support_SharedBufferManager(se::Object* obj)
 {
     auto cls = se::Class::create("SharedBufferManager", obj, nullptr, _SE(js_editor_support_SharedBufferManager_constructor));
 
+    cls->defineFunction("getChunkCount", _SE(js_editor_support_SharedBufferManager_getChunkCount));
     cls->defineFunction("getSharedBuffer", _SE(js_editor_support_SharedBufferManager_getSharedBuffer));
+    cls->defineFunction("getSharedBufferChunk", _SE(js_editor_support_SharedBufferManager_getSharedBufferChunk));
     cls->defineFunction("setResizeCallback", _SE(js_editor_support_SharedBufferManager_setResizeCallback));
     cls->defineFinalizeFunction(_SE(js_cc_middleware_SharedBufferManager_finalize));
     cls->install();
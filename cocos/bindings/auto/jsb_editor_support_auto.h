@@ -31,7 +31,9 @@ bool js_register_cc_middleware_SharedBufferManager(se::Object* obj);
 bool register_all_editor_support(se::Object* obj);
 
 JSB_REGISTER_OBJECT_TYPE(cc::middleware::SharedBufferManager);
+SE_DECLARE_FUNC(js_editor_support_SharedBufferManager_getChunkCount);
 SE_DECLARE_FUNC(js_editor_support_SharedBufferManager_getSharedBuffer);
+SE_DECLARE_FUNC(js_editor_support_SharedBufferManager_getSharedBufferChunk);
 SE_DECLARE_FUNC(js_editor_support_SharedBufferManager_setResizeCallback);
 SE_DECLARE_FUNC(js_editor_support_SharedBufferManager_SharedBufferManager);
 
@@ -0,0 +1,150 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandStream.h"
+#include "base/Log.h"
+#include "base/memory/Memory.h"
+#include "cocos/bindings/auto/jsb_gfx_auto.h"
+#include "renderer/core/CoreStd.h"
+#include "renderer/core/gfx/GFXCommandBuffer.h"
+#include "renderer/core/gfx/GFXDescriptorSet.h"
+#include "renderer/core/gfx/GFXInputAssembler.h"
+#include "renderer/core/gfx/GFXPipelineState.h"
+
+using namespace se;
+
+namespace {
+bool reportInvalidObject(CommandStreamOp op, uint command, uint index) {
+    CC_LOG_ERROR("CommandStream: command %u (op %u) references invalid object %u", command, static_cast<uint>(op), index);
+    return false;
+}
+} // namespace
+
+CommandStream::CommandStream(Object *objectTable)
+: _objectTable(objectTable) {
+    CCASSERT(objectTable->isArray(), "CommandStream: It must be initialized with a JavaScript array");
+    _objectTable->incRef();
+}
+
+CommandStream::~CommandStream() {
+    _objectTable->decRef();
+}
+
+template <class T>
+T *CommandStream::getObject(uint index, const Class *cls) {
+    if (index >= _objects.size()) {
+        return nullptr;
+    }
+    auto &cached = _objects[index];
+    if (!cached.nativeObject) {
+        Value jsEntry;
+        if (_objectTable->getArrayElement(index, &jsEntry) && jsEntry.isObject()) {
+            cached.nativeObject = jsEntry.toObject()->getPrivateData();
+            cached.cls = jsEntry.toObject()->_getClass();
+        }
+    }
+    // the table is shared by all ops, an index may point at an object of another type
+    if (!cached.nativeObject || cached.cls != cls) {
+        return nullptr;
+    }
+    return static_cast<T *>(cached.nativeObject);
+}
+
+bool CommandStream::decode(cc::gfx::CommandBuffer *cmdBuff, const uint *words, uint wordCount) {
+    uint objectCount = 0;
+    _objectTable->getArrayLength(&objectCount);
+    _objects.assign(objectCount, CachedObject());
+
+    const uint *cur = words;
+    const uint *end = words + wordCount;
+    for (uint command = 0; cur < end; ++command) {
+        auto op = static_cast<CommandStreamOp>(*cur++);
+        switch (op) {
+            case CommandStreamOp::END:
+                return true;
+            case CommandStreamOp::BIND_PIPELINE_STATE: {
+                if (end - cur < 1) break;
+                auto *pipelineState = getObject<cc::gfx::PipelineState>(cur[0], __jsb_cc_gfx_PipelineState_class);
+                if (!pipelineState) return reportInvalidObject(op, command, cur[0]);
+                cmdBuff->bindPipelineState(pipelineState);
+                cur += 1;
+                continue;
+            }
+            case CommandStreamOp::BIND_DESCRIPTOR_SET: {
+                if (end - cur < 3 || static_cast<uint>(end - cur - 3) < cur[2]) break;
+                auto *descriptorSet = getObject<cc::gfx::DescriptorSet>(cur[1], __jsb_cc_gfx_DescriptorSet_class);
+                if (!descriptorSet) return reportInvalidObject(op, command, cur[1]);
+                cmdBuff->bindDescriptorSet(cur[0], descriptorSet, cur[2], cur[2] ? cur + 3 : nullptr);
+                cur += 3 + cur[2];
+                continue;
+            }
+            case CommandStreamOp::BIND_INPUT_ASSEMBLER: {
+                if (end - cur < 1) break;
+                auto *inputAssembler = getObject<cc::gfx::InputAssembler>(cur[0], __jsb_cc_gfx_InputAssembler_class);
+                if (!inputAssembler) return reportInvalidObject(op, command, cur[0]);
+                cmdBuff->bindInputAssembler(inputAssembler);
+                cur += 1;
+                continue;
+            }
+            case CommandStreamOp::SET_VIEWPORT: {
+                if (end - cur < 6) break;
+                cc::gfx::Viewport vp;
+                vp.left = static_cast<int>(cur[0]);
+                vp.top = static_cast<int>(cur[1]);
+                vp.width = cur[2];
+                vp.height = cur[3];
+                memcpy(&vp.minDepth, cur + 4, sizeof(float));
+                memcpy(&vp.maxDepth, cur + 5, sizeof(float));
+                cmdBuff->setViewport(vp);
+                cur += 6;
+                continue;
+            }
+            case CommandStreamOp::SET_SCISSOR: {
+                if (end - cur < 4) break;
+                cc::gfx::Rect rect;
+                rect.x = static_cast<int>(cur[0]);
+                rect.y = static_cast<int>(cur[1]);
+                rect.width = cur[2];
+                rect.height = cur[3];
+                cmdBuff->setScissor(rect);
+                cur += 4;
+                continue;
+            }
+            case CommandStreamOp::DRAW: {
+                if (end - cur < 1) break;
+                auto *inputAssembler = getObject<cc::gfx::InputAssembler>(cur[0], __jsb_cc_gfx_InputAssembler_class);
+                if (!inputAssembler) return reportInvalidObject(op, command, cur[0]);
+                cmdBuff->draw(inputAssembler);
+                cur += 1;
+                continue;
+            }
+            default:
+                CC_LOG_ERROR("CommandStream: unknown op %u at word %u", static_cast<uint>(op), static_cast<uint>(cur - words - 1));
+                return false;
+        }
+        CC_LOG_ERROR("CommandStream: command %u (op %u) is truncated", command, static_cast<uint>(op));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "cocos/base/Macros.h"
+#include "cocos/base/Object.h"
+#include "cocos/base/TypeDef.h"
+#include "cocos/base/memory/StlAlloc.h"
+#include "cocos/bindings/jswrapper/Object.h"
+
+namespace cc {
+namespace gfx {
+class CommandBuffer;
+}
+} // namespace cc
+
+namespace se {
+
+/**
+ * Commands recorded by JS into an ArrayBuffer as uint32 words and replayed into a gfx::CommandBuffer
+ * with a single binding call. Objects are referenced by their index in the JS object table the stream
+ * was created with.
+ */
+enum class CommandStreamOp : uint {
+    END,
+    BIND_PIPELINE_STATE,  // object
+    BIND_DESCRIPTOR_SET,  // set, object, dynamicOffsetCount, dynamicOffsets...
+    BIND_INPUT_ASSEMBLER, // object
+    SET_VIEWPORT,         // left, top, width, height, minDepth(float), maxDepth(float)
+    SET_SCISSOR,          // x, y, width, height
+    DRAW,                 // object
+    COUNT
+};
+
+class CC_DLL CommandStream final : public cc::Object {
+public:
+    CommandStream(Object *objectTable);
+    ~CommandStream();
+
+    bool decode(cc::gfx::CommandBuffer *cmdBuff, const uint *words, uint wordCount);
+
+private:
+    struct CachedObject {
+        void *nativeObject = nullptr;
+        Class *cls = nullptr;
+    };
+
+    // null if the entry is not a native object of the expected binding class
+    template <class T>
+    T *getObject(uint index, const Class *cls);
+
+    Object *_objectTable = nullptr;
+    // native objects resolved during current decode, avoids fetching the same js object again
+    cc::vector<CachedObject> _objects;
+};
+
+} // namespace se
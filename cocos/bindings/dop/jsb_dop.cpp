@@ -27,9 +27,11 @@ THE SOFTWARE.
 #include "BufferPool.h"
 #include "ObjectPool.h"
 #include "BufferAllocator.h"
+#include "CommandStream.h"
 #include "cocos/bindings/manual/jsb_global.h"
 #include "cocos/bindings/manual/jsb_classtype.h"
 #include "cocos/bindings/manual/jsb_conversions.h"
+#include "cocos/renderer/core/gfx/GFXCommandBuffer.h"
 
 /********************************************************
        BufferPool binding
@@ -239,6 +241,83 @@ static bool js_register_se_BufferAllocator(se::Object *obj) {
     return true;
 }
 
+/*****************************************************
+   CommandStream binding
+  ******************************************************/
+static se::Class *jsb_CommandStream_class = nullptr;
+
+SE_DECLARE_FINALIZE_FUNC(jsb_CommandStream_finalize)
+
+static bool jsb_CommandStream_constructor(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        if (!args[0].isObject() || !args[0].toObject()->isArray()) {
+            SE_REPORT_ERROR("jsb_CommandStream_constructor: parameter 1 wants a JSArray");
+            return false;
+        }
+
+        se::CommandStream *stream = JSB_ALLOC(se::CommandStream, args[0].toObject());
+        s.thisObject()->setPrivateData(stream);
+        se::NonRefNativePtrCreatedByCtorMap::emplace(stream);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_CTOR(jsb_CommandStream_constructor, jsb_CommandStream_class, jsb_CommandStream_finalize)
+
+static bool jsb_CommandStream_finalize(se::State &s) {
+    auto iter = se::NonRefNativePtrCreatedByCtorMap::find(s.nativeThisObject());
+    if (iter != se::NonRefNativePtrCreatedByCtorMap::end()) {
+        se::NonRefNativePtrCreatedByCtorMap::erase(iter);
+        se::CommandStream *cobj = (se::CommandStream *)s.nativeThisObject();
+        JSB_FREE(cobj);
+    }
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(jsb_CommandStream_finalize)
+
+static bool jsb_CommandStream_flush(se::State &s) {
+    se::CommandStream *stream = (se::CommandStream *)s.nativeThisObject();
+    SE_PRECONDITION2(stream, false, "jsb_CommandStream_flush : Invalid Native Object");
+
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 3) {
+        bool ok = true;
+        cc::gfx::CommandBuffer *cmdBuff = nullptr;
+        ok &= seval_to_native_ptr(args[0], &cmdBuff);
+        uint8_t *data = nullptr;
+        size_t byteLength = 0;
+        ok &= seval_to_buffer_data(args[1], &data, &byteLength);
+        uint wordCount = 0;
+        ok &= seval_to_uint(args[2], &wordCount);
+        SE_PRECONDITION2(ok && cmdBuff, false, "jsb_CommandStream_flush : Error processing arguments");
+        SE_PRECONDITION2(wordCount * sizeof(uint) <= byteLength, false, "jsb_CommandStream_flush : word count exceeds buffer size");
+
+        s.rval().setBoolean(stream->decode(cmdBuff, reinterpret_cast<const uint *>(data), wordCount));
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(jsb_CommandStream_flush);
+
+static bool js_register_se_CommandStream(se::Object *obj) {
+    se::Class *cls = se::Class::create("NativeCommandStream", obj, nullptr, _SE(jsb_CommandStream_constructor));
+    cls->defineFunction("flush", _SE(jsb_CommandStream_flush));
+    cls->install();
+    JSBClassType::registerClass<se::CommandStream>(cls);
+
+    jsb_CommandStream_class = cls;
+
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
 bool register_all_dop_bindings(se::Object *obj) {
     // TODO: Don't make dop into jsb namespace. Currently put it into jsb namesapce just to test codes.
     se::Value nsVal;
@@ -252,5 +331,6 @@ bool register_all_dop_bindings(se::Object *obj) {
     js_register_se_BufferAllocator(ns);
     js_register_se_BufferPool(ns);
     js_register_se_ObjectPool(ns);
+    js_register_se_CommandStream(ns);
     return true;
 }
@@ -42,6 +42,14 @@
     #endif
 #endif
 
+#ifndef SE_ENABLE_CODE_CACHE
+    #if defined(CC_DEBUG) && CC_DEBUG > 0
+        #define SE_ENABLE_CODE_CACHE 0
+    #else
+        #define SE_ENABLE_CODE_CACHE 1 // cache compiled scripts in writable path, only works with V8
+    #endif
+#endif
+
 #define SE_LOG_TO_JS_ENV 0 // print log to JavaScript environment, for example DevTools
 
 #if !defined(ANDROID_INSTANT) && defined(USE_V8_DEBUGGER) && USE_V8_DEBUGGER > 0
@@ -136,6 +136,46 @@ Object *Object::createArrayBufferObject(void *data, size_t byteLength) {
     return obj;
 }
 
+    #if (__MAC_OS_X_VERSION_MAX_ALLOWED >= 101200 || __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000)
+namespace {
+struct ExternalBufferContext {
+    size_t byteLength;
+    Object::BufferContentsFreeFunc freeFunc;
+    void *freeUserData;
+};
+
+void externalArrayBufferDeallocator(void *bytes, void *deallocatorContext) {
+    auto *context = static_cast<ExternalBufferContext *>(deallocatorContext);
+    context->freeFunc(bytes, context->byteLength, context->freeUserData);
+    delete context;
+}
+} // namespace
+    #endif
+
+Object *Object::createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData) {
+    #if (__MAC_OS_X_VERSION_MAX_ALLOWED >= 101200 || __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000)
+    if (isSupportTypedArrayAPI()) {
+        auto *context = new ExternalBufferContext{byteLength, freeFunc, freeUserData};
+        JSValueRef exception = nullptr;
+        JSObjectRef jsobj = JSObjectMakeArrayBufferWithBytesNoCopy(__cx, contents, byteLength, externalArrayBufferDeallocator, context, &exception);
+        if (exception != nullptr) {
+            delete context;
+            ScriptEngine::getInstance()->_clearException(exception);
+            return nullptr;
+        }
+
+        Object *obj = Object::_createJSObject(nullptr, jsobj);
+        if (obj != nullptr)
+            obj->_type = Type::ARRAY_BUFFER;
+        return obj;
+    }
+    #endif
+    // no external buffer support, fall back to copy
+    Object *obj = createArrayBufferObject(contents, byteLength);
+    freeFunc(contents, byteLength, freeUserData);
+    return obj;
+}
+
 Object *Object::createTypedArray(TypedArrayType type, void *data, size_t byteLength) {
     if (type == TypedArrayType::NONE) {
         SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
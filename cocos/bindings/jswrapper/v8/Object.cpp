@@ -30,6 +30,7 @@
     #include "ScriptEngine.h"
     #include "../MappingUtils.h"
 
+    #include <cstring>
     #include <memory>
     #include <unordered_map>
 
@@ -40,6 +41,63 @@ std::unique_ptr<std::unordered_map<Object *, void *>> __objectMap; // Currently,
 namespace {
 v8::Isolate *__isolate = nullptr;
 uint32_t _nativeObjectId = 0;
+
+// property names used by bindings are a small fixed set ( struct fields, callbacks ),
+// keep them as internalized strings instead of creating a new v8 string for every access.
+// Keys point at the cached copy of the name, so a const char* can be looked up without a temporary string
+const size_t MAX_CACHED_PROPERTY_NAMES = 2048;
+
+struct PropertyName {
+    const char *str;
+    size_t length;
+};
+
+struct PropertyNameHash {
+    size_t operator()(const PropertyName &name) const {
+        // FNV-1a
+        size_t hash = 2166136261U;
+        for (size_t i = 0; i < name.length; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(name.str[i])) * 16777619U;
+        }
+        return hash;
+    }
+};
+
+struct PropertyNameEqual {
+    bool operator()(const PropertyName &a, const PropertyName &b) const {
+        return a.length == b.length && memcmp(a.str, b.str, a.length) == 0;
+    }
+};
+
+struct CachedPropertyName {
+    std::unique_ptr<char[]> storage;
+    v8::Global<v8::String> value;
+};
+
+std::unordered_map<PropertyName, CachedPropertyName, PropertyNameHash, PropertyNameEqual> __propertyNameCache;
+
+v8::MaybeLocal<v8::String> getPropertyName(const char *name, bool isNameCached) {
+    if (!isNameCached) {
+        return v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+    }
+
+    PropertyName key{name, strlen(name)};
+    auto iter = __propertyNameCache.find(key);
+    if (iter != __propertyNameCache.end()) {
+        return iter->second.value.Get(__isolate);
+    }
+
+    v8::MaybeLocal<v8::String> nameValue = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kInternalized, static_cast<int>(key.length));
+    if (!nameValue.IsEmpty() && __propertyNameCache.size() < MAX_CACHED_PROPERTY_NAMES) {
+        CachedPropertyName cached;
+        cached.storage.reset(new char[key.length + 1]);
+        memcpy(cached.storage.get(), name, key.length + 1);
+        cached.value.Reset(__isolate, nameValue.ToLocalChecked());
+        key.str = cached.storage.get();
+        __propertyNameCache.emplace(key, std::move(cached));
+    }
+    return nameValue;
+}
 } // namespace
 
 Object::Object()
@@ -140,6 +198,10 @@ void Object::cleanup() {
     }
 
     __objectMap.reset();
+    for (auto &e : __propertyNameCache) {
+        e.second.value.Reset();
+    }
+    __propertyNameCache.clear();
     __isolate = nullptr;
 }
 
@@ -191,6 +253,13 @@ Object *Object::createArrayBufferObject(void *data, size_t byteLength) {
     return obj;
 }
 
+Object *Object::createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData) {
+    std::shared_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(contents, byteLength, freeFunc, freeUserData);
+    v8::Local<v8::ArrayBuffer> jsobj = v8::ArrayBuffer::New(__isolate, backingStore);
+    Object *obj = Object::_createJSObject(nullptr, jsobj);
+    return obj;
+}
+
 Object *Object::createTypedArray(TypedArrayType type, void *data, size_t byteLength) {
     if (type == TypedArrayType::NONE) {
         SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
@@ -283,7 +352,7 @@ bool Object::init(Class *cls, v8::Local<v8::Object> obj) {
     return true;
 }
 
-bool Object::getProperty(const char *name, Value *data) {
+bool Object::getProperty(const char *name, Value *data, bool isNameCached) {
     assert(data != nullptr);
     data->setUndefined();
 
@@ -293,7 +362,7 @@ bool Object::getProperty(const char *name, Value *data) {
         return false;
     }
 
-    v8::MaybeLocal<v8::String> nameValue = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+    v8::MaybeLocal<v8::String> nameValue = getPropertyName(name, isNameCached);
     if (nameValue.IsEmpty())
         return false;
 
@@ -339,8 +408,8 @@ bool Object::deleteProperty(const char *name) {
     return true;
 }
 
-bool Object::setProperty(const char *name, const Value &data) {
-    v8::MaybeLocal<v8::String> nameValue = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+bool Object::setProperty(const char *name, const Value &data, bool isNameCached) {
+    v8::MaybeLocal<v8::String> nameValue = getPropertyName(name, isNameCached);
     if (nameValue.IsEmpty())
         return false;
 
@@ -536,7 +605,7 @@ bool Object::getArrayLength(uint32_t *length) const {
     assert(length != nullptr);
     Object *thiz = const_cast<Object *>(this);
 
-    v8::MaybeLocal<v8::String> lengthStr = v8::String::NewFromUtf8(__isolate, "length", v8::NewStringType::kNormal);
+    v8::MaybeLocal<v8::String> lengthStr = getPropertyName("length", true);
     if (lengthStr.IsEmpty()) {
         *length = 0;
         return false;
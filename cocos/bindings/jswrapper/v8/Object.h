@@ -107,6 +107,19 @@ public:
          */
     static Object *createArrayBufferObject(void *bytes, size_t byteLength);
 
+    using BufferContentsFreeFunc = void (*)(void *contents, size_t byteLength, void *userData);
+
+    /**
+         *  @brief Creates a JavaScript Array Buffer object which takes ownership of an existing buffer without copying it.
+         *  @param[in] contents A pointer to the byte buffer to be used as the backing store of the Array Buffer object.
+         *  @param[in] byteLength The number of bytes pointed to by the parameter contents.
+         *  @param[in] freeFunc The function to release contents when the Array Buffer object is garbage collected.
+         *  @param[in] freeUserData The user data passed to freeFunc.
+         *  @return A Array Buffer Object whose backing store is contents, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createExternalArrayBufferObject(void *contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void *freeUserData = nullptr);
+
     /**
          *  @brief Creates a JavaScript Object from a JSON formatted string.
          *  @param[in] jsonStr The utf-8 string containing the JSON string to be parsed.
@@ -136,11 +149,14 @@ public:
          *  @param[in] name A utf-8 string containing the property's name.
          *  @param[out] value The property's value if object has the property, otherwise the undefined value.
          *  @return true if object has the property, otherwise false.
+         *  @note The v8 string of a const char* name is cached, pass names built at runtime as std::string.
          */
-    bool getProperty(const char *name, Value *value);
+    inline bool getProperty(const char *name, Value *value) {
+        return getProperty(name, value, true);
+    }
 
     inline bool getProperty(const std::string &name, Value *value) {
-        return getProperty(name.c_str(), value);
+        return getProperty(name.c_str(), value, false);
     }
 
     /**
@@ -148,11 +164,14 @@ public:
          *  @param[in] name A utf-8 string containing the property's name.
          *  @param[in] value A value to be used as the property's value.
          *  @return true if the property is set successfully, otherwise false.
+         *  @note The v8 string of a const char* name is cached, pass names built at runtime as std::string.
          */
-    bool setProperty(const char *name, const Value &value);
+    inline bool setProperty(const char *name, const Value &value) {
+        return setProperty(name, value, true);
+    }
 
     inline bool setProperty(const std::string &name, const Value &value) {
-        return setProperty(name.c_str(), value);
+        return setProperty(name.c_str(), value, false);
     }
 
     /**
@@ -400,6 +419,9 @@ private:
 
     bool init(Class *cls, v8::Local<v8::Object> obj);
 
+    bool getProperty(const char *name, Value *value, bool isNameCached);
+    bool setProperty(const char *name, const Value &value, bool isNameCached);
+
     Class *_cls;
     ObjectWrap _obj;
     uint32_t _rootCount;
@@ -30,6 +30,7 @@
     #include "Class.h"
     #include "Object.h"
     #include "Utils.h"
+    #include "base/ThreadPool.h"
     #include "platform/FileUtils.h"
 
     #include <sstream>
@@ -62,6 +63,19 @@ Class *__jsb_CCPrivateData_class = nullptr;
 namespace {
 ScriptEngine *__instance = nullptr;
 
+const uint32_t CODE_CACHE_MAGIC = 0x43434553; // "SECC"
+const size_t CODE_CACHE_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+
+// FNV-1a
+uint64_t hashCodeCacheSource(const std::string &str) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 void __log(const v8::FunctionCallbackInfo<v8::Value> &info) {
     if (info[0]->IsString()) {
         v8::String::Utf8Value utf8(v8::Isolate::GetCurrent(), info[0]);
@@ -606,6 +620,7 @@ bool ScriptEngine::start() {
     //
     bool ok = false;
     _startTime = std::chrono::steady_clock::now();
+    _codeCacheStats = CodeCacheStats();
 
     for (auto cb : _permRegisterCallbackArray) {
         ok = cb(_globalObj);
@@ -700,7 +715,41 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
         return false;
 
     v8::ScriptOrigin origin(originStr.ToLocalChecked());
-    v8::MaybeLocal<v8::Script> maybeScript = v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+
+    // code cache file layout: magic, source hash, v8 cached data
+    const bool useCodeCache = !_codeCacheDir.empty() && strcmp(fileName, "(no filename)") != 0;
+    const uint64_t sourceHash = useCodeCache ? hashCodeCacheSource(scriptStr) : 0;
+    std::string cachePath;
+    cc::Data cacheFileData;
+    v8::ScriptCompiler::CachedData *cachedData = nullptr; // owned by compileSource
+    if (useCodeCache) {
+        cachePath = getCodeCachePath(sourceUrl);
+        auto fu = cc::FileUtils::getInstance();
+        if (fu->isFileExist(cachePath)) {
+            cacheFileData = fu->getDataFromFile(cachePath);
+        }
+        const uint8_t *bytes = cacheFileData.getBytes();
+        if (cacheFileData.getSize() > CODE_CACHE_HEADER_SIZE && memcmp(bytes, &CODE_CACHE_MAGIC, sizeof(CODE_CACHE_MAGIC)) == 0 && memcmp(bytes + sizeof(CODE_CACHE_MAGIC), &sourceHash, sizeof(sourceHash)) == 0) {
+            cachedData = new v8::ScriptCompiler::CachedData(bytes + CODE_CACHE_HEADER_SIZE, (int)(cacheFileData.getSize() - CODE_CACHE_HEADER_SIZE));
+        }
+    }
+
+    auto compileStart = std::chrono::steady_clock::now();
+    v8::ScriptCompiler::Source compileSource(source.ToLocalChecked(), origin, cachedData);
+    v8::MaybeLocal<v8::Script> maybeScript = v8::ScriptCompiler::Compile(_context.Get(_isolate), &compileSource, cachedData ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kNoCompileOptions);
+    _codeCacheStats.compileMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+
+    bool needUpdateCache = useCodeCache;
+    if (cachedData) {
+        if (compileSource.GetCachedData()->rejected) {
+            ++_codeCacheStats.rejected;
+        } else {
+            ++_codeCacheStats.hit;
+            needUpdateCache = false;
+        }
+    } else if (useCodeCache) {
+        ++_codeCacheStats.miss;
+    }
 
     bool success = false;
 
@@ -720,6 +769,26 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
             success = true;
         }
 
+        // create cache after running, so functions compiled lazily during module initialization are included
+        if (success && needUpdateCache) {
+            v8::ScriptCompiler::CachedData *newCache = v8::ScriptCompiler::CreateCodeCache(v8Script->GetUnboundScript());
+            if (newCache) {
+                auto fileData = std::make_shared<cc::Data>();
+                auto *buffer = static_cast<uint8_t *>(malloc(CODE_CACHE_HEADER_SIZE + newCache->length));
+                memcpy(buffer, &CODE_CACHE_MAGIC, sizeof(CODE_CACHE_MAGIC));
+                memcpy(buffer + sizeof(CODE_CACHE_MAGIC), &sourceHash, sizeof(sourceHash));
+                memcpy(buffer + CODE_CACHE_HEADER_SIZE, newCache->data, newCache->length);
+                fileData->fastSet(buffer, CODE_CACHE_HEADER_SIZE + newCache->length);
+                delete newCache;
+
+                cc::ThreadPool::getDefaultThreadPool()->pushTask([fileData, cachePath](int /*tid*/) {
+                    if (!cc::FileUtils::getInstance()->writeDataToFile(*fileData, cachePath)) {
+                        SE_LOGE("ScriptEngine::evalString write code cache %s failed!\n", cachePath.c_str());
+                    }
+                });
+            }
+        }
+
         if (block.HasCaught()) {
             v8::Local<v8::Message> message = block.Message();
             SE_LOGE("ScriptEngine::evalString catch exception:\n");
@@ -750,6 +819,32 @@ const ScriptEngine::FileOperationDelegate &ScriptEngine::getFileOperationDelegat
     return _fileOperationDelegate;
 }
 
+void ScriptEngine::setCodeCacheDirectory(const std::string &dir) {
+    _codeCacheDir.clear();
+    if (dir.empty()) {
+        return;
+    }
+
+    // cached data can only be consumed by the same V8 version, keep caches of different versions apart
+    std::string versionDir = dir;
+    if (versionDir.back() != '/') {
+        versionDir += '/';
+    }
+    versionDir += v8::V8::GetVersion();
+    versionDir += '/';
+    if (!cc::FileUtils::getInstance()->createDirectory(versionDir)) {
+        SE_LOGE("ScriptEngine::setCodeCacheDirectory failed to create %s\n", versionDir.c_str());
+        return;
+    }
+    _codeCacheDir = versionDir;
+}
+
+std::string ScriptEngine::getCodeCachePath(const std::string &sourceUrl) const {
+    char name[32] = {0};
+    snprintf(name, sizeof(name), "%016llx.jscache", (unsigned long long)hashCodeCacheSource(sourceUrl));
+    return _codeCacheDir + name;
+}
+
 bool ScriptEngine::saveByteCodeToFile(const std::string &path, const std::string &path_bc) {
     bool success = false;
     auto fu = cc::FileUtils::getInstance();
@@ -174,6 +174,25 @@ public:
          */
     bool saveByteCodeToFile(const std::string &scriptPath, const std::string &outputPath);
 
+    /**
+         *  @brief Enables code cache for scripts evaluated with a file name. Cache files are stored per V8 version
+         *         and are regenerated when the script source changes or the cache is rejected.
+         *  @param[in] dir The directory where cache files are written to, pass an empty string to disable code cache.
+         */
+    void setCodeCacheDirectory(const std::string &dir);
+
+    struct CodeCacheStats {
+        uint32_t hit = 0;
+        uint32_t miss = 0;
+        uint32_t rejected = 0;
+        double compileMs = 0.0; // time spent compiling scripts, with or without cache
+    };
+
+    /**
+         *  @brief Gets code cache statistics since script engine started.
+         */
+    const CodeCacheStats &getCodeCacheStats() const { return _codeCacheStats; }
+
     /**
          * @brief Grab a snapshot of the current JavaScript execution stack.
          * @return current stack trace string
@@ -323,6 +342,7 @@ private:
          */
     bool runByteCodeFile(const std::string &path_bc, Value *ret /* = nullptr */);
     void callExceptionCallback(const char *, const char *, const char *);
+    std::string getCodeCachePath(const std::string &sourceUrl) const;
 
     std::chrono::steady_clock::time_point _startTime;
     std::vector<RegisterCallback> _registerCallbackArray;
@@ -341,6 +361,8 @@ private:
     Object *_gcFunc = nullptr;
 
     FileOperationDelegate _fileOperationDelegate;
+    std::string _codeCacheDir;
+    CodeCacheStats _codeCacheStats;
     ExceptionCallback _nativeExceptionCallback = nullptr;
     ExceptionCallback _jsExceptionCallback = nullptr;
 
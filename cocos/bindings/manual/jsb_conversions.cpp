@@ -349,6 +349,21 @@ bool seval_to_Uint8Array(const se::Value &v, uint8_t *ret) {
     return true;
 }
 
+bool seval_to_buffer_data(const se::Value &v, uint8_t **ptr, size_t *length) {
+    assert(ptr != nullptr && length != nullptr);
+    *ptr = nullptr;
+    *length = 0;
+    SE_PRECONDITION2(v.isObject(), false, "Convert parameter to buffer failed!");
+    se::Object *obj = v.toObject();
+    if (obj->isArrayBuffer()) {
+        return obj->getArrayBufferData(ptr, length);
+    }
+    if (obj->isTypedArray()) {
+        return obj->getTypedArrayData(ptr, length);
+    }
+    return false;
+}
+
 bool seval_to_uintptr_t(const se::Value &v, uintptr_t *ret) {
     assert(ret != nullptr);
     if (v.isNumber()) {
@@ -430,7 +445,7 @@ bool seval_to_ccvaluemap(const se::Value &v, cc::ValueMap *ret) {
     se::Value value;
     cc::Value ccvalue;
     for (const auto &key : allKeys) {
-        SE_PRECONDITION3(obj->getProperty(key.c_str(), &value), false, ret->clear());
+        SE_PRECONDITION3(obj->getProperty(key, &value), false, ret->clear());
         ok = seval_to_ccvalue(value, &ccvalue);
         SE_PRECONDITION3(ok, false, ret->clear());
         dict.emplace(key, ccvalue);
@@ -468,7 +483,7 @@ bool seval_to_ccvaluemapintkey(const se::Value &v, cc::ValueMapIntKey *ret) {
     se::Value value;
     cc::Value ccvalue;
     for (const auto &key : allKeys) {
-        SE_PRECONDITION3(obj->getProperty(key.c_str(), &value), false, ret->clear());
+        SE_PRECONDITION3(obj->getProperty(key, &value), false, ret->clear());
 
         if (!isNumberString(key)) {
             SE_LOGD("seval_to_ccvaluemapintkey, found not numeric key: %s", key.c_str());
@@ -655,9 +670,13 @@ bool seval_to_std_vector_float(const se::Value &v, std::vector<float> *ret) {
     assert(ret != nullptr);
     SE_PRECONDITION2(v.isObject(), false, "Convert parameter to vector of float failed!");
     se::Object *obj = v.toObject();
+    if (typedarray_to_vector(obj, ret, std::true_type{})) {
+        return true;
+    }
     SE_PRECONDITION2(obj->isArray(), false, "Convert parameter to vector of float failed!");
     uint32_t len = 0;
     if (obj->getArrayLength(&len)) {
+        ret->reserve(len);
         se::Value value;
         for (uint32_t i = 0; i < len; ++i) {
             SE_PRECONDITION3(obj->getArrayElement(i, &value) && value.isNumber(), false, ret->clear());
@@ -710,7 +729,7 @@ bool seval_to_std_map_string_string(const se::Value &v, std::map<std::string, st
     se::Value value;
     std::string strValue;
     for (const auto &key : allKeys) {
-        SE_PRECONDITION3(obj->getProperty(key.c_str(), &value), false, ret->clear());
+        SE_PRECONDITION3(obj->getProperty(key, &value), false, ret->clear());
         ok = seval_to_std_string(value, &strValue);
         SE_PRECONDITION3(ok, false, ret->clear());
         ret->emplace(key, strValue);
@@ -961,7 +980,7 @@ bool ccvaluemap_to_seval(const cc::ValueMap &v, se::Value *ret) {
             break;
         }
 
-        obj->setProperty(key.c_str(), tmp);
+        obj->setProperty(key, tmp);
     }
     if (ok)
         ret->setObject(obj);
@@ -990,7 +1009,7 @@ bool ccvaluemapintkey_to_seval(const cc::ValueMapIntKey &v, se::Value *ret) {
             break;
         }
 
-        obj->setProperty(key.c_str(), tmp);
+        obj->setProperty(key, tmp);
     }
     if (ok)
         ret->setObject(obj);
@@ -1082,7 +1101,7 @@ bool std_map_string_string_to_seval(const std::map<std::string, std::string> &v,
             break;
         }
 
-        obj->setProperty(key.c_str(), tmp);
+        obj->setProperty(key, tmp);
     }
 
     if (ok)
@@ -1324,7 +1343,7 @@ bool seval_to_Map_string_key(const se::Value &v, cc::Map<std::string, cc::middle
         auto pngPos = key.find(".png");
         if (pngPos == key.npos) continue;
 
-        ok = obj->getProperty(key.c_str(), &tmp);
+        ok = obj->getProperty(key, &tmp);
         if (!ok || !tmp.isObject()) {
             ret->clear();
             return false;
@@ -187,6 +187,8 @@ bool seval_to_std_vector_uint16(const se::Value &v, std::vector<uint16_t> *ret);
 bool seval_to_std_vector_float(const se::Value &v, std::vector<float> *ret);
 bool seval_to_std_vector_Vec2(const se::Value &v, std::vector<cc::Vec2> *ret);
 bool seval_to_Uint8Array(const se::Value &v, uint8_t *ret);
+// get the backing store of an ArrayBuffer or a TypedArray without copying
+bool seval_to_buffer_data(const se::Value &v, uint8_t **ptr, size_t *length);
 bool seval_to_uintptr_t(const se::Value &v, uintptr_t *ret);
 
 bool seval_to_std_map_string_string(const se::Value &v, std::map<std::string, std::string> *ret);
@@ -395,7 +397,7 @@ bool seval_to_Map_string_key(const se::Value &v, cc::Map<std::string, T> *ret) {
 
     se::Value tmp;
     for (const auto &key : allKeys) {
-        ok = obj->getProperty(key.c_str(), &tmp);
+        ok = obj->getProperty(key, &tmp);
         if (!ok || !tmp.isObject()) {
             ret->clear();
             return false;
@@ -1027,10 +1029,57 @@ sevalue_to_native(const se::Value &from, T ***to, se::Object *) {
     return true;
 }
 
+template <typename T>
+struct typedarray_type_of : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::NONE> {};
+template <>
+struct typedarray_type_of<int8_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::INT8> {};
+template <>
+struct typedarray_type_of<int16_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::INT16> {};
+template <>
+struct typedarray_type_of<int32_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::INT32> {};
+template <>
+struct typedarray_type_of<uint8_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::UINT8> {};
+template <>
+struct typedarray_type_of<uint16_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::UINT16> {};
+template <>
+struct typedarray_type_of<uint32_t> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::UINT32> {};
+template <>
+struct typedarray_type_of<float> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::FLOAT32> {};
+template <>
+struct typedarray_type_of<double> : std::integral_constant<se::Object::TypedArrayType, se::Object::TypedArrayType::FLOAT64> {};
+
+// not zero-copy: std::vector owns its elements, so a typed array with the same element layout is
+// copied with one memcpy instead of element by element. Bindings that only read the data should
+// take the backing store through seval_to_buffer_data instead
+template <typename T, typename allocator>
+bool typedarray_to_vector(se::Object *array, std::vector<T, allocator> *to, std::true_type) {
+    if (!array->isTypedArray() || array->getTypedArrayType() != typedarray_type_of<T>::value) {
+        return false;
+    }
+    uint8_t *data = nullptr;
+    size_t byteLength = 0;
+    if (!array->getTypedArrayData(&data, &byteLength)) {
+        return false;
+    }
+    to->resize(byteLength / sizeof(T));
+    if (!to->empty()) {
+        memcpy(to->data(), data, to->size() * sizeof(T));
+    }
+    return true;
+}
+
+template <typename T, typename allocator>
+bool typedarray_to_vector(se::Object *, std::vector<T, allocator> *, std::false_type) {
+    return false;
+}
+
 template <typename T, typename allocator>
 bool sevalue_to_native(const se::Value &from, std::vector<T, allocator> *to, se::Object *ctx) {
     assert(from.toObject());
     se::Object *array = from.toObject();
+    if (typedarray_to_vector(array, to, std::integral_constant<bool, typedarray_type_of<T>::value != se::Object::TypedArrayType::NONE>{})) {
+        return true;
+    }
     assert(array->isArray());
     uint32_t len = 0;
     array->getArrayLength(&len);
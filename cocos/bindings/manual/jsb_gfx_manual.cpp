@@ -29,6 +29,7 @@
 #endif
 
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 #define GFX_MAX_VERTEX_ATTRIBUTES 16
@@ -38,6 +39,36 @@
 #define GFX_INVALID_BINDING       ((uint8_t)-1)
 #define GFX_INVALID_HANDLE        ((uint)-1)
 
+// Keeps a js function rooted for as long as any copy of the upload callback exists,
+// so callbacks dropped without being called (e.g. on device destruction) release it too
+struct JSUploadCallbackHolder {
+    explicit JSUploadCallbackHolder(se::Object *obj)
+    : funcObj(obj) {
+        funcObj->root();
+        funcObj->incRef();
+    }
+    ~JSUploadCallbackHolder() {
+        if (!se::ScriptEngine::getInstance()->isValid()) return;
+        funcObj->unroot();
+        funcObj->decRef();
+    }
+    se::Object *funcObj = nullptr;
+};
+
+// Wraps an optional js function, it is kept alive until the upload has finished
+static cc::gfx::UploadCallback js_gfx_makeUploadCallback(const se::Value &jsFunc) {
+    if (!jsFunc.isObject() || !jsFunc.toObject()->isFunction()) return nullptr;
+
+    auto holder = std::make_shared<JSUploadCallbackHolder>(jsFunc.toObject());
+    return [holder]() {
+        se::ScriptEngine::getInstance()->clearException();
+        se::AutoHandleScope hs;
+        if (!holder->funcObj->call(se::EmptyValueArray, nullptr)) {
+            se::ScriptEngine::getInstance()->clearException();
+        }
+    };
+}
+
 bool js_gfx_Device_copyBuffersToTexture(se::State &s) {
     cc::gfx::Device *cobj = (cc::gfx::Device *)s.nativeThisObject();
     SE_PRECONDITION2(cobj, false, "js_gfx_Device_copyBuffersToTexture : Invalid Native Object");
@@ -62,16 +93,8 @@ bool js_gfx_Device_copyBuffersToTexture(se::State &s) {
                     uint8_t *ptr = nullptr;
                     CC_UNUSED size_t dataLength = 0;
                     if (value.isObject()) {
-                        se::Object *obj = value.toObject();
-                        if (obj->isArrayBuffer()) {
-                            ok = obj->getArrayBufferData(&ptr, &dataLength);
-                            SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
-                        } else if (obj->isTypedArray()) {
-                            ok = obj->getTypedArrayData(&ptr, &dataLength);
-                            SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
-                        } else {
-                            assert(false);
-                        }
+                        ok = seval_to_buffer_data(value, &ptr, &dataLength);
+                        SE_PRECONDITION2(ok, false, "getBufferData failed!");
                     } else {
                         unsigned long address = 0;
                         seval_to_ulong(value, &address);
@@ -101,7 +124,9 @@ bool js_gfx_Device_copyTexImagesToTexture(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
-    if (argc == 3) {
+    // the optional callback uploads asynchronously where the backend supports it,
+    // the texture must not be sampled before the callback has run
+    if (argc == 3 || argc == 4) {
         cc::gfx::BufferDataList arg0;
         cc::gfx::Texture *arg1 = nullptr;
         cc::gfx::BufferTextureCopyList arg2;
@@ -133,7 +158,12 @@ bool js_gfx_Device_copyTexImagesToTexture(se::State &s) {
         ok &= seval_to_native_ptr(args[1], &arg1);
         ok &= sevalue_to_native(args[2], &arg2, s.thisObject());
         SE_PRECONDITION2(ok, false, "js_gfx_Device_copyBuffersToTexture : Error processing arguments");
-        cobj->copyBuffersToTexture(arg0, arg1, arg2);
+        cc::gfx::UploadCallback callback = argc == 4 ? js_gfx_makeUploadCallback(args[3]) : nullptr;
+        if (callback) {
+            cobj->copyBuffersToTextureAsync(arg0, arg1, arg2, callback);
+        } else {
+            cobj->copyBuffersToTexture(arg0, arg1, arg2);
+        }
         return true;
     }
     SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
@@ -271,16 +301,7 @@ static bool js_gfx_GFXBuffer_update(se::State &s) {
 
     uint8_t *arg0 = nullptr;
     CC_UNUSED size_t dataLength = 0;
-    se::Object *obj = args[0].toObject();
-    if (obj->isArrayBuffer()) {
-        ok = obj->getArrayBufferData(&arg0, &dataLength);
-        SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
-    } else if (obj->isTypedArray()) {
-        ok = obj->getTypedArrayData(&arg0, &dataLength);
-        SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
-    } else {
-        ok = false;
-    }
+    ok = seval_to_buffer_data(args[0], &arg0, &dataLength);
 
     if (argc == 1) {
         SE_PRECONDITION2(ok, false, "js_gfx_GFXBuffer_update : Error processing arguments");
@@ -299,6 +320,27 @@ static bool js_gfx_GFXBuffer_update(se::State &s) {
 }
 SE_BIND_FUNC(js_gfx_GFXBuffer_update)
 
+static bool js_gfx_Device_updateBufferAsync(se::State &s) {
+    cc::gfx::Device *cobj = (cc::gfx::Device *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_gfx_Device_updateBufferAsync : Invalid Native Object");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 3) {
+        cc::gfx::Buffer *arg0 = nullptr;
+        uint8_t *arg1 = nullptr;
+        CC_UNUSED size_t dataLength = 0;
+        ok &= seval_to_native_ptr(args[0], &arg0);
+        ok &= seval_to_buffer_data(args[1], &arg1, &dataLength);
+        SE_PRECONDITION2(ok && arg0, false, "js_gfx_Device_updateBufferAsync : Error processing arguments");
+        cobj->updateBufferAsync(arg0, arg1, static_cast<uint>(dataLength), js_gfx_makeUploadCallback(args[2]));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+    return false;
+}
+SE_BIND_FUNC(js_gfx_Device_updateBufferAsync)
+
 static bool js_gfx_CommandBuffer_execute(se::State &s) {
     cc::gfx::CommandBuffer *cobj = (cc::gfx::CommandBuffer *)s.nativeThisObject();
     SE_PRECONDITION2(cobj, false, "js_gfx_CommandBuffer_execute : Invalid Native Object");
@@ -356,16 +398,7 @@ static bool js_gfx_CommandBuffer_updateBuffer(se::State &s) {
 
     uint8_t *arg1 = nullptr;
     CC_UNUSED size_t dataLength = 0;
-    se::Object *obj = args[1].toObject();
-    if (obj->isArrayBuffer()) {
-        ok = obj->getArrayBufferData(&arg1, &dataLength);
-        SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
-    } else if (obj->isTypedArray()) {
-        ok = obj->getTypedArrayData(&arg1, &dataLength);
-        SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
-    } else {
-        ok = false;
-    }
+    ok = seval_to_buffer_data(args[1], &arg1, &dataLength);
 
     if (argc == 2) {
         SE_PRECONDITION2(ok, false, "js_gfx_CommandBuffer_updateBuffer : Error processing arguments");
@@ -401,16 +434,8 @@ static bool js_gfx_CommandBuffer_copyBuffersToTexture(se::State &s) {
                 if (dataObj->getArrayElement(i, &value)) {
                     uint8_t *ptr = nullptr;
                     CC_UNUSED size_t dataLength = 0;
-                    se::Object *obj = value.toObject();
-                    if (obj->isArrayBuffer()) {
-                        ok = obj->getArrayBufferData(&ptr, &dataLength);
-                        SE_PRECONDITION2(ok, false, "getArrayBufferData failed!");
-                    } else if (obj->isTypedArray()) {
-                        ok = obj->getTypedArrayData(&ptr, &dataLength);
-                        SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
-                    } else {
-                        assert(false);
-                    }
+                    ok = seval_to_buffer_data(value, &ptr, &dataLength);
+                    SE_PRECONDITION2(ok, false, "getBufferData failed!");
                     arg0[i] = ptr;
                 }
             }
@@ -467,6 +492,7 @@ SE_BIND_FUNC(js_gfx_InputAssembler_extractDrawInfo)
 bool register_all_gfx_manual(se::Object *obj) {
     __jsb_cc_gfx_Device_proto->defineFunction("copyBuffersToTexture", _SE(js_gfx_Device_copyBuffersToTexture));
     __jsb_cc_gfx_Device_proto->defineFunction("copyTexImagesToTexture", _SE(js_gfx_Device_copyTexImagesToTexture));
+    __jsb_cc_gfx_Device_proto->defineFunction("updateBufferAsync", _SE(js_gfx_Device_updateBufferAsync));
 
     __jsb_cc_gfx_Device_proto->defineFunction("createBuffer", _SE(js_gfx_Device_createBuffer));
     __jsb_cc_gfx_Device_proto->defineFunction("createTexture", _SE(js_gfx_Device_createTexture));
@@ -27,8 +27,9 @@
 #include "xxtea/xxtea.h"
 #include "base/ZipUtils.h"
 #include "base/Scheduler.h"
-#include "base/ThreadPool.h"
+#include "base/LoadScheduler.h"
 #include "base/base64.h"
+#include "base/memory/AllocProfiler.h"
 #include "network/HttpClient.h"
 #include "platform/Application.h"
 #include "platform/Image.h"
@@ -48,7 +49,6 @@ using namespace cc;
 se::Object *__jsbObj = nullptr;
 se::Object *__glObj = nullptr;
 
-static ThreadPool *__threadPool = nullptr;
 
 static std::shared_ptr<cc::network::Downloader> _localDownloader = nullptr;
 static std::map<std::string, std::function<void(const std::string &, unsigned char *, uint)>> _localDownloaderHandlers;
@@ -63,30 +63,36 @@ static cc::network::Downloader *localDownloader() {
         _localDownloader = std::make_shared<cc::network::Downloader>();
         _localDownloader->onDataTaskSuccess = [=](const cc::network::DownloadTask &task,
                                                   const std::vector<unsigned char> &data) {
-            if (data.empty()) {
-                SE_REPORT_ERROR("Getting image from (%s) failed!", task.requestURL.c_str());
-                return;
-            }
-
             auto callback = _localDownloaderHandlers.find(task.identifier);
             if (callback == _localDownloaderHandlers.end()) {
                 SE_REPORT_ERROR("Getting image from (%s), callback not found!!", task.requestURL.c_str());
                 return;
             }
+            auto handler = std::move(callback->second);
+            _localDownloaderHandlers.erase(callback);
+
+            if (data.empty()) {
+                SE_REPORT_ERROR("Getting image from (%s) failed!", task.requestURL.c_str());
+                handler("", nullptr, 0);
+                return;
+            }
             size_t imageBytes = data.size();
             unsigned char *imageData = (unsigned char *)malloc(imageBytes);
             memcpy(imageData, data.data(), imageBytes);
 
-            (callback->second)("", imageData, static_cast<uint>(imageBytes));
-            //initImageFunc("", imageData, imageBytes);
-            _localDownloaderHandlers.erase(callback);
+            handler("", imageData, static_cast<uint>(imageBytes));
         };
         _localDownloader->onTaskError = [=](const cc::network::DownloadTask &task,
                                             int errorCode,
                                             int errorCodeInternal,
                                             const std::string &errorStr) {
             SE_REPORT_ERROR("Getting image from (%s) failed!", task.requestURL.c_str());
-            _localDownloaderHandlers.erase(task.identifier);
+            auto callback = _localDownloaderHandlers.find(task.identifier);
+            if (callback != _localDownloaderHandlers.end()) {
+                auto handler = std::move(callback->second);
+                _localDownloaderHandlers.erase(callback);
+                handler("", nullptr, 0);
+            }
         };
     }
     return _localDownloader.get();
@@ -214,6 +220,9 @@ void jsb_init_file_operation_delegate() {
         assert(delegate.isValid());
 
         se::ScriptEngine::getInstance()->setFileOperationDelegate(delegate);
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8 && SE_ENABLE_CODE_CACHE
+        se::ScriptEngine::getInstance()->setCodeCacheDirectory(FileUtils::getInstance()->getWritablePath() + "jscache/");
+#endif
     }
 }
 
@@ -642,39 +651,6 @@ struct ImageInfo {
     bool compressed = false;
 };
 
-uint8_t *convertRGB2RGBA(uint32_t length, uint8_t *src) {
-    uint8_t *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src++;
-        dst[i + 1] = *src++;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
-uint8_t *convertIA2RGBA(uint32_t length, uint8_t *src) {
-    uint8_t *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = *src++;
-    }
-    return dst;
-}
-
-uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
-    uint8_t *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
 struct ImageInfo *createImageInfo(Image *img) {
     struct ImageInfo *imgInfo = new struct ImageInfo();
     imgInfo->length = (uint32_t)img->getDataLen();
@@ -683,45 +659,13 @@ struct ImageInfo *createImageInfo(Image *img) {
     img->takeData(&imgInfo->data);
     imgInfo->format = img->getRenderFormat();
     imgInfo->compressed = img->isCompressed();
-
-    // Convert to RGBA888 because standard web api will return only RGBA888.
-    // If not, then it may have issue in glTexSubImage. For example, engine
-    // will create a big texture, and update its content with small pictures.
-    // The big texture is RGBA888, then the small picture should be the same
-    // format, or it will cause 0x502 error on OpenGL ES 2.
-    if (!imgInfo->compressed && imgInfo->format != cc::gfx::Format::RGBA8) {
-        imgInfo->length = img->getWidth() * img->getHeight() * 4;
-        uint8_t *dst = nullptr;
-        uint32_t length = imgInfo->length;
-        uint8_t *src = imgInfo->data;
-        switch (imgInfo->format) {
-            case cc::gfx::Format::A8:
-            case cc::gfx::Format::LA8:
-                dst = convertIA2RGBA(length, src);
-                break;
-            case cc::gfx::Format::L8:
-            case cc::gfx::Format::R8:
-            case cc::gfx::Format::R8I:
-                dst = convertI2RGBA(length, src);
-                break;
-            case cc::gfx::Format::RGB8:
-                dst = convertRGB2RGBA(length, src);
-                break;
-            default:
-                SE_LOGE("unknown image format");
-                break;
-        }
-
-        if (dst != imgInfo->data) free(imgInfo->data);
-        imgInfo->data = dst;
-        imgInfo->hasAlpha = true;
-    }
+    imgInfo->hasAlpha = !imgInfo->compressed && imgInfo->format == cc::gfx::Format::RGBA8;
 
     return imgInfo;
 }
 } // namespace
 
-bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal) {
+bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal, int priority, uint32_t *requestId) {
     if (path.empty()) {
         se::ValueArray seArgs;
         callbackVal.toObject()->call(seArgs, nullptr);
@@ -729,35 +673,48 @@ bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal
     }
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
+    // canceled loads don't call back, the caller knows it has given up on them
+    auto *scheduler = LoadScheduler::getInstance();
+    LoadScheduler::RequestId id = scheduler->createRequest(priority);
+    if (requestId) {
+        *requestId = id;
+    }
 
-    auto initImageFunc = [path, callbackPtr](const std::string &fullPath, unsigned char *imageData, int imageBytes) {
-        Image *img = new (std::nothrow) Image();
-
-        __threadPool->pushTask([=](int tid) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
+    // image data is owned by the jobs, so it is freed when a canceled request drops them
+    auto decodeFunc = [path, callbackPtr, id](const std::shared_ptr<unsigned char> &imageData, int imageBytes) {
+        LoadScheduler::getInstance()->submit(id, LoadScheduler::Stage::DECODE, [=]() {
             // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
-            } else {
-                loadSucceed = img->initWithImageFile(fullPath);
-            }
-
             struct ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
+            if (imageData && LoadScheduler::getInstance()->isAlive(id)) {
+                Image *img = new (std::nothrow) Image();
+                // Decode to RGBA888 because standard web api will return only RGBA888.
+                // If not, then it may have issue in glTexSubImage. For example, engine
+                // will create a big texture, and update its content with small pictures.
+                // The big texture is RGBA888, then the small picture should be the same
+                // format, or it will cause 0x502 error on OpenGL ES 2.
+                img->setForceRGBA8(true);
+                if (img->initWithImageData(imageData.get(), imageBytes)) {
+                    imgInfo = createImageInfo(img);
+                }
+                img->release();
             }
 
             Application::getInstance()->getScheduler()->performFunctionInCocosThread([=]() {
+                auto *scheduler = LoadScheduler::getInstance();
+                if (!scheduler->isAlive(id)) {
+                    if (imgInfo) {
+                        free(imgInfo->data);
+                        delete imgInfo;
+                    }
+                    return;
+                }
+                scheduler->finish(id);
+
                 se::AutoHandleScope hs;
                 se::ValueArray seArgs;
                 se::Value dataVal;
 
-                if (loadSucceed) {
+                if (imgInfo) {
                     se::HandleObject retObj(se::Object::createPlainObject());
                     ulong_to_seval((unsigned long)imgInfo->data, &dataVal);
                     retObj->setProperty("data", dataVal);
@@ -771,14 +728,25 @@ bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal
                     SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
                 }
                 callbackPtr->toObject()->call(seArgs, nullptr);
-                img->release();
             });
         });
     };
+
     size_t pos = std::string::npos;
     if (path.find("http://") == 0 || path.find("https://") == 0) {
-        localDownloaderCreateTask(path, initImageFunc);
-
+        scheduler->submitAsync(id, LoadScheduler::Stage::NETWORK, [path, id, decodeFunc](const std::function<void()> &done) {
+            // downloader has to be used in cocos thread
+            Application::getInstance()->getScheduler()->performFunctionInCocosThread([=]() {
+                if (!LoadScheduler::getInstance()->isAlive(id)) {
+                    done();
+                    return;
+                }
+                localDownloaderCreateTask(path, [=](const std::string & /*fullPath*/, unsigned char *imageData, int imageBytes) {
+                    done();
+                    decodeFunc(std::shared_ptr<unsigned char>(imageData, free), imageBytes);
+                });
+            });
+        });
     } else if (path.find("data:") == 0 && (pos = path.find("base64,")) != std::string::npos) {
         int imageBytes = 0;
         unsigned char *imageData = nullptr;
@@ -788,19 +756,25 @@ bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal
         imageBytes = base64Decode((const unsigned char *)base64Data, (unsigned int)dataLen, &imageData);
         if (imageBytes <= 0 || imageData == nullptr) {
             SE_REPORT_ERROR("Decode base64 image data failed!");
+            scheduler->finish(id);
             return false;
         }
-        initImageFunc("", imageData, imageBytes);
+        decodeFunc(std::shared_ptr<unsigned char>(imageData, free), imageBytes);
     } else {
-        std::string fullPath(FileUtils::getInstance()->fullPathForFilename(path));
-        if (0 == path.find("file://"))
-            fullPath = FileUtils::getInstance()->fullPathForFilename(path.substr(strlen("file://")));
-
-        if (fullPath.empty()) {
-            SE_REPORT_ERROR("File (%s) doesn't exist!", path.c_str());
-            return false;
-        }
-        initImageFunc(fullPath, nullptr, 0);
+        // path resolution is thread safe, the stats it may need are done on the io thread
+        scheduler->submit(id, LoadScheduler::Stage::IO, [path, decodeFunc]() {
+            auto *fileUtils = FileUtils::getInstance();
+            std::string fullPath = fileUtils->fullPathForFilename(0 == path.find("file://") ? path.substr(strlen("file://")) : path);
+            if (fullPath.empty()) {
+                SE_REPORT_ERROR("File (%s) doesn't exist!", path.c_str());
+                decodeFunc(nullptr, 0);
+                return;
+            }
+            Data data = fileUtils->getDataFromFile(fullPath);
+            ssize_t imageBytes = 0;
+            unsigned char *imageData = data.takeBuffer(&imageBytes);
+            decodeFunc(std::shared_ptr<unsigned char>(imageData, free), static_cast<int>(imageBytes));
+        });
     }
     return true;
 }
@@ -809,7 +783,7 @@ static bool js_loadImage(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
     CC_UNUSED bool ok = true;
-    if (argc == 2) {
+    if (argc == 2 || argc == 3) {
         std::string path;
         ok &= seval_to_std_string(args[0], &path);
         SE_PRECONDITION2(ok, false, "js_loadImage : Error processing arguments");
@@ -818,9 +792,18 @@ static bool js_loadImage(se::State &s) {
         assert(callbackVal.isObject());
         assert(callbackVal.toObject()->isFunction());
 
-        return jsb_global_load_image(path, callbackVal);
+        int32_t priority = 0;
+        if (argc == 3) {
+            ok &= seval_to_int32(args[2], &priority);
+            SE_PRECONDITION2(ok, false, "js_loadImage : Error processing arguments");
+        }
+
+        uint32_t requestId = LoadScheduler::INVALID_REQUEST;
+        bool ret = jsb_global_load_image(path, callbackVal, priority, &requestId);
+        s.rval().setUint32(requestId);
+        return ret;
     }
-    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d or %d", (int)argc, 2, 3);
     return false;
 }
 SE_BIND_FUNC(js_loadImage)
@@ -842,6 +825,87 @@ static bool js_destroyImage(se::State &s) {
 }
 SE_BIND_FUNC(js_destroyImage)
 
+static bool js_setLoadPriority(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        uint32_t requestId = 0;
+        int32_t priority = 0;
+        ok &= seval_to_uint32(args[0], &requestId);
+        ok &= seval_to_int32(args[1], &priority);
+        SE_PRECONDITION2(ok, false, "js_setLoadPriority : Error processing arguments");
+        LoadScheduler::getInstance()->setPriority(requestId, priority);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_setLoadPriority)
+
+static bool js_cancelLoad(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 0) {
+        LoadScheduler::getInstance()->cancelAll();
+        return true;
+    }
+    if (argc == 1) {
+        uint32_t requestId = 0;
+        ok &= seval_to_uint32(args[0], &requestId);
+        SE_PRECONDITION2(ok, false, "js_cancelLoad : Error processing arguments");
+        LoadScheduler::getInstance()->cancel(requestId);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d or %d", (int)argc, 0, 1);
+    return false;
+}
+SE_BIND_FUNC(js_cancelLoad)
+
+static bool js_setLoadConcurrency(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        int32_t stage = 0;
+        int32_t count = 0;
+        ok &= seval_to_int32(args[0], &stage);
+        ok &= seval_to_int32(args[1], &count);
+        SE_PRECONDITION2(ok, false, "js_setLoadConcurrency : Error processing arguments");
+        SE_PRECONDITION2(stage >= 0 && stage < static_cast<int32_t>(LoadScheduler::Stage::COUNT), false, "js_setLoadConcurrency : Invalid stage");
+        LoadScheduler::getInstance()->setConcurrency(static_cast<LoadScheduler::Stage>(stage), count);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_setLoadConcurrency)
+
+static bool js_startAllocProfiler(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc >= 1) {
+        std::string path;
+        uint32_t sampleInterval = 512 * 1024;
+        ok &= seval_to_std_string(args[0], &path);
+        if (argc >= 2) ok &= seval_to_uint32(args[1], &sampleInterval);
+        SE_PRECONDITION2(ok, false, "js_startAllocProfiler : Error processing arguments");
+        s.rval().setBoolean(AllocProfiler::start(path, sampleInterval));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting >= %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_startAllocProfiler)
+
+static bool js_stopAllocProfiler(se::State &s) {
+    AllocProfiler::stop();
+    return true;
+}
+SE_BIND_FUNC(js_stopAllocProfiler)
+
 static bool JSB_openURL(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
@@ -978,8 +1042,6 @@ SE_BIND_FUNC(JSB_hideInputBox)
 #endif
 
 bool jsb_register_global_variables(se::Object *global) {
-    __threadPool = ThreadPool::newFixedThreadPool(3);
-
     global->defineFunction("require", _SE(require));
     global->defineFunction("requireModule", _SE(moduleRequire));
 
@@ -996,6 +1058,11 @@ bool jsb_register_global_variables(se::Object *global) {
     __jsbObj->defineFunction("copyTextToClipboard", _SE(JSB_copyTextToClipboard));
     __jsbObj->defineFunction("setPreferredFramesPerSecond", _SE(JSB_setPreferredFramesPerSecond));
     __jsbObj->defineFunction("destroyImage", _SE(js_destroyImage));
+    __jsbObj->defineFunction("setLoadPriority", _SE(js_setLoadPriority));
+    __jsbObj->defineFunction("cancelLoad", _SE(js_cancelLoad));
+    __jsbObj->defineFunction("setLoadConcurrency", _SE(js_setLoadConcurrency));
+    __jsbObj->defineFunction("startAllocProfiler", _SE(js_startAllocProfiler));
+    __jsbObj->defineFunction("stopAllocProfiler", _SE(js_stopAllocProfiler));
 #if CC_USE_EDITBOX
     __jsbObj->defineFunction("showInputBox", _SE(JSB_showInputBox));
     __jsbObj->defineFunction("hideInputBox", _SE(JSB_hideInputBox));
@@ -1017,8 +1084,8 @@ bool jsb_register_global_variables(se::Object *global) {
     se::ScriptEngine::getInstance()->clearException();
 
     se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
-        delete __threadPool;
-        __threadPool = nullptr;
+        // loads of the old VM are useless after restarting
+        LoadScheduler::getInstance()->cancelAll();
 
         PoolManager::getInstance()->getCurrentPool()->clear();
     });
@@ -81,4 +81,5 @@ bool jsb_run_script_module(const std::string &filePath, se::Value *rval = nullpt
 
 void jsb_set_xxtea_key(const std::string &key);
 
-bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal);
+// Loads an image through LoadScheduler, requestId could be used to reprioritize or cancel the load
+bool jsb_global_load_image(const std::string &path, const se::Value &callbackVal, int priority = 0, uint32_t *requestId = nullptr);
@@ -5,8 +5,10 @@
 #include "cocos/bindings/manual/jsb_global.h"
 #include "renderer/core/gfx/GFXPipelineState.h"
 #include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/PipelineProfiler.h"
 #include "renderer/pipeline/PipelineStateManager.h"
 #include "renderer/pipeline/RenderPipeline.h"
+#include "renderer/pipeline/forward/ForwardPipeline.h"
 
 static bool js_pipeline_RenderPipeline_getMacros(se::State &s) {
     cc::pipeline::RenderPipeline *cobj = (cc::pipeline::RenderPipeline *)s.nativeThisObject();
@@ -24,6 +26,92 @@ static bool js_pipeline_RenderPipeline_getMacros(se::State &s) {
 }
 SE_BIND_PROP_GET(js_pipeline_RenderPipeline_getMacros)
 
+static bool js_pipeline_ForwardPipeline_setGPUInstanceCulling(se::State &s) {
+    cc::pipeline::ForwardPipeline *cobj = (cc::pipeline::ForwardPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardPipeline_setGPUInstanceCulling : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        cobj->setGPUInstanceCulling(args[0].toBoolean());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardPipeline_setGPUInstanceCulling)
+
+static bool js_pipeline_ForwardPipeline_setOcclusionCulling(se::State &s) {
+    cc::pipeline::ForwardPipeline *cobj = (cc::pipeline::ForwardPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardPipeline_setOcclusionCulling : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        cobj->setOcclusionCulling(args[0].toBoolean());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardPipeline_setOcclusionCulling)
+
+static bool js_pipeline_ForwardPipeline_setOccluder(se::State &s) {
+    cc::pipeline::ForwardPipeline *cobj = (cc::pipeline::ForwardPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardPipeline_setOccluder : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 3) {
+        uint32_t modelID = 0;
+        cc::vector<float> positions;
+        cc::vector<uint> indices;
+        ok &= seval_to_uint32(args[0], &modelID);
+        ok &= args[1].isObject() && sevalue_to_native(args[1], &positions, s.thisObject());
+        ok &= args[2].isObject() && sevalue_to_native(args[2], &indices, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_pipeline_ForwardPipeline_setOccluder : Error processing arguments.");
+        cobj->setOccluder(modelID, positions, indices);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 3);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardPipeline_setOccluder)
+
+static bool js_pipeline_ForwardPipeline_removeOccluder(se::State &s) {
+    cc::pipeline::ForwardPipeline *cobj = (cc::pipeline::ForwardPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardPipeline_removeOccluder : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint32_t modelID = 0;
+        ok &= seval_to_uint32(args[0], &modelID);
+        SE_PRECONDITION2(ok, false, "js_pipeline_ForwardPipeline_removeOccluder : Error processing arguments.");
+        cobj->removeOccluder(modelID);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardPipeline_removeOccluder)
+
+static bool js_pipeline_ForwardPipeline_setRenderTargetBudget(se::State &s) {
+    cc::pipeline::ForwardPipeline *cobj = (cc::pipeline::ForwardPipeline *)s.nativeThisObject();
+    SE_PRECONDITION2(cobj, false, "js_pipeline_ForwardPipeline_setRenderTargetBudget : Invalid Native Object.");
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 1) {
+        uint32_t bytes = 0;
+        ok &= seval_to_uint32(args[0], &bytes);
+        SE_PRECONDITION2(ok, false, "js_pipeline_ForwardPipeline_setRenderTargetBudget : Error processing arguments.");
+        cobj->setRenderTargetBudget(bytes);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_pipeline_ForwardPipeline_setRenderTargetBudget)
+
 static bool JSB_getOrCreatePipelineState(se::State &s) {
     const auto &args = s.args();
     size_t argc = args.size();
@@ -44,6 +132,65 @@ static bool JSB_getOrCreatePipelineState(se::State &s) {
 }
 SE_BIND_FUNC(JSB_getOrCreatePipelineState);
 
+static bool JSB_getFrameAllocatorStats(se::State &s) {
+    const auto &stats = cc::FrameAllocator::getLastFrameStats();
+    se::HandleObject retObj(se::Object::createPlainObject());
+    retObj->setProperty("allocations", se::Value(stats.allocations));
+    retObj->setProperty("usedBytes", se::Value(static_cast<double>(stats.usedBytes)));
+    retObj->setProperty("capacity", se::Value(static_cast<double>(stats.capacity)));
+    s.rval().setObject(retObj);
+    return true;
+}
+SE_BIND_FUNC(JSB_getFrameAllocatorStats);
+
+static bool JSB_setProfilerEnabled(se::State &s) {
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        cc::pipeline::PipelineProfiler::getInstance()->setEnabled(args[0].toBoolean());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_setProfilerEnabled);
+
+static bool JSB_getProfilerFrame(se::State &s) {
+    const auto *frame = cc::pipeline::PipelineProfiler::getInstance()->getLastFrame();
+    if (!frame) {
+        s.rval().setUndefined();
+        return true;
+    }
+
+    se::HandleObject samplesObj(se::Object::createArrayObject(frame->samples.size()));
+    for (uint i = 0; i < frame->samples.size(); ++i) {
+        const auto &sample = frame->samples[i];
+        se::HandleObject sampleObj(se::Object::createPlainObject());
+        sampleObj->setProperty("name", se::Value(sample.name));
+        sampleObj->setProperty("depth", se::Value(sample.depth));
+        sampleObj->setProperty("cpuBegin", se::Value(sample.cpuBegin));
+        sampleObj->setProperty("cpuEnd", se::Value(sample.cpuEnd));
+        sampleObj->setProperty("gpuBegin", se::Value(sample.gpuBegin));
+        sampleObj->setProperty("gpuEnd", se::Value(sample.gpuEnd));
+        samplesObj->setArrayElement(i, se::Value(sampleObj));
+    }
+
+    se::HandleObject retObj(se::Object::createPlainObject());
+    retObj->setProperty("frameIndex", se::Value(static_cast<double>(frame->frameIndex)));
+    retObj->setProperty("cpuTime", se::Value(frame->cpuTime));
+    retObj->setProperty("gpuTime", se::Value(frame->gpuTime));
+    retObj->setProperty("samples", se::Value(samplesObj));
+    s.rval().setObject(retObj);
+    return true;
+}
+SE_BIND_FUNC(JSB_getProfilerFrame);
+
+static bool JSB_exportProfilerTrace(se::State &s) {
+    s.rval().setString(cc::pipeline::PipelineProfiler::getInstance()->exportChromeTrace());
+    return true;
+}
+SE_BIND_FUNC(JSB_exportProfilerTrace);
+
 bool register_all_pipeline_manual(se::Object *obj) {
     // Get the ns
     se::Value nrVal;
@@ -59,7 +206,16 @@ bool register_all_pipeline_manual(se::Object *obj) {
     psmVal.setObject(jsobj);
     nr->setProperty("PipelineStateManager", psmVal);
     psmVal.toObject()->defineFunction("getOrCreatePipelineState", _SE(JSB_getOrCreatePipelineState));
+    nr->defineFunction("getFrameAllocatorStats", _SE(JSB_getFrameAllocatorStats));
+    nr->defineFunction("setProfilerEnabled", _SE(JSB_setProfilerEnabled));
+    nr->defineFunction("getProfilerFrame", _SE(JSB_getProfilerFrame));
+    nr->defineFunction("exportProfilerTrace", _SE(JSB_exportProfilerTrace));
 
     __jsb_cc_pipeline_RenderPipeline_proto->defineProperty("macros", _SE(js_pipeline_RenderPipeline_getMacros), nullptr);
+    __jsb_cc_pipeline_ForwardPipeline_proto->defineFunction("setGPUInstanceCulling", _SE(js_pipeline_ForwardPipeline_setGPUInstanceCulling));
+    __jsb_cc_pipeline_ForwardPipeline_proto->defineFunction("setOcclusionCulling", _SE(js_pipeline_ForwardPipeline_setOcclusionCulling));
+    __jsb_cc_pipeline_ForwardPipeline_proto->defineFunction("setOccluder", _SE(js_pipeline_ForwardPipeline_setOccluder));
+    __jsb_cc_pipeline_ForwardPipeline_proto->defineFunction("removeOccluder", _SE(js_pipeline_ForwardPipeline_removeOccluder));
+    __jsb_cc_pipeline_ForwardPipeline_proto->defineFunction("setRenderTargetBudget", _SE(js_pipeline_ForwardPipeline_setRenderTargetBudget));
     return true;
 }
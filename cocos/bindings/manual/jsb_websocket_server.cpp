@@ -371,7 +371,7 @@ static bool WebSocketServer_Connection_send(se::State &s) {
         std::function<void(const std::string &cb)> callback;
         if (args[argc - 1].isObject() && args[argc - 1].toObject()->isFunction()) {
             std::string callbackId = gen_send_index();
-            s.thisObject()->setProperty(callbackId.c_str(), args[argc - 1]);
+            s.thisObject()->setProperty(callbackId, args[argc - 1]);
             std::weak_ptr<WebSocketServerConnection> connWeak = *cobj;
 
             callback = [callbackId, connWeak](const std::string &err) {
@@ -385,7 +385,7 @@ static bool WebSocketServer_Connection_send(se::State &s) {
                     return;
                 }
                 se::Value callback;
-                if (!sobj->getProperty(callbackId.c_str(), &callback)) {
+                if (!sobj->getProperty(callbackId, &callback)) {
                     SE_REPORT_ERROR("send[%s] callback not found!", callbackId.c_str());
                     return;
                 }
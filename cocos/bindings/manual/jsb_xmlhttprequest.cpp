@@ -155,9 +155,14 @@ public:
     uint16_t getStatus() const { return _status; }
     const std::string &getStatusText() const { return _statusText; }
     const std::string &getResponseText() const { return _responseText; }
-    const cc::Data &getResponseData() const { return _responseData; }
+    bool hasResponseData() const { return _hasResponseData; }
+    // hand response body over to the caller without copying, it's only available once per response
+    std::vector<char> *releaseResponseData();
     ResponseType getResponseType() const { return _responseType; }
     void setResponseType(ResponseType type) { _responseType = type; }
+    // ArrayBuffer response shares the response body, it's created once and kept here instead of on the js object
+    se::Object *getResponseArrayBuffer() const { return _responseArrayBuffer; }
+    void setResponseArrayBuffer(se::Object *arrayBuffer);
 
     void overrideMimeType(const std::string &mimeType);
     std::string getMimeType() const;
@@ -190,10 +195,12 @@ private:
     std::string _statusText;
     std::string _overrideMimeType;
 
-    cc::Data _responseData;
+    std::vector<char> _responseData;
+    bool _hasResponseData = false;
 
     cc::network::HttpRequest *_httpRequest;
     //    cc::EventListenerCustom* _resetDirectorListener;
+    se::Object *_responseArrayBuffer = nullptr;
 
     unsigned long _timeoutInMilliseconds;
     uint16_t _status;
@@ -239,6 +246,20 @@ XMLHttpRequest::~XMLHttpRequest() {
     // Avoid HttpClient response call a released object!
     _httpRequest->setResponseCallback(nullptr);
     CC_SAFE_RELEASE(_httpRequest);
+    // safe after the script engine cleanup too, it has unrooted all objects then
+    setResponseArrayBuffer(nullptr);
+}
+
+void XMLHttpRequest::setResponseArrayBuffer(se::Object *arrayBuffer) {
+    if (_responseArrayBuffer) {
+        _responseArrayBuffer->unroot();
+        _responseArrayBuffer->decRef();
+    }
+    _responseArrayBuffer = arrayBuffer;
+    if (_responseArrayBuffer) {
+        _responseArrayBuffer->root();
+        _responseArrayBuffer->incRef();
+    }
 }
 
 bool XMLHttpRequest::open(const std::string &method, const std::string &url) {
@@ -405,6 +426,7 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
 
     _responseText.clear();
     _responseData.clear();
+    _hasResponseData = false;
 
     if (!response->isSucceed()) {
         std::string errorBuffer = response->getErrorBuffer();
@@ -442,7 +464,9 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
     if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
         _responseText.append(buffer->data(), buffer->size());
     } else {
-        _responseData.copy((unsigned char *)buffer->data(), buffer->size());
+        // take over the buffer received by HttpClient, no copy
+        _responseData = std::move(*buffer);
+        _hasResponseData = true;
     }
 
     _status = statusCode;
@@ -459,6 +483,14 @@ void XMLHttpRequest::onResponse(HttpClient *client, HttpResponse *response) {
     }
 }
 
+std::vector<char> *XMLHttpRequest::releaseResponseData() {
+    if (!_hasResponseData) {
+        return nullptr;
+    }
+    _hasResponseData = false;
+    return new std::vector<char>(std::move(_responseData));
+}
+
 void XMLHttpRequest::overrideMimeType(const std::string &mimeType) {
     _overrideMimeType = mimeType;
 }
@@ -649,6 +681,10 @@ static bool XMLHttpRequest_constructor(se::State &s) {
 }
 SE_BIND_CTOR(XMLHttpRequest_constructor, __jsb_XMLHttpRequest_class, XMLHttpRequest_finalize)
 
+static void freeResponseData(void * /*contents*/, size_t /*byteLength*/, void *userData) {
+    delete static_cast<std::vector<char> *>(userData);
+}
+
 static bool XMLHttpRequest_open(se::State &s) {
     const auto &args = s.args();
     int argc = (int)args.size();
@@ -662,6 +698,7 @@ static bool XMLHttpRequest_open(se::State &s) {
         ok = seval_to_std_string(args[1], &url);
         SE_PRECONDITION2(ok, false, "args[1] isn't a string.");
         bool ret = request->open(method, url);
+        request->setResponseArrayBuffer(nullptr);
         s.rval().setBoolean(ret);
         return true;
     }
@@ -860,10 +897,21 @@ static bool XMLHttpRequest_getResponse(se::State &s) {
                     s.rval().setNull();
                 }
             } else if (xhr->getResponseType() == XMLHttpRequest::ResponseType::ARRAY_BUFFER) {
-                const Data &data = xhr->getResponseData();
-                se::HandleObject seObj(se::Object::createArrayBufferObject(data.getBytes(), data.getSize()));
+                se::Object *cached = xhr->getResponseArrayBuffer();
+                if (cached) {
+                    s.rval().setObject(cached);
+                    return true;
+                }
+
+                std::vector<char> *data = xhr->releaseResponseData();
+                if (data == nullptr) {
+                    s.rval().setNull();
+                    return true;
+                }
+                se::HandleObject seObj(se::Object::createExternalArrayBufferObject(data->data(), data->size(), freeResponseData, data));
                 if (!seObj.isEmpty()) {
                     s.rval().setObject(seObj);
+                    xhr->setResponseArrayBuffer(seObj.get());
                 } else {
                     s.rval().setNull();
                 }
@@ -53,20 +53,20 @@ public:
     }
 
     inline void writeUint32(std::size_t pos, uint32_t val) {
-        if (_bufferSize < pos + sizeof(val)) {
+        if (pos < _basePos || _bufferSize < pos - _basePos + sizeof(val)) {
             _outRange = true;
             return;
         }
-        uint32_t *buffer = (uint32_t *)(_buffer + pos);
+        uint32_t *buffer = (uint32_t *)(_buffer + pos - _basePos);
         *buffer = val;
     }
 
     inline void writeFloat32(std::size_t pos, float val) {
-        if (_bufferSize < pos + sizeof(val)) {
+        if (pos < _basePos || _bufferSize < pos - _basePos + sizeof(val)) {
             _outRange = true;
             return;
         }
-        float *buffer = (float *)(_buffer + pos);
+        float *buffer = (float *)(_buffer + pos - _basePos);
         *buffer = val;
     }
 
@@ -154,8 +154,12 @@ public:
         return _curPos;
     }
 
+    /**
+     * @brief Logical write position, it keeps valid even if the buffer has
+     * switched to another chunk, use it with writeUint32(pos, val) or writeFloat32(pos, val).
+     */
     inline std::size_t getCurPos() const {
-        return _curPos;
+        return _basePos + _curPos;
     }
 
     inline uint8_t *getCurBuffer() const {
@@ -222,6 +226,8 @@ protected:
     std::size_t _bufferSize = 0;
     std::size_t _curPos = 0;
     std::size_t _readPos = 0;
+    // Logical position of _buffer[0], only chunked buffer will move it.
+    std::size_t _basePos = 0;
     bool _outRange = false;
     std::size_t _maxSize = 0;
     fullCallback _fullCallback = nullptr;
@@ -28,47 +28,125 @@
 
 MIDDLEWARE_BEGIN
 
-IOTypedArray::IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool) {
+IOTypedArray::IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool, bool chunked) {
     _arrayType = arrayType;
     _bufferSize = defaultSize;
     _usePool = usePool;
+    _chunked = chunked;
 
-    if (_usePool) {
-        _typeArray = TypedArrayPool::getInstance()->pop(_arrayType, _bufferSize);
-    } else {
-        se::AutoHandleScope hs;
-        _typeArray = se::Object::createTypedArray(_arrayType, nullptr, _bufferSize);
-        _typeArray->root();
-    }
+    _typeArray = createTypeArray(_bufferSize);
 
     se::AutoHandleScope hs;
     _typeArray->getTypedArrayData(&_buffer, &_bufferSize);
+
+    if (_chunked) {
+        Chunk chunk;
+        chunk.typeArray = _typeArray;
+        chunk.buffer = _buffer;
+        chunk.size = _bufferSize;
+        _chunks.push_back(chunk);
+    }
 }
 
 IOTypedArray::~IOTypedArray() {
-    if (_usePool) {
-        TypedArrayPool::getInstance()->push(_arrayType, _bufferSize, _typeArray);
+    if (_chunked) {
+        for (auto &chunk : _chunks) {
+            releaseTypeArray(chunk.typeArray, chunk.size);
+        }
+        _chunks.clear();
     } else {
-        _typeArray->unroot();
-        _typeArray->decRef();
+        releaseTypeArray(_typeArray, _bufferSize);
     }
     _typeArray = nullptr;
     _buffer = nullptr;
 }
 
-void IOTypedArray::resize(std::size_t newLen, bool needCopy) {
-    if (_bufferSize >= newLen) return;
+se::Object *IOTypedArray::createTypeArray(std::size_t size) {
+    if (_usePool) {
+        return TypedArrayPool::getInstance()->pop(_arrayType, size);
+    }
 
-    se::Object *newTypeBuffer = nullptr;
+    se::AutoHandleScope hs;
+    se::Object *typeArray = se::Object::createTypedArray(_arrayType, nullptr, size);
+    typeArray->root();
+    return typeArray;
+}
 
-    if (_usePool) {
-        newTypeBuffer = TypedArrayPool::getInstance()->pop(_arrayType, newLen);
+void IOTypedArray::releaseTypeArray(se::Object *typeArray, std::size_t size, bool deferred) {
+    if (_usePool && deferred) {
+        TypedArrayPool::getInstance()->pushDeferred(_arrayType, size, typeArray);
+    } else if (_usePool) {
+        TypedArrayPool::getInstance()->push(_arrayType, size, typeArray);
     } else {
+        typeArray->unroot();
+        typeArray->decRef();
+    }
+}
+
+void IOTypedArray::useChunk(std::size_t index) {
+    Chunk &chunk = _chunks[index];
+    _chunkIndex = index;
+    _typeArray = chunk.typeArray;
+    _buffer = chunk.buffer;
+    _bufferSize = chunk.size;
+}
+
+void IOTypedArray::rewind() {
+    reset();
+    _basePos = 0;
+    _recordPos = 0;
+    _outRange = false;
+    if (_chunked && _chunkIndex != 0) {
+        useChunk(0);
+    }
+}
+
+void IOTypedArray::linkChunk(std::size_t needSize) {
+    std::size_t recordLen = _curPos - _recordPos;
+    std::size_t chunkSize = _chunks[0].size;
+    if (chunkSize < recordLen + needSize) {
+        chunkSize = recordLen + needSize;
+    }
+
+    std::size_t nextIndex = _chunkIndex + 1;
+    if (nextIndex >= _chunks.size()) {
+        _chunks.push_back(Chunk());
+    } else if (_chunks[nextIndex].size < chunkSize) {
+        // Chunk behind current one is not used in this round,replace it with a larger one.
+        releaseTypeArray(_chunks[nextIndex].typeArray, _chunks[nextIndex].size, true);
+        _chunks[nextIndex] = Chunk();
+    }
+
+    Chunk &chunk = _chunks[nextIndex];
+    if (!chunk.typeArray) {
+        chunk.typeArray = createTypeArray(chunkSize);
         se::AutoHandleScope hs;
-        newTypeBuffer = se::Object::createTypedArray(_arrayType, nullptr, newLen);
-        newTypeBuffer->root();
+        chunk.typeArray->getTypedArrayData(&chunk.buffer, &chunk.size);
+    }
+
+    uint8_t *recordBuffer = _buffer + _recordPos;
+    useChunk(nextIndex);
+    if (recordLen > 0) {
+        memcpy(_buffer, recordBuffer, recordLen);
+    }
+
+    // Positions inside current record keep valid after moving.
+    _basePos += _recordPos;
+    _recordPos = 0;
+    _curPos = recordLen;
+    _outRange = false;
+}
+
+void IOTypedArray::resize(std::size_t newLen, bool needCopy) {
+    if (_bufferSize >= newLen) return;
+
+    if (_chunked) {
+        linkChunk(newLen - _curPos);
+        return;
     }
 
+    se::Object *newTypeBuffer = createTypeArray(newLen);
+
     uint8_t *newBuffer = nullptr;
     se::AutoHandleScope hs;
     newTypeBuffer->getTypedArrayData(&newBuffer, (size_t *)&newLen);
@@ -77,12 +155,7 @@ void IOTypedArray::resize(std::size_t newLen, bool needCopy) {
         memcpy(newBuffer, _buffer, _bufferSize);
     }
 
-    if (_usePool) {
-        TypedArrayPool::getInstance()->push(_arrayType, _bufferSize, _typeArray);
-    } else {
-        _typeArray->unroot();
-        _typeArray->decRef();
-    }
+    releaseTypeArray(_typeArray, _bufferSize, true);
 
     _typeArray = newTypeBuffer;
     _buffer = newBuffer;
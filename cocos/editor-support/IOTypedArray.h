@@ -27,10 +27,14 @@
 #include "MiddlewareMacro.h"
 #include "SeApi.h"
 #include "base/Macros.h"
+#include <vector>
 
 MIDDLEWARE_BEGIN
 /**
  * Inherit from IOBuffer.
+ * In chunked mode the TypeArray handed to js will never be reallocated,
+ * if space is not enough,a new chunk will be linked and the current record
+ * will be moved to the head of it.
  */
 class IOTypedArray : public IOBuffer {
 public:
@@ -39,8 +43,9 @@ public:
      * @param[in] arrayType TypeArray type
      * @param[in] defaultSize TypeArray capacity
      * @param[in] usePool If true,will get TypeArray from pool,or create TypeArray,default false.
+     * @param[in] chunked If true,will link new chunk instead of reallocate buffer,default false.
      */
-    IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool = false);
+    IOTypedArray(se::Object::TypedArrayType arrayType, std::size_t defaultSize, bool usePool = false, bool chunked = false);
     virtual ~IOTypedArray();
 
     inline se::Object *getTypeArray() const {
@@ -49,10 +54,60 @@ public:
 
     virtual void resize(std::size_t newLen, bool needCopy = false) override;
 
+    /**
+     * @brief Mark current position as the beginning of a record.
+     * Data between record beginning and current position will be
+     * moved together when a new chunk is linked.
+     */
+    inline void beginRecord() {
+        _recordPos = _curPos;
+    }
+
+    /**
+     * @brief Record beginning offset in current chunk.
+     */
+    inline std::size_t getRecordPos() const {
+        return _recordPos;
+    }
+
+    inline std::size_t getChunkIndex() const {
+        return _chunkIndex;
+    }
+
+    inline std::size_t getChunkCount() const {
+        return _chunks.size();
+    }
+
+    se::Object *getChunk(std::size_t index) const {
+        if (_chunks.size() <= index) return nullptr;
+        return _chunks[index].typeArray;
+    }
+
+    /**
+     * @brief Go back to first chunk,linked chunks are kept for reusing.
+     */
+    void rewind();
+
 private:
+    struct Chunk {
+        se::Object *typeArray = nullptr;
+        uint8_t *buffer = nullptr;
+        std::size_t size = 0;
+    };
+
+    se::Object *createTypeArray(std::size_t size);
+    // deferred is for TypeArray replaced while js may still hold a view of it
+    void releaseTypeArray(se::Object *typeArray, std::size_t size, bool deferred = false);
+    void linkChunk(std::size_t needSize);
+    void useChunk(std::size_t index);
+
     se::Object::TypedArrayType _arrayType = se::Object::TypedArrayType::NONE;
     se::Object *_typeArray = nullptr;
     bool _usePool = false;
+    bool _chunked = false;
+    std::vector<Chunk> _chunks;
+    std::size_t _chunkIndex = 0;
+    std::size_t _recordPos = 0;
 };
 
 MIDDLEWARE_END
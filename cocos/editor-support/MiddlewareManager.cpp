@@ -23,6 +23,8 @@
  ****************************************************************************/
 #include "MiddlewareManager.h"
 #include "SeApi.h"
+#include "TypedArrayPool.h"
+#include "base/memory/AllocProfiler.h"
 #include <algorithm>
 
 MIDDLEWARE_BEGIN
@@ -65,6 +67,9 @@ void MiddlewareManager::_clearRemoveList() {
 }
 
 void MiddlewareManager::update(float dt) {
+    CC_MEM_TAG_SCOPE(MIDDLEWARE);
+    // js has consumed last frame,TypeArray replaced in it are not viewed any more
+    TypedArrayPool::getInstance()->recycleDeferred();
     isUpdating = true;
 
     _renderInfo.reset();
@@ -192,6 +197,19 @@ SharedBufferManager *MiddlewareManager::getAttachInfoMgr() {
     return &_attachInfo;
 }
 
+void MiddlewareManager::beginRecord() {
+    _renderInfo.beginRecord();
+    _attachInfo.beginRecord();
+}
+
+void MiddlewareManager::fillSharedBufferOffset(IOTypedArray *sharedBufferOffset) {
+    sharedBufferOffset->reset();
+    sharedBufferOffset->writeUint32(_renderInfo.getRecordOffset());
+    sharedBufferOffset->writeUint32(_attachInfo.getRecordOffset());
+    sharedBufferOffset->writeUint32(_renderInfo.getRecordChunk());
+    sharedBufferOffset->writeUint32(_attachInfo.getRecordChunk());
+}
+
 std::size_t MiddlewareManager::getVBTypedArrayLength(int format, std::size_t bufferPos) {
     MeshBuffer *mb = _mbMap[format];
     if (!mb) return 0;
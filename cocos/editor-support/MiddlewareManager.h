@@ -105,6 +105,18 @@ public:
     SharedBufferManager *getRenderInfoMgr();
     SharedBufferManager *getAttachInfoMgr();
 
+    /**
+     * @brief Mark beginning of render info and attach info of one display.
+     */
+    void beginRecord();
+
+    /**
+     * @brief Fill display shared buffer offset with current record position.
+     * Layout is render info offset,attach info offset,render info chunk,attach info chunk.
+     * @param[in] sharedBufferOffset Display shared buffer offset,capacity must be four uint32.
+     */
+    void fillSharedBufferOffset(IOTypedArray *sharedBufferOffset);
+
     MiddlewareManager();
     ~MiddlewareManager();
 
@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+#include "MiddlewareMacro.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+MIDDLEWARE_BEGIN
+/**
+ * Vertex positions of the previous and the last evaluated pose of one slot.
+ * Low detail armatures evaluate pose once every interval frames,frames between
+ * two evaluations blend between the two poses,so the shown pose reaches the last
+ * evaluated one right before the next evaluation.
+ */
+class PoseHistory {
+public:
+    /**
+     * @brief Blend weight of the last evaluated pose.
+     * @param[in] framesSincePose Frames since the last pose evaluation,0 if it happened this frame.
+     * @param[in] interval Pose evaluation interval in frames.
+     */
+    static float getBlend(int framesSincePose, int interval) {
+        return std::min(1.0f, (framesSincePose + 1.0f) / interval);
+    }
+
+    /**
+     * @brief Prepare for blending vertices of this frame.
+     * @param[in] vertCount Vertex count,history is reset if it changes.
+     * @param[in] reset If true,history starts over from the pose of this frame.
+     * @param[in] evaluated If true,pose of this frame is newly evaluated and pushed into history.
+     */
+    void begin(std::size_t vertCount, bool reset, bool evaluated) {
+        _reset = reset || _verts.size() != vertCount * 4;
+        _evaluated = evaluated;
+        _lastOffset = vertCount * 2;
+        _verts.resize(vertCount * 4);
+    }
+
+    /**
+     * @brief Blend one vertex.
+     * @param[in] index Vertex index.
+     * @param[in] blend Blend weight,see getBlend.
+     * @param[in,out] x Position of current pose in,blended position out.
+     * @param[in,out] y Position of current pose in,blended position out.
+     */
+    void blend(std::size_t index, float blend, float &x, float &y) {
+        float *prev = _verts.data() + index * 2;
+        float *last = prev + _lastOffset;
+        if (_reset) {
+            prev[0] = last[0] = x;
+            prev[1] = last[1] = y;
+        } else if (_evaluated) {
+            prev[0] = last[0];
+            prev[1] = last[1];
+            last[0] = x;
+            last[1] = y;
+        }
+        x = prev[0] + (last[0] - prev[0]) * blend;
+        y = prev[1] + (last[1] - prev[1]) * blend;
+    }
+
+    void clear() {
+        _verts.clear();
+    }
+
+private:
+    // previous pose first,then the last evaluated one
+    std::vector<float> _verts;
+    std::size_t _lastOffset = 0;
+    bool _reset = true;
+    bool _evaluated = true;
+};
+
+MIDDLEWARE_END
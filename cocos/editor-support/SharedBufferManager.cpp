@@ -45,7 +45,8 @@ void SharedBufferManager::afterCleanupHandle() {
 
 void SharedBufferManager::init() {
     if (!_buffer) {
-        _buffer = new IOTypedArray(_arrayType, INIT_RENDER_INFO_BUFFER_SIZE);
+        // Chunk will never be reallocated,so js could hold it safely.
+        _buffer = new IOTypedArray(_arrayType, INIT_RENDER_INFO_BUFFER_SIZE, true, true);
         _buffer->setResizeCallback([this] {
             if (_resizeCallback) {
                 _resizeCallback();
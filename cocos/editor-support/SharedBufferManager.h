@@ -35,7 +35,28 @@ public:
     virtual ~SharedBufferManager();
 
     void reset() {
-        _buffer->reset();
+        _buffer->rewind();
+    }
+
+    /**
+     * @brief Mark the beginning of one display render data.
+     */
+    void beginRecord() {
+        _buffer->beginRecord();
+    }
+
+    /**
+     * @brief Offset of current record in its chunk,in element.
+     */
+    uint32_t getRecordOffset() const {
+        return (uint32_t)(_buffer->getRecordPos() / sizeof(uint32_t));
+    }
+
+    /**
+     * @brief Chunk index of current record.
+     */
+    uint32_t getRecordChunk() const {
+        return (uint32_t)_buffer->getChunkIndex();
     }
 
     IOTypedArray *getBuffer() {
@@ -48,7 +69,15 @@ public:
     }
 
     se_object_ptr getSharedBuffer() const {
-        return _buffer->getTypeArray();
+        return _buffer->getChunk(0);
+    }
+
+    std::size_t getChunkCount() const {
+        return _buffer->getChunkCount();
+    }
+
+    se_object_ptr getSharedBufferChunk(std::size_t index) const {
+        return _buffer->getChunk(index);
     }
 
 private:
@@ -67,78 +67,68 @@ void TypedArrayPool::afterInitHandle() {
 void TypedArrayPool::clearPool() {
     PoolLog("*****clearPool TypeArray pool begin");
 
-    //map
-    for (auto it = _pool.begin(); it != _pool.end(); it++) {
-        //map
-        fitMap &mapPool = *(it->second);
-        for (auto itMapPool = mapPool.begin(); itMapPool != mapPool.end(); itMapPool++) {
-            //vector
-            objPool &itFitPool = *(itMapPool->second);
-            PoolLog("clear arrayType:%d,fitSize:%lu,objSize:%lu\n", it->first, itMapPool->first, itFitPool.size());
-            for (auto itFit = itFitPool.begin(); itFit != itFitPool.end(); itFit++) {
-                (*itFit)->unroot();
-                (*itFit)->decRef();
-            }
-            delete &itFitPool;
+    for (std::size_t i = 0; i < TYPE_COUNT * SIZE_CLASS_COUNT; i++) {
+        objPool &itFitPool = _pool[i];
+        PoolLog("clear arrayType:%lu,fitSize:%lu,objSize:%lu\n", i / SIZE_CLASS_COUNT, (std::size_t)MIN_TYPE_ARRAY_SIZE << (i % SIZE_CLASS_COUNT), itFitPool.size());
+        for (auto itFit = itFitPool.begin(); itFit != itFitPool.end(); itFit++) {
+            (*itFit)->unroot();
+            (*itFit)->decRef();
         }
-        delete &mapPool;
+        itFitPool.clear();
     }
-    _pool.clear();
+
+    for (auto &deferred : _deferred) {
+        deferred.object->unroot();
+        deferred.object->decRef();
+    }
+    _deferred.clear();
 
     PoolLog("*****clearPool TypeArray pool end");
 }
 
 void TypedArrayPool::dump() {
-    //map
-    for (auto it = _pool.begin(); it != _pool.end(); it++) {
-        //map
-        fitMap &mapPool = *(it->second);
-        for (auto itMapPool = mapPool.begin(); itMapPool != mapPool.end(); itMapPool++) {
-            //vector
-            CC_UNUSED objPool &itFitPool = *(itMapPool->second);
-            PoolLog("arrayType:%d,fitSize:%lu,objSize:%lu\n", it->first, itMapPool->first, itFitPool.size());
-        }
+    for (std::size_t i = 0; i < TYPE_COUNT * SIZE_CLASS_COUNT; i++) {
+        CC_UNUSED objPool &itFitPool = _pool[i];
+        PoolLog("arrayType:%lu,fitSize:%lu,objSize:%lu\n", i / SIZE_CLASS_COUNT, (std::size_t)MIN_TYPE_ARRAY_SIZE << (i % SIZE_CLASS_COUNT), itFitPool.size());
+    }
+}
+
+std::size_t TypedArrayPool::getSizeClass(std::size_t size) {
+    std::size_t sizeClass = 0;
+    std::size_t fitSize = MIN_TYPE_ARRAY_SIZE;
+    while (fitSize < size) {
+        fitSize <<= 1;
+        sizeClass++;
     }
+    return sizeClass;
 }
 
 se::Object *TypedArrayPool::pop(arrayType type, std::size_t size) {
-    std::size_t fitSize = ceil(size / float(MIN_TYPE_ARRAY_SIZE)) * MIN_TYPE_ARRAY_SIZE;
-    objPool *objPoolPtr = getObjPool(type, fitSize);
+    std::size_t sizeClass = getSizeClass(size);
+    std::size_t fitSize = size;
+    objPool *objPoolPtr = nullptr;
+    // Too large to pool,create it directly.
+    if (sizeClass < SIZE_CLASS_COUNT) {
+        fitSize = (std::size_t)MIN_TYPE_ARRAY_SIZE << sizeClass;
+        objPoolPtr = getObjPool(type, sizeClass);
+    }
 
-    if (objPoolPtr->size() > 0) {
+    if (objPoolPtr && objPoolPtr->size() > 0) {
         se::Object *obj = objPoolPtr->back();
         objPoolPtr->pop_back();
         PoolLog("TypedArrayPool:pop result:success,type:%d,fitSize:%lu,objSize:%lu\n", (int)type, fitSize, objPoolPtr->size());
         return obj;
     }
 
-    PoolLog("TypedArrayPool:pop result:empty,type:%d,fitSize:%lu,objSize:%lu\n", (int)type, fitSize, objPoolPtr->size());
+    PoolLog("TypedArrayPool:pop result:empty,type:%d,fitSize:%lu\n", (int)type, fitSize);
     se::AutoHandleScope hs;
     auto typeArray = se::Object::createTypedArray(type, nullptr, fitSize);
     typeArray->root();
     return typeArray;
 }
 
-TypedArrayPool::objPool *TypedArrayPool::getObjPool(arrayType type, std::size_t fitSize) {
-    auto it = _pool.find(type);
-    fitMap *fitMapPtr = nullptr;
-    if (it == _pool.end()) {
-        fitMapPtr = new fitMap();
-        _pool[type] = fitMapPtr;
-    } else {
-        fitMapPtr = it->second;
-    }
-
-    auto itPool = fitMapPtr->find(fitSize);
-    objPool *objPoolPtr = nullptr;
-    if (itPool == fitMapPtr->end()) {
-        objPoolPtr = new objPool();
-        (*fitMapPtr)[fitSize] = objPoolPtr;
-    } else {
-        objPoolPtr = itPool->second;
-    }
-
-    return objPoolPtr;
+TypedArrayPool::objPool *TypedArrayPool::getObjPool(arrayType type, std::size_t sizeClass) {
+    return &_pool[(std::size_t)type * SIZE_CLASS_COUNT + sizeClass];
 }
 
 void TypedArrayPool::push(arrayType type, std::size_t arrayCapacity, se::Object *object) {
@@ -153,7 +143,17 @@ void TypedArrayPool::push(arrayType type, std::size_t arrayCapacity, se::Object
         return;
     }
 
-    objPool *objPoolPtr = getObjPool(type, arrayCapacity);
+    std::size_t sizeClass = getSizeClass(arrayCapacity);
+    // Capacity which is not exactly a size class can not be reused by pop.
+    if (sizeClass >= SIZE_CLASS_COUNT || ((std::size_t)MIN_TYPE_ARRAY_SIZE << sizeClass) != arrayCapacity) {
+        object->unroot();
+        object->decRef();
+        object = nullptr;
+        PoolLog("TypedArrayPool:push result:not fit,type:%d,arrayCapacity:%lu\n", (int)type, arrayCapacity);
+        return;
+    }
+
+    objPool *objPoolPtr = getObjPool(type, sizeClass);
     auto it = std::find(objPoolPtr->begin(), objPoolPtr->end(), object);
     if (it != objPoolPtr->end()) {
         PoolLog("TypedArrayPool:push result:repeat\n");
@@ -170,4 +170,23 @@ void TypedArrayPool::push(arrayType type, std::size_t arrayCapacity, se::Object
     }
 }
 
+void TypedArrayPool::pushDeferred(arrayType type, std::size_t arrayCapacity, se::Object *object) {
+    if (object == nullptr) return;
+
+    if (!allowPush) {
+        push(type, arrayCapacity, object);
+        return;
+    }
+
+    _deferred.push_back({type, arrayCapacity, object});
+    PoolLog("TypedArrayPool:pushDeferred type:%d,arrayCapacity:%lu,deferredSize:%lu\n", (int)type, arrayCapacity, _deferred.size());
+}
+
+void TypedArrayPool::recycleDeferred() {
+    for (auto &deferred : _deferred) {
+        push(deferred.type, deferred.arrayCapacity, deferred.object);
+    }
+    _deferred.clear();
+}
+
 MIDDLEWARE_END
@@ -25,12 +25,13 @@
 #pragma once
 #include "MiddlewareMacro.h"
 #include "SeApi.h"
-#include <map>
 #include <vector>
 
 MIDDLEWARE_BEGIN
 /** 
  * TypeArray Pool for IOTypedArray
+ * Capacity is rounded up to power of two size class,free lists of all
+ * type and size class are stored in one flat array.
  */
 class TypedArrayPool {
 private:
@@ -54,10 +55,19 @@ public:
 private:
     typedef se::Object::TypedArrayType arrayType;
     typedef std::vector<se::Object *> objPool;
-    typedef std::map<std::size_t, objPool *> fitMap;
-    typedef std::map<arrayType, fitMap *> typeMap;
 
-    objPool *getObjPool(arrayType type, std::size_t size);
+    struct DeferredObj {
+        arrayType type;
+        std::size_t arrayCapacity;
+        se::Object *object;
+    };
+
+    // Size class i holds TypeArray which capacity is MIN_TYPE_ARRAY_SIZE << i.
+    static const std::size_t SIZE_CLASS_COUNT = 16;
+    static const std::size_t TYPE_COUNT = (std::size_t)arrayType::FLOAT64 + 1;
+
+    static std::size_t getSizeClass(std::size_t size);
+    objPool *getObjPool(arrayType type, std::size_t sizeClass);
 
     TypedArrayPool();
     ~TypedArrayPool();
@@ -72,7 +82,8 @@ private:
     void afterInitHandle();
 
 private:
-    typeMap _pool;
+    objPool _pool[TYPE_COUNT * SIZE_CLASS_COUNT];
+    std::vector<DeferredObj> _deferred;
     bool allowPush = true;
 
 public:
@@ -90,5 +101,19 @@ public:
      * @param[in] object TypeArray which want to put in pool.
      */
     void push(arrayType type, std::size_t arrayCapacity, se::Object *object);
+
+    /**
+     * @brief push a TypeArray back to pool when recycleDeferred is called,
+     * js may still hold a view of it until the end of the frame.
+     * @param[in] type TypeArray type.
+     * @param[in] arrayCapacity TypeArray capacity.
+     * @param[in] object TypeArray which want to put in pool.
+     */
+    void pushDeferred(arrayType type, std::size_t arrayCapacity, se::Object *object);
+
+    /**
+     * @brief Put all TypeArray pushed by pushDeferred into pool,call it once per frame.
+     */
+    void recycleDeferred();
 };
 MIDDLEWARE_END
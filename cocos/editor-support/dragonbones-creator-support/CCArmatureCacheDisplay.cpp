@@ -56,7 +56,7 @@ CCArmatureCacheDisplay::CCArmatureCacheDisplay(const std::string &armatureName,
     }
 
     // store global TypedArray begin and end offset
-    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 2);
+    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 4);
 
     // store render order(1), world matrix(16)
     _paramsBuffer = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, sizeof(float) * 17);
@@ -162,13 +162,13 @@ void CCArmatureCacheDisplay::render(float dt) {
     auto attachInfo = attachMgr->getBuffer();
     if (!attachInfo) return;
 
-    //  store render info offset
-    _sharedBufferOffset->writeUint32((uint32_t)renderInfo->getCurPos() / sizeof(uint32_t));
-    // store attach info offset
-    _sharedBufferOffset->writeUint32((uint32_t)attachInfo->getCurPos() / sizeof(uint32_t));
+    // mark record beginning,record will be moved as a whole if a new chunk is linked
+    mgr->beginRecord();
 
     // check enough space
     renderInfo->checkSpace(sizeof(uint32_t) * 2, true);
+    // store render info and attach info offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
     // write border
     renderInfo->writeUint32(0xffffffff);
 
@@ -333,6 +333,9 @@ void CCArmatureCacheDisplay::render(float dt) {
             attachInfo->writeBytes((const char *)&bone->globalTransformMatrix, sizeof(cc::Mat4));
         }
     }
+
+    // record may have been moved to another chunk,refresh offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
 }
 void CCArmatureCacheDisplay::beginSchedule() {
     MiddlewareManager::getInstance()->addTimer(this);
@@ -51,14 +51,16 @@ CCArmatureDisplay *CCArmatureDisplay::create() {
 }
 
 CCArmatureDisplay::CCArmatureDisplay() {
-    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 2);
+    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 4);
 
-    // store render order(1), world matrix(16)
-    _paramsBuffer = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, sizeof(float) * 17);
+    // store render order(1), world matrix(16), screen size(1)
+    _paramsBuffer = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, sizeof(float) * 18);
     // set render order to 0
     _paramsBuffer->writeFloat32(0);
     // set world transform to identity
     _paramsBuffer->writeBytes((const char *)&cc::Mat4::IDENTITY, sizeof(float) * 16);
+    // set screen size to 0,it's only used when culling is enabled
+    _paramsBuffer->writeFloat32(0);
 }
 
 CCArmatureDisplay::~CCArmatureDisplay() {
@@ -116,13 +118,13 @@ void CCArmatureDisplay::dbRender() {
     auto attachInfo = attachMgr->getBuffer();
     if (!attachInfo) return;
 
-    //  store render info offset
-    _sharedBufferOffset->writeUint32((uint32_t)renderInfo->getCurPos() / sizeof(uint32_t));
-    // store attach info offset
-    _sharedBufferOffset->writeUint32((uint32_t)attachInfo->getCurPos() / sizeof(uint32_t));
+    // mark record beginning,record will be moved as a whole if a new chunk is linked
+    mgr->beginRecord();
 
     // check enough space
     renderInfo->checkSpace(sizeof(uint32_t) * 2, true);
+    // store render info and attach info offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
     // write border
     renderInfo->writeUint32(0xffffffff);
 
@@ -137,6 +139,12 @@ void CCArmatureDisplay::dbRender() {
         return;
     }
 
+    // culled,material len keeps zero
+    _interpolatePose = false;
+    if (_cullingEnabled && !updateCulling()) {
+        return;
+    }
+
     _preBlendMode = -1;
     _preTextureIndex = -1;
     _curTextureIndex = -1;
@@ -148,6 +156,9 @@ void CCArmatureDisplay::dbRender() {
 
     // Traverse all aramture to fill vertex and index buffer.
     traverseArmature(_armature);
+    if (_interpolatePose) {
+        _resetPoseHistory = false;
+    }
 
     renderInfo->writeUint32(materialLenOffset, _materialLen);
     if (_preISegWritePos != -1) {
@@ -204,6 +215,90 @@ void CCArmatureDisplay::dbRender() {
             CC_LOG_INFO("You can adjust MAX_DEBUG_BUFFER_SIZE in MiddlewareMacro");
         }
     }
+
+    // record may have been moved to another chunk,refresh offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
+}
+
+void CCArmatureDisplay::setPoseUpdateEnabled(Armature *armature, bool enabled, bool forceUpdate) {
+    armature->_updatePose = enabled;
+    if (forceUpdate) {
+        // Zero time will not dispatch events again, only evaluate pose.
+        armature->advanceTime(0.0f);
+    }
+
+    for (const auto slot : armature->getSlots()) {
+        Armature *childArmature = slot->getChildArmature();
+        if (childArmature) {
+            setPoseUpdateEnabled(childArmature, enabled, forceUpdate);
+        }
+    }
+}
+
+bool CCArmatureDisplay::updateCulling() {
+    auto paramsBuffer = _paramsBuffer->getBuffer();
+    // data store in buffer which 68 to 71 is screen size
+    float screenSize = *(float *)&paramsBuffer[68];
+
+    if (screenSize <= 0.0f) {
+        // Animation time and events keep going,pose will be evaluated when visible again.
+        if (!_culled) {
+            _culled = true;
+            setPoseUpdateEnabled(_armature, false, false);
+        }
+        _skippedPoseCount++;
+        _skippedRenderCount++;
+        return false;
+    }
+
+    if (_culled) {
+        _culled = false;
+        _lowDetailFrame = 0;
+        _resetPoseHistory = true;
+        setPoseUpdateEnabled(_armature, true, true);
+    }
+
+    // Pose of this frame was decided by the previous one.
+    _framesSincePose = _armature->_updatePose ? 0 : _framesSincePose + 1;
+    bool lowDetail = _lowDetailInterval > 1 && screenSize < _lowDetailScreenSize;
+    // Shown one interval late,the last evaluated pose is reached right before the next evaluation.
+    _interpolatePose = lowDetail;
+    _poseEvaluated = _framesSincePose == 0;
+    _poseBlend = middleware::PoseHistory::getBlend(_framesSincePose, _lowDetailInterval);
+    if (!lowDetail) {
+        _resetPoseHistory = true;
+    }
+
+    // Decide whether next frame should evaluate pose.
+    bool updatePose = true;
+    if (lowDetail) {
+        _lowDetailFrame = (_lowDetailFrame + 1) % _lowDetailInterval;
+        updatePose = _lowDetailFrame == 0;
+    }
+    if (_armature->_updatePose != updatePose) {
+        setPoseUpdateEnabled(_armature, updatePose, false);
+    }
+    if (!updatePose) {
+        _skippedPoseCount++;
+    }
+    return true;
+}
+
+void CCArmatureDisplay::setCullingEnabled(bool enabled) {
+    _cullingEnabled = enabled;
+    if (!enabled && _armature) {
+        _culled = false;
+        _lowDetailFrame = 0;
+        setPoseUpdateEnabled(_armature, true, false);
+    }
+    _resetPoseHistory = true;
+}
+
+void CCArmatureDisplay::setLowDetailUpdate(float minScreenSize, int interval) {
+    _lowDetailScreenSize = minScreenSize;
+    _lowDetailInterval = interval > 1 ? interval : 1;
+    _lowDetailFrame = 0;
+    _resetPoseHistory = true;
 }
 
 cc::Vec2 CCArmatureDisplay::convertToRootSpace(float x, float y) const {
@@ -365,11 +460,32 @@ void CCArmatureDisplay::traverseArmature(Armature *armature, float parentOpacity
 
         middleware::V2F_T2F_C4F *worldTriangles = slot->worldVerts;
 
-        for (int v = 0, w = 0, vn = triangles.vertCount; v < vn; ++v, w += 2) {
+        // Blend in armature space,node transform is applied afterwards and never lags behind.
+        middleware::PoseHistory *poseHistory = nullptr;
+        if (_interpolatePose) {
+            poseHistory = &slot->poseHistory;
+            poseHistory->begin(triangles.vertCount, _resetPoseHistory, _poseEvaluated);
+        }
+
+        for (int v = 0, vn = triangles.vertCount; v < vn; ++v) {
             middleware::V2F_T2F_C4F *vertex = triangles.verts + v;
             middleware::V2F_T2F_C4F *worldVertex = worldTriangles + v;
-            worldVertex->vertex.x = vertex->vertex.x * worldMatrix->m[0] + vertex->vertex.y * worldMatrix->m[4] + worldMatrix->m[12];
-            worldVertex->vertex.y = vertex->vertex.x * worldMatrix->m[1] + vertex->vertex.y * worldMatrix->m[5] + worldMatrix->m[13];
+            if (poseHistory) {
+                const cc::Mat4 &slotMatrix = slot->worldMatrix;
+                float x = vertex->vertex.x * slotMatrix.m[0] + vertex->vertex.y * slotMatrix.m[4] + slotMatrix.m[12];
+                float y = vertex->vertex.x * slotMatrix.m[1] + vertex->vertex.y * slotMatrix.m[5] + slotMatrix.m[13];
+                poseHistory->blend(v, _poseBlend, x, y);
+                if (_batch) {
+                    worldVertex->vertex.x = x * nodeWorldMat.m[0] + y * nodeWorldMat.m[4] + nodeWorldMat.m[12];
+                    worldVertex->vertex.y = x * nodeWorldMat.m[1] + y * nodeWorldMat.m[5] + nodeWorldMat.m[13];
+                } else {
+                    worldVertex->vertex.x = x;
+                    worldVertex->vertex.y = y;
+                }
+            } else {
+                worldVertex->vertex.x = vertex->vertex.x * worldMatrix->m[0] + vertex->vertex.y * worldMatrix->m[4] + worldMatrix->m[12];
+                worldVertex->vertex.y = vertex->vertex.x * worldMatrix->m[1] + vertex->vertex.y * worldMatrix->m[5] + worldMatrix->m[13];
+            }
 
             worldVertex->color.r = r;
             worldVertex->color.g = g;
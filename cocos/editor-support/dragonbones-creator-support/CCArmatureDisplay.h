@@ -53,6 +53,11 @@ public:
 
 private:
     void traverseArmature(Armature *armature, float parentOpacity = 1.0f);
+    /**
+     * @return false if armature is invisible and should not be rendered.
+     */
+    bool updateCulling();
+    static void setPoseUpdateEnabled(Armature *armature, bool enabled, bool forceUpdate);
 
 protected:
     bool _debugDraw = false;
@@ -128,12 +133,12 @@ public:
     se_object_ptr getDebugData() const;
     /**
      * @return shared buffer offset, it's a Uint32Array
-     * format |render info offset|attach info offset|
+     * format |render info offset|attach info offset|render info chunk|attach info chunk|
      */
     se_object_ptr getSharedBufferOffset() const;
     /**
      * @return js send to cpp parameters, it's a Uint32Array
-     * format |render order|world matrix|
+     * format |render order|world matrix|screen size|
      */
     se_object_ptr getParamsBuffer() const;
 
@@ -156,6 +161,40 @@ public:
         _premultipliedAlpha = value;
     }
 
+    /**
+     * @brief Enable visibility driven update.Js should fill projected screen size
+     * in pixels into params buffer,zero means invisible.Invisible armature only
+     * advances animation time and dispatches events,without pose evaluation and rendering.
+     */
+    void setCullingEnabled(bool enabled);
+
+    /**
+     * @brief When culling is enabled,armature which screen size is less than
+     * minScreenSize evaluates pose once every interval frames.Frames between two
+     * evaluations blend the vertices of the last two evaluated poses,so motion stays
+     * smooth at the cost of showing the pose up to one interval late.
+     */
+    void setLowDetailUpdate(float minScreenSize, int interval);
+
+    /**
+     * @return count of frames which pose evaluation is skipped.
+     */
+    uint32_t getSkippedPoseCount() const {
+        return _skippedPoseCount;
+    }
+
+    /**
+     * @return count of frames which rendering is skipped.
+     */
+    uint32_t getSkippedRenderCount() const {
+        return _skippedRenderCount;
+    }
+
+    void resetSkippedCount() {
+        _skippedPoseCount = 0;
+        _skippedRenderCount = 0;
+    }
+
     /**
      * @brief Convert component position to global position.
      * @param[in] pos Component position
@@ -185,6 +224,21 @@ private:
     bool _batch = true;
     bool _useAttach = false;
     bool _premultipliedAlpha = false;
+
+    bool _cullingEnabled = false;
+    bool _culled = false;
+    float _lowDetailScreenSize = 0.0f;
+    int _lowDetailInterval = 1;
+    int _lowDetailFrame = 0;
+    // Low detail frames blend between the last two evaluated poses.
+    bool _interpolatePose = false;
+    bool _poseEvaluated = true;
+    bool _resetPoseHistory = true;
+    int _framesSincePose = 0;
+    float _poseBlend = 1.0f;
+    uint32_t _skippedPoseCount = 0;
+    uint32_t _skippedRenderCount = 0;
+
     cc::middleware::Color4F _nodeColor = cc::middleware::Color4F::WHITE;
     dbEventCallback _dbEventCallback = nullptr;
 
@@ -35,6 +35,7 @@ void CCSlot::_onClear() {
     _localMatrix.setIdentity();
     worldMatrix.setIdentity();
     _worldMatDirty = true;
+    poseHistory.clear();
 }
 
 void CCSlot::disposeTriangles() {
@@ -28,6 +28,7 @@
 #include "math/Geometry.h"
 #include "math/Mat4.h"
 #include "middleware-adapter.h"
+#include "PoseHistory.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -53,6 +54,8 @@ public:
     cc::middleware::Triangles triangles;
     // Slot vertex transform to World vertex
     cc::middleware::V2F_T2F_C4F *worldVerts = nullptr;
+    // Armature space poses,only kept while the armature display blends low detail frames
+    cc::middleware::PoseHistory poseHistory;
     cc::middleware::Color4B color;
     cc::Rect boundsRect;
 
@@ -546,8 +546,10 @@ void AnimationState::advanceTime(float passedTime, float cacheFrameRate)
         return;
     }
 
-    const auto isCacheEnabled = _fadeState == 0 && cacheFrameRate > 0.0f;
-    auto isUpdateTimeline = true;
+    // Pose is not needed, only keep action timeline running to dispatch events.
+    const auto isUpdatePose = _armature->_updatePose;
+    const auto isCacheEnabled = isUpdatePose && _fadeState == 0 && cacheFrameRate > 0.0f;
+    auto isUpdateTimeline = isUpdatePose;
     auto isUpdateBoneTimeline = true;
     auto time = _time;
     _weightResult = weight * _fadeProgress;
@@ -68,6 +68,7 @@ void Armature::_onClear()
     _flipX = false;
     _flipY = false;
     _cacheFrameIndex = -1;
+    _updatePose = true;
     _bones.clear();
     _slots.clear();
     _constraints.clear();
@@ -208,7 +209,7 @@ void Armature::advanceTime(float passedTime)
     }
 
     // Update bones and slots.
-    if (_cacheFrameIndex < 0 || _cacheFrameIndex != prevCacheFrameIndex)
+    if (_updatePose && (_cacheFrameIndex < 0 || _cacheFrameIndex != prevCacheFrameIndex))
     {
         for (const auto bone : _bones)
         {
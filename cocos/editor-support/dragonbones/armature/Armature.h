@@ -80,6 +80,11 @@ public:
      * @internal
      */
     int _cacheFrameIndex;
+    /**
+     * @internal
+     * If false, only animation time, events and actions are advanced, bones and slots pose is not evaluated.
+     */
+    bool _updatePose;
     /**
      * @internal
      */
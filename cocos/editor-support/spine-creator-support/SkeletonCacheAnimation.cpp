@@ -57,7 +57,7 @@ SkeletonCacheAnimation::SkeletonCacheAnimation(const std::string &uuid, bool isS
     }
 
     // store global TypedArray begin and end offset
-    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 2);
+    _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 4);
 
     // store render order(1), world matrix(16)
     _paramsBuffer = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, sizeof(float) * 17);
@@ -182,13 +182,13 @@ void SkeletonCacheAnimation::render(float dt) {
     auto attachInfo = attachMgr->getBuffer();
     if (!attachInfo) return;
 
-    //  store render info offset
-    _sharedBufferOffset->writeUint32((uint32_t)renderInfo->getCurPos() / sizeof(uint32_t));
-    // store attach info offset
-    _sharedBufferOffset->writeUint32((uint32_t)attachInfo->getCurPos() / sizeof(uint32_t));
+    // mark record beginning,record will be moved as a whole if a new chunk is linked
+    mgr->beginRecord();
 
     // check enough space
     renderInfo->checkSpace(sizeof(uint32_t) * 2, true);
+    // store render info and attach info offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
     // write border
     renderInfo->writeUint32(0xffffffff);
 
@@ -398,6 +398,9 @@ void SkeletonCacheAnimation::render(float dt) {
             attachInfo->writeBytes((const char *)&bone->globalTransformMatrix, sizeof(cc::Mat4));
         }
     }
+
+    // record may have been moved to another chunk,refresh offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
 }
 
 Skeleton *SkeletonCacheAnimation::getSkeleton() const {
@@ -90,7 +90,7 @@ void SkeletonRenderer::initialize() {
 
     if (_sharedBufferOffset == nullptr) {
         // store global TypedArray begin and end offset
-        _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 2);
+        _sharedBufferOffset = new IOTypedArray(se::Object::TypedArrayType::UINT32, sizeof(uint32_t) * 4);
     }
 
     if (_paramsBuffer == nullptr) {
@@ -287,13 +287,13 @@ void SkeletonRenderer::render(float deltaTime) {
     auto attachInfo = attachMgr->getBuffer();
     if (!attachInfo) return;
 
-    //  store render info offset
-    _sharedBufferOffset->writeUint32((uint32_t)renderInfo->getCurPos() / sizeof(uint32_t));
-    // store attach info offset
-    _sharedBufferOffset->writeUint32((uint32_t)attachInfo->getCurPos() / sizeof(uint32_t));
+    // mark record beginning,record will be moved as a whole if a new chunk is linked
+    mgr->beginRecord();
 
     // check enough space
     renderInfo->checkSpace(sizeof(uint32_t) * 2, true);
+    // store render info and attach info offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
     // write border
     renderInfo->writeUint32(0xffffffff);
 
@@ -903,6 +903,9 @@ void SkeletonRenderer::render(float deltaTime) {
         }
     }
 
+    // record may have been moved to another chunk,refresh offset
+    mgr->fillSharedBufferOffset(_sharedBufferOffset);
+
     // debug end
     if (_debugBuffer) {
         if (_debugBuffer->isOutRange()) {
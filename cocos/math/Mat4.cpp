@@ -106,7 +106,7 @@ void Mat4::createPerspective(float fieldOfView, float aspectRatio,
     const float minClipZ = -1.0f;
     const float projectionSignY = 1.0f;
 
-    const float f = 1.0f / std::tanf(fieldOfView / 2.0f);
+    const float f = 1.0f / std::tan(fieldOfView / 2.0f);
     const float nf = 1.0f / (zNearPlane - zFarPlane);
 
     const float x = f / aspectRatio;
@@ -40,6 +40,7 @@
 
     #include "base/UTF8.h"
     #include "base/Log.h"
+    #include "base/memory/AllocProfiler.h"
 
     #ifndef JCLS_HTTPCLIENT
         #define JCLS_HTTPCLIENT "com/cocos/lib/CocosHttpURLConnection"
@@ -695,6 +696,7 @@ void HttpClient::processResponse(HttpResponse *response, char *responseMessage)
 // Worker thread
 void HttpClient::networkThread() {
     increaseThreadCount();
+    CC_MEM_TAG_SCOPE(NETWORK);
 
     while (true) {
         HttpRequest *request;
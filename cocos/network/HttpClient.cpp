@@ -26,13 +26,16 @@
  ****************************************************************************/
 
 #include "network/HttpClient.h"
+#include <algorithm>
 #include <queue>
+#include <unordered_map>
 #include <errno.h>
 #include <curl/curl.h>
 #include "platform/FileUtils.h"
 #include "platform/Application.h"
 #include "platform/StdC.h"
 #include "base/Log.h"
+#include "base/memory/AllocProfiler.h"
 
 namespace cc {
 
@@ -48,11 +51,21 @@ typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *str
 
 // Callback function used by libcurl for collect response data
 static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    std::vector<char> *recvBuffer = (std::vector<char> *)stream;
+    HttpResponse *response = (HttpResponse *)stream;
     size_t sizes = size * nmemb;
 
+    // streaming mode, the body is handed out and not kept in response
+    const ccHttpRequestDataCallback &dataCallback = response->getHttpRequest()->getResponseDataCallback();
+    if (dataCallback) {
+        return dataCallback((const char *)ptr, sizes) ? sizes : 0;
+    }
+    if (FILE *fp = response->getResponseFile()) {
+        return fwrite(ptr, 1, sizes, fp);
+    }
+
     // add data to the end of recvBuffer
     // write data maybe called more than once in a single request
+    std::vector<char> *recvBuffer = response->getResponseData();
     recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
 
     return sizes;
@@ -60,72 +73,75 @@ static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
 
 // Callback function used by libcurl for collect header data
 static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    std::vector<char> *recvBuffer = (std::vector<char> *)stream;
+    HttpResponse *response = (HttpResponse *)stream;
     size_t sizes = size * nmemb;
 
+    // reserve body buffer by content length, so it needn't grow while receiving.
+    // The header comes from the server, larger bodies still grow the buffer as data arrives
+    static const size_t maxReserveSize = 8 * 1024 * 1024;
+    static const char contentLengthKey[] = "content-length:";
+    const size_t keyLength = sizeof(contentLengthKey) - 1;
+    if (sizes > keyLength && std::equal(contentLengthKey, contentLengthKey + keyLength, (const char *)ptr, [](char a, char b) { return a == tolower((unsigned char)b); })) {
+        HttpRequest *request = response->getHttpRequest();
+        if (!request->getResponseDataCallback() && request->getResponseFilePath().empty()) {
+            std::string value((const char *)ptr + keyLength, sizes - keyLength);
+            unsigned long long contentLength = strtoull(value.c_str(), nullptr, 10);
+            std::vector<char> *recvBuffer = response->getResponseData();
+            if (contentLength > recvBuffer->size()) {
+                recvBuffer->reserve(static_cast<size_t>(std::min<unsigned long long>(contentLength, maxReserveSize)));
+            }
+        }
+    }
+
     // add data to the end of recvBuffer
     // write data maybe called more than once in a single request
+    std::vector<char> *recvBuffer = response->getResponseHeader();
     recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
 
     return sizes;
 }
 
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-// Worker thread
-void HttpClient::networkThread() {
-    increaseThreadCount();
-
-    while (true) {
-        HttpRequest *request;
-
-        // step 1: send http request if the requestQueue isn't empty
-        {
-            std::lock_guard<std::mutex> lock(_requestQueueMutex);
-            while (_requestQueue.empty()) {
-                _sleepCondition.wait(_requestQueueMutex);
-            }
-            request = _requestQueue.at(0);
-            _requestQueue.erase(0);
-        }
-
-        if (request == _requestSentinel) {
-            break;
-        }
-
-        // step 2: libcurl sync access
-
-        // Create a HttpResponse object, the default setting is http access failed
-        HttpResponse *response = new (std::nothrow) HttpResponse(request);
-
-        processResponse(response, _responseMessage);
-
-        // add response packet into queue
-        _responseQueueMutex.lock();
-        _responseQueue.pushBack(response);
-        _responseQueueMutex.unlock();
+// Open the file response body is written to, if there is one
+static bool beginResponseData(HttpResponse *response, char *errorBuffer) {
+    const std::string &filePath = response->getHttpRequest()->getResponseFilePath();
+    if (filePath.empty()) {
+        return true;
+    }
+    FILE *fp = fopen(FileUtils::getInstance()->getSuitableFOpen(filePath).c_str(), "wb");
+    if (!fp) {
+        snprintf(errorBuffer, HttpClient::RESPONSE_BUFFER_SIZE, "Can't open file %s", filePath.c_str());
+        return false;
+    }
+    response->setResponseFile(fp);
+    return true;
+}
 
-        _schedulerMutex.lock();
-        if (auto sche = _scheduler.lock()) {
-            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
-        }
-        _schedulerMutex.unlock();
+// Close the file response body is written to, partial file is removed if request failed
+static void endResponseData(HttpResponse *response, bool succeed) {
+    FILE *fp = response->getResponseFile();
+    if (!fp) {
+        return;
     }
+    fclose(fp);
+    response->setResponseFile(nullptr);
+    if (!succeed) {
+        FileUtils::getInstance()->removeFile(response->getHttpRequest()->getResponseFilePath());
+    }
+}
 
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    _requestQueueMutex.lock();
-    _requestQueue.clear();
-    _requestQueueMutex.unlock();
+// wait timeout of network thread when libcurl can't be woken up by new requests
+#define CC_HTTP_MULTI_WAIT_MS 10
 
-    _responseQueueMutex.lock();
-    _responseQueue.clear();
-    _responseQueueMutex.unlock();
+// TLS sessions and DNS entries are shared by all requests, including the ones sent immediately from other threads
+static CURLSH *_shareHandle = nullptr;
+static std::mutex _shareMutexes[CURL_LOCK_DATA_LAST];
 
-    decreaseThreadCountAndMayDeleteThis();
+static void lockShareData(CURL * /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void * /*userptr*/) {
+    _shareMutexes[data].lock();
+}
+
+static void unlockShareData(CURL * /*handle*/, curl_lock_data data, void * /*userptr*/) {
+    _shareMutexes[data].unlock();
 }
 
 // Worker thread
@@ -189,6 +205,17 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
 
     curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
 
+    if (_shareHandle) {
+        curl_easy_setopt(handle, CURLOPT_SHARE, _shareHandle);
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x072f00
+    // use HTTP/2 for https if both libcurl and server support it, otherwise fall back to HTTP/1.1
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    // prefer waiting for a connection that can be multiplexed over opening a new one
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif
+
     return true;
 }
 
@@ -252,9 +279,17 @@ public:
         return setOption(CURLOPT_URL, request->getUrl()) && setOption(CURLOPT_WRITEFUNCTION, callback) && setOption(CURLOPT_WRITEDATA, stream) && setOption(CURLOPT_HEADERFUNCTION, headerCallback) && setOption(CURLOPT_HEADERDATA, headerStream);
     }
 
+    CURL *getHandle() const { return _curl; }
+
     /// @param responseCode Null not allowed
     bool perform(long *responseCode) {
-        if (CURLE_OK != curl_easy_perform(_curl))
+        return finish(curl_easy_perform(_curl), responseCode);
+    }
+
+    /// @param result Result of the transfer
+    /// @param responseCode Null not allowed
+    bool finish(CURLcode result, long *responseCode) {
+        if (CURLE_OK != result)
             return false;
         CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
         if (code != CURLE_OK || !(*responseCode >= 200 && *responseCode < 300)) {
@@ -267,39 +302,181 @@ public:
     }
 };
 
-//Process Get Request
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+// Setup options depending on request type
+static bool setupRequestType(HttpRequest *request, CURLRaii &curl) {
+    switch (request->getRequestType()) {
+        case HttpRequest::Type::GET: // HTTP GET
+            return curl.setOption(CURLOPT_FOLLOWLOCATION, true);
 
-//Process POST Request
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+        case HttpRequest::Type::POST: // HTTP POST
+            return curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
 
-//Process PUT Request
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+        case HttpRequest::Type::PUT:
+            return curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
 
-//Process HEAD Request
-static int processHeadTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+        case HttpRequest::Type::HEAD:
+            return curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+        case HttpRequest::Type::DELETE:
+            return curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true);
+
+        default:
+            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
+            return false;
+    }
 }
 
-//Process DELETE Request
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
+// A request being processed by network thread
+struct HttpTransfer {
+    HttpRequest *request = nullptr;
+    HttpResponse *response = nullptr;
     CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    char errorBuffer[HttpClient::RESPONSE_BUFFER_SIZE] = {0};
+};
+
+// Worker thread
+void HttpClient::networkThread() {
+    increaseThreadCount();
+    CC_MEM_TAG_SCOPE(NETWORK);
+
+    CURLM *multiHandle = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+    // requests to the same host share one HTTP/2 connection
+    curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+    _requestQueueMutex.lock();
+    _multiHandle = multiHandle;
+    _requestQueueMutex.unlock();
+
+    std::unordered_map<CURL *, HttpTransfer *> transfers;
+    bool quit = false;
+
+    auto finishTransfer = [this](HttpTransfer *transfer, bool succeed, long responseCode) {
+        HttpResponse *response = transfer->response;
+        endResponseData(response, succeed);
+        response->setResponseCode(responseCode);
+        response->setSucceed(succeed);
+        if (!succeed) {
+            response->setErrorBuffer(transfer->errorBuffer);
+        }
+        delete transfer;
+
+        // add response packet into queue
+        _responseQueueMutex.lock();
+        _responseQueue.pushBack(response);
+        _responseQueueMutex.unlock();
+
+        _schedulerMutex.lock();
+        if (auto sche = _scheduler.lock()) {
+            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+        }
+        _schedulerMutex.unlock();
+    };
+
+    while (!quit) {
+        // step 1: start queued requests until reach the concurrency limit
+        {
+            std::lock_guard<std::mutex> lock(_requestQueueMutex);
+            while (transfers.empty() && _requestQueue.empty()) {
+                _sleepCondition.wait(_requestQueueMutex);
+            }
+
+            size_t maxConcurrentRequests = static_cast<size_t>(_maxConcurrentRequests.load());
+            while (!_requestQueue.empty() && transfers.size() < maxConcurrentRequests) {
+                HttpRequest *request = _requestQueue.at(0);
+                if (request == _requestSentinel) {
+                    quit = true;
+                    break;
+                }
+                _requestQueue.erase(0);
+
+                // Create a HttpResponse object, the default setting is http access failed
+                auto *transfer = new (std::nothrow) HttpTransfer();
+                transfer->request = request;
+                transfer->response = new (std::nothrow) HttpResponse(request);
+
+                CURLRaii &curl = transfer->curl;
+                bool ok = beginResponseData(transfer->response, transfer->errorBuffer) && curl.init(this, request, writeData, transfer->response, writeHeaderData, transfer->response, transfer->errorBuffer) && setupRequestType(request, curl) && curl.setOption(CURLOPT_PRIVATE, transfer);
+                CURLMcode mcode = ok ? curl_multi_add_handle(multiHandle, curl.getHandle()) : CURLM_OK;
+                if (!ok || CURLM_OK != mcode) {
+                    if (ok) {
+                        snprintf(transfer->errorBuffer, sizeof(transfer->errorBuffer), "%s", curl_multi_strerror(mcode));
+                    }
+                    finishTransfer(transfer, false, -1);
+                    continue;
+                }
+                transfers[curl.getHandle()] = transfer;
+            }
+        }
+
+        if (quit) {
+            break;
+        }
+
+        // step 2: drive transfers and collect the finished ones
+        int runningHandles = 0;
+        if (CURLM_OK != curl_multi_perform(multiHandle, &runningHandles)) {
+            CC_LOG_ERROR("HttpClient: curl_multi_perform failed");
+        }
+
+        CURLMsg *msg = nullptr;
+        int msgInQueue = 0;
+        while ((msg = curl_multi_info_read(multiHandle, &msgInQueue))) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            CURL *handle = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            auto iter = transfers.find(handle);
+            if (iter == transfers.end()) {
+                continue;
+            }
+            HttpTransfer *transfer = iter->second;
+            transfers.erase(iter);
+            curl_multi_remove_handle(multiHandle, handle);
+
+            long responseCode = -1;
+            bool succeed = transfer->curl.finish(result, &responseCode);
+            finishTransfer(transfer, succeed, responseCode);
+        }
+
+        // step 3: wait for socket activity, new requests wake it up if libcurl supports it
+        if (!transfers.empty()) {
+#if LIBCURL_VERSION_NUM >= 0x074400
+            curl_multi_poll(multiHandle, nullptr, 0, 1000, nullptr);
+#else
+            curl_multi_wait(multiHandle, nullptr, 0, CC_HTTP_MULTI_WAIT_MS, nullptr);
+#endif
+        }
+    }
+
+    _requestQueueMutex.lock();
+    _multiHandle = nullptr;
+    _requestQueueMutex.unlock();
+
+    // cleanup: if worker thread received quit signal, abort requests in flight
+    for (auto &e : transfers) {
+        HttpTransfer *transfer = e.second;
+        curl_multi_remove_handle(multiHandle, e.first);
+        // the body file is incomplete, close and remove it
+        endResponseData(transfer->response, false);
+        transfer->response->release();
+        transfer->request->release();
+        delete transfer;
+    }
+    transfers.clear();
+    curl_multi_cleanup(multiHandle);
+
+    // clean up un-completed request queue
+    _requestQueueMutex.lock();
+    _requestQueue.clear();
+    _requestQueueMutex.unlock();
+
+    _responseQueueMutex.lock();
+    _responseQueue.clear();
+    _responseQueueMutex.unlock();
+
+    decreaseThreadCountAndMayDeleteThis();
 }
 
 // HttpClient implementation
@@ -364,9 +541,21 @@ HttpClient::HttpClient()
     memset(_responseMessage, 0, RESPONSE_BUFFER_SIZE * sizeof(char));
     _scheduler = Application::getInstance()->getScheduler();
     increaseThreadCount();
+
+    _shareHandle = curl_share_init();
+    if (_shareHandle) {
+        curl_share_setopt(_shareHandle, CURLSHOPT_LOCKFUNC, lockShareData);
+        curl_share_setopt(_shareHandle, CURLSHOPT_UNLOCKFUNC, unlockShareData);
+        curl_share_setopt(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
 }
 
 HttpClient::~HttpClient() {
+    if (_shareHandle) {
+        curl_share_cleanup(_shareHandle);
+        _shareHandle = nullptr;
+    }
     CC_SAFE_RELEASE(_requestSentinel);
     CC_LOG_DEBUG("HttpClient destructor");
 }
@@ -398,6 +587,11 @@ void HttpClient::send(HttpRequest *request) {
 
     _requestQueueMutex.lock();
     _requestQueue.pushBack(request);
+#if LIBCURL_VERSION_NUM >= 0x074400
+    if (_multiHandle) {
+        curl_multi_wakeup(static_cast<CURLM *>(_multiHandle));
+    }
+#endif
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
@@ -448,68 +642,15 @@ void HttpClient::dispatchResponseCallbacks() {
 void HttpClient::processResponse(HttpResponse *response, char *responseMessage) {
     auto request = response->getHttpRequest();
     long responseCode = -1;
-    int retValue = 0;
 
     // Process the request -> get response packet
-    switch (request->getRequestType()) {
-        case HttpRequest::Type::GET: // HTTP GET
-            retValue = processGetTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::POST: // HTTP POST
-            retValue = processPostTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::PUT:
-            retValue = processPutTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::HEAD:
-            retValue = processHeadTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::DELETE:
-            retValue = processDeleteTask(this, request,
-                                         writeData,
-                                         response->getResponseData(),
-                                         &responseCode,
-                                         writeHeaderData,
-                                         response->getResponseHeader(),
-                                         responseMessage);
-            break;
-
-        default:
-            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
-            break;
-    }
+    CURLRaii curl;
+    bool ok = beginResponseData(response, responseMessage) && curl.init(this, request, writeData, response, writeHeaderData, response, responseMessage) && setupRequestType(request, curl) && curl.perform(&responseCode);
+    endResponseData(response, ok);
 
     // write data to HttpResponse
     response->setResponseCode(responseCode);
-    if (retValue != 0) {
+    if (!ok) {
         response->setSucceed(false);
         response->setErrorBuffer(responseMessage);
     } else {
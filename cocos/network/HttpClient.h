@@ -28,6 +28,7 @@
 #ifndef __CCHTTPCLIENT_H__
 #define __CCHTTPCLIENT_H__
 
+#include <atomic>
 #include <thread>
 #include <condition_variable>
 #include "base/Vector.h"
@@ -146,6 +147,21 @@ public:
      */
     CC_DEPRECATED_ATTRIBUTE int getTimeoutForRead();
 
+    /**
+     * Set the max number of requests sent by `send` that are processed at the same time.
+     * Only the curl implementation runs requests concurrently, other platforms process them one by one.
+     *
+     * @param value the max number of concurrent requests, at least 1.
+     */
+    void setMaxConcurrentRequests(int value) { _maxConcurrentRequests = value > 0 ? value : 1; }
+
+    /**
+     * Get the max number of requests sent by `send` that are processed at the same time.
+     *
+     * @return the max number of concurrent requests.
+     */
+    int getMaxConcurrentRequests() const { return _maxConcurrentRequests; }
+
     HttpCookie *getCookie() const { return _cookie; }
 
     std::mutex &getCookieFileMutex() { return _cookieFileMutex; }
@@ -200,6 +216,10 @@ private:
 
     HttpCookie *_cookie;
 
+    std::atomic<int> _maxConcurrentRequests{16};
+    // curl multi handle of network thread, used to wake it up when new requests are sent
+    void *_multiHandle = nullptr;
+
     std::condition_variable_any _sleepCondition;
 
     char _responseMessage[RESPONSE_BUFFER_SIZE];
@@ -47,6 +47,8 @@ class HttpClient;
 class HttpResponse;
 
 typedef std::function<void(HttpClient *, HttpResponse *)> ccHttpRequestCallback;
+// data, size, return false to abort the request
+typedef std::function<bool(const char *, size_t)> ccHttpRequestDataCallback;
 
 /**
  * Defines the object which users must packed for HttpClient::send(HttpRequest*) method.
@@ -236,6 +238,44 @@ public:
         return _callback;
     }
 
+    /**
+     * Set the callback to receive response body in chunks as they arrive, the body is not kept in HttpResponse then.
+     * The callback is invoked in network thread, return false from it to abort the request.
+     *
+     * @param callback the ccHttpRequestDataCallback function.
+     */
+    inline void setResponseDataCallback(const ccHttpRequestDataCallback &callback) {
+        _dataCallback = callback;
+    }
+
+    /**
+     * Get ccHttpRequestDataCallback callback function.
+     *
+     * @return const ccHttpRequestDataCallback& ccHttpRequestDataCallback callback function.
+     */
+    inline const ccHttpRequestDataCallback &getResponseDataCallback() const {
+        return _dataCallback;
+    }
+
+    /**
+     * Set the file to write response body to, the body is not kept in HttpResponse then.
+     * The file is removed if the request fails.
+     *
+     * @param path the full path of the file.
+     */
+    inline void setResponseFilePath(const std::string &path) {
+        _responseFilePath = path;
+    }
+
+    /**
+     * Get the file to write response body to.
+     *
+     * @return const std::string& the full path of the file, empty if response body is kept in memory.
+     */
+    inline const std::string &getResponseFilePath() const {
+        return _responseFilePath;
+    }
+
     /**
      * Set custom-defined headers.
      *
@@ -269,6 +309,8 @@ protected:
     std::vector<char> _requestData;    /// used for POST
     std::string _tag;                  /// user defined tag, to identify different requests in response callback
     ccHttpRequestCallback _callback;   /// C++11 style callbacks
+    ccHttpRequestDataCallback _dataCallback; /// receives response body in chunks
+    std::string _responseFilePath;     /// file to write response body to
     void *_userData;                   /// You can add your customed data here
     std::vector<std::string> _headers; /// custom http headers
     float _timeoutInSeconds;
@@ -28,6 +28,7 @@
 #define __HTTP_RESPONSE__
 
 #include "network/HttpRequest.h"
+#include <cstdio>
 
 /**
  * @addtogroup network
@@ -64,6 +65,9 @@ public:
      * Users don't need to destruct HttpResponse object manually.
      */
     virtual ~HttpResponse() {
+        if (_responseFile) {
+            fclose(_responseFile);
+        }
         if (_pHttpRequest) {
             _pHttpRequest->release();
         }
@@ -109,6 +113,22 @@ public:
         return &_responseData;
     }
 
+    /**
+     * Get the file response body is being written to, it is used by HttpClient.
+     * @return FILE* the opened file, nullptr if response body isn't written to a file.
+     */
+    inline FILE *getResponseFile() const {
+        return _responseFile;
+    }
+
+    /**
+     * Set the file response body is written to, it is used by HttpClient.
+     * @param file the opened file, HttpResponse closes it on destruction.
+     */
+    inline void setResponseFile(FILE *file) {
+        _responseFile = file;
+    }
+
     /**
      * Get the response headers.
      * @return std::vector<char>* the pointer that point to the _responseHeader.
@@ -210,6 +230,7 @@ protected:
     long _responseCode;                /// the status code returned from libcurl, e.g. 200, 404
     std::string _errorBuffer;          /// if _responseCode != 200, please read _errorBuffer to find the reason
     std::string _responseDataString;   // the returned raw data. You can also dump it as a string
+    FILE *_responseFile = nullptr;     /// file response body is written to
 };
 
 } // namespace network
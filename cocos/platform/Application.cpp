@@ -23,6 +23,9 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "cocos/platform/Application.h"
+#include "cocos/base/JobSystem.h"
+#include "cocos/base/Log.h"
+#include "cocos/base/memory/AllocProfiler.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 
 #if USE_AUDIO
@@ -55,6 +58,8 @@ void Application::restartVM() {
     _scheduler->unscheduleAll();
 
     scriptEngine->cleanup();
+    // the workers are created again by the next pipeline that uses them
+    cc::JobSystem::destroyInstance();
     cc::EventDispatcher::destroy();
 
     // start
@@ -78,7 +83,7 @@ void Application::tick() {
     ++_totalFrames;
 
     // iOS/macOS use its own fps limitation algorithm.
-#if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_WINDOWS)
+#if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_LINUX)
     if (dtNS < _prefererredNanosecondsPerFrame) {
         std::this_thread::sleep_for(
             std::chrono::nanoseconds(_prefererredNanosecondsPerFrame - static_cast<long>(dtNS)));
@@ -89,7 +94,20 @@ void Application::tick() {
     prevTime = std::chrono::steady_clock::now();
 
     _scheduler->update(dt);
-    cc::EventDispatcher::dispatchTickEvent(dt);
+    {
+        CC_MEM_TAG_SCOPE(SCRIPT);
+        cc::EventDispatcher::dispatchTickEvent(dt);
+    }
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    if (_totalFrames == 1) {
+        auto scriptEngine = se::ScriptEngine::getInstance();
+        const auto &stats = scriptEngine->getCodeCacheStats();
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - scriptEngine->getStartTime()).count();
+        CC_LOG_INFO("First frame after %.2f ms, script compile %.2f ms, code cache hit: %u, miss: %u, rejected: %u",
+                    elapsed, stats.compileMs, stats.hit, stats.miss, stats.rejected);
+    }
+#endif
 
     PoolManager::getInstance()->getCurrentPool()->clear();
 
@@ -0,0 +1,413 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/FileArchive.h"
+#include "base/Log.h"
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include "platform/win32/Utils-win32.h"
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+        #include "platform/android/FileUtils-android.h"
+        #define ASSETS_FOLDER_NAME "@assets/"
+    #endif
+#endif
+
+namespace cc {
+
+namespace {
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+constexpr uint32_t ZIP64_END_OF_CENTRAL_DIR_SIGNATURE = 0x06064b50;
+constexpr uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr uint16_t ZIP64_EXTRA_ID = 0x0001;
+
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t END_OF_CENTRAL_DIR_SIZE = 22;
+constexpr size_t ZIP64_LOCATOR_SIZE = 20;
+constexpr size_t ZIP64_END_OF_CENTRAL_DIR_SIZE = 56;
+constexpr size_t MAX_COMMENT_SIZE = 0xffff;
+
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+
+constexpr size_t EXTRACT_CHUNK_SIZE = 64 * 1024;
+
+// zip is little-endian, so are all targets we ship
+template <typename T>
+inline T readValue(const unsigned char *p) {
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return value;
+}
+} // namespace
+
+void FileView::clear() {
+    _bytes = nullptr;
+    _size = 0;
+    _archive.reset();
+}
+
+std::shared_ptr<FileArchive> FileArchive::open(const std::string &fullPath) {
+    std::shared_ptr<FileArchive> archive(new (std::nothrow) FileArchive());
+    if (!archive || !archive->map(fullPath)) {
+        CC_LOG_ERROR("FileArchive: can't map %s", fullPath.c_str());
+        return nullptr;
+    }
+    if (!archive->buildIndex()) {
+        CC_LOG_ERROR("FileArchive: %s is not a valid zip archive", fullPath.c_str());
+        return nullptr;
+    }
+    archive->_path = fullPath;
+    return archive;
+}
+
+FileArchive::~FileArchive() {
+    unmap();
+}
+
+bool FileArchive::map(const std::string &fullPath) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    HANDLE file = ::CreateFile(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        ::CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = ::CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (!mapping) return false;
+
+    void *bytes = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!bytes) {
+        ::CloseHandle(mapping);
+        return false;
+    }
+    _bytes = static_cast<const unsigned char *>(bytes);
+    _size = static_cast<size_t>(size.QuadPart);
+    _handle = mapping;
+    return true;
+#else
+    #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    if (fullPath.find(ASSETS_FOLDER_NAME) == 0) {
+        AAssetManager *assetManager = FileUtilsAndroid::getAssetManager();
+        if (!assetManager) return false;
+
+        AAsset *asset = AAssetManager_open(assetManager, fullPath.c_str() + strlen(ASSETS_FOLDER_NAME), AASSET_MODE_BUFFER);
+        if (!asset) return false;
+        // mapped for stored assets, compressed assets are inflated into memory once
+        const void *bytes = AAsset_getBuffer(asset);
+        if (!bytes) {
+            AAsset_close(asset);
+            return false;
+        }
+        _bytes = static_cast<const unsigned char *>(bytes);
+        _size = static_cast<size_t>(AAsset_getLength64(asset));
+        _handle = asset;
+        return true;
+    }
+    #endif
+
+    int fd = ::open(fullPath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0 || statBuf.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *bytes = mmap(nullptr, static_cast<size_t>(statBuf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (bytes == MAP_FAILED) return false;
+
+    _bytes = static_cast<const unsigned char *>(bytes);
+    _size = static_cast<size_t>(statBuf.st_size);
+    return true;
+#endif
+}
+
+void FileArchive::unmap() {
+    if (!_bytes) return;
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    ::UnmapViewOfFile(_bytes);
+    ::CloseHandle(static_cast<HANDLE>(_handle));
+#else
+    #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    if (_handle) {
+        AAsset_close(static_cast<AAsset *>(_handle));
+    } else
+    #endif
+    {
+        munmap(const_cast<unsigned char *>(_bytes), _size);
+    }
+#endif
+
+    _bytes = nullptr;
+    _size = 0;
+    _handle = nullptr;
+}
+
+bool FileArchive::buildIndex() {
+    if (_size < END_OF_CENTRAL_DIR_SIZE) return false;
+
+    // the end of central directory record is followed by a comment of up to 64k
+    size_t eocd = _size - END_OF_CENTRAL_DIR_SIZE;
+    size_t scanEnd = _size > END_OF_CENTRAL_DIR_SIZE + MAX_COMMENT_SIZE ? _size - END_OF_CENTRAL_DIR_SIZE - MAX_COMMENT_SIZE : 0;
+    while (readValue<uint32_t>(_bytes + eocd) != END_OF_CENTRAL_DIR_SIGNATURE) {
+        if (eocd == scanEnd) return false;
+        --eocd;
+    }
+
+    uint64_t entryCount = readValue<uint16_t>(_bytes + eocd + 10);
+    uint64_t dirSize = readValue<uint32_t>(_bytes + eocd + 12);
+    uint64_t dirOffset = readValue<uint32_t>(_bytes + eocd + 16);
+
+    if (eocd >= ZIP64_LOCATOR_SIZE && readValue<uint32_t>(_bytes + eocd - ZIP64_LOCATOR_SIZE) == ZIP64_LOCATOR_SIGNATURE) {
+        uint64_t zip64Eocd = readValue<uint64_t>(_bytes + eocd - ZIP64_LOCATOR_SIZE + 8);
+        // offsets and sizes are untrusted, compare against what is left so they can't wrap around
+        if (_size < ZIP64_END_OF_CENTRAL_DIR_SIZE || zip64Eocd > _size - ZIP64_END_OF_CENTRAL_DIR_SIZE ||
+            readValue<uint32_t>(_bytes + zip64Eocd) != ZIP64_END_OF_CENTRAL_DIR_SIGNATURE) {
+            return false;
+        }
+        entryCount = readValue<uint64_t>(_bytes + zip64Eocd + 32);
+        dirSize = readValue<uint64_t>(_bytes + zip64Eocd + 40);
+        dirOffset = readValue<uint64_t>(_bytes + zip64Eocd + 48);
+    }
+    if (dirOffset > _size || dirSize > _size - dirOffset) return false;
+
+    // every entry takes at least a central header, don't let a forged count reserve more
+    _entries.reserve(static_cast<size_t>(std::min<uint64_t>(entryCount, dirSize / CENTRAL_HEADER_SIZE)));
+
+    const unsigned char *p = _bytes + dirOffset;
+    const unsigned char *end = p + dirSize;
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        if (p + CENTRAL_HEADER_SIZE > end || readValue<uint32_t>(p) != CENTRAL_HEADER_SIGNATURE) return false;
+
+        uint16_t flags = readValue<uint16_t>(p + 8);
+        uint16_t nameLength = readValue<uint16_t>(p + 28);
+        uint16_t extraLength = readValue<uint16_t>(p + 30);
+        uint16_t commentLength = readValue<uint16_t>(p + 32);
+        const unsigned char *name = p + CENTRAL_HEADER_SIZE;
+        const unsigned char *extra = name + nameLength;
+        const unsigned char *next = extra + extraLength + commentLength;
+        if (next > end) return false;
+
+        Entry entry;
+        entry.method = readValue<uint16_t>(p + 10);
+        entry.crc32 = readValue<uint32_t>(p + 16);
+        entry.compressedSize = readValue<uint32_t>(p + 20);
+        entry.uncompressedSize = readValue<uint32_t>(p + 24);
+        entry.localHeaderOffset = readValue<uint32_t>(p + 42);
+
+        // 64-bit values follow in this order, only for the fields saturated above
+        for (const unsigned char *field = extra; field + 4 <= extra + extraLength;) {
+            uint16_t id = readValue<uint16_t>(field);
+            uint16_t size = readValue<uint16_t>(field + 2);
+            const unsigned char *value = field + 4;
+            const unsigned char *valueEnd = value + size;
+            if (valueEnd > extra + extraLength) break;
+            if (id == ZIP64_EXTRA_ID) {
+                for (uint64_t *target : {&entry.uncompressedSize, &entry.compressedSize, &entry.localHeaderOffset}) {
+                    if (*target != 0xffffffff) continue;
+                    if (value + 8 > valueEnd) break;
+                    *target = readValue<uint64_t>(value);
+                    value += 8;
+                }
+            }
+            field = valueEnd;
+        }
+
+        // stored entries are read with their uncompressed size but bounds-checked with the compressed one
+        if (entry.method == METHOD_STORED && entry.compressedSize != entry.uncompressedSize) return false;
+
+        bool isDirectory = nameLength > 0 && name[nameLength - 1] == '/';
+        bool isEncrypted = (flags & 0x1) != 0;
+        bool isSupported = entry.method == METHOD_STORED || entry.method == METHOD_DEFLATED;
+        if (!isDirectory) {
+            std::string entryName(reinterpret_cast<const char *>(name), nameLength);
+            if (isEncrypted || !isSupported) {
+                _unsupportedEntries.push_back(std::move(entryName));
+            } else {
+                _entries.emplace(std::move(entryName), entry);
+            }
+        }
+        p = next;
+    }
+    return true;
+}
+
+const FileArchive::Entry *FileArchive::findEntry(const std::string &name) const {
+    auto iter = _entries.find(name);
+    return iter == _entries.end() ? nullptr : &iter->second;
+}
+
+const unsigned char *FileArchive::getData(const Entry *entry) const {
+    // the local header can carry a different extra field than the central directory
+    uint64_t offset = entry->localHeaderOffset;
+    if (_size < LOCAL_HEADER_SIZE || offset > _size - LOCAL_HEADER_SIZE) return nullptr;
+
+    const unsigned char *header = _bytes + offset;
+    if (readValue<uint32_t>(header) != LOCAL_HEADER_SIGNATURE) return nullptr;
+
+    offset += LOCAL_HEADER_SIZE + readValue<uint16_t>(header + 26) + readValue<uint16_t>(header + 28);
+    if (offset > _size || entry->compressedSize > _size - offset) return nullptr;
+    return _bytes + offset;
+}
+
+bool FileArchive::getView(const Entry *entry, FileView *view) const {
+    if (!entry || entry->method != METHOD_STORED) return false;
+
+    const unsigned char *data = getData(entry);
+    if (!data) return false;
+
+    view->_bytes = data;
+    view->_size = static_cast<size_t>(entry->uncompressedSize);
+    view->_archive = shared_from_this();
+    return true;
+}
+
+bool FileArchive::read(const Entry *entry, void *buffer, size_t capacity) const {
+    if (!entry || capacity < entry->uncompressedSize) return false;
+
+    const unsigned char *data = getData(entry);
+    if (!data) return false;
+
+    if (entry->method == METHOD_STORED) {
+        memcpy(buffer, data, static_cast<size_t>(entry->uncompressedSize));
+        return true;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // raw deflate stream, zip entries have no zlib header
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) return false;
+
+    uint64_t inLeft = entry->compressedSize;
+    uint64_t outLeft = entry->uncompressedSize;
+    stream.next_in = const_cast<Bytef *>(data);
+    stream.next_out = static_cast<Bytef *>(buffer);
+
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        // avail_in and avail_out are 32-bit, feed large entries in chunks
+        if (stream.avail_in == 0) {
+            stream.avail_in = static_cast<uInt>(std::min<uint64_t>(inLeft, UINT32_MAX));
+            inLeft -= stream.avail_in;
+        }
+        if (stream.avail_out == 0) {
+            stream.avail_out = static_cast<uInt>(std::min<uint64_t>(outLeft, UINT32_MAX));
+            outLeft -= stream.avail_out;
+        }
+        ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret == Z_BUF_ERROR && ((stream.avail_in == 0 && inLeft) || (stream.avail_out == 0 && outLeft))) ret = Z_OK;
+    }
+    inflateEnd(&stream);
+
+    auto inflated = static_cast<uint64_t>(stream.next_out - static_cast<Bytef *>(buffer));
+    if (ret != Z_STREAM_END || inflated != entry->uncompressedSize) {
+        CC_LOG_ERROR("FileArchive: inflate failed in %s", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FileArchive::extract(const Entry *entry, const ChunkWriter &writer) const {
+    if (!entry) return false;
+
+    const unsigned char *data = getData(entry);
+    if (!data) return false;
+
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t written = 0;
+
+    if (entry->method == METHOD_STORED) {
+        for (uint64_t offset = 0; offset < entry->uncompressedSize; offset += EXTRACT_CHUNK_SIZE) {
+            auto size = static_cast<size_t>(std::min<uint64_t>(EXTRACT_CHUNK_SIZE, entry->uncompressedSize - offset));
+            crc = crc32(crc, data + offset, static_cast<uInt>(size));
+            if (!writer(data + offset, size)) return false;
+        }
+        written = entry->uncompressedSize;
+    } else {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) return false;
+
+        unsigned char chunk[EXTRACT_CHUNK_SIZE];
+        uint64_t inLeft = entry->compressedSize;
+        stream.next_in = const_cast<Bytef *>(data);
+
+        int ret = Z_OK;
+        while (ret == Z_OK) {
+            if (stream.avail_in == 0) {
+                stream.avail_in = static_cast<uInt>(std::min<uint64_t>(inLeft, UINT32_MAX));
+                inLeft -= stream.avail_in;
+            }
+            stream.next_out = chunk;
+            stream.avail_out = static_cast<uInt>(sizeof(chunk));
+            ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END) break;
+
+            auto size = sizeof(chunk) - stream.avail_out;
+            if (size > 0) {
+                crc = crc32(crc, chunk, static_cast<uInt>(size));
+                written += size;
+                if (!writer(chunk, size)) {
+                    inflateEnd(&stream);
+                    return false;
+                }
+            }
+            // no progress with input left means the stream is truncated
+            if (ret == Z_OK && size == 0 && stream.avail_in == 0 && inLeft == 0) break;
+        }
+        inflateEnd(&stream);
+
+        if (ret != Z_STREAM_END) {
+            CC_LOG_ERROR("FileArchive: inflate failed in %s", _path.c_str());
+            return false;
+        }
+    }
+
+    if (written != entry->uncompressedSize || crc != entry->crc32) {
+        CC_LOG_ERROR("FileArchive: crc mismatch in %s", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,134 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cc {
+
+class FileArchive;
+
+/**
+ * Read-only view into a memory-mapped archive.
+ * The view keeps the archive mapped until it is released, the bytes must not be modified.
+ */
+class CC_DLL FileView {
+public:
+    const unsigned char *getBytes() const { return _bytes; }
+    size_t getSize() const { return _size; }
+    bool isNull() const { return _bytes == nullptr; }
+    void clear();
+
+private:
+    friend class FileArchive;
+
+    const unsigned char *_bytes = nullptr;
+    size_t _size = 0;
+    std::shared_ptr<const FileArchive> _archive;
+};
+
+/**
+ * Memory-mapped zip archive.
+ *
+ * The central directory is parsed once when the archive is opened and kept in a hashed index,
+ * the archive is immutable afterwards so it can be read from any number of threads concurrently.
+ * Stored entries are handed out as views into the mapping, deflated entries are inflated
+ * straight into the caller's buffer.
+ */
+class CC_DLL FileArchive : public std::enable_shared_from_this<FileArchive> {
+public:
+    struct Entry {
+        uint64_t localHeaderOffset = 0;
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+        uint32_t crc32 = 0;
+        uint16_t method = 0;
+    };
+    typedef std::unordered_map<std::string, Entry> EntryMap;
+
+    // Receives consecutive chunks of an entry, returning false stops the extraction
+    typedef std::function<bool(const unsigned char *data, size_t size)> ChunkWriter;
+
+    /**
+     * Maps the zip archive at the given full path and indexes its entries.
+     * On Android, paths starting with "@assets/" are opened through the asset manager,
+     * which only maps them if the archive is stored uncompressed in the apk.
+     * @return nullptr if the archive could not be mapped or is not a valid zip archive.
+     */
+    static std::shared_ptr<FileArchive> open(const std::string &fullPath);
+
+    ~FileArchive();
+
+    const std::string &getPath() const { return _path; }
+    size_t getEntryCount() const { return _entries.size(); }
+    const EntryMap &getEntries() const { return _entries; }
+    /** Names of encrypted entries or entries using a compression method other than stored and deflated, they are not indexed. */
+    const std::vector<std::string> &getUnsupportedEntries() const { return _unsupportedEntries; }
+
+    const Entry *findEntry(const std::string &name) const;
+    bool isStored(const Entry *entry) const { return entry->method == 0; }
+
+    /** Sets a view of a stored entry without copying, fails for compressed entries. */
+    bool getView(const Entry *entry, FileView *view) const;
+
+    /**
+     * Reads the entry into a buffer provided by the caller.
+     * @param capacity Must be at least the uncompressed size of the entry.
+     */
+    bool read(const Entry *entry, void *buffer, size_t capacity) const;
+
+    /**
+     * Inflates the entry chunk by chunk and checks its crc in the same pass,
+     * so entries of any size can be streamed to disk with a small buffer.
+     * @return false if writer returns false, the data is corrupted or the crc doesn't match.
+     */
+    bool extract(const Entry *entry, const ChunkWriter &writer) const;
+
+private:
+    FileArchive() = default;
+
+    bool map(const std::string &fullPath);
+    void unmap();
+    bool buildIndex();
+    const unsigned char *getData(const Entry *entry) const;
+
+    std::string _path;
+    const unsigned char *_bytes = nullptr;
+    size_t _size = 0;
+    void *_handle = nullptr;
+    EntryMap _entries;
+    std::vector<std::string> _unsupportedEntries;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(FileArchive);
+};
+
+} // namespace cc
@@ -41,6 +41,7 @@ THE SOFTWARE.
     #include "unzip/unzip.h"
 #endif
 #include <sys/stat.h>
+#include <cstring>
 #include <regex>
 
 namespace cc {
@@ -523,6 +524,7 @@ bool FileUtils::writeDataToFile(const Data &data, const std::string &fullPath) {
 
 bool FileUtils::init() {
     _searchPathArray.push_back(_defaultResRootPath);
+    updateSearchPathSnapshot();
     return true;
 }
 
@@ -546,6 +548,10 @@ FileUtils::Status FileUtils::getContents(const std::string &filename, ResizableB
     if (filename.empty())
         return Status::NotExists;
 
+    Status status;
+    if (getContentsFromArchive(filename, buffer, &status))
+        return status;
+
     auto fs = FileUtils::getInstance();
 
     std::string fullPath = fs->fullPathForFilename(filename);
@@ -580,6 +586,165 @@ FileUtils::Status FileUtils::getContents(const std::string &filename, ResizableB
     return Status::OK;
 }
 
+FileUtils::Status FileUtils::readContents(const std::string &filename, void *buffer, size_t capacity, size_t *size) {
+    *size = 0;
+    if (filename.empty())
+        return Status::NotExists;
+
+    std::shared_ptr<FileArchive> archive;
+    const FileArchive::Entry *entry = nullptr;
+    if (findArchiveEntry(filename, &archive, &entry)) {
+        *size = static_cast<size_t>(entry->uncompressedSize);
+        if (*size > capacity)
+            return Status::TooLarge;
+        if (*size == 0)
+            return Status::OK;
+        return archive->read(entry, buffer, capacity) ? Status::OK : Status::ReadFailed;
+    }
+
+    std::string fullPath = fullPathForFilename(filename);
+    if (fullPath.empty())
+        return Status::NotExists;
+
+    FILE *fp = fopen(getSuitableFOpen(fullPath).c_str(), "rb");
+    if (!fp) {
+        // not a plain file, e.g. inside the apk
+        Data data;
+        Status status = getContents(fullPath, &data);
+        if (status != Status::OK)
+            return status;
+        *size = data.getSize();
+        if (*size > capacity)
+            return Status::TooLarge;
+        memcpy(buffer, data.getBytes(), *size);
+        return Status::OK;
+    }
+
+#if defined(_MSC_VER)
+    auto descriptor = _fileno(fp);
+#else
+    auto descriptor = fileno(fp);
+#endif
+    struct stat statBuf;
+    if (fstat(descriptor, &statBuf) == -1) {
+        fclose(fp);
+        return Status::ReadFailed;
+    }
+    *size = statBuf.st_size;
+    if (*size > capacity) {
+        fclose(fp);
+        return Status::TooLarge;
+    }
+
+    size_t readsize = fread(buffer, 1, *size, fp);
+    fclose(fp);
+
+    if (readsize < *size) {
+        *size = readsize;
+        return Status::ReadFailed;
+    }
+    return Status::OK;
+}
+
+bool FileUtils::mountArchive(const std::string &archivePath, const std::string &mountPoint) {
+    std::string fullPath = fullPathForFilename(archivePath);
+    if (fullPath.empty())
+        return false;
+
+    auto archive = FileArchive::open(fullPath);
+    if (!archive)
+        return false;
+
+    std::string prefix = mountPoint;
+    if (!prefix.empty() && prefix[prefix.length() - 1] != '/') {
+        prefix += '/';
+    }
+
+    std::lock_guard<std::mutex> lock(_archivesMutex);
+    auto archives = std::make_shared<ArchiveList>();
+    archives->push_back({prefix, archive});
+    if (_archives) {
+        for (const auto &mounted : *_archives) {
+            if (mounted.archive->getPath() != fullPath) {
+                archives->push_back(mounted);
+            }
+        }
+    }
+    std::atomic_store(&_archives, std::shared_ptr<const ArchiveList>(std::move(archives)));
+
+    CC_LOG_DEBUG("FileUtils: mounted %s with %u entries", fullPath.c_str(), static_cast<unsigned>(archive->getEntryCount()));
+    return true;
+}
+
+void FileUtils::unmountArchive(const std::string &archivePath) {
+    std::string fullPath = fullPathForFilename(archivePath);
+
+    std::lock_guard<std::mutex> lock(_archivesMutex);
+    if (!_archives)
+        return;
+    auto archives = std::make_shared<ArchiveList>();
+    for (const auto &mounted : *_archives) {
+        if (mounted.archive->getPath() != fullPath) {
+            archives->push_back(mounted);
+        }
+    }
+    std::atomic_store(&_archives, std::shared_ptr<const ArchiveList>(std::move(archives)));
+}
+
+bool FileUtils::findArchiveEntry(const std::string &filename, std::shared_ptr<FileArchive> *archive, const FileArchive::Entry **entry) const {
+    auto archives = std::atomic_load(&_archives);
+    if (!archives || archives->empty() || filename.empty())
+        return false;
+
+    // normalizePath is regex based, only pay for it if there is something to normalize
+    std::string path = filename.find("./") == std::string::npos ? filename : normalizePath(filename);
+    if (isAbsolutePath(path)) {
+        // absolute paths are only served if they point into the resource root
+        auto snapshot = std::atomic_load(&_searchPathSnapshot);
+        if (!snapshot) return false;
+        const std::string &rootPath = snapshot->defaultResRootPath;
+        if (rootPath.empty() || path.compare(0, rootPath.length(), rootPath) != 0)
+            return false;
+        path.erase(0, rootPath.length());
+    }
+
+    for (const auto &mounted : *archives) {
+        if (path.compare(0, mounted.mountPoint.length(), mounted.mountPoint) != 0)
+            continue;
+        const auto *found = mounted.archive->findEntry(path.substr(mounted.mountPoint.length()));
+        if (found) {
+            *archive = mounted.archive;
+            *entry = found;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileUtils::getContentsFromArchive(const std::string &filename, ResizableBuffer *buffer, Status *status) const {
+    std::shared_ptr<FileArchive> archive;
+    const FileArchive::Entry *entry = nullptr;
+    if (!findArchiveEntry(filename, &archive, &entry))
+        return false;
+
+    auto size = static_cast<size_t>(entry->uncompressedSize);
+    buffer->resize(size);
+    if (size == 0) {
+        *status = Status::OK;
+        return true;
+    }
+    *status = archive->read(entry, buffer->buffer(), size) ? Status::OK : Status::ReadFailed;
+    return true;
+}
+
+bool FileUtils::getContentsView(const std::string &filename, FileView *view) const {
+    std::shared_ptr<FileArchive> archive;
+    const FileArchive::Entry *entry = nullptr;
+    if (!findArchiveEntry(filename, &archive, &entry))
+        return false;
+    return archive->getView(entry, view);
+}
+
 unsigned char *FileUtils::getFileDataFromZip(const std::string &zipFilePath, const std::string &filename, ssize_t *size) {
     unsigned char *buffer = nullptr;
     unzFile file = nullptr;
@@ -650,19 +815,37 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const {
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end()) {
-        return cacheIter->second;
+    std::string fullpath;
+    if (_fullPathCache.find(filename, &fullpath)) {
+        return fullpath;
     }
 
-    std::string fullpath;
+    // taken before the search paths, so a result racing with a search path change is not cached
+    uint32_t generation = _fullPathCache.getGeneration();
+    auto snapshot = std::atomic_load(&_searchPathSnapshot);
+    if (!snapshot) {
+        return "";
+    }
+    auto manifest = std::atomic_load(&_pathManifest);
+    const std::string &rootPath = snapshot->defaultResRootPath;
+
+    for (const auto &searchIt : snapshot->searchPaths) {
+        // the manifest lists everything under the resource root, don't probe for files it doesn't have
+        if (manifest && searchIt.compare(0, rootPath.length(), rootPath) == 0) {
+            std::string relativePath = searchIt.substr(rootPath.length()) + filename;
+            if (relativePath.find("./") != std::string::npos) {
+                relativePath = normalizePath(relativePath);
+            }
+            if (manifest->find(relativePath) == manifest->end()) {
+                continue;
+            }
+        }
 
-    for (const auto &searchIt : _searchPathArray) {
         fullpath = this->getPathForFilename(filename, searchIt);
 
         if (!fullpath.empty()) {
             // Using the filename passed in as key.
-            _fullPathCache.insert(std::make_pair(filename, fullpath));
+            _fullPathCache.insert(filename, fullpath, generation);
             return fullpath;
         }
     }
@@ -671,6 +854,40 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const {
     return "";
 }
 
+bool FileUtils::loadPathManifest(const std::string &manifestFile) {
+    std::string content;
+    if (getContents(manifestFile, &content) != Status::OK) {
+        CC_LOG_ERROR("FileUtils: can't load path manifest %s", manifestFile.c_str());
+        return false;
+    }
+
+    auto manifest = std::make_shared<std::unordered_set<std::string>>();
+    size_t begin = 0;
+    while (begin < content.length()) {
+        size_t end = content.find('\n', begin);
+        if (end == std::string::npos) {
+            end = content.length();
+        }
+        size_t last = end;
+        while (last > begin && (content[last - 1] == '\r' || content[last - 1] == ' ')) {
+            --last;
+        }
+        if (last > begin) {
+            manifest->emplace(content, begin, last - begin);
+        }
+        begin = end + 1;
+    }
+
+    std::atomic_store(&_pathManifest, std::shared_ptr<const std::unordered_set<std::string>>(std::move(manifest)));
+    _fullPathCache.clear();
+    return true;
+}
+
+void FileUtils::updateSearchPathSnapshot() {
+    std::atomic_store(&_searchPathSnapshot, std::make_shared<const SearchPathSnapshot>(SearchPathSnapshot{_searchPathArray, _defaultResRootPath}));
+    _fullPathCache.clear();
+}
+
 std::string FileUtils::fullPathFromRelativeFile(const std::string &filename, const std::string &relativeFile) {
     return relativeFile.substr(0, relativeFile.rfind('/') + 1) + filename;
 }
@@ -708,7 +925,6 @@ void FileUtils::setSearchPaths(const std::vector<std::string> &searchPaths) {
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
 
-    _fullPathCache.clear();
     _searchPathArray.clear();
 
     for (const auto &path : _originalSearchPaths) {
@@ -732,6 +948,8 @@ void FileUtils::setSearchPaths(const std::vector<std::string> &searchPaths) {
         //CC_LOG_DEBUG("Default root path doesn't exist, adding it.");
         _searchPathArray.push_back(_defaultResRootPath);
     }
+
+    updateSearchPathSnapshot();
 }
 
 void FileUtils::addSearchPath(const std::string &searchpath, const bool front) {
@@ -750,6 +968,8 @@ void FileUtils::addSearchPath(const std::string &searchpath, const bool front) {
         _originalSearchPaths.push_back(searchpath);
         _searchPathArray.push_back(path);
     }
+
+    updateSearchPathSnapshot();
 }
 
 std::string FileUtils::getFullPathForDirectoryAndFilename(const std::string &directory, const std::string &filename) const {
@@ -769,6 +989,11 @@ std::string FileUtils::getFullPathForDirectoryAndFilename(const std::string &dir
 }
 
 bool FileUtils::isFileExist(const std::string &filename) const {
+    std::shared_ptr<FileArchive> archive;
+    const FileArchive::Entry *entry = nullptr;
+    if (findArchiveEntry(filename, &archive, &entry))
+        return true;
+
     if (isAbsolutePath(filename)) {
         return isFileExistInternal(normalizePath(filename));
     } else {
@@ -792,17 +1017,21 @@ bool FileUtils::isDirectoryExist(const std::string &dirPath) const {
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if (cacheIter != _fullPathCache.end()) {
-        return isDirectoryExistInternal(cacheIter->second);
+    std::string fullpath;
+    if (_fullPathCache.find(dirPath, &fullpath)) {
+        return isDirectoryExistInternal(fullpath);
     }
 
-    std::string fullpath;
-    for (const auto &searchIt : _searchPathArray) {
+    uint32_t generation = _fullPathCache.getGeneration();
+    auto snapshot = std::atomic_load(&_searchPathSnapshot);
+    if (!snapshot) {
+        return false;
+    }
+    for (const auto &searchIt : snapshot->searchPaths) {
         // searchPath + file_path
         fullpath = fullPathForFilename(searchIt + dirPath);
         if (isDirectoryExistInternal(fullpath)) {
-            _fullPathCache.insert(std::make_pair(dirPath, fullpath));
+            _fullPathCache.insert(dirPath, fullpath, generation);
             return true;
         }
     }
@@ -26,14 +26,19 @@ THE SOFTWARE.
 #ifndef __CC_FILEUTILS_H__
 #define __CC_FILEUTILS_H__
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <type_traits>
 
 #include "base/Macros.h"
 #include "base/Value.h"
 #include "base/Data.h"
+#include "platform/FileArchive.h"
+#include "platform/PathCache.h"
 
 namespace cc {
 
@@ -250,6 +255,36 @@ public:
      */
     virtual unsigned char *getFileDataFromZip(const std::string &zipFilePath, const std::string &filename, ssize_t *size);
 
+    /**
+     *  Memory-maps a zip archive and serves the files in it before the search paths are probed.
+     *  The archive is indexed once here, reading from mounted archives is safe on any thread.
+     *
+     *  @param archivePath The path of the archive, it could be a relative or absolute path.
+     *  @param mountPoint The path prefix the archive entries are visible under, e.g. "assets/".
+     *                    Empty if the archive mirrors the resource root.
+     *  @return True if the archive was mapped and indexed.
+     */
+    bool mountArchive(const std::string &archivePath, const std::string &mountPoint = "");
+
+    /**
+     *  Unmaps an archive mounted by mountArchive, views handed out keep it mapped until they are released.
+     */
+    void unmountArchive(const std::string &archivePath);
+
+    /**
+     *  Gets a read-only view of a file stored uncompressed in a mounted archive, no data is copied.
+     *
+     *  @return False if the file is not in a mounted archive or is compressed, use readContents or getContents then.
+     */
+    bool getContentsView(const std::string &filename, FileView *view) const;
+
+    /**
+     *  Reads a file into a buffer owned by the caller, compressed archive entries are inflated into it directly.
+     *
+     *  @param[out] size The size of the file, it is also set if Status::TooLarge is returned because the buffer is too small.
+     */
+    virtual Status readContents(const std::string &filename, void *buffer, size_t capacity, size_t *size);
+
     /** Returns the fullpath for a given filename.
 
      First it will try to get a new filename from the "filenameLookup" dictionary.
@@ -550,8 +585,17 @@ public:
      */
     virtual long getFileSize(const std::string &filepath);
 
-    /** Returns the full path cache. */
-    const std::unordered_map<std::string, std::string> &getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the full path cache. */
+    std::unordered_map<std::string, std::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
+
+    /**
+     *  Loads a manifest of all files under the default resource root, one relative path per line.
+     *  Search paths inside the resource root are then only probed for files listed in it,
+     *  so lookups of missing files don't hit the file system once per search path.
+     *
+     *  @return True if the manifest was loaded.
+     */
+    bool loadPathManifest(const std::string &manifestFile);
 
     std::string normalizePath(const std::string &path) const;
     std::string getFileDir(const std::string &path) const;
@@ -607,6 +651,25 @@ protected:
      */
     virtual std::string getFullPathForDirectoryAndFilename(const std::string &directory, const std::string &filename) const;
 
+    /**
+     *  Looks up a file in the mounted archives.
+     *
+     *  @return True if one of the archives contains the file.
+     */
+    bool findArchiveEntry(const std::string &filename, std::shared_ptr<FileArchive> *archive, const FileArchive::Entry **entry) const;
+
+    /**
+     *  Reads a file from the mounted archives, platform implementations of getContents call it first.
+     *
+     *  @return False if the file is not in a mounted archive, status is not touched then.
+     */
+    bool getContentsFromArchive(const std::string &filename, ResizableBuffer *buffer, Status *status) const;
+
+    /**
+     *  Publishes _searchPathArray and _defaultResRootPath to other threads and drops the full paths resolved against the old ones.
+     */
+    void updateSearchPathSnapshot();
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
@@ -624,14 +687,44 @@ protected:
      *  For instance:
      *  On Android, the default root path of resources will be assigned with "@assets/" in FileUtilsAndroid::init().
      *  Similarly on Blackberry, we assign "app/native/Resources/" to this variable in FileUtilsBlackberry::init().
+     *  Lookups off the main thread must read it from _searchPathSnapshot instead.
      */
     std::string _defaultResRootPath;
 
     /**
      *  The full path cache. When a file is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  This variable is used for improving the performance of file search, it is safe to use on any thread.
+     */
+    mutable PathCache _fullPathCache;
+
+    struct SearchPathSnapshot {
+        std::vector<std::string> searchPaths;
+        std::string defaultResRootPath;
+    };
+
+    /**
+     *  Copy of _searchPathArray and _defaultResRootPath for path resolution, readers take it with std::atomic_load
+     *  so that both always match.
+     */
+    std::shared_ptr<const SearchPathSnapshot> _searchPathSnapshot;
+
+    /**
+     *  Files under the default resource root, set by loadPathManifest.
+     */
+    std::shared_ptr<const std::unordered_set<std::string>> _pathManifest;
+
+    struct MountedArchive {
+        std::string mountPoint;
+        std::shared_ptr<FileArchive> archive;
+    };
+    typedef std::vector<MountedArchive> ArchiveList;
+
+    /**
+     *  The mounted archives, most recently mounted first.
+     *  Readers take a snapshot with std::atomic_load, mounting replaces the list under _archivesMutex.
      */
-    mutable std::unordered_map<std::string, std::string> _fullPathCache;
+    std::shared_ptr<const ArchiveList> _archives;
+    std::mutex _archivesMutex;
 
     /**
      * Writable path.
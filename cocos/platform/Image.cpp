@@ -59,6 +59,18 @@ extern "C" {
 
 #include <map>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define IMAGE_USE_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define IMAGE_USE_SSE2
+    #if defined(__SSSE3__)
+        #include <tmmintrin.h>
+        #define IMAGE_USE_SSSE3
+    #endif
+#endif
+
 namespace cc {
 
 //////////////////////////////////////////////////////////////////////////
@@ -267,6 +279,162 @@ Image::~Image() {
     CC_SAFE_FREE(_data);
 }
 
+namespace {
+// expand channels to RGBA8, dst holds pixelCount * 4 bytes
+
+void convertI2RGBA(const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(IMAGE_USE_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgba.val[1] = rgba.val[2] = vld1q_u8(src + i);
+        rgba.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#elif defined(IMAGE_USE_SSE2)
+    const __m128i alpha = _mm_set1_epi8((char)0xff);
+    for (; i + 16 <= pixelCount; i += 16) {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i llLo = _mm_unpacklo_epi8(l, l);
+        __m128i llHi = _mm_unpackhi_epi8(l, l);
+        __m128i laLo = _mm_unpacklo_epi8(l, alpha);
+        __m128i laHi = _mm_unpackhi_epi8(l, alpha);
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(llLo, laLo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(llLo, laLo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(llHi, laHi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(llHi, laHi));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        dst[i * 4] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+void convertIA2RGBA(const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(IMAGE_USE_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x2_t la = vld2q_u8(src + i * 2);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgba.val[1] = rgba.val[2] = la.val[0];
+        rgba.val[3] = la.val[1];
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#elif defined(IMAGE_USE_SSE2)
+    const __m128i lumMask = _mm_set1_epi16(0x00ff);
+    for (; i + 8 <= pixelCount; i += 8) {
+        __m128i la = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+        __m128i l = _mm_and_si128(la, lumMask);
+        __m128i ll = _mm_or_si128(l, _mm_slli_epi16(l, 8));
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(ll, la));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(ll, la));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        dst[i * 4] = dst[i * 4 + 1] = dst[i * 4 + 2] = src[i * 2];
+        dst[i * 4 + 3] = src[i * 2 + 1];
+    }
+}
+
+void convertA2RGBA(const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(IMAGE_USE_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgba.val[1] = rgba.val[2] = vdupq_n_u8(255);
+        rgba.val[3] = vld1q_u8(src + i);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#elif defined(IMAGE_USE_SSE2)
+    const __m128i white = _mm_set1_epi8((char)0xff);
+    for (; i + 16 <= pixelCount; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i waLo = _mm_unpacklo_epi8(white, a);
+        __m128i waHi = _mm_unpackhi_epi8(white, a);
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(white, waLo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(white, waLo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(white, waHi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(white, waHi));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        dst[i * 4] = dst[i * 4 + 1] = dst[i * 4 + 2] = 255;
+        dst[i * 4 + 3] = src[i];
+    }
+}
+
+void convertRGB2RGBA(const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+#if defined(IMAGE_USE_NEON)
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + i * 4, rgba);
+    }
+#elif defined(IMAGE_USE_SSSE3)
+    // 4 pixels per 12 bytes, the load reads 4 bytes beyond, so stop one group early
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+    for (; i + 6 <= pixelCount; i += 4) {
+        __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        __m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), rgba);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        dst[i * 4] = src[i * 3];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
+} // namespace
+
+bool Image::convertToRGBA8() {
+    void (*convert)(const uint8_t *, uint8_t *, size_t) = nullptr;
+    switch (_renderFormat) {
+        case gfx::Format::RGBA8:
+            return true;
+        case gfx::Format::L8:
+        case gfx::Format::R8:
+        case gfx::Format::R8I:
+            convert = convertI2RGBA;
+            break;
+        case gfx::Format::LA8:
+            convert = convertIA2RGBA;
+            break;
+        case gfx::Format::A8:
+            convert = convertA2RGBA;
+            break;
+        case gfx::Format::RGB8:
+            convert = convertRGB2RGBA;
+            break;
+        default:
+            CC_LOG_ERROR("Image: can't convert format %d to RGBA8", static_cast<int>(_renderFormat));
+            return false;
+    }
+
+    size_t pixelCount = static_cast<size_t>(_width) * _height;
+    auto *dst = static_cast<unsigned char *>(malloc(pixelCount * 4));
+    if (!dst) {
+        return false;
+    }
+    convert(_data, dst, pixelCount);
+    free(_data);
+    _data = dst;
+    _dataLen = pixelCount * 4;
+    _renderFormat = gfx::Format::RGBA8;
+    return true;
+}
+
 bool Image::initWithImageFile(const std::string &path) {
     bool ret = false;
     //NOTE: fullPathForFilename isn't threadsafe. we should make sure the parameter is a full path.
@@ -332,6 +500,11 @@ bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
         if (unpackedData != data) {
             free(unpackedData);
         }
+
+        // decoders write RGBA8 directly when they can, convert what's left
+        if (ret && _forceRGBA8 && !_isCompressed) {
+            ret = convertToRGBA8();
+        }
     } while (0);
 
     return ret;
@@ -559,6 +732,13 @@ bool Image::initWithJpgData(const unsigned char *data, ssize_t dataLen) {
             cinfo.out_color_space = JCS_RGB;
             _renderFormat = gfx::Format::RGB8;
         }
+    #ifdef JCS_ALPHA_EXTENSIONS
+        // libjpeg-turbo can output RGBA with opaque alpha while decoding
+        if (_forceRGBA8) {
+            cinfo.out_color_space = JCS_EXT_RGBA;
+            _renderFormat = gfx::Format::RGBA8;
+        }
+    #endif
 
         /* Start decompression jpeg here */
         jpeg_start_decompress(&cinfo);
@@ -664,6 +844,14 @@ bool Image::initWithPngData(const unsigned char *data, ssize_t dataLen) {
         if (bit_depth < 8) {
             png_set_packing(png_ptr);
         }
+        // expand to RGBA while reading rows, images with alpha channel keep their alpha.
+        // png_set_add_alpha updates the color type, png_set_filler would leave it at RGB
+        if (_forceRGBA8) {
+            if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
+                png_set_gray_to_rgb(png_ptr);
+            }
+            png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
+        }
         // update info
         png_read_update_info(png_ptr, info_ptr);
         bit_depth = png_get_bit_depth(png_ptr, info_ptr);
@@ -902,17 +1090,19 @@ bool Image::initWithWebpData(const unsigned char *data, ssize_t dataLen) {
         if (WebPGetFeatures(static_cast<const uint8_t *>(data), dataLen, &config.input) != VP8_STATUS_OK) break;
         if (config.input.width == 0 || config.input.height == 0) break;
 
-        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : MODE_RGB;
-        _renderFormat = config.input.has_alpha ? gfx::Format::RGBA8 : gfx::Format::RGB8;
+        // decoder fills opaque alpha itself when RGBA8 is forced
+        const bool outputAlpha = config.input.has_alpha || _forceRGBA8;
+        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : (outputAlpha ? MODE_RGBA : MODE_RGB);
+        _renderFormat = outputAlpha ? gfx::Format::RGBA8 : gfx::Format::RGB8;
         _width = config.input.width;
         _height = config.input.height;
         _isCompressed = false;
 
-        _dataLen = _width * _height * (config.input.has_alpha ? 4 : 3);
+        _dataLen = _width * _height * (outputAlpha ? 4 : 3);
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
 
         config.output.u.RGBA.rgba = static_cast<uint8_t *>(_data);
-        config.output.u.RGBA.stride = _width * (config.input.has_alpha ? 4 : 3);
+        config.output.u.RGBA.stride = _width * (outputAlpha ? 4 : 3);
         config.output.u.RGBA.size = _dataLen;
         config.output.is_external_memory = 1;
 
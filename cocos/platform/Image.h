@@ -66,6 +66,9 @@ public:
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const unsigned char *data, ssize_t dataLen, int width, int height, int bitsPerComponent, bool preMulti = false);
 
+    // decode non-compressed images straight into RGBA8, must be set before init
+    inline void setForceRGBA8(bool force) { _forceRGBA8 = force; }
+
     // data will be free ouside.
     inline void takeData(unsigned char **outData) {
         *outData = _data;
@@ -93,6 +96,7 @@ protected:
     bool initWithETCData(const unsigned char *data, ssize_t dataLen);
     bool initWithETC2Data(const unsigned char *data, ssize_t dataLen);
     bool initWithASTCData(const unsigned char *data, ssize_t dataLen);
+    bool convertToRGBA8();
 
 protected:
     unsigned char *_data = nullptr;
@@ -103,6 +107,7 @@ protected:
     gfx::Format _renderFormat;
     std::string _filePath;
     bool _isCompressed = false;
+    bool _forceRGBA8 = false;
 
 protected:
     // noncopyable
@@ -0,0 +1,68 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/PathCache.h"
+
+namespace cc {
+
+bool PathCache::find(const std::string &key, std::string *value) const {
+    auto &shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.entries.find(key);
+    if (iter == shard.entries.end()) {
+        return false;
+    }
+    *value = iter->second;
+    return true;
+}
+
+void PathCache::insert(const std::string &key, const std::string &value, uint32_t generation) {
+    auto &shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // checked under the shard lock, clear() bumps the generation before it empties the shards
+    if (generation != _generation.load(std::memory_order_acquire)) {
+        return;
+    }
+    shard.entries.emplace(key, value);
+}
+
+void PathCache::clear() {
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+    for (auto &shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+std::unordered_map<std::string, std::string> PathCache::snapshot() const {
+    std::unordered_map<std::string, std::string> entries;
+    for (const auto &shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        entries.insert(shard.entries.begin(), shard.entries.end());
+    }
+    return entries;
+}
+
+} // namespace cc
@@ -0,0 +1,69 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cc {
+
+/**
+ * Full path cache of FileUtils that can be shared by all threads.
+ *
+ * Entries are spread over independently locked shards, so concurrent lookups rarely wait on each other.
+ * clear() starts a new generation, results resolved against an older generation are dropped by insert()
+ * so a resolution racing with a search path change can't leave a stale entry behind.
+ */
+class CC_DLL PathCache {
+public:
+    bool find(const std::string &key, std::string *value) const;
+    void insert(const std::string &key, const std::string &value, uint32_t generation);
+    void clear();
+
+    uint32_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
+
+    // Copies all entries, for inspection only
+    std::unordered_map<std::string, std::string> snapshot() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 32;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::string> entries;
+    };
+
+    Shard &getShard(const std::string &key) const { return _shards[std::hash<std::string>()(key) % SHARD_COUNT]; }
+
+    mutable Shard _shards[SHARD_COUNT];
+    std::atomic<uint32_t> _generation{0};
+};
+
+} // namespace cc
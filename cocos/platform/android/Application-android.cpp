@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include <android_native_app_glue.h>
 #include "platform/android/jni/JniImp.h"
 #include "base/Scheduler.h"
+#include "base/JobSystem.h"
 #include "audio/include/AudioEngine.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/event/EventDispatcher.h"
@@ -80,6 +81,7 @@ Application::~Application() {
 
     EventDispatcher::destroy();
     se::ScriptEngine::destroyInstance();
+    JobSystem::destroyInstance();
 
     Application::_instance = nullptr;
 }
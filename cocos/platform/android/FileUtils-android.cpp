@@ -178,6 +178,10 @@ FileUtils::Status FileUtilsAndroid::getContents(const std::string &filename, Res
     if (filename.empty())
         return FileUtils::Status::NotExists;
 
+    FileUtils::Status status;
+    if (getContentsFromArchive(filename, buffer, &status))
+        return status;
+
     std::string fullPath = fullPathForFilename(filename);
     if (fullPath.empty())
         return FileUtils::Status::NotExists;
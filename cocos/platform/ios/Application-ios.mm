@@ -25,6 +25,7 @@
 #import "Application.h"
 #import <UIKit/UIKit.h>
 #include "base/Scheduler.h"
+#include "base/JobSystem.h"
 #include "base/AutoreleasePool.h"
 #include "bindings/event/EventDispatcher.h"
 #include "bindings/jswrapper/SeApi.h"
@@ -135,6 +136,7 @@ Application::~Application() {
 
     EventDispatcher::destroy();
     se::ScriptEngine::destroyInstance();
+    JobSystem::destroyInstance();
 
     Application::_instance = nullptr;
 
@@ -0,0 +1,172 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "platform/Application.h"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/utsname.h>
+#include "platform/FileUtils.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/bindings/event/EventDispatcher.h"
+#include "base/Scheduler.h"
+#include "base/JobSystem.h"
+#include "base/AutoreleasePool.h"
+
+namespace cc {
+
+namespace {
+// LANGUAGE, LC_ALL, LC_MESSAGES and LANG, in the order gettext honors them, e.g. "zh_CN.UTF-8"
+std::string getLocaleName() {
+    const char *names[] = {"LANGUAGE", "LC_ALL", "LC_MESSAGES", "LANG"};
+    for (const char *name : names) {
+        const char *value = getenv(name);
+        if (value && value[0] && strcmp(value, "C") != 0 && strcmp(value, "POSIX") != 0) {
+            return value;
+        }
+    }
+    return "en";
+}
+} // namespace
+
+Application *Application::_instance = nullptr;
+std::shared_ptr<Scheduler> Application::_scheduler = nullptr;
+
+Application::Application(int width, int height) {
+    Application::_instance = this;
+    _scheduler = std::make_shared<Scheduler>();
+
+    // no window on linux, the logical size is what the host asked for
+    _viewLogicalSize.x = width;
+    _viewLogicalSize.y = height;
+
+    FileUtils::getInstance()->addSearchPath("Resources", true);
+
+    EventDispatcher::init();
+    se::ScriptEngine::getInstance();
+}
+
+Application::~Application() {
+    EventDispatcher::destroy();
+    se::ScriptEngine::destroyInstance();
+    JobSystem::destroyInstance();
+
+    Application::_instance = nullptr;
+}
+
+bool Application::init() {
+    auto scheduler = Application::getInstance()->getScheduler();
+    scheduler->removeAllFunctionsToBePerformedInCocosThread();
+    scheduler->unscheduleAll();
+
+    se::ScriptEngine::getInstance()->cleanup();
+
+    return true;
+}
+
+void Application::setPreferredFramesPerSecond(int fps) {
+    if (fps == 0)
+        return;
+
+    _fps = fps;
+    _prefererredNanosecondsPerFrame = (long)(1.0 / _fps * NANOSECONDS_PER_SECOND);
+}
+
+Application::LanguageType Application::getCurrentLanguage() const {
+    std::string code = getCurrentLanguageCode();
+
+    if (code == "zh") return LanguageType::CHINESE;
+    if (code == "fr") return LanguageType::FRENCH;
+    if (code == "it") return LanguageType::ITALIAN;
+    if (code == "de") return LanguageType::GERMAN;
+    if (code == "es") return LanguageType::SPANISH;
+    if (code == "nl") return LanguageType::DUTCH;
+    if (code == "ru") return LanguageType::RUSSIAN;
+    if (code == "ko") return LanguageType::KOREAN;
+    if (code == "ja") return LanguageType::JAPANESE;
+    if (code == "hu") return LanguageType::HUNGARIAN;
+    if (code == "pt") return LanguageType::PORTUGUESE;
+    if (code == "ar") return LanguageType::ARABIC;
+    if (code == "nb" || code == "no") return LanguageType::NORWEGIAN;
+    if (code == "pl") return LanguageType::POLISH;
+    if (code == "tr") return LanguageType::TURKISH;
+    if (code == "uk") return LanguageType::UKRAINIAN;
+    if (code == "ro") return LanguageType::ROMANIAN;
+    if (code == "bg") return LanguageType::BULGARIAN;
+    return LanguageType::ENGLISH;
+}
+
+std::string Application::getCurrentLanguageCode() const {
+    std::string locale = getLocaleName();
+    // "zh_CN.UTF-8" or "zh:en" --> "zh"
+    return locale.substr(0, locale.find_first_of("_.:@"));
+}
+
+bool Application::isDisplayStats() {
+    se::AutoHandleScope hs;
+    se::Value ret;
+    char commandBuf[100] = "cc.profiler.isShowingStats();";
+    se::ScriptEngine::getInstance()->evalString(commandBuf, 100, &ret);
+    return ret.toBoolean();
+}
+
+void Application::setDisplayStats(bool isShow) {
+    se::AutoHandleScope hs;
+    char commandBuf[100] = {0};
+    sprintf(commandBuf, isShow ? "cc.profiler.showStats();" : "cc.profiler.hideStats();");
+    se::ScriptEngine::getInstance()->evalString(commandBuf);
+}
+
+void Application::setCursorEnabled(bool value) {
+}
+
+Application::Platform Application::getPlatform() const {
+    return Platform::LINUX;
+}
+
+bool Application::openURL(const std::string &url) {
+    // nothing to show the page on a headless machine
+    return false;
+}
+
+void Application::copyTextToClipboard(const std::string &text) {
+}
+
+void Application::onPause() {
+}
+
+void Application::onResume() {
+}
+
+std::string Application::getSystemVersion() {
+    struct utsname name;
+    if (uname(&name) != 0) {
+        return "Linux";
+    }
+    char buff[256] = {0};
+    snprintf(buff, sizeof(buff), "%s %s", name.sysname, name.release);
+    return buff;
+}
+} // namespace cc
@@ -0,0 +1,303 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "platform/CanvasRenderingContext2D.h"
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <regex>
+#include "base/csscolorparser.h"
+#include "math/Math.h"
+
+// Linux builds are headless, there is no font rasterizer to draw with.
+// Rectangles are filled so that cleared and solid canvases come out right,
+// text is only measured (with an average glyph advance) and never drawn.
+
+typedef std::array<float, 2> Size;
+typedef std::array<float, 4> Color4F;
+
+namespace {
+void fillRectWithColor(uint8_t *buf, uint32_t totalWidth, uint32_t totalHeight, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    uint32_t x1 = std::min(x + width, totalWidth);
+    uint32_t y1 = std::min(y + height, totalHeight);
+    uint8_t *p;
+    for (uint32_t offsetY = y; offsetY < y1; ++offsetY) {
+        for (uint32_t offsetX = x; offsetX < x1; ++offsetX) {
+            p = buf + (totalWidth * offsetY + offsetX) * 4;
+            *p++ = r;
+            *p++ = g;
+            *p++ = b;
+            *p++ = a;
+        }
+    }
+}
+} // namespace
+
+class CanvasRenderingContext2DImpl {
+public:
+    void recreateBuffer(float w, float h) {
+        _bufferWidth = w;
+        _bufferHeight = h;
+        if (_bufferWidth < 1.0f || _bufferHeight < 1.0f) {
+            _imageData.clear();
+            return;
+        }
+
+        int textureSize = (int)_bufferWidth * (int)_bufferHeight * 4;
+        uint8_t *data = (uint8_t *)malloc(sizeof(uint8_t) * textureSize);
+        memset(data, 0x00, textureSize);
+        _imageData.fastSet(data, textureSize);
+    }
+
+    void clearRect(float x, float y, float w, float h) {
+        if (_imageData.isNull())
+            return;
+
+        fillRectWithColor(_imageData.getBytes(), (uint32_t)_bufferWidth, (uint32_t)_bufferHeight,
+                          (uint32_t)std::max(x, 0.0f), (uint32_t)std::max(y, 0.0f), (uint32_t)w, (uint32_t)h, 0, 0, 0, 0);
+    }
+
+    void fillRect(float x, float y, float w, float h) {
+        if (_imageData.isNull())
+            return;
+
+        uint8_t r = static_cast<uint8_t>(round(_fillStyle[0] * 255));
+        uint8_t g = static_cast<uint8_t>(round(_fillStyle[1] * 255));
+        uint8_t b = static_cast<uint8_t>(round(_fillStyle[2] * 255));
+        uint8_t a = static_cast<uint8_t>(round(_fillStyle[3] * 255));
+        fillRectWithColor(_imageData.getBytes(), (uint32_t)_bufferWidth, (uint32_t)_bufferHeight,
+                          (uint32_t)std::max(x, 0.0f), (uint32_t)std::max(y, 0.0f), (uint32_t)w, (uint32_t)h, r, g, b, a);
+    }
+
+    Size measureText(const std::string &text) {
+        // count code points, continuation bytes of utf-8 sequences don't advance
+        size_t count = 0;
+        for (unsigned char c : text) {
+            if ((c & 0xC0) != 0x80) ++count;
+        }
+        return Size{{count * _fontSize * 0.55f, _fontSize * 1.2f}};
+    }
+
+    void updateFont(float fontSize) {
+        _fontSize = fontSize;
+    }
+
+    void setFillStyle(float r, float g, float b, float a) {
+        _fillStyle = {{r, g, b, a}};
+    }
+
+    const cc::Data &getDataRef() const {
+        return _imageData;
+    }
+
+private:
+    cc::Data _imageData;
+    float _bufferWidth = 0.0f;
+    float _bufferHeight = 0.0f;
+    float _fontSize = 14.0f;
+    Color4F _fillStyle = {{0.0f, 0.0f, 0.0f, 1.0f}};
+};
+
+namespace cc {
+
+CanvasGradient::CanvasGradient() {
+}
+
+CanvasGradient::~CanvasGradient() {
+}
+
+void CanvasGradient::addColorStop(float offset, const std::string &color) {
+}
+
+// CanvasRenderingContext2D
+
+CanvasRenderingContext2D::CanvasRenderingContext2D(float width, float height)
+: _width(width),
+  _height(height) {
+    _impl = new CanvasRenderingContext2DImpl();
+}
+
+CanvasRenderingContext2D::~CanvasRenderingContext2D() {
+    delete _impl;
+}
+
+void CanvasRenderingContext2D::recreateBufferIfNeeded() {
+    if (_isBufferSizeDirty) {
+        _isBufferSizeDirty = false;
+        _impl->recreateBuffer(_width, _height);
+        if (_canvasBufferUpdatedCB != nullptr)
+            _canvasBufferUpdatedCB(_impl->getDataRef());
+    }
+}
+
+void CanvasRenderingContext2D::clearRect(float x, float y, float width, float height) {
+    recreateBufferIfNeeded();
+    _impl->clearRect(x, y, width, height);
+}
+
+void CanvasRenderingContext2D::fillRect(float x, float y, float width, float height) {
+    recreateBufferIfNeeded();
+    _impl->fillRect(x, y, width, height);
+
+    if (_canvasBufferUpdatedCB != nullptr)
+        _canvasBufferUpdatedCB(_impl->getDataRef());
+}
+
+void CanvasRenderingContext2D::fillText(const std::string &text, float x, float y, float maxWidth) {
+    if (text.empty())
+        return;
+    recreateBufferIfNeeded();
+
+    if (_canvasBufferUpdatedCB != nullptr)
+        _canvasBufferUpdatedCB(_impl->getDataRef());
+}
+
+void CanvasRenderingContext2D::strokeText(const std::string &text, float x, float y, float maxWidth) {
+    if (text.empty())
+        return;
+    recreateBufferIfNeeded();
+
+    if (_canvasBufferUpdatedCB != nullptr)
+        _canvasBufferUpdatedCB(_impl->getDataRef());
+}
+
+cc::Size CanvasRenderingContext2D::measureText(const std::string &text) {
+    auto s = _impl->measureText(text);
+    return cc::Size(s[0], s[1]);
+}
+
+CanvasGradient *CanvasRenderingContext2D::createLinearGradient(float x0, float y0, float x1, float y1) {
+    return nullptr;
+}
+
+void CanvasRenderingContext2D::save() {
+}
+
+void CanvasRenderingContext2D::beginPath() {
+}
+
+void CanvasRenderingContext2D::closePath() {
+}
+
+void CanvasRenderingContext2D::moveTo(float x, float y) {
+}
+
+void CanvasRenderingContext2D::lineTo(float x, float y) {
+}
+
+void CanvasRenderingContext2D::stroke() {
+}
+
+void CanvasRenderingContext2D::restore() {
+}
+
+void CanvasRenderingContext2D::setCanvasBufferUpdatedCallback(const CanvasBufferUpdatedCallback &cb) {
+    _canvasBufferUpdatedCB = cb;
+    recreateBufferIfNeeded();
+}
+
+void CanvasRenderingContext2D::set_width(float width) {
+    if (math::IsEqualF(width, _width)) return;
+    _width = width;
+    _isBufferSizeDirty = true;
+    recreateBufferIfNeeded();
+}
+
+void CanvasRenderingContext2D::set_height(float height) {
+    if (math::IsEqualF(height, _height)) return;
+    _height = height;
+    _isBufferSizeDirty = true;
+    recreateBufferIfNeeded();
+}
+
+void CanvasRenderingContext2D::set_lineWidth(float lineWidth) {
+    _lineWidth = lineWidth;
+}
+
+void CanvasRenderingContext2D::set_lineCap(const std::string &lineCap) {
+}
+
+void CanvasRenderingContext2D::set_lineJoin(const std::string &lineJoin) {
+}
+
+void CanvasRenderingContext2D::fill() {
+}
+
+void CanvasRenderingContext2D::rect(float x, float y, float w, float h) {
+}
+
+void CanvasRenderingContext2D::set_font(const std::string &font) {
+    if (_font != font) {
+        _font = font;
+
+        std::string fontSizeStr = "30";
+        std::regex re("((\\d+)([\\.]\\d+)?)px");
+        std::match_results<std::string::const_iterator> results;
+        if (std::regex_search(_font.cbegin(), _font.cend(), results, re)) {
+            fontSizeStr = results[1].str();
+        }
+
+        _impl->updateFont(atof(fontSizeStr.c_str()));
+    }
+}
+
+void CanvasRenderingContext2D::set_textAlign(const std::string &textAlign) {
+}
+
+void CanvasRenderingContext2D::set_textBaseline(const std::string &textBaseline) {
+}
+
+void CanvasRenderingContext2D::set_fillStyle(const std::string &fillStyle) {
+    CSSColorParser::Color color = CSSColorParser::parse(fillStyle);
+    _impl->setFillStyle(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a);
+}
+
+void CanvasRenderingContext2D::set_strokeStyle(const std::string &strokeStyle) {
+}
+
+void CanvasRenderingContext2D::set_globalCompositeOperation(const std::string &globalCompositeOperation) {
+}
+
+void CanvasRenderingContext2D::_fillImageData(const Data &imageData, float imageWidth, float imageHeight, float offsetX, float offsetY) {
+}
+
+void CanvasRenderingContext2D::translate(float x, float y) {
+}
+
+void CanvasRenderingContext2D::scale(float x, float y) {
+}
+
+void CanvasRenderingContext2D::rotate(float angle) {
+}
+
+void CanvasRenderingContext2D::transform(float a, float b, float c, float d, float e, float f) {
+}
+
+void CanvasRenderingContext2D::setTransform(float a, float b, float c, float d, float e, float f) {
+}
+
+} // namespace cc
@@ -0,0 +1,87 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+
+    #include "platform/Device.h"
+    #include <sys/utsname.h>
+
+namespace cc {
+
+int Device::getDPI() {
+    // headless, there is no monitor to ask
+    return 96;
+}
+
+void Device::setAccelerometerEnabled(bool isEnabled) {}
+
+void Device::setAccelerometerInterval(float interval) {}
+
+const Device::MotionValue &Device::getDeviceMotionValue() {
+    static MotionValue __motionValue;
+    return __motionValue;
+}
+
+Device::Orientation Device::getDeviceOrientation() {
+    return Device::Orientation::LANDSCAPE_RIGHT;
+}
+
+std::string Device::getDeviceModel() {
+    struct utsname name;
+    if (uname(&name) == 0) {
+        return std::string("Linux ") + name.machine;
+    }
+    return std::string("Linux");
+}
+
+void Device::setKeepScreenOn(bool value) {
+    CC_UNUSED_PARAM(value);
+}
+
+void Device::vibrate(float duration) {
+    CC_UNUSED_PARAM(duration);
+}
+
+float Device::getBatteryLevel() {
+    return 1.0f;
+}
+
+Device::NetworkType Device::getNetworkType() {
+    return Device::NetworkType::LAN;
+}
+
+cc::Vec4 Device::getSafeAreaEdge() {
+    // no SafeArea concept on linux, return ZERO Vec4.
+    return cc::Vec4();
+}
+
+float Device::getDevicePixelRatio() {
+    return 1;
+}
+
+} // namespace cc
+
+#endif // CC_PLATFORM == CC_PLATFORM_LINUX
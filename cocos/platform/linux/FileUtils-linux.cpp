@@ -0,0 +1,109 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+
+    #include "platform/linux/FileUtils-linux.h"
+    #include "base/Log.h"
+    #include <cstdlib>
+    #include <limits.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+namespace cc {
+
+FileUtils *FileUtils::getInstance() {
+    if (s_sharedFileUtils == nullptr) {
+        s_sharedFileUtils = new FileUtilsLinux();
+        if (!s_sharedFileUtils->init()) {
+            delete s_sharedFileUtils;
+            s_sharedFileUtils = nullptr;
+            CC_LOG_DEBUG("ERROR: Could not init FileUtilsLinux");
+        }
+    }
+    return s_sharedFileUtils;
+}
+
+FileUtilsLinux::FileUtilsLinux() {
+}
+
+bool FileUtilsLinux::init() {
+    // resources are looked up next to the executable, like on win32
+    char exePath[PATH_MAX] = {0};
+    ssize_t length = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+    if (length > 0) {
+        std::string exeDir(exePath, length);
+        _defaultResRootPath = exeDir.substr(0, exeDir.find_last_of('/') + 1);
+    } else {
+        _defaultResRootPath = "./";
+    }
+    return FileUtils::init();
+}
+
+std::string FileUtilsLinux::getWritablePath() const {
+    if (!_writablePath.empty()) {
+        return _writablePath;
+    }
+
+    // $XDG_DATA_HOME/<exe name>/, falling back to ~/.local/share/<exe name>/
+    std::string dataHome;
+    const char *xdgDataHome = getenv("XDG_DATA_HOME");
+    const char *home = getenv("HOME");
+    if (xdgDataHome && xdgDataHome[0]) {
+        dataHome = xdgDataHome;
+    } else if (home && home[0]) {
+        dataHome = std::string(home) + "/.local/share";
+    } else {
+        return _defaultResRootPath;
+    }
+
+    char exePath[PATH_MAX] = {0};
+    ssize_t length = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+    std::string exeName = length > 0 ? std::string(exePath, length) : std::string("cocos");
+    exeName = exeName.substr(exeName.find_last_of('/') + 1);
+
+    std::string path = dataHome + "/" + exeName + "/";
+    const_cast<FileUtilsLinux *>(this)->createDirectory(path);
+    return path;
+}
+
+bool FileUtilsLinux::isFileExistInternal(const std::string &strFilePath) const {
+    if (strFilePath.empty()) {
+        return false;
+    }
+
+    std::string strPath = strFilePath;
+    if (!isAbsolutePath(strPath)) { // Not absolute path, add the default root path at the beginning.
+        strPath.insert(0, _defaultResRootPath);
+    }
+
+    struct stat sts;
+    return (stat(strPath.c_str(), &sts) == 0) && S_ISREG(sts.st_mode);
+}
+
+} // namespace cc
+
+#endif // CC_PLATFORM == CC_PLATFORM_LINUX
@@ -0,0 +1,63 @@
+/****************************************************************************
+Copyright (c) 2010-2012 cocos2d-x.org
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CC_FILEUTILS_LINUX_H__
+#define __CC_FILEUTILS_LINUX_H__
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX
+
+    #include "platform/FileUtils.h"
+    #include "base/Macros.h"
+    #include <string>
+
+namespace cc {
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+//! @brief  Helper class to handle file operations
+class CC_DLL FileUtilsLinux : public FileUtils {
+    friend class FileUtils;
+    FileUtilsLinux();
+
+public:
+    /* override functions */
+    bool init() override;
+    virtual std::string getWritablePath() const override;
+
+protected:
+    virtual bool isFileExistInternal(const std::string &strFilePath) const override;
+};
+
+// end of platform group
+/// @}
+
+} // namespace cc
+
+#endif // CC_PLATFORM == CC_PLATFORM_LINUX
+
+#endif // __CC_FILEUTILS_LINUX_H__
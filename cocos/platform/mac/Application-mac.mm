@@ -25,6 +25,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "audio/include/AudioEngine.h"
 #include "base/Scheduler.h"
+#include "base/JobSystem.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "platform/Application.h"
 #include <algorithm>
@@ -132,6 +133,7 @@ Application::~Application() {
 
     EventDispatcher::destroy();
     se::ScriptEngine::destroyInstance();
+    JobSystem::destroyInstance();
 
     Application::_instance = nullptr;
 
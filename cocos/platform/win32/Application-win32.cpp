@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "base/Scheduler.h"
+#include "base/JobSystem.h"
 #include "base/AutoreleasePool.h"
 #include "audio/include/AudioEngine.h"
 
@@ -64,6 +65,7 @@ Application::~Application() {
 
     EventDispatcher::destroy();
     se::ScriptEngine::destroyInstance();
+    JobSystem::destroyInstance();
 
     Application::_instance = nullptr;
 }
@@ -144,6 +144,10 @@ FileUtils::Status FileUtilsWin32::getContents(const std::string &filename, Resiz
     if (filename.empty())
         return FileUtils::Status::NotExists;
 
+    FileUtils::Status status;
+    if (getContentsFromArchive(filename, buffer, &status))
+        return status;
+
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
@@ -10,6 +10,9 @@ enum class GFXCmdType : uint8_t {
     DRAW,
     UPDATE_BUFFER,
     COPY_BUFFER_TO_TEXTURE,
+    DISPATCH,
+    BARRIER,
+    MARKER,
     COUNT,
 };
 
@@ -34,6 +34,13 @@ public:
     virtual void updateBuffer(Buffer *buff, const void *data, uint size) = 0;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) = 0;
     virtual void execute(const CommandBuffer *const *cmdBuffs, uint32_t count) = 0;
+    virtual void dispatch(const DispatchInfo &info) = 0;
+    virtual void pipelineBarrier(const GlobalBarrier *barrier) = 0;
+    // debug labels shown by graphics debuggers, markers may nest
+    virtual void beginMarker(const String &name) = 0;
+    virtual void endMarker() = 0;
+    // writes the GPU time into a slot of the current frame, see Device::getTimestamps
+    virtual void writeTimestamp(uint slot) = 0;
 
     CC_INLINE void bindDescriptorSetForJS(uint set, DescriptorSet *descriptorSet) {
         bindDescriptorSet(set, descriptorSet, 0, nullptr);
@@ -99,6 +99,8 @@ enum class Feature {
     STENCIL_WRITE_MASK,
     STENCIL_COMPARE_MASK,
     MULTITHREADED_SUBMISSION,
+    COMPUTE_SHADER,
+    TIMESTAMP_QUERY,
     COUNT,
 };
 
@@ -562,6 +564,7 @@ enum class DescriptorType : FlagBits {
     STORAGE_BUFFER = 0x4,
     DYNAMIC_STORAGE_BUFFER = 0x8,
     SAMPLER = 0x10,
+    STORAGE_IMAGE = 0x20,
 };
 
 enum class QueueType {
@@ -570,6 +573,46 @@ enum class QueueType {
     TRANSFER,
 };
 
+/**
+ * Resource accesses used to describe pipeline barriers, in the spirit of
+ * https://github.com/Tobski/simple_vulkan_synchronization: each value
+ * implies both the pipeline stage and the kind of memory access.
+ */
+enum class AccessType {
+    NONE,
+
+    // Read accesses
+    INDIRECT_BUFFER,
+    INDEX_BUFFER,
+    VERTEX_BUFFER,
+    VERTEX_SHADER_READ_UNIFORM_BUFFER,
+    VERTEX_SHADER_READ_TEXTURE,
+    VERTEX_SHADER_READ_OTHER,
+    FRAGMENT_SHADER_READ_UNIFORM_BUFFER,
+    FRAGMENT_SHADER_READ_TEXTURE,
+    FRAGMENT_SHADER_READ_OTHER,
+    COLOR_ATTACHMENT_READ,
+    DEPTH_STENCIL_ATTACHMENT_READ,
+    COMPUTE_SHADER_READ_UNIFORM_BUFFER,
+    COMPUTE_SHADER_READ_TEXTURE,
+    COMPUTE_SHADER_READ_OTHER,
+    TRANSFER_READ,
+    HOST_READ,
+    PRESENT,
+
+    // Write accesses
+    VERTEX_SHADER_WRITE,
+    FRAGMENT_SHADER_WRITE,
+    COLOR_ATTACHMENT_WRITE,
+    DEPTH_STENCIL_ATTACHMENT_WRITE,
+    COMPUTE_SHADER_WRITE,
+    TRANSFER_WRITE,
+    HOST_WRITE,
+
+    COUNT,
+};
+typedef cc::vector<AccessType> AccessTypeList;
+
 enum class CommandBufferType {
     PRIMARY,
     SECONDARY,
@@ -655,6 +698,7 @@ struct BufferTextureCopy {
 };
 typedef cc::vector<BufferTextureCopy> BufferTextureCopyList;
 typedef cc::vector<const uint8_t *> BufferDataList;
+typedef std::function<void()> UploadCallback;
 
 struct Viewport {
     int left = 0;
@@ -771,6 +815,16 @@ struct DrawInfo {
 
 typedef cc::vector<DrawInfo> DrawInfoList;
 
+struct DispatchInfo {
+    uint groupCountX = 0;
+    uint groupCountY = 0;
+    uint groupCountZ = 0;
+
+    // if set, the group counts are sourced from this buffer instead
+    Buffer *indirectBuffer = nullptr;
+    uint indirectOffset = 0;
+};
+
 struct IndirectBuffer {
     DrawInfoList drawInfos;
 };
@@ -848,6 +902,25 @@ struct UniformSampler {
 
 typedef cc::vector<UniformSampler> UniformSamplerList;
 
+struct UniformStorageBuffer {
+    uint set = 0;
+    uint binding = 0;
+    String name;
+    uint count = 0;
+};
+
+typedef cc::vector<UniformStorageBuffer> UniformStorageBufferList;
+
+struct UniformStorageImage {
+    uint set = 0;
+    uint binding = 0;
+    String name;
+    Type type = Type::UNKNOWN;
+    uint count = 0;
+};
+
+typedef cc::vector<UniformStorageImage> UniformStorageImageList;
+
 struct ShaderStage {
     ShaderStageFlagBit stage;
     String source;
@@ -873,6 +946,8 @@ struct ShaderInfo {
     AttributeList attributes;
     UniformBlockList blocks;
     UniformSamplerList samplers;
+    UniformStorageBufferList buffers;
+    UniformStorageImageList images;
 };
 
 struct InputAssemblerInfo {
@@ -1031,6 +1106,7 @@ struct PipelineStateInfo {
     BlendState blendState;
     PrimitiveMode primitive = PrimitiveMode::TRIANGLE_LIST;
     DynamicStateFlags dynamicStates = DynamicStateFlagBit::NONE;
+    PipelineBindPoint bindPoint = PipelineBindPoint::GRAPHICS;
 };
 
 struct CommandBufferInfo {
@@ -1039,6 +1115,15 @@ struct CommandBufferInfo {
 };
 typedef cc::vector<CommandBuffer *> CommandBufferList;
 
+/**
+ * Execution and memory dependency between everything recorded
+ * before and after the barrier, described by resource accesses.
+ */
+struct GlobalBarrier {
+    AccessTypeList prevAccesses;
+    AccessTypeList nextAccesses;
+};
+
 struct QueueInfo {
     QueueType type = QueueType::GRAPHICS;
 };
@@ -1059,6 +1144,7 @@ struct FormatInfo {
 
 extern CC_DLL const uint DESCRIPTOR_BUFFER_TYPE;
 extern CC_DLL const uint DESCRIPTOR_SAMPLER_TYPE;
+extern CC_DLL const uint DESCRIPTOR_TEXTURE_TYPE;
 extern CC_DLL const uint DESCRIPTOR_DYNAMIC_TYPE;
 
 extern CC_DLL const FormatInfo GFX_FORMAT_INFOS[];
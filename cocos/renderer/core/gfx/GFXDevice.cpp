@@ -1,5 +1,7 @@
 #include "CoreStd.h"
 
+#include <cstring>
+
 #include "GFXContext.h"
 #include "GFXDevice.h"
 #include "cocos/bindings/event/CustomEventTypes.h"
@@ -9,6 +11,8 @@ namespace cc {
 namespace gfx {
 
 Device *Device::_instance = nullptr;
+constexpr uint Device::MAX_TIMESTAMPS;
+constexpr uint Device::TIMESTAMP_HISTORY;
 
 Device *Device::getInstance() {
     return Device::_instance;
@@ -44,5 +48,33 @@ Format Device::getDepthStencilFormat() const {
     return _context->getDepthStencilFormat();
 }
 
+bool Device::getTimestamps(uint64_t frameIndex, uint64_t *nanoseconds, uint count) const {
+    // frame indices start from 1, 0 marks empty history entries
+    const uint entry = frameIndex % TIMESTAMP_HISTORY;
+    if (!frameIndex || _timestampFrames[entry] != frameIndex) return false;
+
+    memcpy(nanoseconds, _timestamps[entry], std::min(count, MAX_TIMESTAMPS) * sizeof(uint64_t));
+    return true;
+}
+
+void Device::resolveTimestamps(uint64_t frameIndex, const uint64_t *nanoseconds, uint count) {
+    const uint entry = frameIndex % TIMESTAMP_HISTORY;
+    count = std::min(count, MAX_TIMESTAMPS);
+    memcpy(_timestamps[entry], nanoseconds, count * sizeof(uint64_t));
+    memset(_timestamps[entry] + count, 0, (MAX_TIMESTAMPS - count) * sizeof(uint64_t));
+    _timestampFrames[entry] = frameIndex;
+}
+
+// backends without an asynchronous path upload in place, the data is ready right away
+void Device::updateBufferAsync(Buffer *buffer, const void *data, uint size, const UploadCallback &callback) {
+    buffer->update(const_cast<void *>(data), size);
+    if (callback) callback();
+}
+
+void Device::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    copyBuffersToTexture(buffers, dst, regions, count);
+    if (callback) callback();
+}
+
 } // namespace gfx
 } // namespace cc
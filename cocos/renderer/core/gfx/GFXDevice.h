@@ -22,6 +22,9 @@ namespace gfx {
 
 class CC_DLL Device : public Object {
 public:
+    static constexpr uint MAX_TIMESTAMPS = 128u;
+    static constexpr uint TIMESTAMP_HISTORY = 4u;
+
     static Device *getInstance();
 
     Device();
@@ -52,6 +55,16 @@ public:
     CC_INLINE void copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions) {
         copyBuffersToTexture(buffers.data(), dst, regions.data(), static_cast<uint>(regions.size()) );
     }
+    // Uploads which may overlap rendering. The callback runs on the thread calling
+    // acquire once the data is visible to commands submitted after it, the destination
+    // has to stay alive and must not be used by any command before that.
+    CC_INLINE void copyBuffersToTextureAsync(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions, const UploadCallback &callback) {
+        copyBuffersToTextureAsync(buffers.data(), dst, regions.data(), static_cast<uint>(regions.size()), callback);
+    }
+    virtual void updateBufferAsync(Buffer *buffer, const void *data, uint size, const UploadCallback &callback);
+    // GPU times in nanoseconds of the timestamp slots written during a frame, 0 for unused slots.
+    // Results show up a few frames later once the GPU is done with that frame.
+    bool getTimestamps(uint64_t frameIndex, uint64_t *nanoseconds, uint count) const;
 
     virtual void setMultithreaded(bool multithreaded) {}
     virtual SurfaceTransform getSurfaceTransform() const { return _transform; }
@@ -63,6 +76,10 @@ public:
     virtual uint getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint getNumInstances() const { return _numInstances; }
     virtual uint getNumTris() const { return _numTriangles; }
+    // API calls issued by the last presented frame, only tracked by the GL backends
+    virtual uint getNumGLCalls() const { return 0u; }
+    // index of the frame being recorded, counting from 1 and advanced by present
+    CC_INLINE uint64_t getFrameIndex() const { return _frameIndex; }
 
     Format getColorFormat() const;
     Format getDepthStencilFormat() const;
@@ -110,10 +127,14 @@ protected:
     virtual PipelineLayout *createPipelineLayout() = 0;
     virtual PipelineState *createPipelineState() = 0;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) = 0;
+    virtual void copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback);
 
     virtual void bindRenderContext(bool bound) {}
     virtual void bindDeviceContext(bool bound) {}
 
+    // backends hand over the timestamps of a frame once they are available
+    void resolveTimestamps(uint64_t frameIndex, const uint64_t *nanoseconds, uint count);
+
     API _API = API::UNKNOWN;
     SurfaceTransform _transform = SurfaceTransform::IDENTITY;
     String _deviceName;
@@ -133,6 +154,9 @@ protected:
     uint _numDrawCalls = 0u;
     uint _numInstances = 0u;
     uint _numTriangles = 0u;
+    uint64_t _frameIndex = 1u;
+    uint64_t _timestampFrames[TIMESTAMP_HISTORY] = {};
+    uint64_t _timestamps[TIMESTAMP_HISTORY][MAX_TIMESTAMPS] = {};
     uint _maxVertexAttributes = 0u;
     uint _maxVertexUniformVectors = 0u;
     uint _maxFragmentUniformVectors = 0u;
@@ -25,6 +25,7 @@ public:
     CC_INLINE const BlendState &getBlendState() const { return _blendState; }
     CC_INLINE const RenderPass *getRenderPass() const { return _renderPass; }
     CC_INLINE const PipelineLayout *getPipelineLayout() const { return _pipelineLayout; }
+    CC_INLINE PipelineBindPoint getBindPoint() const { return _bindPoint; }
 
 protected:
     Device *_device = nullptr;
@@ -37,6 +38,7 @@ protected:
     BlendState _blendState;
     RenderPass *_renderPass = nullptr;
     PipelineLayout *_pipelineLayout = nullptr;
+    PipelineBindPoint _bindPoint = PipelineBindPoint::GRAPHICS;
 };
 
 } // namespace gfx
@@ -22,6 +22,8 @@ public:
     CC_INLINE const AttributeList &getAttributes() const { return _attributes; }
     CC_INLINE const UniformBlockList &getBlocks() const { return _blocks; }
     CC_INLINE const UniformSamplerList &getSamplers() const { return _samplers; }
+    CC_INLINE const UniformStorageBufferList &getBuffers() const { return _buffers; }
+    CC_INLINE const UniformStorageImageList &getImages() const { return _images; }
 
 protected:
     Device *_device = nullptr;
@@ -31,6 +33,8 @@ protected:
     AttributeList _attributes;
     UniformBlockList _blocks;
     UniformSamplerList _samplers;
+    UniformStorageBufferList _buffers;
+    UniformStorageImageList _images;
 };
 
 } // namespace gfx
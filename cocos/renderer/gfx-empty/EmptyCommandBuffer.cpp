@@ -0,0 +1,165 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "EmptyStd.h"
+
+#include "EmptyCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+EmptyCommandBuffer::EmptyCommandBuffer(Device *device)
+: CommandBuffer(device) {
+}
+
+EmptyCommandBuffer::~EmptyCommandBuffer() {
+}
+
+bool EmptyCommandBuffer::initialize(const CommandBufferInfo &info) {
+    _type = info.type;
+    _queue = info.queue;
+
+    return true;
+}
+
+void EmptyCommandBuffer::destroy() {
+}
+
+void EmptyCommandBuffer::begin(RenderPass *renderPass, uint subpass, Framebuffer *frameBuffer, int submitIndex) {
+    _curPipelineState = nullptr;
+
+    _numDrawCalls = 0;
+    _numInstances = 0;
+    _numTriangles = 0;
+}
+
+void EmptyCommandBuffer::end() {
+    _isInRenderPass = false;
+}
+
+void EmptyCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, int stencil, bool fromSecondaryCB) {
+    _isInRenderPass = true;
+}
+
+void EmptyCommandBuffer::endRenderPass() {
+    _isInRenderPass = false;
+}
+
+void EmptyCommandBuffer::bindPipelineState(PipelineState *pso) {
+    _curPipelineState = pso;
+}
+
+void EmptyCommandBuffer::bindDescriptorSet(uint set, DescriptorSet *descriptorSet, uint dynamicOffsetCount, const uint *dynamicOffsets) {
+}
+
+void EmptyCommandBuffer::bindInputAssembler(InputAssembler *ia) {
+}
+
+void EmptyCommandBuffer::setViewport(const Viewport &vp) {
+}
+
+void EmptyCommandBuffer::setScissor(const Rect &rect) {
+}
+
+void EmptyCommandBuffer::setLineWidth(float width) {
+}
+
+void EmptyCommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+}
+
+void EmptyCommandBuffer::setBlendConstants(const Color &constants) {
+}
+
+void EmptyCommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+}
+
+void EmptyCommandBuffer::setStencilWriteMask(StencilFace face, uint mask) {
+}
+
+void EmptyCommandBuffer::setStencilCompareMask(StencilFace face, int ref, uint mask) {
+}
+
+void EmptyCommandBuffer::draw(InputAssembler *ia) {
+    if ((_type == CommandBufferType::PRIMARY && _isInRenderPass) ||
+        (_type == CommandBufferType::SECONDARY)) {
+
+        ++_numDrawCalls;
+        _numInstances += ia->getInstanceCount();
+        if (_curPipelineState) {
+            switch (_curPipelineState->getPrimitive()) {
+                case PrimitiveMode::TRIANGLE_LIST: {
+                    _numTriangles += ia->getIndexCount() / 3 * std::max(ia->getInstanceCount(), 1U);
+                    break;
+                }
+                case PrimitiveMode::TRIANGLE_STRIP:
+                case PrimitiveMode::TRIANGLE_FAN: {
+                    _numTriangles += (ia->getIndexCount() - 2) * std::max(ia->getInstanceCount(), 1U);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    } else {
+        CC_LOG_ERROR("Command 'draw' must be recorded inside a render pass.");
+    }
+}
+
+void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint size) {
+    if (_type == CommandBufferType::PRIMARY && _isInRenderPass) {
+        CC_LOG_ERROR("Command 'updateBuffer' must be recorded outside a render pass.");
+    }
+}
+
+void EmptyCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) {
+    if (_type == CommandBufferType::PRIMARY && _isInRenderPass) {
+        CC_LOG_ERROR("Command 'copyBuffersToTexture' must be recorded outside a render pass.");
+    }
+}
+
+void EmptyCommandBuffer::execute(const CommandBuffer *const *cmdBuffs, uint32_t count) {
+    for (uint i = 0; i < count; ++i) {
+        const CommandBuffer *cmdBuff = cmdBuffs[i];
+        _numDrawCalls += cmdBuff->getNumDrawCalls();
+        _numInstances += cmdBuff->getNumInstances();
+        _numTriangles += cmdBuff->getNumTris();
+    }
+}
+
+void EmptyCommandBuffer::dispatch(const DispatchInfo &info) {
+}
+
+void EmptyCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+}
+
+void EmptyCommandBuffer::beginMarker(const String &name) {
+}
+
+void EmptyCommandBuffer::endMarker() {
+}
+
+void EmptyCommandBuffer::writeTimestamp(uint slot) {
+}
+
+} // namespace gfx
+} // namespace cc
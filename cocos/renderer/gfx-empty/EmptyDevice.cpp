@@ -0,0 +1,204 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "EmptyStd.h"
+
+#include "EmptyBuffer.h"
+#include "EmptyCommandBuffer.h"
+#include "EmptyContext.h"
+#include "EmptyDescriptorSet.h"
+#include "EmptyDescriptorSetLayout.h"
+#include "EmptyDevice.h"
+#include "EmptyFence.h"
+#include "EmptyFramebuffer.h"
+#include "EmptyInputAssembler.h"
+#include "EmptyPipelineLayout.h"
+#include "EmptyPipelineState.h"
+#include "EmptyQueue.h"
+#include "EmptyRenderPass.h"
+#include "EmptySampler.h"
+#include "EmptyShader.h"
+#include "EmptyTexture.h"
+
+namespace cc {
+namespace gfx {
+
+EmptyDevice::EmptyDevice() {
+}
+
+EmptyDevice::~EmptyDevice() {
+}
+
+bool EmptyDevice::initialize(const DeviceInfo &info) {
+    _API = API::UNKNOWN;
+    _deviceName = "Empty";
+    _width = info.width;
+    _height = info.height;
+    _nativeWidth = info.nativeWidth;
+    _nativeHeight = info.nativeHeight;
+    _windowHandle = info.windowHandle;
+
+    _bindingMappingInfo = info.bindingMappingInfo;
+    if (!_bindingMappingInfo.bufferOffsets.size()) {
+        _bindingMappingInfo.bufferOffsets.push_back(0);
+    }
+    if (!_bindingMappingInfo.samplerOffsets.size()) {
+        _bindingMappingInfo.samplerOffsets.push_back(0);
+    }
+
+    ContextInfo ctxInfo;
+    ctxInfo.windowHandle = _windowHandle;
+    ctxInfo.sharedCtx = info.sharedCtx;
+
+    _context = CC_NEW(EmptyContext(this));
+    if (!_context->initialize(ctxInfo)) {
+        destroy();
+        return false;
+    }
+
+    // report everything as supported so no fallback path gets taken
+    for (uint i = 0; i < static_cast<uint>(Feature::COUNT); ++i) {
+        _features[i] = true;
+    }
+
+    _renderer = "Empty";
+    _vendor = "Cocos";
+    _version = "1.0";
+
+    _maxVertexAttributes = 16u;
+    _maxVertexUniformVectors = 256u;
+    _maxFragmentUniformVectors = 256u;
+    _maxTextureUnits = 16u;
+    _maxVertexTextureUnits = 16u;
+    _maxUniformBufferBindings = 24u;
+    _maxUniformBlockSize = 65536u;
+    _maxTextureSize = 4096u;
+    _maxCubeMapTextureSize = 4096u;
+    _uboOffsetAlignment = 16u;
+    _depthBits = 24u;
+    _stencilBits = 8u;
+
+    QueueInfo queueInfo;
+    queueInfo.type = QueueType::GRAPHICS;
+    _queue = createQueue(queueInfo);
+
+    CommandBufferInfo cmdBuffInfo;
+    cmdBuffInfo.type = CommandBufferType::PRIMARY;
+    cmdBuffInfo.queue = _queue;
+    _cmdBuff = createCommandBuffer(cmdBuffInfo);
+
+    CC_LOG_INFO("Empty device initialized.");
+    CC_LOG_INFO("SCREEN_SIZE: %d x %d", _width, _height);
+
+    return true;
+}
+
+void EmptyDevice::destroy() {
+    CC_SAFE_DESTROY(_cmdBuff);
+    CC_SAFE_DESTROY(_queue);
+    CC_SAFE_DESTROY(_context);
+}
+
+void EmptyDevice::resize(uint width, uint height) {
+    _width = width;
+    _height = height;
+}
+
+void EmptyDevice::acquire() {
+}
+
+void EmptyDevice::present() {
+    EmptyQueue *queue = (EmptyQueue *)_queue;
+    _numDrawCalls = queue->_numDrawCalls;
+    _numInstances = queue->_numInstances;
+    _numTriangles = queue->_numTriangles;
+
+    // Clear queue stats
+    queue->_numDrawCalls = 0;
+    queue->_numInstances = 0;
+    queue->_numTriangles = 0;
+
+    ++_frameIndex;
+}
+
+CommandBuffer *EmptyDevice::doCreateCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
+    return CC_NEW(EmptyCommandBuffer(this));
+}
+
+Fence *EmptyDevice::createFence() {
+    return CC_NEW(EmptyFence(this));
+}
+
+Queue *EmptyDevice::createQueue() {
+    return CC_NEW(EmptyQueue(this));
+}
+
+Buffer *EmptyDevice::createBuffer() {
+    return CC_NEW(EmptyBuffer(this));
+}
+
+Texture *EmptyDevice::createTexture() {
+    return CC_NEW(EmptyTexture(this));
+}
+
+Sampler *EmptyDevice::createSampler() {
+    return CC_NEW(EmptySampler(this));
+}
+
+Shader *EmptyDevice::createShader() {
+    return CC_NEW(EmptyShader(this));
+}
+
+InputAssembler *EmptyDevice::createInputAssembler() {
+    return CC_NEW(EmptyInputAssembler(this));
+}
+
+RenderPass *EmptyDevice::createRenderPass() {
+    return CC_NEW(EmptyRenderPass(this));
+}
+
+Framebuffer *EmptyDevice::createFramebuffer() {
+    return CC_NEW(EmptyFramebuffer(this));
+}
+
+DescriptorSet *EmptyDevice::createDescriptorSet() {
+    return CC_NEW(EmptyDescriptorSet(this));
+}
+
+DescriptorSetLayout *EmptyDevice::createDescriptorSetLayout() {
+    return CC_NEW(EmptyDescriptorSetLayout(this));
+}
+
+PipelineLayout *EmptyDevice::createPipelineLayout() {
+    return CC_NEW(EmptyPipelineLayout(this));
+}
+
+PipelineState *EmptyDevice::createPipelineState() {
+    return CC_NEW(EmptyPipelineState(this));
+}
+
+void EmptyDevice::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) {
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,57 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "EmptyStd.h"
+
+#include "EmptyQueue.h"
+
+namespace cc {
+namespace gfx {
+
+EmptyQueue::EmptyQueue(Device *device)
+: Queue(device) {
+}
+
+EmptyQueue::~EmptyQueue() {
+}
+
+bool EmptyQueue::initialize(const QueueInfo &info) {
+    _type = info.type;
+
+    return true;
+}
+
+void EmptyQueue::destroy() {
+}
+
+void EmptyQueue::submit(const CommandBuffer *const *cmdBuffs, uint count, Fence *fence) {
+    for (uint i = 0; i < count; ++i) {
+        const CommandBuffer *cmdBuff = cmdBuffs[i];
+        _numDrawCalls += cmdBuff->getNumDrawCalls();
+        _numInstances += cmdBuff->getNumInstances();
+        _numTriangles += cmdBuff->getNumTris();
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,124 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "EmptyStd.h"
+
+#include "EmptyTexture.h"
+
+namespace cc {
+namespace gfx {
+
+EmptyTexture::EmptyTexture(Device *device)
+: Texture(device) {
+}
+
+EmptyTexture::~EmptyTexture() {
+}
+
+bool EmptyTexture::initialize(const TextureInfo &info) {
+    _type = info.type;
+    _usage = info.usage;
+    _format = info.format;
+    _width = info.width;
+    _height = info.height;
+    _depth = info.depth;
+    _layerCount = info.layerCount;
+    _levelCount = info.levelCount;
+    _samples = info.samples;
+    _flags = info.flags;
+    _size = FormatSize(_format, _width, _height, _depth);
+
+    if (_flags & TextureFlags::BAKUP_BUFFER) {
+        _buffer = (uint8_t *)CC_MALLOC(_size);
+        if (!_buffer) {
+            CC_LOG_ERROR("EmptyTexture: CC_MALLOC backup buffer failed.");
+            return false;
+        }
+        _device->getMemoryStatus().textureSize += _size;
+    }
+
+    _device->getMemoryStatus().textureSize += _size;
+
+    return true;
+}
+
+bool EmptyTexture::initialize(const TextureViewInfo &info) {
+    _isTextureView = true;
+
+    EmptyTexture *texture = (EmptyTexture *)info.texture;
+
+    _type = info.type;
+    _usage = texture->_usage;
+    _format = info.format;
+    _width = texture->_width;
+    _height = texture->_height;
+    _depth = texture->_depth;
+    _baseLevel = info.baseLevel;
+    _levelCount = info.levelCount;
+    _baseLayer = info.baseLayer;
+    _layerCount = info.layerCount;
+    _samples = texture->_samples;
+    _flags = texture->_flags;
+
+    return true;
+}
+
+void EmptyTexture::destroy() {
+    if (_isTextureView) return;
+
+    if (_size) {
+        _device->getMemoryStatus().textureSize -= _size;
+    }
+
+    if (_buffer) {
+        CC_FREE(_buffer);
+        _device->getMemoryStatus().textureSize -= _size;
+        _buffer = nullptr;
+    }
+
+    _size = 0u;
+}
+
+void EmptyTexture::resize(uint width, uint height) {
+    if (_width != width || _height != height) {
+        uint size = FormatSize(_format, width, height, _depth);
+        const uint oldSize = _size;
+        _width = width;
+        _height = height;
+        _size = size;
+
+        MemoryStatus &status = _device->getMemoryStatus();
+        status.textureSize -= oldSize;
+        status.textureSize += _size;
+
+        if (_buffer) {
+            CC_FREE(_buffer);
+            _buffer = (uint8_t *)CC_MALLOC(_size);
+            status.textureSize -= oldSize;
+            status.textureSize += _size;
+        }
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -144,14 +144,20 @@ void GLES2CommandBuffer::bindDescriptorSet(uint set, DescriptorSet *descriptorSe
         _isStateInvalid = true;
     }
     if (dynamicOffsetCount) {
-        _curDynamicOffsets[set].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
-        _isStateInvalid = true;
+        vector<uint> &curOffsets = _curDynamicOffsets[set];
+        if (curOffsets.size() != dynamicOffsetCount || memcmp(curOffsets.data(), dynamicOffsets, dynamicOffsetCount * sizeof(uint))) {
+            curOffsets.assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+            _isStateInvalid = true;
+        }
     }
 }
 
 void GLES2CommandBuffer::bindInputAssembler(InputAssembler *ia) {
-    _curGPUInputAssember = ((GLES2InputAssembler *)ia)->gpuInputAssembler();
-    _isStateInvalid = true;
+    GLES2GPUInputAssembler *gpuInputAssembler = ((GLES2InputAssembler *)ia)->gpuInputAssembler();
+    if (_curGPUInputAssember != gpuInputAssembler) {
+        _curGPUInputAssember = gpuInputAssembler;
+        _isStateInvalid = true;
+    }
 }
 
 void GLES2CommandBuffer::setViewport(const Viewport &vp) {
@@ -353,6 +359,24 @@ void GLES2CommandBuffer::execute(const CommandBuffer *const *cmdBuffs, uint32_t
     }
 }
 
+void GLES2CommandBuffer::dispatch(const DispatchInfo &info) {
+    CC_LOG_ERROR("Command 'dispatch' is not supported on GLES2, check Feature::COMPUTE_SHADER first.");
+}
+
+void GLES2CommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+    // GLES2 has no incoherent writes to synchronize
+}
+
+void GLES2CommandBuffer::beginMarker(const String &name) {
+    // debug labels and timer queries are only wired up on GLES3
+}
+
+void GLES2CommandBuffer::endMarker() {
+}
+
+void GLES2CommandBuffer::writeTimestamp(uint slot) {
+}
+
 void GLES2CommandBuffer::BindStates() {
     GLES2CmdBindStates *cmd = _cmdAllocator->bindStatesCmdPool.alloc();
 
@@ -61,6 +61,11 @@ public:
     virtual void updateBuffer(Buffer *buff, const void *data, uint size) override;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) override;
     virtual void execute(const CommandBuffer *const *cmdBuffs, uint32_t count) override;
+    virtual void dispatch(const DispatchInfo &info) override;
+    virtual void pipelineBarrier(const GlobalBarrier *barrier) override;
+    virtual void beginMarker(const String &name) override;
+    virtual void endMarker() override;
+    virtual void writeTimestamp(uint slot) override;
 
 protected:
     void BindStates();
@@ -1551,7 +1551,7 @@ void GLES2CmdFuncEndRenderPass(GLES2Device *device) {
 void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipelineState, GLES2GPUInputAssembler *gpuInputAssembler,
                            vector<GLES2GPUDescriptorSet *> &gpuDescriptorSets, vector<uint> &dynamicOffsets,
                            Viewport &viewport, Rect &scissor, float lineWidth, bool depthBiasEnabled, GLES2DepthBias &depthBias, Color &blendConstants,
-                           GLES2DepthBounds &depthBounds, GLES2StencilWriteMask &stencilWriteMask, GLES2StencilCompareMask &stencilCompareMask) {
+                           GLES2DepthBounds &depthBounds, GLES2StencilWriteMask &stencilWriteMask, GLES2StencilCompareMask &stencilCompareMask, bool isBindingUnchanged) {
     GLES2ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
     GLES2GPUStateCache *cache = device->stateCache();
@@ -1560,9 +1560,12 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
     GLenum glWrapT = 0u;
     GLenum glMinFilter = 0u;
 
+    bool isPipelineChanged = false;
+
     if (gpuPipelineState && gpuPipelineState != gfxStateCache.gpuPipelineState) {
         gfxStateCache.gpuPipelineState = gpuPipelineState;
         gfxStateCache.glPrimitive = gpuPipelineState->glPrimitive;
+        isPipelineChanged = true;
 
         if (gpuPipelineState->gpuShader) {
             if (cache->glProgram != gpuPipelineState->gpuShader->glProgram) {
@@ -1571,7 +1574,13 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
                 isShaderChanged = true;
             }
         }
+    }
 
+    // different pipelines often share the same fixed-function states,
+    // compare the packed blocks first and only walk the fields on a mismatch
+    if (isPipelineChanged &&
+        (!cache->isStateBlockValid || cache->stateBlockReverseCW != gfxStateCache.reverseCW ||
+         cache->stateBlock != gpuPipelineState->stateBlock)) {
         // bind rasterizer state
         if (cache->rs.cullMode != gpuPipelineState->rs.cullMode) {
             switch (gpuPipelineState->rs.cullMode) {
@@ -1607,7 +1616,8 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
         }
         if ((cache->rs.depthBias != gpuPipelineState->rs.depthBias) ||
             (cache->rs.depthBiasSlop != gpuPipelineState->rs.depthBiasSlop)) {
-            GL_CHECK(glPolygonOffset(cache->rs.depthBias, cache->rs.depthBiasSlop));
+            GL_CHECK(glPolygonOffset(gpuPipelineState->rs.depthBias, gpuPipelineState->rs.depthBiasSlop));
+            cache->rs.depthBias = gpuPipelineState->rs.depthBias;
             cache->rs.depthBiasSlop = gpuPipelineState->rs.depthBiasSlop;
         }
         if (cache->rs.lineWidth != gpuPipelineState->rs.lineWidth) {
@@ -1702,7 +1712,7 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
 
         // bind blend state
         if (cache->bs.isA2C != gpuPipelineState->bs.isA2C) {
-            if (cache->bs.isA2C) {
+            if (gpuPipelineState->bs.isA2C) {
                 GL_CHECK(glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE));
             } else {
                 GL_CHECK(glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE));
@@ -1758,10 +1768,14 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
                                  (GLboolean)(target.blendColorMask & ColorMask::A)));
             cacheTarget.blendColorMask = target.blendColorMask;
         }
+
+        cache->stateBlock = gpuPipelineState->stateBlock;
+        cache->stateBlockReverseCW = gfxStateCache.reverseCW;
+        cache->isStateBlockValid = true;
     } // if
 
-    // bind descriptor sets
-    if (gpuPipelineState && gpuPipelineState->gpuShader && gpuPipelineState->gpuPipelineLayout) {
+    // bind descriptor sets, skipped when the previous bind used the very same bindings
+    if (!isBindingUnchanged && gpuPipelineState && gpuPipelineState->gpuShader && gpuPipelineState->gpuPipelineLayout) {
 
         size_t blockLen = gpuPipelineState->gpuShader->glBlocks.size();
         const vector<vector<int>> &dynamicOffsetIndices = gpuPipelineState->gpuPipelineLayout->dynamicOffsetIndices;
@@ -2121,6 +2135,10 @@ void GLES2CmdFuncBindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
 
     if (gpuPipelineState && !gpuPipelineState->dynamicStates.empty()) {
         for (DynamicStateFlagBit dynamicState : gpuPipelineState->dynamicStates) {
+            // everything but viewport and scissor overrides fields of the state block
+            if (dynamicState != DynamicStateFlagBit::VIEWPORT && dynamicState != DynamicStateFlagBit::SCISSOR) {
+                cache->isStateBlockValid = false;
+            }
             switch (dynamicState) {
                 case DynamicStateFlagBit::VIEWPORT:
                     if (cache->viewport != viewport) {
@@ -2533,6 +2551,8 @@ void GLES2CmdFuncExecuteCmds(GLES2Device *device, GLES2CmdPackage *cmdPackage) {
 
     static uint cmdIndices[(int)GFXCmdType::COUNT] = {0};
     memset(cmdIndices, 0, sizeof(cmdIndices));
+    // consecutive binds that only swap the input assembler keep their descriptors
+    GLES2CmdBindStates *lastBindStates = nullptr;
 
     for (uint i = 0; i < cmdPackage->cmds.size(); ++i) {
         GFXCmdType cmdType = cmdPackage->cmds[i];
@@ -2550,7 +2570,12 @@ void GLES2CmdFuncExecuteCmds(GLES2Device *device, GLES2CmdPackage *cmdPackage) {
             }
             case GFXCmdType::BIND_STATES: {
                 GLES2CmdBindStates *cmd = cmdPackage->bindStatesCmds[cmdIdx];
-                GLES2CmdFuncBindState(device, cmd->gpuPipelineState, cmd->gpuInputAssembler, cmd->gpuDescriptorSets, cmd->dynamicOffsets, cmd->viewport, cmd->scissor, cmd->lineWidth, cmd->depthBiasEnabled, cmd->depthBias, cmd->blendConstants, cmd->depthBounds, cmd->stencilWriteMask, cmd->stencilCompareMask);
+                bool isBindingUnchanged = lastBindStates &&
+                                          lastBindStates->gpuPipelineState == cmd->gpuPipelineState &&
+                                          lastBindStates->gpuDescriptorSets == cmd->gpuDescriptorSets &&
+                                          lastBindStates->dynamicOffsets == cmd->dynamicOffsets;
+                GLES2CmdFuncBindState(device, cmd->gpuPipelineState, cmd->gpuInputAssembler, cmd->gpuDescriptorSets, cmd->dynamicOffsets, cmd->viewport, cmd->scissor, cmd->lineWidth, cmd->depthBiasEnabled, cmd->depthBias, cmd->blendConstants, cmd->depthBounds, cmd->stencilWriteMask, cmd->stencilCompareMask, isBindingUnchanged);
+                lastBindStates = cmd;
                 break;
             } // namespace gfx
             case GFXCmdType::DRAW: {
@@ -2571,6 +2596,9 @@ void GLES2CmdFuncExecuteCmds(GLES2Device *device, GLES2CmdPackage *cmdPackage) {
             default:
                 break;
         }
+        if (cmdType != GFXCmdType::BIND_STATES && cmdType != GFXCmdType::DRAW) {
+            lastBindStates = nullptr;
+        }
         cmdIdx++;
     }
 }
@@ -213,6 +213,7 @@ void GLES2Device::present() {
     _numDrawCalls = queue->_numDrawCalls;
     _numInstances = queue->_numInstances;
     _numTriangles = queue->_numTriangles;
+    _numGLCalls = gles2CallCount;
 
     _context->present();
 
@@ -220,6 +221,9 @@ void GLES2Device::present() {
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
     queue->_numTriangles = 0;
+    gles2CallCount = 0u;
+
+    ++_frameIndex;
 }
 
 void GLES2Device::bindRenderContext(bool bound) {
@@ -65,6 +65,7 @@ public:
     virtual void resize(uint width, uint height) override;
     virtual void acquire() override;
     virtual void present() override;
+    virtual uint getNumGLCalls() const override { return _numGLCalls; }
 
     CC_INLINE bool useVAO() const { return _useVAO; }
     CC_INLINE bool useDrawInstanced() const { return _useDrawInstanced; }
@@ -122,6 +123,7 @@ private:
     bool _useDiscardFramebuffer = false;
 
     uint _threadID = 0u;
+    uint _numGLCalls = 0u;
 };
 
 } // namespace gfx
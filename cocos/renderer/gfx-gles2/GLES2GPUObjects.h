@@ -258,6 +258,56 @@ public:
     uint dynamicOffsetCount;
 };
 
+// The fixed-function part of a pipeline state packed into plain words,
+// so two pipelines can be compared with a single memcmp before walking
+// the individual rasterizer, depth-stencil and blend fields.
+struct GLES2GPUStateBlock final {
+    static constexpr uint WORD_COUNT = 17u;
+
+    uint32_t words[WORD_COUNT] = {};
+
+    void pack(const RasterizerState &rs, const DepthStencilState &dss, const BlendState &bs) {
+        const BlendTarget &target = bs.targets[0];
+        words[0] = (uint32_t)rs.cullMode |
+                   (rs.isFrontFaceCCW ? 1u : 0u) << 2 |
+                   (dss.depthTest ? 1u : 0u) << 3 |
+                   (dss.depthWrite ? 1u : 0u) << 4 |
+                   (uint32_t)dss.depthFunc << 5 |
+                   (dss.stencilTestFront ? 1u : 0u) << 8 |
+                   (dss.stencilTestBack ? 1u : 0u) << 9 |
+                   (bs.isA2C ? 1u : 0u) << 10 |
+                   (target.blend ? 1u : 0u) << 11 |
+                   (uint32_t)target.blendColorMask << 12 |
+                   (uint32_t)target.blendEq << 16 |
+                   (uint32_t)target.blendAlphaEq << 19;
+        words[1] = (uint32_t)target.blendSrc |
+                   (uint32_t)target.blendDst << 5 |
+                   (uint32_t)target.blendSrcAlpha << 10 |
+                   (uint32_t)target.blendDstAlpha << 15;
+        words[2] = (uint32_t)dss.stencilFuncFront |
+                   (uint32_t)dss.stencilFailOpFront << 3 |
+                   (uint32_t)dss.stencilZFailOpFront << 6 |
+                   (uint32_t)dss.stencilPassOpFront << 9;
+        words[3] = (uint32_t)dss.stencilFuncBack |
+                   (uint32_t)dss.stencilFailOpBack << 3 |
+                   (uint32_t)dss.stencilZFailOpBack << 6 |
+                   (uint32_t)dss.stencilPassOpBack << 9;
+        words[4] = dss.stencilReadMaskFront;
+        words[5] = dss.stencilWriteMaskFront;
+        words[6] = dss.stencilRefFront;
+        words[7] = dss.stencilReadMaskBack;
+        words[8] = dss.stencilWriteMaskBack;
+        words[9] = dss.stencilRefBack;
+        memcpy(&words[10], &rs.depthBias, sizeof(float));
+        memcpy(&words[11], &rs.depthBiasSlop, sizeof(float));
+        memcpy(&words[12], &rs.lineWidth, sizeof(float));
+        memcpy(&words[13], &bs.blendColor, 4 * sizeof(float));
+    }
+
+    bool operator==(const GLES2GPUStateBlock &rhs) const { return memcmp(words, rhs.words, sizeof(words)) == 0; }
+    bool operator!=(const GLES2GPUStateBlock &rhs) const { return !(*this == rhs); }
+};
+
 class GLES2GPUPipelineState final : public Object {
 public:
     GLenum glPrimitive = GL_TRIANGLES;
@@ -265,6 +315,7 @@ public:
     RasterizerState rs;
     DepthStencilState dss;
     BlendState bs;
+    GLES2GPUStateBlock stateBlock;
     DynamicStateList dynamicStates;
     GLES2GPUPipelineLayout *gpuLayout = nullptr;
     GLES2GPURenderPass *gpuRenderPass = nullptr;
@@ -321,6 +372,10 @@ public:
     BlendState bs;
     bool isCullFaceEnabled = true;
     bool isStencilTestEnabled = false;
+    // state block of the last pipeline applied, invalidated by dynamic states
+    GLES2GPUStateBlock stateBlock;
+    bool isStateBlockValid = false;
+    bool stateBlockReverseCW = false;
     map<String, uint> texUnitCacheMap;
     GLES2ObjectCache gfxStateCache;
 
@@ -344,6 +399,7 @@ public:
         glReadFBO = 0;
         isCullFaceEnabled = true;
         isStencilTestEnabled = false;
+        isStateBlockValid = false;
 
         viewport = Viewport();
         scissor = Rect();
@@ -67,6 +67,7 @@ bool GLES2PipelineState::initialize(const PipelineStateInfo &info) {
     _dynamicStates = info.dynamicStates;
     _renderPass = info.renderPass;
     _pipelineLayout = info.pipelineLayout;
+    _bindPoint = info.bindPoint;
 
     _gpuPipelineState = CC_NEW(GLES2GPUPipelineState);
     _gpuPipelineState->glPrimitive = GLES2Primitives[(int)_primitive];
@@ -74,6 +75,7 @@ bool GLES2PipelineState::initialize(const PipelineStateInfo &info) {
     _gpuPipelineState->rs = _rasterizerState;
     _gpuPipelineState->dss = _depthStencilState;
     _gpuPipelineState->bs = _blendState;
+    _gpuPipelineState->stateBlock.pack(_rasterizerState, _depthStencilState, _blendState);
     _gpuPipelineState->gpuRenderPass = ((GLES2RenderPass *)_renderPass)->gpuRenderPass();
     _gpuPipelineState->gpuPipelineLayout = ((GLES2PipelineLayout *)_pipelineLayout)->gpuPipelineLayout();
 
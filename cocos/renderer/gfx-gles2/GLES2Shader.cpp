@@ -41,6 +41,8 @@ bool GLES2Shader::initialize(const ShaderInfo &info) {
     _attributes = info.attributes;
     _blocks = info.blocks;
     _samplers = info.samplers;
+    _buffers = info.buffers;
+    _images = info.images;
 
     _gpuShader = CC_NEW(GLES2GPUShader);
     _gpuShader->name = _name;
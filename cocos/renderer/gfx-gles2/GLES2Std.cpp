@@ -22,3 +22,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "GLES2Std.h"
+
+namespace cc {
+namespace gfx {
+
+uint gles2CallCount = 0u;
+
+} // namespace gfx
+} // namespace cc
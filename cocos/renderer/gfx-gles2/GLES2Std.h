@@ -42,9 +42,17 @@ THE SOFTWARE.
 
 #endif
 
+namespace cc {
+namespace gfx {
+// GL calls issued through GL_CHECK, collected by the device once per frame
+extern CC_GLES2_API uint gles2CallCount;
+} // namespace gfx
+} // namespace cc
+
 #if CC_DEBUG > 0
 #define GL_CHECK(x)                                                  \
     do {                                                             \
+        ++::cc::gfx::gles2CallCount;                                 \
         x; GLenum err = glGetError();                                \
         if (err != GL_NO_ERROR) {                                    \
             CC_LOG_ERROR("%s returned GL error: 0x%x", #x, err);     \
@@ -60,6 +68,10 @@ THE SOFTWARE.
         }                                                            \
     } while (0)
 #else
-#define GL_CHECK(x) x
+#define GL_CHECK(x)                  \
+    do {                             \
+        ++::cc::gfx::gles2CallCount; \
+        x;                           \
+    } while (0)
 #define EGL_CHECK(x) x
 #endif
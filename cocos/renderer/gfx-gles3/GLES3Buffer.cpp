@@ -87,6 +87,9 @@ bool GLES3Buffer::initialize(const BufferViewInfo &info) {
     _gpuBuffer->glBuffer = buffer->_gpuBuffer->glBuffer;
     _gpuBuffer->glOffset = info.offset;
     _gpuBuffer->buffer = buffer->_gpuBuffer->buffer;
+    if (buffer->_gpuBuffer->isStreamed) {
+        _gpuBuffer->gpuStreamSource = buffer->_gpuBuffer;
+    }
     _gpuBuffer->indirects = buffer->_gpuBuffer->indirects;
 
     return true;
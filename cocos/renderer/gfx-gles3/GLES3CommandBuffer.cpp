@@ -144,14 +144,20 @@ void GLES3CommandBuffer::bindDescriptorSet(uint set, DescriptorSet *descriptorSe
         _isStateInvalid = true;
     }
     if (dynamicOffsetCount) {
-        _curDynamicOffsets[set].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
-        _isStateInvalid = true;
+        vector<uint> &curOffsets = _curDynamicOffsets[set];
+        if (curOffsets.size() != dynamicOffsetCount || memcmp(curOffsets.data(), dynamicOffsets, dynamicOffsetCount * sizeof(uint))) {
+            curOffsets.assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+            _isStateInvalid = true;
+        }
     }
 }
 
 void GLES3CommandBuffer::bindInputAssembler(InputAssembler *ia) {
-    _curGPUInputAssember = ((GLES3InputAssembler *)ia)->gpuInputAssembler();
-    _isStateInvalid = true;
+    GLES3GPUInputAssembler *gpuInputAssembler = ((GLES3InputAssembler *)ia)->gpuInputAssembler();
+    if (_curGPUInputAssember != gpuInputAssembler) {
+        _curGPUInputAssember = gpuInputAssembler;
+        _isStateInvalid = true;
+    }
 }
 
 void GLES3CommandBuffer::setViewport(const Viewport &vp) {
@@ -349,6 +355,21 @@ void GLES3CommandBuffer::execute(const CommandBuffer *const *cmdBuffs, uint32_t
             ++cmd->refCount;
             _curCmdPackage->copyBufferToTextureCmds.push(cmd);
         }
+        for (uint j = 0; j < cmdPackage->dispatchCmds.size(); ++j) {
+            GLES3CmdDispatch *cmd = cmdPackage->dispatchCmds[j];
+            ++cmd->refCount;
+            _curCmdPackage->dispatchCmds.push(cmd);
+        }
+        for (uint j = 0; j < cmdPackage->barrierCmds.size(); ++j) {
+            GLES3CmdBarrier *cmd = cmdPackage->barrierCmds[j];
+            ++cmd->refCount;
+            _curCmdPackage->barrierCmds.push(cmd);
+        }
+        for (uint j = 0; j < cmdPackage->markerCmds.size(); ++j) {
+            GLES3CmdMarker *cmd = cmdPackage->markerCmds[j];
+            ++cmd->refCount;
+            _curCmdPackage->markerCmds.push(cmd);
+        }
         _curCmdPackage->cmds.concat(cmdPackage->cmds);
 
         _numDrawCalls += cmdBuff->_numDrawCalls;
@@ -360,6 +381,67 @@ void GLES3CommandBuffer::execute(const CommandBuffer *const *cmdBuffs, uint32_t
     }
 }
 
+void GLES3CommandBuffer::dispatch(const DispatchInfo &info) {
+    if ((_type == CommandBufferType::PRIMARY && !_isInRenderPass) ||
+        (_type == CommandBufferType::SECONDARY)) {
+
+        if (_isStateInvalid) {
+            BindStates();
+        }
+
+        GLES3CmdDispatch *cmd = _cmdAllocator->dispatchCmdPool.alloc();
+        cmd->dispatchInfo.groupCountX = info.groupCountX;
+        cmd->dispatchInfo.groupCountY = info.groupCountY;
+        cmd->dispatchInfo.groupCountZ = info.groupCountZ;
+        cmd->dispatchInfo.indirectBuffer = info.indirectBuffer ? ((GLES3Buffer *)info.indirectBuffer)->gpuBuffer() : nullptr;
+        cmd->dispatchInfo.indirectOffset = info.indirectOffset;
+
+        _curCmdPackage->dispatchCmds.push(cmd);
+        _curCmdPackage->cmds.push(GFXCmdType::DISPATCH);
+    } else {
+        CC_LOG_ERROR("Command 'dispatch' must be recorded outside a render pass.");
+    }
+}
+
+void GLES3CommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+    if (!barrier) return;
+
+    GLbitfield barriers = MapGLBarrierBits(*barrier);
+    if (barriers) {
+        GLES3CmdBarrier *cmd = _cmdAllocator->barrierCmdPool.alloc();
+        cmd->barriers = barriers;
+
+        _curCmdPackage->barrierCmds.push(cmd);
+        _curCmdPackage->cmds.push(GFXCmdType::BARRIER);
+    }
+}
+
+void GLES3CommandBuffer::beginMarker(const String &name) {
+    GLES3CmdMarker *cmd = _cmdAllocator->markerCmdPool.alloc();
+    cmd->op = GLES3MarkerOp::PUSH;
+    cmd->label = name;
+
+    _curCmdPackage->markerCmds.push(cmd);
+    _curCmdPackage->cmds.push(GFXCmdType::MARKER);
+}
+
+void GLES3CommandBuffer::endMarker() {
+    GLES3CmdMarker *cmd = _cmdAllocator->markerCmdPool.alloc();
+    cmd->op = GLES3MarkerOp::POP;
+
+    _curCmdPackage->markerCmds.push(cmd);
+    _curCmdPackage->cmds.push(GFXCmdType::MARKER);
+}
+
+void GLES3CommandBuffer::writeTimestamp(uint slot) {
+    GLES3CmdMarker *cmd = _cmdAllocator->markerCmdPool.alloc();
+    cmd->op = GLES3MarkerOp::TIMESTAMP;
+    cmd->slot = slot;
+
+    _curCmdPackage->markerCmds.push(cmd);
+    _curCmdPackage->cmds.push(GFXCmdType::MARKER);
+}
+
 void GLES3CommandBuffer::BindStates() {
     GLES3CmdBindStates *cmd = _cmdAllocator->bindStatesCmdPool.alloc();
 
@@ -29,6 +29,10 @@ THE SOFTWARE.
 
 #define BUFFER_OFFSET(idx) (static_cast<char *>(0) + (idx))
 
+// sizes of DrawElementsIndirectCommand & DrawArraysIndirectCommand
+#define GLES3_DRAW_ELEMENTS_INDIRECT_SIZE (5 * sizeof(GLuint))
+#define GLES3_DRAW_ARRAYS_INDIRECT_SIZE (4 * sizeof(GLuint))
+
 constexpr uint USE_VAO = true;
 
 namespace cc {
@@ -598,6 +602,197 @@ const GLenum GLES3_BLEND_FACTORS[] = {
     GL_CONSTANT_ALPHA,
     GL_ONE_MINUS_CONSTANT_ALPHA,
 };
+
+bool IsStreamable(GLES3Device *device, const GLES3GPUBuffer *gpuBuffer) {
+    if (!device->streamBuffer() || !(gpuBuffer->memUsage & MemoryUsageBit::HOST)) return false;
+    if (gpuBuffer->usage & (BufferUsageBit::INDIRECT | BufferUsageBit::STORAGE | BufferUsageBit::TRANSFER_SRC | BufferUsageBit::TRANSFER_DST)) return false;
+    if (!gpuBuffer->size || gpuBuffer->size > GLES3GPUStreamBuffer::MAX_STREAMED_SIZE) return false;
+    return gpuBuffer->glTarget == GL_ARRAY_BUFFER || gpuBuffer->glTarget == GL_ELEMENT_ARRAY_BUFFER || gpuBuffer->glTarget == GL_UNIFORM_BUFFER;
+}
+
+void MoveStreamedBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, GLuint glBuffer, uint glOffset) {
+    GLuint oldGLBuffer = gpuBuffer->glBuffer;
+    uint oldOffset = gpuBuffer->glOffset;
+    gpuBuffer->glBuffer = glBuffer;
+    gpuBuffer->glOffset = glOffset;
+
+    if (gpuBuffer->glTarget != GL_UNIFORM_BUFFER) {
+        // input assemblers re-point their VAOs on the next draw
+        ++device->streamBuffer()->version;
+        return;
+    }
+
+    // follow the buffer on every binding point that still references it, views included
+    GLES3GPUStateCache *cache = device->stateCache();
+    for (size_t i = 0; i < cache->glBindUBOs.size(); ++i) {
+        uint bindOffset = cache->glBindUBOOffsets[i];
+        if (cache->glBindUBOs[i] != oldGLBuffer || bindOffset < oldOffset || bindOffset >= oldOffset + gpuBuffer->size) continue;
+
+        uint delta = bindOffset - oldOffset;
+        GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, (GLuint)i, glBuffer, glOffset + delta, gpuBuffer->size - delta));
+        cache->glUniformBuffer = cache->glBindUBOs[i] = glBuffer;
+        cache->glBindUBOOffsets[i] = glOffset + delta;
+    }
+}
+
+// returns whether the buffer still lived in the allocated range
+bool DemoteStreamedBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer, GLES3GPUStreamBuffer::Allocation &allocation) {
+    GLES3GPUBuffer *gpuBuffer = allocation.gpuBuffer;
+    allocation.gpuBuffer = nullptr;
+    if (!gpuBuffer || gpuBuffer->glBuffer != gpuStreamBuffer->glBuffer || gpuBuffer->glOffset != allocation.offset) return false;
+
+    if (gpuBuffer->streamSize) {
+        GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, gpuBuffer->glOwnBuffer));
+        GL_CHECK(glBufferSubData(GL_COPY_WRITE_BUFFER, 0, gpuBuffer->streamSize, gpuBuffer->buffer));
+    }
+    MoveStreamedBuffer(device, gpuBuffer, gpuBuffer->glOwnBuffer, 0u);
+    return true;
+}
+
+void FenceStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    // buffers not updated since the last fence were read from the previous range during this batch too,
+    // so that range has to outlive this fence. Moving them back to their own storage ends the chain here.
+    bool isPreviousRangeRead = false;
+    if (!gpuStreamBuffer->fencedRanges.empty()) {
+        for (GLES3GPUStreamBuffer::Allocation &allocation : gpuStreamBuffer->fencedRanges.back().allocations) {
+            if (!allocation.gpuBuffer) continue;
+            isPreviousRangeRead = true;
+            DemoteStreamedBuffer(device, gpuStreamBuffer, allocation);
+        }
+    }
+    if (!gpuStreamBuffer->pendingSize && !isPreviousRangeRead) return;
+
+    GLES3GPUStreamBuffer::FencedRange range;
+    GL_CHECK(range.glFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    range.serial = range.releaseSerial = ++gpuStreamBuffer->serial;
+    range.size = gpuStreamBuffer->pendingSize;
+    range.allocations.swap(gpuStreamBuffer->pendingAllocations);
+    if (isPreviousRangeRead) {
+        gpuStreamBuffer->fencedRanges.back().releaseSerial = range.serial;
+    }
+    gpuStreamBuffer->fencedRanges.push_back(std::move(range));
+    gpuStreamBuffer->pendingSize = 0u;
+}
+
+// the fence guarding the last batch that may read from the oldest range
+GLsync GetReleaseFence(const GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    const GLES3GPUStreamBuffer::FencedRange &front = gpuStreamBuffer->fencedRanges.front();
+    for (const GLES3GPUStreamBuffer::FencedRange &range : gpuStreamBuffer->fencedRanges) {
+        if (range.serial == front.releaseSerial) return range.glFence;
+    }
+    return front.glFence;
+}
+
+void ReleaseFencedRange(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    GLES3GPUStreamBuffer::FencedRange &range = gpuStreamBuffer->fencedRanges.front();
+    GLsync glFence = GetReleaseFence(gpuStreamBuffer);
+
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    while (status == GL_TIMEOUT_EXPIRED) {
+        GL_CHECK(status = glClientWaitSync(glFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull));
+    }
+    if (status == GL_WAIT_FAILED) {
+        CC_LOG_ERROR("Waiting for a stream buffer fence failed.");
+    }
+    GL_CHECK(glDeleteSync(range.glFence));
+
+    // ranges fenced in the middle of a frame may still be live
+    for (GLES3GPUStreamBuffer::Allocation &allocation : range.allocations) {
+        DemoteStreamedBuffer(device, gpuStreamBuffer, allocation);
+    }
+
+    gpuStreamBuffer->used -= range.size;
+    gpuStreamBuffer->fencedRanges.erase(gpuStreamBuffer->fencedRanges.begin());
+}
+
+uint AllocStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer, uint size) {
+    const uint alignment = gpuStreamBuffer->alignment;
+    uint offset = (gpuStreamBuffer->head + alignment - 1) / alignment * alignment;
+    if (offset + size > GLES3GPUStreamBuffer::CAPACITY) {
+        offset = 0u; // wrap around, the tail of the ring is wasted until released
+    }
+    uint consumed = (offset >= gpuStreamBuffer->head ? offset - gpuStreamBuffer->head : GLES3GPUStreamBuffer::CAPACITY - gpuStreamBuffer->head) + size;
+
+    while (gpuStreamBuffer->used + consumed > GLES3GPUStreamBuffer::CAPACITY) {
+        if (gpuStreamBuffer->fencedRanges.empty()) {
+            // the current frame alone fills the ring, wait for what it has issued so far
+            FenceStreamBuffer(device, gpuStreamBuffer);
+            if (gpuStreamBuffer->fencedRanges.empty()) break;
+        }
+        ReleaseFencedRange(device, gpuStreamBuffer);
+    }
+
+    gpuStreamBuffer->head = offset + size;
+    gpuStreamBuffer->used += consumed;
+    gpuStreamBuffer->pendingSize += consumed;
+    return offset;
+}
+
+void WriteStreamBuffer(GLES3GPUStreamBuffer *gpuStreamBuffer, uint offset, const void *data, uint size) {
+    // COPY_WRITE keeps the VAO and indexed binding points untouched
+    GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, gpuStreamBuffer->glBuffer));
+    void *mapped = nullptr;
+    GL_CHECK(mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (mapped) {
+        memcpy(mapped, data, size);
+        GL_CHECK(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
+    } else {
+        GL_CHECK(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
+    }
+}
+
+void ForgetStreamedBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
+    GLES3GPUStreamBuffer *gpuStreamBuffer = device->streamBuffer();
+    if (!gpuStreamBuffer) return;
+
+    for (GLES3GPUStreamBuffer::Allocation &allocation : gpuStreamBuffer->pendingAllocations) {
+        if (allocation.gpuBuffer == gpuBuffer) allocation.gpuBuffer = nullptr;
+    }
+    for (GLES3GPUStreamBuffer::FencedRange &range : gpuStreamBuffer->fencedRanges) {
+        for (GLES3GPUStreamBuffer::Allocation &allocation : range.allocations) {
+            if (allocation.gpuBuffer == gpuBuffer) allocation.gpuBuffer = nullptr;
+        }
+    }
+    if (gpuBuffer->glBuffer == gpuStreamBuffer->glBuffer) {
+        MoveStreamedBuffer(device, gpuBuffer, gpuBuffer->glOwnBuffer, 0u);
+    }
+}
+
+// streamed vertex and index buffers move on every update,
+// re-point the bound VAO at their current storage
+void UpdateStreamedInputAssembler(GLES3Device *device, const GLES3GPUShader *gpuShader, GLES3GPUInputAssembler *gpuInputAssembler) {
+    const uint version = device->streamBuffer()->version;
+    uint &vaoVersion = gpuInputAssembler->glVAOStreamVersions[gpuShader->glProgram ^ device->getThreadID()];
+    if (vaoVersion == version) return;
+    vaoVersion = version;
+
+    GLES3GPUStateCache *cache = device->stateCache();
+    for (size_t j = 0; j < gpuShader->glInputs.size(); ++j) {
+        const GLES3GPUInput &gpuInput = gpuShader->glInputs[j];
+        for (size_t a = 0; a < gpuInputAssembler->glAttribs.size(); ++a) {
+            const GLES3GPUAttribute &gpuAttribute = gpuInputAssembler->glAttribs[a];
+            if (gpuAttribute.name != gpuInput.name) continue;
+            if (gpuAttribute.gpuStreamedBuffer) {
+                const GLES3GPUBuffer *gpuVB = gpuAttribute.gpuStreamedBuffer;
+                if (cache->glArrayBuffer != gpuVB->glBuffer) {
+                    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, gpuVB->glBuffer));
+                    cache->glArrayBuffer = gpuVB->glBuffer;
+                }
+                for (uint c = 0; c < gpuAttribute.componentCount; ++c) {
+                    uint attribOffset = gpuVB->glOffset + gpuAttribute.offset + gpuAttribute.size * c;
+                    GL_CHECK(glVertexAttribPointer(gpuInput.glLoc + c, gpuAttribute.count, gpuAttribute.glType, gpuAttribute.isNormalized, gpuAttribute.stride, BUFFER_OFFSET(attribOffset)));
+                }
+            }
+            break;
+        }
+    }
+
+    const GLES3GPUBuffer *gpuIndexBuffer = gpuInputAssembler->gpuIndexBuffer;
+    if (gpuIndexBuffer && gpuIndexBuffer->isStreamed) {
+        // part of the VAO state, not tracked by the cache
+        GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuIndexBuffer->glBuffer));
+    }
+}
 } // namespace
 
 void GLES3CmdFuncCreateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
@@ -657,7 +852,26 @@ void GLES3CmdFuncCreateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
             device->stateCache()->glUniformBuffer = 0;
         }
     } else if (gpuBuffer->usage & BufferUsageBit::INDIRECT) {
-        gpuBuffer->glTarget = GL_NONE;
+        if (gpuBuffer->usage & BufferUsageBit::STORAGE) {
+            // written by compute shaders, has to be a real buffer object
+            gpuBuffer->glTarget = GL_DRAW_INDIRECT_BUFFER;
+            GL_CHECK(glGenBuffers(1, &gpuBuffer->glBuffer));
+            if (gpuBuffer->size) {
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+                GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->size, nullptr, glUsage));
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+            }
+        } else {
+            gpuBuffer->glTarget = GL_NONE;
+        }
+    } else if (gpuBuffer->usage & BufferUsageBit::STORAGE) {
+        gpuBuffer->glTarget = GL_SHADER_STORAGE_BUFFER;
+        GL_CHECK(glGenBuffers(1, &gpuBuffer->glBuffer));
+        if (gpuBuffer->size) {
+            GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpuBuffer->glBuffer));
+            GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER, gpuBuffer->size, nullptr, glUsage));
+            GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+        }
     } else if ((gpuBuffer->usage & BufferUsageBit::TRANSFER_DST) ||
                (gpuBuffer->usage & BufferUsageBit::TRANSFER_SRC)) {
         gpuBuffer->buffer = (uint8_t *)CC_MALLOC(gpuBuffer->size);
@@ -666,11 +880,23 @@ void GLES3CmdFuncCreateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
         CCASSERT(false, "Unsupported BufferType, create buffer failed.");
         gpuBuffer->glTarget = GL_NONE;
     }
+
+    if (IsStreamable(device, gpuBuffer)) {
+        gpuBuffer->isStreamed = true;
+        gpuBuffer->glOwnBuffer = gpuBuffer->glBuffer;
+        gpuBuffer->buffer = (uint8_t *)CC_MALLOC(gpuBuffer->size);
+        memset(gpuBuffer->buffer, 0, gpuBuffer->size);
+    }
 }
 
 void GLES3CmdFuncDestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
+    if (gpuBuffer->isStreamed) {
+        // the ring itself belongs to the device
+        ForgetStreamedBuffer(device, gpuBuffer);
+    }
+
     if (gpuBuffer->glBuffer) {
         if (gpuBuffer->usage & BufferUsageBit::VERTEX) {
             if (USE_VAO) {
@@ -719,6 +945,18 @@ void GLES3CmdFuncDestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
 void GLES3CmdFuncResizeBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
+    if (gpuBuffer->isStreamed) {
+        // resized contents are undefined, start over from the own storage
+        ForgetStreamedBuffer(device, gpuBuffer);
+        CC_SAFE_FREE(gpuBuffer->buffer);
+        gpuBuffer->streamSize = 0u;
+        gpuBuffer->isStreamed = IsStreamable(device, gpuBuffer);
+        if (gpuBuffer->isStreamed) {
+            gpuBuffer->buffer = (uint8_t *)CC_MALLOC(gpuBuffer->size);
+            memset(gpuBuffer->buffer, 0, gpuBuffer->size);
+        }
+    }
+
     GLenum glUsage = (gpuBuffer->memUsage & MemoryUsageBit::HOST ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 
     if (gpuBuffer->usage & BufferUsageBit::VERTEX) {
@@ -772,7 +1010,23 @@ void GLES3CmdFuncResizeBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
         }
     } else if (gpuBuffer->usage & BufferUsageBit::INDIRECT) {
         gpuBuffer->indirects.resize(gpuBuffer->count);
-        gpuBuffer->glTarget = GL_NONE;
+        if (gpuBuffer->glBuffer) {
+            gpuBuffer->glTarget = GL_DRAW_INDIRECT_BUFFER;
+            if (gpuBuffer->size) {
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+                GL_CHECK(glBufferData(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->size, nullptr, glUsage));
+                GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+            }
+        } else {
+            gpuBuffer->glTarget = GL_NONE;
+        }
+    } else if (gpuBuffer->usage & BufferUsageBit::STORAGE) {
+        gpuBuffer->glTarget = GL_SHADER_STORAGE_BUFFER;
+        if (gpuBuffer->size) {
+            GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpuBuffer->glBuffer));
+            GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER, gpuBuffer->size, nullptr, glUsage));
+            GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+        }
     } else if ((gpuBuffer->usage & BufferUsageBit::TRANSFER_DST) ||
                (gpuBuffer->usage & BufferUsageBit::TRANSFER_SRC)) {
         if (gpuBuffer->buffer) {
@@ -1003,6 +1257,7 @@ void GLES3CmdFuncDestroySampler(GLES3Device *device, GLES3GPUSampler *gpuSampler
 void GLES3CmdFuncCreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
     GLenum glShaderStage = 0;
     String shaderStageStr;
+    const char *shaderVersion = "#version 300 es\n";
     GLint status;
 
     for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
@@ -1019,6 +1274,16 @@ void GLES3CmdFuncCreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
                 shaderStageStr = "Fragment Shader";
                 break;
             }
+            case ShaderStageFlagBit::COMPUTE: {
+                if (!device->hasFeature(Feature::COMPUTE_SHADER)) {
+                    CC_LOG_ERROR("Compute Shader in %s requires an OpenGL ES 3.1 context.", gpuShader->name.c_str());
+                    return;
+                }
+                glShaderStage = GL_COMPUTE_SHADER;
+                shaderStageStr = "Compute Shader";
+                shaderVersion = "#version 310 es\n";
+                break;
+            }
             default: {
                 CCASSERT(false, "Unsupported ShaderStageFlagBit");
                 return;
@@ -1026,7 +1291,7 @@ void GLES3CmdFuncCreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
         }
 
         GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
-        String shaderSource = "#version 300 es\n" + gpuStage.source;
+        String shaderSource = shaderVersion + gpuStage.source;
         const char *source = shaderSource.c_str();
         GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&source, nullptr));
         GL_CHECK(glCompileShader(gpuStage.glShader));
@@ -1297,6 +1562,48 @@ void GLES3CmdFuncCreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
 
     // strip out the inactive ones
     gpuShader->glSamplers = glActiveSamplers;
+
+    if (!device->hasFeature(Feature::COMPUTE_SHADER)) return;
+
+    // storage blocks and images can only get their bindings from layout qualifiers
+    // in ES 3.1, so read them back instead of assigning them like the samplers above
+    for (size_t i = 0; i < gpuShader->buffers.size(); ++i) {
+        const UniformStorageBuffer &buffer = gpuShader->buffers[i];
+        GLuint glIndex;
+        GL_CHECK(glIndex = glGetProgramResourceIndex(gpuShader->glProgram, GL_SHADER_STORAGE_BLOCK, buffer.name.c_str()));
+        if (glIndex == GL_INVALID_INDEX) continue;
+
+        const GLenum glProp = GL_BUFFER_BINDING;
+        GLint glBinding = 0;
+        GL_CHECK(glGetProgramResourceiv(gpuShader->glProgram, GL_SHADER_STORAGE_BLOCK, glIndex, 1, &glProp, 1, nullptr, &glBinding));
+
+        GLES3GPUUniformStorageBuffer gpuBuffer;
+        gpuBuffer.set = buffer.set;
+        gpuBuffer.binding = buffer.binding;
+        gpuBuffer.name = buffer.name;
+        gpuBuffer.glBinding = glBinding;
+        gpuShader->glBuffers.push_back(gpuBuffer);
+    }
+
+    for (size_t i = 0; i < gpuShader->images.size(); ++i) {
+        const UniformStorageImage &image = gpuShader->images[i];
+        GLint glLoc;
+        GL_CHECK(glLoc = glGetUniformLocation(gpuShader->glProgram, image.name.c_str()));
+        if (glLoc < 0) continue;
+
+        GLint glUnit = 0;
+        GL_CHECK(glGetUniformiv(gpuShader->glProgram, glLoc, &glUnit));
+
+        GLES3GPUUniformStorageImage gpuImage;
+        gpuImage.set = image.set;
+        gpuImage.binding = image.binding;
+        gpuImage.name = image.name;
+        gpuImage.count = image.count;
+        for (uint t = 0u; t < image.count; t++) {
+            gpuImage.units.push_back(glUnit + t);
+        }
+        gpuShader->glImages.push_back(gpuImage);
+    }
 }
 
 void GLES3CmdFuncDestroyShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
@@ -1325,6 +1632,10 @@ void GLES3CmdFuncCreateInputAssembler(GLES3Device *device, GLES3GPUInputAssemble
         }
     }
 
+    if (gpuInputAssembler->gpuIndexBuffer && gpuInputAssembler->gpuIndexBuffer->isStreamed) {
+        gpuInputAssembler->isStreamed = true;
+    }
+
     vector<uint> streamOffsets(device->getMaxVertexAttributes(), 0u);
 
     gpuInputAssembler->glAttribs.resize(gpuInputAssembler->attributes.size());
@@ -1345,6 +1656,12 @@ void GLES3CmdFuncCreateInputAssembler(GLES3Device *device, GLES3GPUInputAssemble
         if (gpuVB) {
             gpuAttribute.glBuffer = gpuVB->glBuffer;
             gpuAttribute.stride = gpuVB->stride;
+
+            GLES3GPUBuffer *gpuSource = gpuVB->gpuStreamSource ? gpuVB->gpuStreamSource : gpuVB;
+            if (gpuSource->isStreamed) {
+                gpuAttribute.gpuStreamedBuffer = gpuSource;
+                gpuInputAssembler->isStreamed = true;
+            }
         }
         streamOffsets[attrib.stream] += gpuAttribute.size;
     }
@@ -1361,6 +1678,7 @@ void GLES3CmdFuncDestroyInputAssembler(GLES3Device *device, GLES3GPUInputAssembl
         GL_CHECK(glDeleteVertexArrays(1, &it->second));
     }
     gpuInputAssembler->glVAOs.clear();
+    gpuInputAssembler->glVAOStreamVersions.clear();
 }
 
 void GLES3CmdFuncCreateFramebuffer(GLES3Device *device, GLES3GPUFramebuffer *gpuFBO) {
@@ -1667,15 +1985,18 @@ void GLES3CmdFuncEndRenderPass(GLES3Device *device) {
 void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipelineState, GLES3GPUInputAssembler *gpuInputAssembler,
                            vector<GLES3GPUDescriptorSet *> &gpuDescriptorSets, vector<uint> &dynamicOffsets, Viewport &viewport, Rect &scissor,
                            float lineWidth, bool depthBiasEnabled, GLES3DepthBias &depthBias, Color &blendConstants, GLES3DepthBounds &depthBounds,
-                           GLES3StencilWriteMask &stencilWriteMask, GLES3StencilCompareMask &stencilCompareMask) {
+                           GLES3StencilWriteMask &stencilWriteMask, GLES3StencilCompareMask &stencilCompareMask, bool isBindingUnchanged) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
 
     GLES3GPUStateCache *cache = device->stateCache();
     bool isShaderChanged = false;
 
+    bool isPipelineChanged = false;
+
     if (gpuPipelineState && gpuPipelineState != gfxStateCache.gpuPipelineState) {
         gfxStateCache.gpuPipelineState = gpuPipelineState;
         gfxStateCache.glPrimitive = gpuPipelineState->glPrimitive;
+        isPipelineChanged = true;
 
         if (gpuPipelineState->gpuShader) {
             if (cache->glProgram != gpuPipelineState->gpuShader->glProgram) {
@@ -1684,7 +2005,13 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 isShaderChanged = true;
             }
         }
+    }
 
+    // different pipelines often share the same fixed-function states,
+    // compare the packed blocks first and only walk the fields on a mismatch
+    if (isPipelineChanged &&
+        (!cache->isStateBlockValid || cache->stateBlockReverseCW != gfxStateCache.reverseCW ||
+         cache->stateBlock != gpuPipelineState->stateBlock)) {
         // bind rasterizer state
         if (cache->rs.cullMode != gpuPipelineState->rs.cullMode) {
             switch (gpuPipelineState->rs.cullMode) {
@@ -1720,7 +2047,8 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
         }
         if ((cache->rs.depthBias != gpuPipelineState->rs.depthBias) ||
             (cache->rs.depthBiasSlop != gpuPipelineState->rs.depthBiasSlop)) {
-            GL_CHECK(glPolygonOffset(cache->rs.depthBias, cache->rs.depthBiasSlop));
+            GL_CHECK(glPolygonOffset(gpuPipelineState->rs.depthBias, gpuPipelineState->rs.depthBiasSlop));
+            cache->rs.depthBias = gpuPipelineState->rs.depthBias;
             cache->rs.depthBiasSlop = gpuPipelineState->rs.depthBiasSlop;
         }
         if (cache->rs.lineWidth != gpuPipelineState->rs.lineWidth) {
@@ -1815,7 +2143,7 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
 
         // bind blend state
         if (cache->bs.isA2C != gpuPipelineState->bs.isA2C) {
-            if (cache->bs.isA2C) {
+            if (gpuPipelineState->bs.isA2C) {
                 GL_CHECK(glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE));
             } else {
                 GL_CHECK(glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE));
@@ -1871,10 +2199,14 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                                  (GLboolean)(target.blendColorMask & ColorMask::A)));
             cacheTarget.blendColorMask = target.blendColorMask;
         }
+
+        cache->stateBlock = gpuPipelineState->stateBlock;
+        cache->stateBlockReverseCW = gfxStateCache.reverseCW;
+        cache->isStateBlockValid = true;
     } // if
 
-    // bind descriptor sets
-    if (gpuPipelineState && gpuPipelineState->gpuShader && gpuPipelineState->gpuPipelineLayout) {
+    // bind descriptor sets, skipped when the previous bind used the very same bindings
+    if (!isBindingUnchanged && gpuPipelineState && gpuPipelineState->gpuShader && gpuPipelineState->gpuPipelineLayout) {
 
         size_t blockLen = gpuPipelineState->gpuShader->glBlocks.size();
         const vector<vector<int>> &dynamicOffsetIndices = gpuPipelineState->gpuPipelineLayout->dynamicOffsetIndices;
@@ -1893,21 +2225,26 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 continue;
             }
 
+            GLuint glBuffer = gpuDescriptor.gpuBuffer->glBuffer;
             uint offset = gpuDescriptor.gpuBuffer->glOffset;
+            if (gpuDescriptor.gpuBuffer->gpuStreamSource) {
+                glBuffer = gpuDescriptor.gpuBuffer->gpuStreamSource->glBuffer;
+                offset += gpuDescriptor.gpuBuffer->gpuStreamSource->glOffset;
+            }
 
             const vector<int> &dynamicOffsetSetIndices = dynamicOffsetIndices[glBlock.set];
             int dynamicOffsetIndex = glBlock.binding < dynamicOffsetSetIndices.size() ? dynamicOffsetSetIndices[glBlock.binding] : -1;
             if (dynamicOffsetIndex >= 0) offset += dynamicOffsets[dynamicOffsetIndex];
 
-            if (cache->glBindUBOs[glBlock.glBinding] != gpuDescriptor.gpuBuffer->glBuffer ||
+            if (cache->glBindUBOs[glBlock.glBinding] != glBuffer ||
                 cache->glBindUBOOffsets[glBlock.glBinding] != offset) {
                 if (offset) {
-                    GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, glBlock.glBinding, gpuDescriptor.gpuBuffer->glBuffer,
+                    GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, glBlock.glBinding, glBuffer,
                                                offset, gpuDescriptor.gpuBuffer->size));
                 } else {
-                    GL_CHECK(glBindBufferBase(GL_UNIFORM_BUFFER, glBlock.glBinding, gpuDescriptor.gpuBuffer->glBuffer));
+                    GL_CHECK(glBindBufferBase(GL_UNIFORM_BUFFER, glBlock.glBinding, glBuffer));
                 }
-                cache->glUniformBuffer = cache->glBindUBOs[glBlock.glBinding] = gpuDescriptor.gpuBuffer->glBuffer;
+                cache->glUniformBuffer = cache->glBindUBOs[glBlock.glBinding] = glBuffer;
                 cache->glBindUBOOffsets[glBlock.glBinding] = offset;
             }
         }
@@ -1948,10 +2285,59 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 }
             }
         }
+
+        size_t bufferLen = gpuPipelineState->gpuShader->glBuffers.size();
+        for (size_t j = 0; j < bufferLen; j++) {
+            const GLES3GPUUniformStorageBuffer &glBuffer = gpuPipelineState->gpuShader->glBuffers[j];
+
+            CCASSERT(gpuDescriptorSets.size() > glBuffer.set, "Invalid set index");
+            const GLES3GPUDescriptorSet *gpuDescriptorSet = gpuDescriptorSets[glBuffer.set];
+            const uint descriptorIndex = gpuDescriptorSet->descriptorIndices->at(glBuffer.binding);
+            const GLES3GPUDescriptor &gpuDescriptor = gpuDescriptorSet->gpuDescriptors[descriptorIndex];
+
+            if (!gpuDescriptor.gpuBuffer) {
+                CC_LOG_ERROR("Storage buffer binding '%s' at set %d binding %d is not bounded",
+                             glBuffer.name.c_str(), glBuffer.set, glBuffer.binding);
+                continue;
+            }
+
+            uint offset = gpuDescriptor.gpuBuffer->glOffset;
+
+            const vector<int> &dynamicOffsetSetIndices = dynamicOffsetIndices[glBuffer.set];
+            int dynamicOffsetIndex = glBuffer.binding < dynamicOffsetSetIndices.size() ? dynamicOffsetSetIndices[glBuffer.binding] : -1;
+            if (dynamicOffsetIndex >= 0) offset += dynamicOffsets[dynamicOffsetIndex];
+
+            // not cached, storage bindings are only touched by compute passes
+            GL_CHECK(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, glBuffer.glBinding, gpuDescriptor.gpuBuffer->glBuffer,
+                                       offset, gpuDescriptor.gpuBuffer->size));
+        }
+
+        size_t imageLen = gpuPipelineState->gpuShader->glImages.size();
+        for (size_t j = 0; j < imageLen; j++) {
+            const GLES3GPUUniformStorageImage &glImage = gpuPipelineState->gpuShader->glImages[j];
+
+            CCASSERT(gpuDescriptorSets.size() > glImage.set, "Invalid set index");
+            const GLES3GPUDescriptorSet *gpuDescriptorSet = gpuDescriptorSets[glImage.set];
+            const uint descriptorIndex = gpuDescriptorSet->descriptorIndices->at(glImage.binding);
+            const GLES3GPUDescriptor *gpuDescriptor = &gpuDescriptorSet->gpuDescriptors[descriptorIndex];
+
+            for (size_t u = 0; u < glImage.units.size(); u++, gpuDescriptor++) {
+                if (!gpuDescriptor->gpuTexture) {
+                    CC_LOG_ERROR("Image binding '%s' at set %d binding %d index %d is not bounded",
+                                 glImage.name.c_str(), glImage.set, glImage.binding, u);
+                    continue;
+                }
+
+                const GLES3GPUTexture *gpuTexture = gpuDescriptor->gpuTexture;
+                GLboolean layered = gpuTexture->type != TextureType::TEX2D;
+                GL_CHECK(glBindImageTexture((GLuint)glImage.units[u], gpuTexture->glTexture, 0, layered, 0, GL_READ_WRITE, gpuTexture->glInternelFmt));
+            }
+        }
     } // if
 
     // bind vao
     if (gpuInputAssembler && gpuPipelineState && gpuPipelineState->gpuShader &&
+        gpuPipelineState->bindPoint == PipelineBindPoint::GRAPHICS &&
         (isShaderChanged || gpuInputAssembler != gfxStateCache.gpuInputAssembler)) {
         gfxStateCache.gpuInputAssembler = gpuInputAssembler;
         if (USE_VAO) {
@@ -2048,6 +2434,10 @@ void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
 
     if (gpuPipelineState && !gpuPipelineState->dynamicStates.empty()) {
         for (DynamicStateFlagBit dynamicState : gpuPipelineState->dynamicStates) {
+            // everything but viewport and scissor overrides fields of the state block
+            if (dynamicState != DynamicStateFlagBit::VIEWPORT && dynamicState != DynamicStateFlagBit::SCISSOR) {
+                cache->isStateBlockValid = false;
+            }
             switch (dynamicState) {
                 case DynamicStateFlagBit::VIEWPORT:
                     if (cache->viewport != viewport) {
@@ -2179,11 +2569,16 @@ void GLES3CmdFuncDraw(GLES3Device *device, DrawInfo &drawInfo) {
     GLenum glPrimitive = gfxStateCache.glPrimitive;
 
     if (gpuInputAssembler && gpuPipelineState) {
+        if (gpuInputAssembler->isStreamed && gpuPipelineState->gpuShader) {
+            UpdateStreamedInputAssembler(device, gpuPipelineState->gpuShader, gpuInputAssembler);
+        }
+
         if (!gpuInputAssembler->gpuIndirectBuffer) {
             if (gpuInputAssembler->gpuIndexBuffer) {
                 if (drawInfo.indexCount > 0) {
                     uint8_t *offset = 0;
                     offset += drawInfo.firstIndex * gpuInputAssembler->gpuIndexBuffer->stride;
+                    if (gpuInputAssembler->gpuIndexBuffer->isStreamed) offset += gpuInputAssembler->gpuIndexBuffer->glOffset;
                     if (drawInfo.instanceCount == 0) {
                         GL_CHECK(glDrawElements(glPrimitive, drawInfo.indexCount, gpuInputAssembler->glIndexType, offset));
                     } else {
@@ -2197,6 +2592,17 @@ void GLES3CmdFuncDraw(GLES3Device *device, DrawInfo &drawInfo) {
                     GL_CHECK(glDrawArraysInstanced(glPrimitive, drawInfo.firstIndex, drawInfo.vertexCount, drawInfo.instanceCount));
                 }
             }
+        } else if (gpuInputAssembler->gpuIndirectBuffer->glBuffer) {
+            const GLES3GPUBuffer *gpuIndirectBuffer = gpuInputAssembler->gpuIndirectBuffer;
+            GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuIndirectBuffer->glBuffer));
+            for (uint j = 0; j < gpuIndirectBuffer->count; ++j) {
+                if (gpuIndirectBuffer->isDrawIndirectByIndex) {
+                    GL_CHECK(glDrawElementsIndirect(glPrimitive, gpuInputAssembler->glIndexType, BUFFER_OFFSET(j * GLES3_DRAW_ELEMENTS_INDIRECT_SIZE)));
+                } else {
+                    GL_CHECK(glDrawArraysIndirect(glPrimitive, BUFFER_OFFSET(j * GLES3_DRAW_ARRAYS_INDIRECT_SIZE)));
+                }
+            }
+            GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
         } else {
             for (size_t j = 0; j < gpuInputAssembler->gpuIndirectBuffer->indirects.size(); ++j) {
                 const DrawInfo &draw = gpuInputAssembler->gpuIndirectBuffer->indirects[j];
@@ -2204,6 +2610,7 @@ void GLES3CmdFuncDraw(GLES3Device *device, DrawInfo &drawInfo) {
                     if (draw.indexCount > 0) {
                         uint8_t *offset = 0;
                         offset += draw.firstIndex * gpuInputAssembler->gpuIndexBuffer->stride;
+                        if (gpuInputAssembler->gpuIndexBuffer->isStreamed) offset += gpuInputAssembler->gpuIndexBuffer->glOffset;
                         if (draw.instanceCount == 0) {
                             GL_CHECK(glDrawElements(glPrimitive, draw.indexCount, gpuInputAssembler->glIndexType, offset));
                         } else {
@@ -2224,10 +2631,48 @@ void GLES3CmdFuncDraw(GLES3Device *device, DrawInfo &drawInfo) {
 
 void GLES3CmdFuncUpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint offset, uint size) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
-    if (gpuBuffer->usage & BufferUsageBit::INDIRECT) {
+    if ((gpuBuffer->usage & BufferUsageBit::INDIRECT) && gpuBuffer->glBuffer) {
+        // translate into the command structs glDraw*Indirect reads
+        const DrawInfo *drawInfo = static_cast<const DrawInfo *>(buffer);
+        const uint drawInfoCount = size / sizeof(DrawInfo);
+        gpuBuffer->isDrawIndirectByIndex = drawInfoCount > 0 && drawInfo->indexCount > 0;
+
+        vector<GLuint> commands;
+        commands.reserve(drawInfoCount * 5);
+        for (uint i = 0; i < drawInfoCount; ++i, ++drawInfo) {
+            if (gpuBuffer->isDrawIndirectByIndex) {
+                commands.push_back(drawInfo->indexCount);
+                commands.push_back(drawInfo->instanceCount);
+                commands.push_back(drawInfo->firstIndex);
+                commands.push_back((GLuint)drawInfo->vertexOffset);
+                commands.push_back(0u); // reservedMustBeZero
+            } else {
+                commands.push_back(drawInfo->vertexCount);
+                commands.push_back(drawInfo->instanceCount);
+                commands.push_back(drawInfo->firstVertex);
+                commands.push_back(0u); // reservedMustBeZero
+            }
+        }
+        const uint commandSize = gpuBuffer->isDrawIndirectByIndex ? GLES3_DRAW_ELEMENTS_INDIRECT_SIZE : GLES3_DRAW_ARRAYS_INDIRECT_SIZE;
+        GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+        GL_CHECK(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, offset / sizeof(DrawInfo) * commandSize, commands.size() * sizeof(GLuint), commands.data()));
+        GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+    } else if (gpuBuffer->usage & BufferUsageBit::INDIRECT) {
         memcpy((uint8_t *)gpuBuffer->indirects.data() + offset, buffer, size);
     } else if (gpuBuffer->usage & BufferUsageBit::TRANSFER_SRC) {
         memcpy((uint8_t *)gpuBuffer->buffer + offset, buffer, size);
+    } else if (gpuBuffer->isStreamed) {
+        // never touch storage the GPU may still read, write a fresh range of the ring instead
+        GLES3GPUStreamBuffer *gpuStreamBuffer = device->streamBuffer();
+        memcpy(gpuBuffer->buffer + offset, buffer, size);
+        gpuBuffer->streamSize = std::max(gpuBuffer->streamSize, offset + size);
+
+        // uniform ranges are bound with the full size, vertex and index data only needs what was written
+        uint rangeSize = gpuBuffer->glTarget == GL_UNIFORM_BUFFER ? gpuBuffer->size : gpuBuffer->streamSize;
+        uint rangeOffset = AllocStreamBuffer(device, gpuStreamBuffer, rangeSize);
+        WriteStreamBuffer(gpuStreamBuffer, rangeOffset, gpuBuffer->buffer, rangeSize);
+        gpuStreamBuffer->pendingAllocations.push_back({gpuBuffer, rangeOffset});
+        MoveStreamedBuffer(device, gpuBuffer, gpuStreamBuffer->glBuffer, rangeOffset);
     } else {
         switch (gpuBuffer->glTarget) {
             case GL_ARRAY_BUFFER: {
@@ -2264,6 +2709,12 @@ void GLES3CmdFuncUpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
                 GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, buffer));
                 break;
             }
+            case GL_SHADER_STORAGE_BUFFER: {
+                GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpuBuffer->glBuffer));
+                GL_CHECK(glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, buffer));
+                GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+                break;
+            }
             default:
                 CCASSERT(false, "Unsupported BufferType, update buffer failed.");
                 break;
@@ -2271,6 +2722,36 @@ void GLES3CmdFuncUpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
     }
 }
 
+void GLES3CmdFuncCreateStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    GL_CHECK(glGenBuffers(1, &gpuStreamBuffer->glBuffer));
+    GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, gpuStreamBuffer->glBuffer));
+    GL_CHECK(glBufferData(GL_COPY_WRITE_BUFFER, GLES3GPUStreamBuffer::CAPACITY, nullptr, GL_STREAM_DRAW));
+}
+
+void GLES3CmdFuncDestroyStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    for (GLES3GPUStreamBuffer::FencedRange &range : gpuStreamBuffer->fencedRanges) {
+        GL_CHECK(glDeleteSync(range.glFence));
+    }
+    gpuStreamBuffer->fencedRanges.clear();
+    gpuStreamBuffer->pendingAllocations.clear();
+    if (gpuStreamBuffer->glBuffer) {
+        GL_CHECK(glDeleteBuffers(1, &gpuStreamBuffer->glBuffer));
+        gpuStreamBuffer->glBuffer = 0;
+    }
+}
+
+void GLES3CmdFuncFenceStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer) {
+    FenceStreamBuffer(device, gpuStreamBuffer);
+
+    // ranges are otherwise only recycled once the ring runs full
+    while (gpuStreamBuffer->fencedRanges.size() > GLES3GPUStreamBuffer::MAX_FENCED_RANGES) {
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        GL_CHECK(status = glClientWaitSync(GetReleaseFence(gpuStreamBuffer), 0, 0));
+        if (status == GL_TIMEOUT_EXPIRED) break;
+        ReleaseFencedRange(device, gpuStreamBuffer);
+    }
+}
+
 void GLES3CmdFuncCopyBuffersToTexture(GLES3Device *device, const uint8_t *const *buffers, GLES3GPUTexture *gpuTexture, const BufferTextureCopy *regions, uint count) {
     GLuint &glTexture = device->stateCache()->glTextures[device->stateCache()->texUint];
     if (glTexture != gpuTexture->glTexture) {
@@ -2433,11 +2914,113 @@ void GLES3CmdFuncCopyBuffersToTexture(GLES3Device *device, const uint8_t *const
     }
 }
 
+void GLES3CmdFuncDispatch(GLES3Device *device, const GLES3GPUDispatchInfo &info) {
+    if (info.indirectBuffer) {
+        GL_CHECK(glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, info.indirectBuffer->glBuffer));
+        GL_CHECK(glDispatchComputeIndirect(info.indirectOffset));
+        GL_CHECK(glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0));
+    } else {
+        GL_CHECK(glDispatchCompute(info.groupCountX, info.groupCountY, info.groupCountZ));
+    }
+}
+
+void GLES3CmdFuncMemoryBarrier(GLES3Device *device, GLbitfield barriers) {
+    if (barriers) {
+        GL_CHECK(glMemoryBarrier(barriers));
+    }
+}
+
+void GLES3CmdFuncBeginMarker(GLES3Device *device, const String &label) {
+    if (device->useDebugMarker()) {
+        // zero length means a null terminated label
+        GL_CHECK(glPushGroupMarkerEXT(0, label.c_str()));
+    }
+}
+
+void GLES3CmdFuncEndMarker(GLES3Device *device) {
+    if (device->useDebugMarker()) {
+        GL_CHECK(glPopGroupMarkerEXT());
+    }
+}
+
+void GLES3CmdFuncWriteTimestamp(GLES3Device *device, uint slot) {
+    GLES3GPUTimestampPool *pool = device->timestampPool();
+    if (!pool || slot >= Device::MAX_TIMESTAMPS) return;
+
+    GL_CHECK(glQueryCounterEXT(pool->glQueries[pool->current][slot], GL_TIMESTAMP_EXT));
+    pool->written[pool->current][slot] = true;
+}
+
+GLbitfield MapGLBarrierBits(const GlobalBarrier &barrier) {
+    // everything except incoherent shader writes is synchronized by the driver
+    bool hasShaderWrites = false;
+    for (AccessType type : barrier.prevAccesses) {
+        if (type == AccessType::VERTEX_SHADER_WRITE ||
+            type == AccessType::FRAGMENT_SHADER_WRITE ||
+            type == AccessType::COMPUTE_SHADER_WRITE) {
+            hasShaderWrites = true;
+        }
+    }
+    if (!hasShaderWrites) return 0u;
+
+    GLbitfield barriers = 0u;
+    for (AccessType type : barrier.nextAccesses) {
+        switch (type) {
+            case AccessType::INDIRECT_BUFFER:
+                barriers |= GL_COMMAND_BARRIER_BIT;
+                break;
+            case AccessType::INDEX_BUFFER:
+                barriers |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+                break;
+            case AccessType::VERTEX_BUFFER:
+                barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+                break;
+            case AccessType::VERTEX_SHADER_READ_UNIFORM_BUFFER:
+            case AccessType::FRAGMENT_SHADER_READ_UNIFORM_BUFFER:
+            case AccessType::COMPUTE_SHADER_READ_UNIFORM_BUFFER:
+                barriers |= GL_UNIFORM_BARRIER_BIT;
+                break;
+            case AccessType::VERTEX_SHADER_READ_TEXTURE:
+            case AccessType::FRAGMENT_SHADER_READ_TEXTURE:
+            case AccessType::COMPUTE_SHADER_READ_TEXTURE:
+                barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+                break;
+            case AccessType::VERTEX_SHADER_READ_OTHER:
+            case AccessType::FRAGMENT_SHADER_READ_OTHER:
+            case AccessType::COMPUTE_SHADER_READ_OTHER:
+            case AccessType::VERTEX_SHADER_WRITE:
+            case AccessType::FRAGMENT_SHADER_WRITE:
+            case AccessType::COMPUTE_SHADER_WRITE:
+                barriers |= GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+                break;
+            case AccessType::COLOR_ATTACHMENT_READ:
+            case AccessType::COLOR_ATTACHMENT_WRITE:
+            case AccessType::DEPTH_STENCIL_ATTACHMENT_READ:
+            case AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE:
+                barriers |= GL_FRAMEBUFFER_BARRIER_BIT;
+                break;
+            case AccessType::TRANSFER_READ:
+            case AccessType::TRANSFER_WRITE:
+                barriers |= GL_BUFFER_UPDATE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT;
+                break;
+            case AccessType::HOST_READ:
+            case AccessType::HOST_WRITE:
+                barriers |= GL_BUFFER_UPDATE_BARRIER_BIT;
+                break;
+            default:
+                break;
+        }
+    }
+    return barriers;
+}
+
 void GLES3CmdFuncExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage) {
     if (!cmdPackage->cmds.size()) return;
 
     static uint cmdIndices[(int)GFXCmdType::COUNT] = {0};
     memset(cmdIndices, 0, sizeof(cmdIndices));
+    // consecutive binds that only swap the input assembler keep their descriptors
+    GLES3CmdBindStates *lastBindStates = nullptr;
 
     for (uint i = 0; i < cmdPackage->cmds.size(); ++i) {
         GFXCmdType cmdType = cmdPackage->cmds[i];
@@ -2455,7 +3038,12 @@ void GLES3CmdFuncExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage) {
             }
             case GFXCmdType::BIND_STATES: {
                 GLES3CmdBindStates *cmd = cmdPackage->bindStatesCmds[cmdIdx];
-                GLES3CmdFuncBindState(device, cmd->gpuPipelineState, cmd->gpuInputAssembler, cmd->gpuDescriptorSets, cmd->dynamicOffsets, cmd->viewport, cmd->scissor, cmd->lineWidth, cmd->depthBiasEnabled, cmd->depthBias, cmd->blendConstants, cmd->depthBounds, cmd->stencilWriteMask, cmd->stencilCompareMask);
+                bool isBindingUnchanged = lastBindStates &&
+                                          lastBindStates->gpuPipelineState == cmd->gpuPipelineState &&
+                                          lastBindStates->gpuDescriptorSets == cmd->gpuDescriptorSets &&
+                                          lastBindStates->dynamicOffsets == cmd->dynamicOffsets;
+                GLES3CmdFuncBindState(device, cmd->gpuPipelineState, cmd->gpuInputAssembler, cmd->gpuDescriptorSets, cmd->dynamicOffsets, cmd->viewport, cmd->scissor, cmd->lineWidth, cmd->depthBiasEnabled, cmd->depthBias, cmd->blendConstants, cmd->depthBounds, cmd->stencilWriteMask, cmd->stencilCompareMask, isBindingUnchanged);
+                lastBindStates = cmd;
                 break;
             } // case BIND_STATES
             case GFXCmdType::DRAW: {
@@ -2473,9 +3061,31 @@ void GLES3CmdFuncExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage) {
                 GLES3CmdFuncCopyBuffersToTexture(device, cmd->buffers, cmd->gpuTexture, cmd->regions, cmd->count);
                 break;
             }
+            case GFXCmdType::DISPATCH: {
+                GLES3CmdDispatch *cmd = cmdPackage->dispatchCmds[cmdIdx];
+                GLES3CmdFuncDispatch(device, cmd->dispatchInfo);
+                break;
+            }
+            case GFXCmdType::BARRIER: {
+                GLES3CmdBarrier *cmd = cmdPackage->barrierCmds[cmdIdx];
+                GLES3CmdFuncMemoryBarrier(device, cmd->barriers);
+                break;
+            }
+            case GFXCmdType::MARKER: {
+                GLES3CmdMarker *cmd = cmdPackage->markerCmds[cmdIdx];
+                switch (cmd->op) {
+                    case GLES3MarkerOp::PUSH: GLES3CmdFuncBeginMarker(device, cmd->label); break;
+                    case GLES3MarkerOp::POP: GLES3CmdFuncEndMarker(device); break;
+                    case GLES3MarkerOp::TIMESTAMP: GLES3CmdFuncWriteTimestamp(device, cmd->slot); break;
+                }
+                break;
+            }
             default:
                 break;
         }
+        if (cmdType != GFXCmdType::BIND_STATES && cmdType != GFXCmdType::DRAW) {
+            lastBindStates = nullptr;
+        }
         cmdIdx++;
     }
 }
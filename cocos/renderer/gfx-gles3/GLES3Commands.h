@@ -165,6 +165,47 @@ public:
     }
 };
 
+class GLES3CmdDispatch final : public GFXCmd {
+public:
+    GLES3GPUDispatchInfo dispatchInfo;
+
+    GLES3CmdDispatch() : GFXCmd(GFXCmdType::DISPATCH) {}
+
+    virtual void clear() override {
+        dispatchInfo.indirectBuffer = nullptr;
+    }
+};
+
+class GLES3CmdBarrier final : public GFXCmd {
+public:
+    GLbitfield barriers = 0u;
+
+    GLES3CmdBarrier() : GFXCmd(GFXCmdType::BARRIER) {}
+
+    virtual void clear() override {
+        barriers = 0u;
+    }
+};
+
+enum class GLES3MarkerOp : uint8_t {
+    PUSH,
+    POP,
+    TIMESTAMP,
+};
+
+class GLES3CmdMarker final : public GFXCmd {
+public:
+    GLES3MarkerOp op = GLES3MarkerOp::PUSH;
+    String label;
+    uint slot = 0u;
+
+    GLES3CmdMarker() : GFXCmd(GFXCmdType::MARKER) {}
+
+    virtual void clear() override {
+        label.clear();
+    }
+};
+
 class GLES3CmdPackage final : public Object {
 public:
     CachedArray<GFXCmdType> cmds;
@@ -173,6 +214,9 @@ public:
     CachedArray<GLES3CmdDraw *> drawCmds;
     CachedArray<GLES3CmdUpdateBuffer *> updateBufferCmds;
     CachedArray<GLES3CmdCopyBufferToTexture *> copyBufferToTextureCmds;
+    CachedArray<GLES3CmdDispatch *> dispatchCmds;
+    CachedArray<GLES3CmdBarrier *> barrierCmds;
+    CachedArray<GLES3CmdMarker *> markerCmds;
 };
 
 class GLES3GPUCommandAllocator final : public Object {
@@ -182,6 +226,9 @@ public:
     CommandPool<GLES3CmdDraw> drawCmdPool;
     CommandPool<GLES3CmdUpdateBuffer> updateBufferCmdPool;
     CommandPool<GLES3CmdCopyBufferToTexture> copyBufferToTextureCmdPool;
+    CommandPool<GLES3CmdDispatch> dispatchCmdPool;
+    CommandPool<GLES3CmdBarrier> barrierCmdPool;
+    CommandPool<GLES3CmdMarker> markerCmdPool;
 
     void clearCmds(GLES3CmdPackage *cmd_package) {
         if (cmd_package->beginRenderPassCmds.size()) {
@@ -199,6 +246,15 @@ public:
         if (cmd_package->copyBufferToTextureCmds.size()) {
             copyBufferToTextureCmdPool.freeCmds(cmd_package->copyBufferToTextureCmds);
         }
+        if (cmd_package->dispatchCmds.size()) {
+            dispatchCmdPool.freeCmds(cmd_package->dispatchCmds);
+        }
+        if (cmd_package->barrierCmds.size()) {
+            barrierCmdPool.freeCmds(cmd_package->barrierCmds);
+        }
+        if (cmd_package->markerCmds.size()) {
+            markerCmdPool.freeCmds(cmd_package->markerCmds);
+        }
 
         cmd_package->cmds.clear();
     }
@@ -209,6 +265,9 @@ public:
         drawCmdPool.release();
         updateBufferCmdPool.release();
         copyBufferToTextureCmdPool.release();
+        dispatchCmdPool.release();
+        barrierCmdPool.release();
+        markerCmdPool.release();
     }
 };
 
@@ -233,13 +292,23 @@ CC_GLES3_API void GLES3CmdFuncEndRenderPass(GLES3Device *device);
 CC_GLES3_API void GLES3CmdFuncBindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipelineState, GLES3GPUInputAssembler *gpuInputAssembler,
                                         vector<GLES3GPUDescriptorSet *> &gpuDescriptorSets, vector<uint> &dynamicOffsets,
                                         Viewport &viewport, Rect &scissor, float lineWidth, bool depthBiasEnabled, GLES3DepthBias &depthBias, Color &blendConstants,
-                                        GLES3DepthBounds &depthBounds, GLES3StencilWriteMask &stencilWriteMask, GLES3StencilCompareMask &stencilCompareMask);
+                                        GLES3DepthBounds &depthBounds, GLES3StencilWriteMask &stencilWriteMask, GLES3StencilCompareMask &stencilCompareMask, bool isBindingUnchanged = false);
 CC_GLES3_API void GLES3CmdFuncDraw(GLES3Device *device, DrawInfo &drawInfo);
 CC_GLES3_API void GLES3CmdFuncUpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint offset, uint size);
+CC_GLES3_API void GLES3CmdFuncCreateStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer);
+CC_GLES3_API void GLES3CmdFuncDestroyStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer);
+CC_GLES3_API void GLES3CmdFuncFenceStreamBuffer(GLES3Device *device, GLES3GPUStreamBuffer *gpuStreamBuffer);
 CC_GLES3_API void GLES3CmdFuncCopyBuffersToTexture(GLES3Device *device, const uint8_t *const *buffers,
                                                    GLES3GPUTexture *gpuTexture, const BufferTextureCopy *regions, uint count);
+CC_GLES3_API void GLES3CmdFuncDispatch(GLES3Device *device, const GLES3GPUDispatchInfo &info);
+CC_GLES3_API void GLES3CmdFuncMemoryBarrier(GLES3Device *device, GLbitfield barriers);
+CC_GLES3_API void GLES3CmdFuncBeginMarker(GLES3Device *device, const String &label);
+CC_GLES3_API void GLES3CmdFuncEndMarker(GLES3Device *device);
+CC_GLES3_API void GLES3CmdFuncWriteTimestamp(GLES3Device *device, uint slot);
 CC_GLES3_API void GLES3CmdFuncExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage);
 
+CC_GLES3_API GLbitfield MapGLBarrierBits(const GlobalBarrier &barrier);
+
 } // namespace gfx
 } // namespace cc
 
@@ -32,6 +32,10 @@ THE SOFTWARE.
     #include "cocos/bindings/event/EventDispatcher.h"
 #endif
 
+#if (CC_PLATFORM == CC_PLATFORM_LINUX)
+    #include <cstring>
+#endif
+
 #define FORCE_DISABLE_VALIDATION  1
 
 namespace cc {
@@ -90,7 +94,29 @@ GLES3Context::GLES3Context(Device *device)
 GLES3Context::~GLES3Context() {
 }
 
-#if (CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_MAC_OSX)
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_MAC_OSX || CC_PLATFORM == CC_PLATFORM_LINUX)
+
+    #if (CC_PLATFORM == CC_PLATFORM_LINUX)
+        #ifndef EGL_PLATFORM_SURFACELESS_MESA
+            #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+        #endif
+
+namespace {
+// Linux runs headless: prefer Mesa's surfaceless platform, which needs neither
+// an X nor a Wayland server, and fall back to whatever the default display is.
+EGLDisplay getHeadlessDisplay() {
+    const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) return display;
+        }
+    }
+    return eglGetDisplay((EGLNativeDisplayType)EGL_DEFAULT_DISPLAY);
+}
+} // namespace
+    #endif
 
 bool GLES3Context::initialize(const ContextInfo &info) {
 
@@ -113,6 +139,8 @@ bool GLES3Context::initialize(const ContextInfo &info) {
         if (_eglDisplay == EGL_NO_DISPLAY) {
             EGL_CHECK(_eglDisplay = eglGetDisplay((EGLNativeDisplayType)EGL_DEFAULT_DISPLAY));
         }
+    #elif (CC_PLATFORM == CC_PLATFORM_LINUX)
+        _eglDisplay = getHeadlessDisplay();
     #else
         EGL_CHECK(_eglDisplay = eglGetDisplay((EGLNativeDisplayType)EGL_DEFAULT_DISPLAY));
     #endif
@@ -138,7 +166,11 @@ bool GLES3Context::initialize(const ContextInfo &info) {
         _depthStencilFmt = Format::D24S8;
 
         const EGLint attribs[] = {
+    #if (CC_PLATFORM == CC_PLATFORM_LINUX)
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    #else
             EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+    #endif
             EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
             // EGL_BUFFER_SIZE, colorBuffSize,
             EGL_BLUE_SIZE, 8,
@@ -206,7 +238,16 @@ bool GLES3Context::initialize(const ContextInfo &info) {
         ANativeWindow_setBuffersGeometry((ANativeWindow *)_windowHandle, width, height, nFmt);
     #endif
 
+    #if (CC_PLATFORM == CC_PLATFORM_LINUX)
+        // offscreen only, the default framebuffer is a pbuffer of the device size
+        const EGLint pbufferAttribs[] = {
+            EGL_WIDTH, static_cast<EGLint>(std::max(_device->getWidth(), 1U)),
+            EGL_HEIGHT, static_cast<EGLint>(std::max(_device->getHeight(), 1U)),
+            EGL_NONE};
+        EGL_CHECK(_eglSurface = eglCreatePbufferSurface(_eglDisplay, _eglConfig, pbufferAttribs));
+    #else
         EGL_CHECK(_eglSurface = eglCreateWindowSurface(_eglDisplay, _eglConfig, (EGLNativeWindowType)_windowHandle, NULL));
+    #endif
         if (_eglSurface == EGL_NO_SURFACE) {
             auto err = eglGetError();
             CC_LOG_ERROR("Window surface created failed. code %d", err);
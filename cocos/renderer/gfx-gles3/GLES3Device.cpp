@@ -135,6 +135,22 @@ bool GLES3Device::initialize(const DeviceInfo &info) {
     _features[static_cast<uint>(Feature::FORMAT_D24S8)] = true;
     _features[static_cast<uint>(Feature::FORMAT_D32FS8)] = true;
 
+    // compute needs an ES 3.1 context, the entry points are null otherwise
+    GLint glMajorVersion = 0, glMinorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &glMajorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &glMinorVersion);
+    if ((glMajorVersion > 3 || glMinorVersion >= 1) && glDispatchCompute && glBindImageTexture && glMemoryBarrier) {
+        _features[static_cast<uint>(Feature::COMPUTE_SHADER)] = true;
+    }
+
+    _useDebugMarker = checkExtension("debug_marker") && glPushGroupMarkerEXT && glPopGroupMarkerEXT;
+    if (checkExtension("disjoint_timer_query") && glQueryCounterEXT && glGetQueryObjectui64vEXT) {
+        _gpuTimestampPool = CC_NEW(GLES3GPUTimestampPool);
+        glGenQueries(GLES3GPUTimestampPool::FRAME_COUNT * MAX_TIMESTAMPS, _gpuTimestampPool->glQueries[0]);
+        _gpuTimestampPool->frameIndices[0] = _frameIndex;
+        _features[static_cast<uint>(Feature::TIMESTAMP_QUERY)] = true;
+    }
+
     _renderer = (const char *)glGetString(GL_RENDERER);
     _vendor = (const char *)glGetString(GL_VENDOR);
     _version = (const char *)glGetString(GL_VERSION);
@@ -171,6 +187,10 @@ bool GLES3Device::initialize(const DeviceInfo &info) {
 
     _gpuStateCache->initialize(_maxTextureUnits, _maxUniformBufferBindings, _maxVertexAttributes);
 
+    _gpuStreamBuffer = CC_NEW(GLES3GPUStreamBuffer);
+    _gpuStreamBuffer->alignment = std::max(_uboOffsetAlignment, 4u);
+    GLES3CmdFuncCreateStreamBuffer(this, _gpuStreamBuffer);
+
     return true;
 }
 
@@ -178,6 +198,16 @@ void GLES3Device::destroy() {
     CC_SAFE_DESTROY(_queue);
     CC_SAFE_DESTROY(_cmdBuff);
     CC_SAFE_DELETE(_gpuStagingBufferPool);
+    if (_gpuStreamBuffer) {
+        GLES3CmdFuncDestroyStreamBuffer(this, _gpuStreamBuffer);
+        CC_DELETE(_gpuStreamBuffer);
+        _gpuStreamBuffer = nullptr;
+    }
+    if (_gpuTimestampPool) {
+        glDeleteQueries(GLES3GPUTimestampPool::FRAME_COUNT * MAX_TIMESTAMPS, _gpuTimestampPool->glQueries[0]);
+        CC_DELETE(_gpuTimestampPool);
+        _gpuTimestampPool = nullptr;
+    }
     CC_SAFE_DELETE(_gpuStateCache);
     CC_SAFE_DESTROY(_deviceContext);
     CC_SAFE_DESTROY(_renderContext);
@@ -197,13 +227,68 @@ void GLES3Device::present() {
     _numDrawCalls = queue->_numDrawCalls;
     _numInstances = queue->_numInstances;
     _numTriangles = queue->_numTriangles;
+    _numGLCalls = gles3CallCount;
 
+    // everything streamed this frame is released once the GPU passes this point
+    GLES3CmdFuncFenceStreamBuffer(this, _gpuStreamBuffer);
     _context->present();
 
     // Clear queue stats
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
     queue->_numTriangles = 0;
+    gles3CallCount = 0u;
+
+    ++_frameIndex;
+    if (_gpuTimestampPool) {
+        readbackTimestamps();
+
+        // the oldest frame is recycled, its results are dropped if they never showed up
+        GLES3GPUTimestampPool *pool = _gpuTimestampPool;
+        pool->current = (pool->current + 1) % GLES3GPUTimestampPool::FRAME_COUNT;
+        pool->frameIndices[pool->current] = _frameIndex;
+        memset(pool->written[pool->current], 0, sizeof(pool->written[pool->current]));
+    }
+}
+
+void GLES3Device::readbackTimestamps() {
+    GLES3GPUTimestampPool *pool = _gpuTimestampPool;
+
+    // results spanning a disjoint event (power management, context loss) are meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    uint64_t nanoseconds[MAX_TIMESTAMPS];
+    for (uint i = 1u; i <= GLES3GPUTimestampPool::FRAME_COUNT; ++i) {
+        uint frame = (pool->current + i) % GLES3GPUTimestampPool::FRAME_COUNT; // oldest first
+        if (!pool->frameIndices[frame]) continue;
+        if (disjoint) {
+            pool->frameIndices[frame] = 0u;
+            continue;
+        }
+
+        bool available = true;
+        for (uint slot = 0u; slot < MAX_TIMESTAMPS && available; ++slot) {
+            if (!pool->written[frame][slot]) continue;
+            GLuint ready = GL_FALSE;
+            glGetQueryObjectuiv(pool->glQueries[frame][slot], GL_QUERY_RESULT_AVAILABLE, &ready);
+            available = ready == GL_TRUE;
+        }
+        // frames complete in order, newer ones can not be ready either
+        if (!available) break;
+
+        uint count = 0u;
+        for (uint slot = 0u; slot < MAX_TIMESTAMPS; ++slot) {
+            nanoseconds[slot] = 0u;
+            if (!pool->written[frame][slot]) continue;
+            GLuint64 result = 0u;
+            glGetQueryObjectui64vEXT(pool->glQueries[frame][slot], GL_QUERY_RESULT, &result);
+            nanoseconds[slot] = result;
+            count = slot + 1;
+        }
+        resolveTimestamps(pool->frameIndices[frame], nanoseconds, count);
+        pool->frameIndices[frame] = 0u;
+    }
 }
 
 void GLES3Device::bindRenderContext(bool bound) {
@@ -30,6 +30,8 @@ namespace gfx {
 class GLES3Context;
 class GLES3GPUStateCache;
 class GLES3GPUStagingBufferPool;
+class GLES3GPUStreamBuffer;
+class GLES3GPUTimestampPool;
 
 class CC_GLES3_API GLES3Device final : public Device {
 public:
@@ -57,9 +59,13 @@ public:
     virtual void resize(uint width, uint height) override;
     virtual void acquire() override;
     virtual void present() override;
+    virtual uint getNumGLCalls() const override { return _numGLCalls; }
 
     CC_INLINE GLES3GPUStateCache *stateCache() const { return _gpuStateCache; }
     CC_INLINE GLES3GPUStagingBufferPool *stagingBufferPool() const { return _gpuStagingBufferPool; }
+    CC_INLINE GLES3GPUTimestampPool *timestampPool() const { return _gpuTimestampPool; }
+    CC_INLINE GLES3GPUStreamBuffer *streamBuffer() const { return _gpuStreamBuffer; }
+    CC_INLINE bool useDebugMarker() const { return _useDebugMarker; }
 
     CC_INLINE bool checkExtension(const String &extension) const {
         for (size_t i = 0; i < _extensions.size(); ++i) {
@@ -93,14 +99,20 @@ protected:
     virtual void bindDeviceContext(bool bound) override;
 
 private:
+    void readbackTimestamps();
+
     GLES3Context *_renderContext = nullptr;
     GLES3Context *_deviceContext = nullptr;
     GLES3GPUStateCache *_gpuStateCache = nullptr;
     GLES3GPUStagingBufferPool *_gpuStagingBufferPool = nullptr;
+    GLES3GPUTimestampPool *_gpuTimestampPool = nullptr;
+    GLES3GPUStreamBuffer *_gpuStreamBuffer = nullptr;
 
     StringArray _extensions;
 
     uint _threadID = 0u;
+    uint _numGLCalls = 0u;
+    bool _useDebugMarker = false;
 };
 
 } // namespace gfx
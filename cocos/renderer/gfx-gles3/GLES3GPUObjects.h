@@ -41,6 +41,16 @@ public:
     GLuint glOffset = 0;
     uint8_t *buffer = nullptr;
     DrawInfoList indirects;
+    // indirect buffers written by compute live on the GPU in GL's command layout
+    bool isDrawIndirectByIndex = false;
+    // small host-visible buffers are updated through the device stream buffer,
+    // glBuffer and glOffset point into it until the range gets recycled and the
+    // shadow copy in buffer is moved back into glOwnBuffer
+    bool isStreamed = false;
+    GLuint glOwnBuffer = 0;
+    uint streamSize = 0;
+    // views of a streamed buffer follow it, glOffset is relative to the source
+    GLES3GPUBuffer *gpuStreamSource = nullptr;
 };
 typedef vector<GLES3GPUBuffer *> GLES3GPUBufferList;
 
@@ -140,6 +150,24 @@ struct GLES3GPUUniformSampler final {
 };
 typedef vector<GLES3GPUUniformSampler> GLES3GPUUniformSamplerList;
 
+struct GLES3GPUUniformStorageBuffer final {
+    uint set = 0;
+    uint binding = 0;
+    String name;
+    GLuint glBinding = 0;
+};
+typedef vector<GLES3GPUUniformStorageBuffer> GLES3GPUUniformStorageBufferList;
+
+struct GLES3GPUUniformStorageImage final {
+    uint set = 0;
+    uint binding = 0;
+    String name;
+    uint count = 0u;
+
+    vector<int> units;
+};
+typedef vector<GLES3GPUUniformStorageImage> GLES3GPUUniformStorageImageList;
+
 struct GLES3GPUShaderStage final {
     GLES3GPUShaderStage(ShaderStageFlagBit t, String s, GLuint shader = 0)
     : type(t), source(s), glShader(shader) {}
@@ -154,16 +182,30 @@ public:
     String name;
     UniformBlockList blocks;
     UniformSamplerList samplers;
+    UniformStorageBufferList buffers;
+    UniformStorageImageList images;
     GLuint glProgram = 0;
     GLES3GPUShaderStageList gpuStages;
     GLES3GPUInputList glInputs;
     GLES3GPUUniformBlockList glBlocks;
     GLES3GPUUniformSamplerList glSamplers;
+    GLES3GPUUniformStorageBufferList glBuffers;
+    GLES3GPUUniformStorageImageList glImages;
+};
+
+struct GLES3GPUDispatchInfo final {
+    uint groupCountX = 0;
+    uint groupCountY = 0;
+    uint groupCountZ = 0;
+
+    GLES3GPUBuffer *indirectBuffer = nullptr;
+    uint indirectOffset = 0;
 };
 
 struct GLES3GPUAttribute final {
     String name;
     GLuint glBuffer = 0;
+    GLES3GPUBuffer *gpuStreamedBuffer = nullptr;
     GLenum glType = 0;
     uint size = 0;
     uint count = 0;
@@ -184,6 +226,9 @@ public:
     GLES3GPUAttributeList glAttribs;
     GLenum glIndexType = 0;
     map<GLuint, GLuint> glVAOs;
+    // stream buffer version each VAO last pointed its streamed buffers at
+    bool isStreamed = false;
+    map<GLuint, uint> glVAOStreamVersions;
 };
 
 class GLES3GPURenderPass final : public Object {
@@ -225,13 +270,65 @@ public:
     uint dynamicOffsetCount;
 };
 
+// The fixed-function part of a pipeline state packed into plain words,
+// so two pipelines can be compared with a single memcmp before walking
+// the individual rasterizer, depth-stencil and blend fields.
+struct GLES3GPUStateBlock final {
+    static constexpr uint WORD_COUNT = 17u;
+
+    uint32_t words[WORD_COUNT] = {};
+
+    void pack(const RasterizerState &rs, const DepthStencilState &dss, const BlendState &bs) {
+        const BlendTarget &target = bs.targets[0];
+        words[0] = (uint32_t)rs.cullMode |
+                   (rs.isFrontFaceCCW ? 1u : 0u) << 2 |
+                   (dss.depthTest ? 1u : 0u) << 3 |
+                   (dss.depthWrite ? 1u : 0u) << 4 |
+                   (uint32_t)dss.depthFunc << 5 |
+                   (dss.stencilTestFront ? 1u : 0u) << 8 |
+                   (dss.stencilTestBack ? 1u : 0u) << 9 |
+                   (bs.isA2C ? 1u : 0u) << 10 |
+                   (target.blend ? 1u : 0u) << 11 |
+                   (uint32_t)target.blendColorMask << 12 |
+                   (uint32_t)target.blendEq << 16 |
+                   (uint32_t)target.blendAlphaEq << 19;
+        words[1] = (uint32_t)target.blendSrc |
+                   (uint32_t)target.blendDst << 5 |
+                   (uint32_t)target.blendSrcAlpha << 10 |
+                   (uint32_t)target.blendDstAlpha << 15;
+        words[2] = (uint32_t)dss.stencilFuncFront |
+                   (uint32_t)dss.stencilFailOpFront << 3 |
+                   (uint32_t)dss.stencilZFailOpFront << 6 |
+                   (uint32_t)dss.stencilPassOpFront << 9;
+        words[3] = (uint32_t)dss.stencilFuncBack |
+                   (uint32_t)dss.stencilFailOpBack << 3 |
+                   (uint32_t)dss.stencilZFailOpBack << 6 |
+                   (uint32_t)dss.stencilPassOpBack << 9;
+        words[4] = dss.stencilReadMaskFront;
+        words[5] = dss.stencilWriteMaskFront;
+        words[6] = dss.stencilRefFront;
+        words[7] = dss.stencilReadMaskBack;
+        words[8] = dss.stencilWriteMaskBack;
+        words[9] = dss.stencilRefBack;
+        memcpy(&words[10], &rs.depthBias, sizeof(float));
+        memcpy(&words[11], &rs.depthBiasSlop, sizeof(float));
+        memcpy(&words[12], &rs.lineWidth, sizeof(float));
+        memcpy(&words[13], &bs.blendColor, 4 * sizeof(float));
+    }
+
+    bool operator==(const GLES3GPUStateBlock &rhs) const { return memcmp(words, rhs.words, sizeof(words)) == 0; }
+    bool operator!=(const GLES3GPUStateBlock &rhs) const { return !(*this == rhs); }
+};
+
 class GLES3GPUPipelineState final : public Object {
 public:
+    PipelineBindPoint bindPoint = PipelineBindPoint::GRAPHICS;
     GLenum glPrimitive = GL_TRIANGLES;
     GLES3GPUShader *gpuShader = nullptr;
     RasterizerState rs;
     DepthStencilState dss;
     BlendState bs;
+    GLES3GPUStateBlock stateBlock;
     DynamicStateList dynamicStates;
     GLES3GPUPipelineLayout *gpuLayout = nullptr;
     GLES3GPURenderPass *gpuRenderPass = nullptr;
@@ -290,6 +387,10 @@ public:
     BlendState bs;
     bool isCullFaceEnabled = true;
     bool isStencilTestEnabled = false;
+    // state block of the last pipeline applied, invalidated by dynamic states
+    GLES3GPUStateBlock stateBlock;
+    bool isStateBlockValid = false;
+    bool stateBlockReverseCW = false;
     map<String, uint> texUnitCacheMap;
     GLES3ObjectCache gfxStateCache;
 
@@ -319,6 +420,7 @@ public:
         glReadFBO = 0;
         isCullFaceEnabled = true;
         isStencilTestEnabled = false;
+        isStateBlockValid = false;
 
         viewport = Viewport();
         scissor = Rect();
@@ -336,6 +438,55 @@ public:
     }
 };
 
+// GL_EXT_disjoint_timer_query names of the frames in flight, the device
+// reads a frame back once all of its queries are available
+class GLES3GPUTimestampPool final : public Object {
+public:
+    static constexpr uint FRAME_COUNT = 3u;
+
+    GLuint glQueries[FRAME_COUNT][Device::MAX_TIMESTAMPS] = {};
+    bool written[FRAME_COUNT][Device::MAX_TIMESTAMPS] = {};
+    uint64_t frameIndices[FRAME_COUNT] = {};
+    uint current = 0u;
+};
+
+// Ring buffer dynamic vertex, index and uniform data is written into with
+// unsynchronized maps. Everything written during a frame is guarded by one
+// fence and the range is only handed out again once the GPU has passed it.
+class GLES3GPUStreamBuffer final : public Object {
+public:
+    static constexpr uint CAPACITY = 8 * 1024 * 1024;
+    static constexpr uint MAX_STREAMED_SIZE = CAPACITY / 16;
+    // older frames are recycled as soon as they are done to bound the sync objects
+    static constexpr uint MAX_FENCED_RANGES = 8u;
+
+    struct Allocation {
+        GLES3GPUBuffer *gpuBuffer = nullptr;
+        uint offset = 0u;
+    };
+
+    struct FencedRange {
+        GLsync glFence = nullptr;
+        uint serial = 0u;
+        // later frames that kept reading from this range push its release back to their fence
+        uint releaseSerial = 0u;
+        uint size = 0u;
+        vector<Allocation> allocations;
+    };
+
+    GLuint glBuffer = 0;
+    uint alignment = 4u;
+    uint head = 0u;
+    // bytes not handed back yet, padding at the end of the ring included
+    uint used = 0u;
+    uint pendingSize = 0u;
+    vector<Allocation> pendingAllocations;
+    vector<FencedRange> fencedRanges;
+    uint serial = 0u;
+    // advanced whenever a streamed vertex or index buffer moves
+    uint version = 1u;
+};
+
 constexpr size_t chunkSize = 16 * 1024 * 1024; // 16M per block by default
 class GLES3GPUStagingBufferPool final : public Object {
 public:
@@ -67,14 +67,18 @@ bool GLES3PipelineState::initialize(const PipelineStateInfo &info) {
     _dynamicStates = info.dynamicStates;
     _renderPass = info.renderPass;
     _pipelineLayout = info.pipelineLayout;
+    _bindPoint = info.bindPoint;
 
     _gpuPipelineState = CC_NEW(GLES3GPUPipelineState);
+    _gpuPipelineState->bindPoint = _bindPoint;
     _gpuPipelineState->glPrimitive = GLES3Primitives[(int)_primitive];
     _gpuPipelineState->gpuShader = ((GLES3Shader *)_shader)->gpuShader();
     _gpuPipelineState->rs = _rasterizerState;
     _gpuPipelineState->dss = _depthStencilState;
     _gpuPipelineState->bs = _blendState;
-    _gpuPipelineState->gpuRenderPass = ((GLES3RenderPass *)_renderPass)->gpuRenderPass();
+    _gpuPipelineState->stateBlock.pack(_rasterizerState, _depthStencilState, _blendState);
+    // compute pipelines are not tied to any render pass
+    _gpuPipelineState->gpuRenderPass = _renderPass ? ((GLES3RenderPass *)_renderPass)->gpuRenderPass() : nullptr;
     _gpuPipelineState->gpuPipelineLayout = ((GLES3PipelineLayout *)_pipelineLayout)->gpuPipelineLayout();
 
     for (uint i = 0; i < 31; i++) {
@@ -128,6 +128,54 @@ void GLES3PrimaryCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffe
     }
 }
 
+void GLES3PrimaryCommandBuffer::dispatch(const DispatchInfo &info) {
+    if ((_type == CommandBufferType::PRIMARY && !_isInRenderPass) ||
+        (_type == CommandBufferType::SECONDARY)) {
+
+        if (_isStateInvalid) {
+            vector<uint> &dynamicOffsetOffsets = _curGPUPipelineState->gpuPipelineLayout->dynamicOffsetOffsets;
+            vector<uint> &dynamicOffsets = _curGPUPipelineState->gpuPipelineLayout->dynamicOffsets;
+            for (size_t i = 0u; i < _curDynamicOffsets.size(); i++) {
+                size_t count = dynamicOffsetOffsets[i + 1] - dynamicOffsetOffsets[i];
+                count = std::min(count, _curDynamicOffsets[i].size());
+                if (count) memcpy(&dynamicOffsets[dynamicOffsetOffsets[i]], _curDynamicOffsets[i].data(), count * sizeof(uint));
+            }
+            GLES3CmdFuncBindState((GLES3Device *)_device, _curGPUPipelineState, _curGPUInputAssember, _curGPUDescriptorSets, dynamicOffsets,
+                                  _curViewport, _curScissor, _curLineWidth, false, _curDepthBias, _curBlendConstants, _curDepthBounds, _curStencilWriteMask, _curStencilCompareMask);
+
+            _isStateInvalid = false;
+        }
+
+        GLES3GPUDispatchInfo gpuDispatchInfo;
+        gpuDispatchInfo.groupCountX = info.groupCountX;
+        gpuDispatchInfo.groupCountY = info.groupCountY;
+        gpuDispatchInfo.groupCountZ = info.groupCountZ;
+        gpuDispatchInfo.indirectBuffer = info.indirectBuffer ? ((GLES3Buffer *)info.indirectBuffer)->gpuBuffer() : nullptr;
+        gpuDispatchInfo.indirectOffset = info.indirectOffset;
+        GLES3CmdFuncDispatch((GLES3Device *)_device, gpuDispatchInfo);
+    } else {
+        CC_LOG_ERROR("Command 'dispatch' must be recorded outside a render pass.");
+    }
+}
+
+void GLES3PrimaryCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+    if (!barrier) return;
+
+    GLES3CmdFuncMemoryBarrier((GLES3Device *)_device, MapGLBarrierBits(*barrier));
+}
+
+void GLES3PrimaryCommandBuffer::beginMarker(const String &name) {
+    GLES3CmdFuncBeginMarker((GLES3Device *)_device, name);
+}
+
+void GLES3PrimaryCommandBuffer::endMarker() {
+    GLES3CmdFuncEndMarker((GLES3Device *)_device);
+}
+
+void GLES3PrimaryCommandBuffer::writeTimestamp(uint slot) {
+    GLES3CmdFuncWriteTimestamp((GLES3Device *)_device, slot);
+}
+
 void GLES3PrimaryCommandBuffer::execute(const CommandBuffer *const *cmdBuffs, uint32_t count) {
     for (uint i = 0; i < count; ++i) {
         GLES3PrimaryCommandBuffer *cmdBuff = (GLES3PrimaryCommandBuffer *)cmdBuffs[i];
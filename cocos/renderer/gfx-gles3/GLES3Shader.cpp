@@ -41,11 +41,15 @@ bool GLES3Shader::initialize(const ShaderInfo &info) {
     _attributes = info.attributes;
     _blocks = info.blocks;
     _samplers = info.samplers;
+    _buffers = info.buffers;
+    _images = info.images;
 
     _gpuShader = CC_NEW(GLES3GPUShader);
     _gpuShader->name = _name;
     _gpuShader->blocks = _blocks;
     _gpuShader->samplers = _samplers;
+    _gpuShader->buffers = _buffers;
+    _gpuShader->images = _images;
     for (const auto &stage : _stages) {
         GLES3GPUShaderStage gpuShaderStage = {stage.stage, stage.source};
         _gpuShader->gpuStages.emplace_back(std::move(gpuShaderStage));
@@ -22,3 +22,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "GLES3Std.h"
+
+namespace cc {
+namespace gfx {
+
+uint gles3CallCount = 0u;
+
+} // namespace gfx
+} // namespace cc
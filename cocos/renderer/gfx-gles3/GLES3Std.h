@@ -39,9 +39,17 @@ THE SOFTWARE.
     #define CC_GLES3_API
 #endif
 
+namespace cc {
+namespace gfx {
+// GL calls issued through GL_CHECK, collected by the device once per frame
+extern CC_GLES3_API uint gles3CallCount;
+} // namespace gfx
+} // namespace cc
+
 #if CC_DEBUG > 0
 #define GL_CHECK(x)                                                  \
     do {                                                             \
+        ++::cc::gfx::gles3CallCount;                                 \
         x; GLenum err = glGetError();                                \
         if (err != GL_NO_ERROR) {                                    \
             CC_LOG_ERROR("%s returned GL error: 0x%x", #x, err);     \
@@ -57,6 +65,10 @@ THE SOFTWARE.
         }                                                            \
     } while (0)
 #else
-#define GL_CHECK(x) x
+#define GL_CHECK(x)                  \
+    do {                             \
+        ++::cc::gfx::gles3CallCount; \
+        x;                           \
+    } while (0)
 #define EGL_CHECK(x) x
 #endif
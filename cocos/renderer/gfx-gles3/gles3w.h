@@ -71,6 +71,48 @@ extern "C" {
 
 #endif /* GL_EXT_texture_sRGB */
 
+#ifndef GL_ES_VERSION_3_1
+    #define GL_COMPUTE_SHADER                   0x91B9
+    #define GL_MAX_COMPUTE_WORK_GROUP_COUNT     0x91BE
+    #define GL_MAX_COMPUTE_WORK_GROUP_SIZE      0x91BF
+    #define GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS 0x90EB
+    #define GL_DISPATCH_INDIRECT_BUFFER         0x90EE
+    #define GL_DRAW_INDIRECT_BUFFER             0x8F3F
+    #define GL_SHADER_STORAGE_BUFFER            0x90D2
+    #define GL_SHADER_STORAGE_BLOCK             0x92E6
+    #define GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS 0x90DD
+    #define GL_MAX_IMAGE_UNITS                  0x8F38
+    #define GL_BUFFER_BINDING                   0x9302
+    #define GL_ACTIVE_RESOURCES                 0x92F5
+    #define GL_READ_ONLY                        0x88B8
+    #define GL_WRITE_ONLY                       0x88B9
+    #define GL_READ_WRITE                       0x88BA
+    #define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT  0x00000001
+    #define GL_ELEMENT_ARRAY_BARRIER_BIT        0x00000002
+    #define GL_UNIFORM_BARRIER_BIT              0x00000004
+    #define GL_TEXTURE_FETCH_BARRIER_BIT        0x00000008
+    #define GL_SHADER_IMAGE_ACCESS_BARRIER_BIT  0x00000020
+    #define GL_COMMAND_BARRIER_BIT              0x00000040
+    #define GL_PIXEL_BUFFER_BARRIER_BIT         0x00000080
+    #define GL_TEXTURE_UPDATE_BARRIER_BIT       0x00000100
+    #define GL_BUFFER_UPDATE_BARRIER_BIT        0x00000200
+    #define GL_FRAMEBUFFER_BARRIER_BIT          0x00000400
+    #define GL_TRANSFORM_FEEDBACK_BARRIER_BIT   0x00000800
+    #define GL_ATOMIC_COUNTER_BARRIER_BIT       0x00001000
+    #define GL_SHADER_STORAGE_BARRIER_BIT       0x00002000
+    #define GL_ALL_BARRIER_BITS                 0xFFFFFFFF
+#endif /* GL_ES_VERSION_3_1 */
+
+#ifndef GL_EXT_disjoint_timer_query
+    #define GL_EXT_disjoint_timer_query 1
+
+    #define GL_TIMESTAMP_EXT                    0x8E28
+    #define GL_GPU_DISJOINT_EXT                 0x8FBB
+
+typedef void(GL_APIENTRY *PFNGLQUERYCOUNTEREXTPROC)(GLuint id, GLenum target);
+typedef void(GL_APIENTRY *PFNGLGETQUERYOBJECTUI64VEXTPROC)(GLuint id, GLenum pname, GLuint64 *params);
+#endif /* GL_EXT_disjoint_timer_query */
+
 /* gles3w api */
 int gles3wInit();
 int gles3wIsSupported(int major, int minor);
@@ -367,6 +409,18 @@ typedef void(GL_APIENTRY *PFNGLGETPROGRAMPIPELINEINFOLOGEXTPROC)(GLuint pipeline
 
 typedef void(GL_APIENTRY *PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC)(GLenum, GLenum, GLenum, GLuint, GLint, GLsizei);
 
+/* OpenGL ES 3.1, resolved at runtime and null on 3.0 contexts */
+typedef void(GL_APIENTRY *PFNGLDISPATCHCOMPUTEPROC)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+typedef void(GL_APIENTRY *PFNGLDISPATCHCOMPUTEINDIRECTPROC)(GLintptr indirect);
+typedef void(GL_APIENTRY *PFNGLDRAWARRAYSINDIRECTPROC)(GLenum mode, const void *indirect);
+typedef void(GL_APIENTRY *PFNGLDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void *indirect);
+typedef void(GL_APIENTRY *PFNGLMEMORYBARRIERPROC)(GLbitfield barriers);
+typedef void(GL_APIENTRY *PFNGLBINDIMAGETEXTUREPROC)(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
+typedef void(GL_APIENTRY *PFNGLGETPROGRAMINTERFACEIVPROC)(GLuint program, GLenum programInterface, GLenum pname, GLint *params);
+typedef GLuint(GL_APIENTRY *PFNGLGETPROGRAMRESOURCEINDEXPROC)(GLuint program, GLenum programInterface, const GLchar *name);
+typedef void(GL_APIENTRY *PFNGLGETPROGRAMRESOURCENAMEPROC)(GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name);
+typedef void(GL_APIENTRY *PFNGLGETPROGRAMRESOURCEIVPROC)(GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum *props, GLsizei bufSize, GLsizei *length, GLint *params);
+
 extern PFNGLACTIVETEXTUREPROC gles3wActiveTexture;
 extern PFNGLATTACHSHADERPROC gles3wAttachShader;
 extern PFNGLBINDATTRIBLOCATIONPROC gles3wBindAttribLocation;
@@ -618,6 +672,8 @@ extern PFNGLGETOBJECTLABELEXTPROC gles3wGetObjectLabelEXT;
 extern PFNGLINSERTEVENTMARKEREXTPROC gles3wInsertEventMarkerEXT;
 extern PFNGLPUSHGROUPMARKEREXTPROC gles3wPushGroupMarkerEXT;
 extern PFNGLPOPGROUPMARKEREXTPROC gles3wPopGroupMarkerEXT;
+extern PFNGLQUERYCOUNTEREXTPROC gles3wQueryCounterEXT;
+extern PFNGLGETQUERYOBJECTUI64VEXTPROC gles3wGetQueryObjectui64vEXT;
 extern PFNGLUSEPROGRAMSTAGESEXTPROC gles3wUseProgramStagesEXT;
 extern PFNGLACTIVESHADERPROGRAMEXTPROC gles3wActiveShaderProgramEXT;
 extern PFNGLCREATESHADERPROGRAMVEXTPROC gles3wCreateShaderProgramvEXT;
@@ -659,6 +715,16 @@ extern PFNGLDEBUGMESSAGECONTROLKHRPROC gles3wDebugMessageControlKHR;
 extern PFNGLDEBUGMESSAGECALLBACKKHRPROC gles3wDebugMessageCallbackKHR;
 extern PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC gles3wFramebufferTexture2DMultisampleEXT;
 extern PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC gles3wFramebufferTexture2DMultisampleIMG;
+extern PFNGLDISPATCHCOMPUTEPROC gles3wDispatchCompute;
+extern PFNGLDISPATCHCOMPUTEINDIRECTPROC gles3wDispatchComputeIndirect;
+extern PFNGLDRAWARRAYSINDIRECTPROC gles3wDrawArraysIndirect;
+extern PFNGLDRAWELEMENTSINDIRECTPROC gles3wDrawElementsIndirect;
+extern PFNGLMEMORYBARRIERPROC gles3wMemoryBarrier;
+extern PFNGLBINDIMAGETEXTUREPROC gles3wBindImageTexture;
+extern PFNGLGETPROGRAMINTERFACEIVPROC gles3wGetProgramInterfaceiv;
+extern PFNGLGETPROGRAMRESOURCEINDEXPROC gles3wGetProgramResourceIndex;
+extern PFNGLGETPROGRAMRESOURCENAMEPROC gles3wGetProgramResourceName;
+extern PFNGLGETPROGRAMRESOURCEIVPROC gles3wGetProgramResourceiv;
 
 #define glActiveTexture                       gles3wActiveTexture
 #define glAttachShader                        gles3wAttachShader
@@ -911,6 +977,8 @@ extern PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC gles3wFramebufferTexture2DMul
 #define glInsertEventMarkerEXT                gles3wInsertEventMarkerEXT
 #define glPushGroupMarkerEXT                  gles3wPushGroupMarkerEXT
 #define glPopGroupMarkerEXT                   gles3wPopGroupMarkerEXT
+#define glQueryCounterEXT                     gles3wQueryCounterEXT
+#define glGetQueryObjectui64vEXT              gles3wGetQueryObjectui64vEXT
 #define glUseProgramStagesEXT                 gles3wUseProgramStagesEXT
 #define glActiveShaderProgramEXT              gles3wActiveShaderProgramEXT
 #define glCreateShaderProgramvEXT             gles3wCreateShaderProgramvEXT
@@ -953,6 +1021,17 @@ extern PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC gles3wFramebufferTexture2DMul
 #define glFramebufferTexture2DMultisampleEXT gles3wFramebufferTexture2DMultisampleEXT
 #define glFramebufferTexture2DMultisampleIMG gles3wFramebufferTexture2DMultisampleIMG
 
+#define glDispatchCompute                     gles3wDispatchCompute
+#define glDispatchComputeIndirect             gles3wDispatchComputeIndirect
+#define glDrawArraysIndirect                  gles3wDrawArraysIndirect
+#define glDrawElementsIndirect                gles3wDrawElementsIndirect
+#define glMemoryBarrier                       gles3wMemoryBarrier
+#define glBindImageTexture                    gles3wBindImageTexture
+#define glGetProgramInterfaceiv               gles3wGetProgramInterfaceiv
+#define glGetProgramResourceIndex             gles3wGetProgramResourceIndex
+#define glGetProgramResourceName              gles3wGetProgramResourceName
+#define glGetProgramResourceiv                gles3wGetProgramResourceiv
+
 #ifdef __cplusplus
 }
 #endif
@@ -517,12 +517,25 @@ PFNGLGETOBJECTLABELEXTPROC gles3wGetObjectLabelEXT;
 PFNGLINSERTEVENTMARKEREXTPROC gles3wInsertEventMarkerEXT;
 PFNGLPUSHGROUPMARKEREXTPROC gles3wPushGroupMarkerEXT;
 PFNGLPOPGROUPMARKEREXTPROC gles3wPopGroupMarkerEXT;
+PFNGLQUERYCOUNTEREXTPROC gles3wQueryCounterEXT;
+PFNGLGETQUERYOBJECTUI64VEXTPROC gles3wGetQueryObjectui64vEXT;
 
 PFNGLDEBUGMESSAGECONTROLKHRPROC gles3wDebugMessageControlKHR;
 PFNGLDEBUGMESSAGECALLBACKKHRPROC gles3wDebugMessageCallbackKHR;
 PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC gles3wFramebufferTexture2DMultisampleEXT;
 PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC gles3wFramebufferTexture2DMultisampleIMG;
 
+PFNGLDISPATCHCOMPUTEPROC gles3wDispatchCompute;
+PFNGLDISPATCHCOMPUTEINDIRECTPROC gles3wDispatchComputeIndirect;
+PFNGLDRAWARRAYSINDIRECTPROC gles3wDrawArraysIndirect;
+PFNGLDRAWELEMENTSINDIRECTPROC gles3wDrawElementsIndirect;
+PFNGLMEMORYBARRIERPROC gles3wMemoryBarrier;
+PFNGLBINDIMAGETEXTUREPROC gles3wBindImageTexture;
+PFNGLGETPROGRAMINTERFACEIVPROC gles3wGetProgramInterfaceiv;
+PFNGLGETPROGRAMRESOURCEINDEXPROC gles3wGetProgramResourceIndex;
+PFNGLGETPROGRAMRESOURCENAMEPROC gles3wGetProgramResourceName;
+PFNGLGETPROGRAMRESOURCEIVPROC gles3wGetProgramResourceiv;
+
 static void load_procs(void)
 {
     gles3wActiveTexture = (PFNGLACTIVETEXTUREPROC) get_proc("glActiveTexture");
@@ -776,6 +789,8 @@ static void load_procs(void)
     gles3wInsertEventMarkerEXT = (PFNGLINSERTEVENTMARKEREXTPROC) get_proc("glInsertEventMarkerEXT");
     gles3wPushGroupMarkerEXT = (PFNGLPUSHGROUPMARKEREXTPROC) get_proc("glPushGroupMarkerEXT");
     gles3wPopGroupMarkerEXT = (PFNGLPOPGROUPMARKEREXTPROC) get_proc("glPopGroupMarkerEXT");
+    gles3wQueryCounterEXT = (PFNGLQUERYCOUNTEREXTPROC) get_proc("glQueryCounterEXT");
+    gles3wGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC) get_proc("glGetQueryObjectui64vEXT");
     gles3wUseProgramStagesEXT = (PFNGLUSEPROGRAMSTAGESEXTPROC) get_proc("glUseProgramStagesEXT");
     gles3wActiveShaderProgramEXT = (PFNGLACTIVESHADERPROGRAMEXTPROC) get_proc("glActiveShaderProgramEXT");
     gles3wCreateShaderProgramvEXT = (PFNGLCREATESHADERPROGRAMVEXTPROC) get_proc("glCreateShaderProgramvEXT");
@@ -817,4 +832,15 @@ static void load_procs(void)
 	gles3wDebugMessageCallbackKHR = (PFNGLDEBUGMESSAGECALLBACKKHRPROC)get_proc("glDebugMessageCallbackKHR");
 	gles3wFramebufferTexture2DMultisampleEXT = (PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC)get_proc("glFramebufferTexture2DMultisampleEXT");
 	gles3wFramebufferTexture2DMultisampleIMG = (PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEIMGPROC)get_proc("glFramebufferTexture2DMultisampleIMG");
+
+    gles3wDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC) get_proc("glDispatchCompute");
+    gles3wDispatchComputeIndirect = (PFNGLDISPATCHCOMPUTEINDIRECTPROC) get_proc("glDispatchComputeIndirect");
+    gles3wDrawArraysIndirect = (PFNGLDRAWARRAYSINDIRECTPROC) get_proc("glDrawArraysIndirect");
+    gles3wDrawElementsIndirect = (PFNGLDRAWELEMENTSINDIRECTPROC) get_proc("glDrawElementsIndirect");
+    gles3wMemoryBarrier = (PFNGLMEMORYBARRIERPROC) get_proc("glMemoryBarrier");
+    gles3wBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC) get_proc("glBindImageTexture");
+    gles3wGetProgramInterfaceiv = (PFNGLGETPROGRAMINTERFACEIVPROC) get_proc("glGetProgramInterfaceiv");
+    gles3wGetProgramResourceIndex = (PFNGLGETPROGRAMRESOURCEINDEXPROC) get_proc("glGetProgramResourceIndex");
+    gles3wGetProgramResourceName = (PFNGLGETPROGRAMRESOURCENAMEPROC) get_proc("glGetProgramResourceName");
+    gles3wGetProgramResourceiv = (PFNGLGETPROGRAMRESOURCEIVPROC) get_proc("glGetProgramResourceiv");
 }
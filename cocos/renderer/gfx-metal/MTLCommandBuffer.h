@@ -69,6 +69,11 @@ public:
     void updateBuffer(Buffer *buff, const void *data, uint size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) override;
     void execute(const CommandBuffer *const *cmdBuffs, uint32_t count) override;
+    void dispatch(const DispatchInfo &info) override;
+    void pipelineBarrier(const GlobalBarrier *barrier) override;
+    void beginMarker(const String &name) override;
+    void endMarker() override;
+    void writeTimestamp(uint slot) override;
 
     CC_INLINE id<MTLCommandBuffer> getMTLCommandBuffer() const { return _mtlCommandBuffer; }
 
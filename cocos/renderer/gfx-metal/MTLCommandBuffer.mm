@@ -407,6 +407,30 @@ void CCMTLCommandBuffer::execute(const CommandBuffer *const *commandBuffs, uint3
     }
 }
 
+void CCMTLCommandBuffer::dispatch(const DispatchInfo &info) {
+    CC_LOG_ERROR("Command 'dispatch' is not supported on Metal yet, check Feature::COMPUTE_SHADER first.");
+}
+
+void CCMTLCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+    // render and blit encoders are tracked by Metal itself
+}
+
+void CCMTLCommandBuffer::beginMarker(const String &name) {
+    if (@available(iOS 11.0, macOS 10.13, *)) {
+        [_mtlCommandBuffer pushDebugGroup:[NSString stringWithUTF8String:name.c_str()]];
+    }
+}
+
+void CCMTLCommandBuffer::endMarker() {
+    if (@available(iOS 11.0, macOS 10.13, *)) {
+        [_mtlCommandBuffer popDebugGroup];
+    }
+}
+
+void CCMTLCommandBuffer::writeTimestamp(uint slot) {
+    // counter sample buffers are not wired up, Feature::TIMESTAMP_QUERY stays off
+}
+
 void CCMTLCommandBuffer::bindDescriptorSets() {
     const auto &vertexBuffers = _inputAssembler->getVertexBuffers();
     for (const auto &bindingInfo : _gpuPipelineState->vertexBufferBindingInfo) {
@@ -230,6 +230,8 @@ void CCMTLDevice::present() {
         _inFlightSemaphore->signal();
     }];
     [mtlCommandBuffer commit];
+
+    ++_frameIndex;
 }
 
 Fence *CCMTLDevice::createFence() {
@@ -50,6 +50,7 @@ bool CCMTLPipelineState::initialize(const PipelineStateInfo &info) {
     _dynamicStates = info.dynamicStates;
     _renderPass = info.renderPass;
     _pipelineLayout = info.pipelineLayout;
+    _bindPoint = info.bindPoint;
 
     if (!createGPUPipelineState()) {
         return false;
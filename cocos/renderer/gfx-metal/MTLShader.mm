@@ -39,6 +39,8 @@ bool CCMTLShader::initialize(const ShaderInfo &info) {
     _attributes = info.attributes;
     _blocks = info.blocks;
     _samplers = info.samplers;
+    _buffers = info.buffers;
+    _images = info.images;
 
     _gpuShader = CC_NEW(CCMTLGPUShader);
 
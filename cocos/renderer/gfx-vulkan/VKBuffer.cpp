@@ -104,7 +104,7 @@ void CCVKBuffer::destroy() {
     if (_gpuBuffer) {
         if (!_isBufferView) {
             ((CCVKDevice *)_device)->gpuBufferHub()->erase(_gpuBuffer);
-            ((CCVKDevice *)_device)->gpuRecycleBin()->collect(_gpuBuffer);
+            ((CCVKDevice *)_device)->recycle(_gpuBuffer);
             _device->getMemoryStatus().bufferSize -= _size;
             CC_DELETE(_gpuBuffer);
         }
@@ -120,7 +120,7 @@ void CCVKBuffer::resize(uint size) {
         _size = size;
         _count = _size / _stride;
 
-        ((CCVKDevice *)_device)->gpuRecycleBin()->collect(_gpuBuffer);
+        ((CCVKDevice *)_device)->recycle(_gpuBuffer);
 
         _gpuBuffer->size = _size;
         _gpuBuffer->count = _count;
@@ -186,7 +186,11 @@ void CCVKCommandBuffer::bindPipelineState(PipelineState *pso) {
     CCVKGPUPipelineState *gpuPipelineState = ((CCVKPipelineState *)pso)->gpuPipelineState();
 
     if (_curGPUPipelineState != gpuPipelineState) {
-        vkCmdBindPipeline(_gpuCommandBuffer->vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, gpuPipelineState->vkPipeline);
+        vkCmdBindPipeline(_gpuCommandBuffer->vkCommandBuffer, MapVkPipelineBindPoint(gpuPipelineState->bindPoint), gpuPipelineState->vkPipeline);
+        // descriptor sets are bound per bind point, rebind all of them when switching
+        if (_curGPUPipelineState && _curGPUPipelineState->bindPoint != gpuPipelineState->bindPoint) {
+            _firstDirtyDescriptorSet = 0u;
+        }
         _curGPUPipelineState = gpuPipelineState;
     }
 }
@@ -425,6 +429,58 @@ void CCVKCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Text
     CCVKCmdFuncCopyBuffersToTexture((CCVKDevice *)_device, buffers, ((CCVKTexture *)texture)->gpuTexture(), regions, count, _gpuCommandBuffer);
 }
 
+void CCVKCommandBuffer::dispatch(const DispatchInfo &info) {
+    if (_curGPUFBO) {
+        CC_LOG_ERROR("Command 'dispatch' must be recorded outside a render pass.");
+        return;
+    }
+
+    if (_firstDirtyDescriptorSet < _curGPUDescriptorSets.size()) {
+        bindDescriptorSets();
+    }
+
+    if (info.indirectBuffer) {
+        CCVKGPUBuffer *gpuBuffer = ((CCVKBuffer *)info.indirectBuffer)->gpuBuffer();
+        CCVKGPUDevice *gpuDevice = static_cast<CCVKDevice *>(_device)->gpuDevice();
+        VkDeviceSize offset = gpuBuffer->startOffset + gpuDevice->curBackBufferIndex * gpuBuffer->instanceSize + info.indirectOffset;
+        vkCmdDispatchIndirect(_gpuCommandBuffer->vkCommandBuffer, gpuBuffer->vkBuffer, offset);
+    } else {
+        vkCmdDispatch(_gpuCommandBuffer->vkCommandBuffer, info.groupCountX, info.groupCountY, info.groupCountZ);
+    }
+}
+
+void CCVKCommandBuffer::pipelineBarrier(const GlobalBarrier *barrier) {
+    if (!barrier) return;
+
+    VkPipelineStageFlags srcStageMask, dstStageMask;
+    VkMemoryBarrier memoryBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+    MapVkGlobalBarrier(*barrier, srcStageMask, dstStageMask, memoryBarrier);
+
+    vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer, srcStageMask, dstStageMask, 0,
+                         memoryBarrier.srcAccessMask ? 1 : 0, &memoryBarrier, 0, nullptr, 0, nullptr);
+}
+
+void CCVKCommandBuffer::beginMarker(const String &name) {
+    if (!static_cast<CCVKDevice *>(_device)->gpuDevice()->useDebugUtils) return;
+
+    VkDebugUtilsLabelEXT label{VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT};
+    label.pLabelName = name.c_str();
+    vkCmdBeginDebugUtilsLabelEXT(_gpuCommandBuffer->vkCommandBuffer, &label);
+}
+
+void CCVKCommandBuffer::endMarker() {
+    if (!static_cast<CCVKDevice *>(_device)->gpuDevice()->useDebugUtils) return;
+
+    vkCmdEndDebugUtilsLabelEXT(_gpuCommandBuffer->vkCommandBuffer);
+}
+
+void CCVKCommandBuffer::writeTimestamp(uint slot) {
+    CCVKDevice *device = static_cast<CCVKDevice *>(_device);
+    if (device->gpuTimestampPool()) {
+        device->gpuTimestampPool()->write(_gpuCommandBuffer->vkCommandBuffer, device->getFrameIndex(), slot);
+    }
+}
+
 void CCVKCommandBuffer::bindDescriptorSets() {
     CCVKDevice *device = (CCVKDevice *)_device;
     CCVKGPUDevice *gpuDevice = device->gpuDevice();
@@ -450,7 +506,7 @@ void CCVKCommandBuffer::bindDescriptorSets() {
     uint dynamicOffsetEndIndex = dynamicOffsetOffsets[_firstDirtyDescriptorSet + dirtyDescriptorSetCount];
     uint dynamicOffsetCount = dynamicOffsetEndIndex - dynamicOffsetStartIndex;
     vkCmdBindDescriptorSets(_gpuCommandBuffer->vkCommandBuffer,
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout->vkPipelineLayout,
+                            MapVkPipelineBindPoint(_curGPUPipelineState->bindPoint), pipelineLayout->vkPipelineLayout,
                             _firstDirtyDescriptorSet, dirtyDescriptorSetCount,
                             &_curVkDescriptorSets[_firstDirtyDescriptorSet],
                             dynamicOffsetCount, _curDynamicOffsets.data() + dynamicOffsetStartIndex);
@@ -81,14 +81,23 @@ void CCVKCmdFuncGetDeviceQueue(CCVKDevice *device, CCVKGPUQueue *gpuQueue) {
 
     const CCVKGPUContext *context = ((CCVKContext *)device->getContext())->gpuContext();
 
+    // prefer the dedicated DMA families for transfers, they run alongside graphics work
+    vector<uint> excludedFlags{0u};
+    if (gpuQueue->type == QueueType::TRANSFER) {
+        excludedFlags = {VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT, 0u};
+    }
+
     size_t queueCount = context->queueFamilyProperties.size();
-    for (size_t i = 0u; i < queueCount; ++i) {
-        const VkQueueFamilyProperties &properties = context->queueFamilyProperties[i];
-        const VkBool32 isPresentable = context->queueFamilyPresentables[i];
-        if (properties.queueCount > 0 && (properties.queueFlags & queueType) && (!needPresentable || isPresentable)) {
-            vkGetDeviceQueue(device->gpuDevice()->vkDevice, i, 0, &gpuQueue->vkQueue);
-            gpuQueue->queueFamilyIndex = i;
-            break;
+    for (uint excluded : excludedFlags) {
+        for (size_t i = 0u; i < queueCount; ++i) {
+            const VkQueueFamilyProperties &properties = context->queueFamilyProperties[i];
+            const VkBool32 isPresentable = context->queueFamilyPresentables[i];
+            if (properties.queueCount > 0 && (properties.queueFlags & queueType) && !(properties.queueFlags & excluded) &&
+                (!needPresentable || isPresentable)) {
+                vkGetDeviceQueue(device->gpuDevice()->vkDevice, i, 0, &gpuQueue->vkQueue);
+                gpuQueue->queueFamilyIndex = i;
+                return;
+            }
         }
     }
 }
@@ -110,6 +119,12 @@ void CCVKCmdFuncCreateTexture(CCVKDevice *device, CCVKGPUTexture *gpuTexture) {
     if (gpuTexture->flags & TextureFlags::GEN_MIPMAP) {
         usageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     }
+    // transient images may only be bound as attachments
+    const VkImageUsageFlags attachmentFlags = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                              VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    if ((usageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) && (usageFlags & ~attachmentFlags)) {
+        usageFlags &= ~VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
 
     VkImageCreateInfo createInfo{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
     createInfo.flags = MapVkImageCreateFlags(gpuTexture->type);
@@ -124,16 +139,45 @@ void CCVKCmdFuncCreateTexture(CCVKDevice *device, CCVKGPUTexture *gpuTexture) {
     createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
     VmaAllocationCreateInfo allocInfo{};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-
     VmaAllocationInfo res;
-    VK_CHECK(vmaCreateImage(device->gpuDevice()->memoryAllocator, &createInfo, &allocInfo, &gpuTexture->vkImage, &gpuTexture->vmaAllocation, &res));
+    VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+
+    // transient attachments never leave tile memory on tilers, so back them with
+    // lazily allocated memory where the device exposes such a memory type
+    if (usageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+        result = vmaCreateImage(device->gpuDevice()->memoryAllocator, &createInfo, &allocInfo, &gpuTexture->vkImage, &gpuTexture->vmaAllocation, &res);
+    }
+    if (result != VK_SUCCESS) {
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        VK_CHECK(vmaCreateImage(device->gpuDevice()->memoryAllocator, &createInfo, &allocInfo, &gpuTexture->vkImage, &gpuTexture->vmaAllocation, &res));
+    }
     //CC_LOG_DEBUG("Allocated texture: %llu %llx %llx %llu %x", res.size, gpuTexture->vkImage, res.deviceMemory, res.offset, res.pMappedData);
 
     gpuTexture->layout = MapVkImageLayout(gpuTexture->usage, gpuTexture->format);
     gpuTexture->accessMask = MapVkAccessFlags(gpuTexture->usage, gpuTexture->format);
     gpuTexture->aspectMask = MapVkImageAspectFlags(gpuTexture->format);
     gpuTexture->targetStage = MapVkPipelineStageFlags(gpuTexture->usage);
+
+    // storage images may be written by compute before anything is uploaded,
+    // so move them to their resting layout right away
+    if (gpuTexture->usage & TextureUsage::STORAGE) {
+        device->gpuTransportHub()->checkIn([gpuTexture](const CCVKGPUCommandBuffer *cmdBuff) {
+            VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            barrier.image = gpuTexture->vkImage;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
+            barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            barrier.dstAccessMask = gpuTexture->accessMask;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = gpuTexture->layout;
+            vkCmdPipelineBarrier(cmdBuff->vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, gpuTexture->targetStage,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        });
+        gpuTexture->currentLayout = gpuTexture->layout;
+    }
 }
 
 void CCVKCmdFuncCreateTextureView(CCVKDevice *device, CCVKGPUTextureView *gpuTextureView) {
@@ -182,6 +226,7 @@ void CCVKCmdFuncCreateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer) {
     }
 
     gpuBuffer->instanceSize = 0u;
+    gpuBuffer->isWritten = false;
 
     VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
     bufferInfo.size = gpuBuffer->size;
@@ -475,7 +520,28 @@ void CCVKCmdFuncCreatePipelineLayout(CCVKDevice *device, CCVKGPUPipelineLayout *
     VK_CHECK(vkCreatePipelineLayout(gpuDevice->vkDevice, &pipelineLayoutCreateInfo, nullptr, &gpuPipelineLayout->vkPipelineLayout));
 }
 
+void CCVKCmdFuncCreateComputePipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
+    VkComputePipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+
+    const CCVKGPUShaderStageList &stages = gpuPipelineState->gpuShader->gpuStages;
+    CCASSERT(stages.size() == 1 && stages[0].type == ShaderStageFlagBit::COMPUTE, "Compute pipelines take exactly one compute stage");
+
+    createInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    createInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    createInfo.stage.module = stages[0].vkShader;
+    createInfo.stage.pName = "main";
+    createInfo.layout = gpuPipelineState->gpuPipelineLayout->vkPipelineLayout;
+
+    VK_CHECK(vkCreateComputePipelines(device->gpuDevice()->vkDevice, device->gpuDevice()->vkPipelineCache,
+                                      1, &createInfo, nullptr, &gpuPipelineState->vkPipeline));
+}
+
 void CCVKCmdFuncCreatePipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
+    if (gpuPipelineState->bindPoint == PipelineBindPoint::COMPUTE) {
+        CCVKCmdFuncCreateComputePipelineState(device, gpuPipelineState);
+        return;
+    }
+
     VkGraphicsPipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
 
     ///////////////////// Shader Stage /////////////////////
@@ -675,6 +741,7 @@ void CCVKCmdFuncCreateFence(CCVKDevice *device, CCVKGPUFence *gpuFence) {
 
 void CCVKCmdFuncUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint size, const CCVKGPUCommandBuffer *cmdBuffer) {
     if (!gpuBuffer) return;
+    gpuBuffer->isWritten = true;
 
     const void *dataToUpload = nullptr;
     size_t sizeToUpload = 0u;
@@ -682,11 +749,13 @@ void CCVKCmdFuncUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
     if (gpuBuffer->usage & BufferUsageBit::INDIRECT) {
         size_t drawInfoCount = size / sizeof(DrawInfo);
         const DrawInfo *drawInfo = static_cast<const DrawInfo *>(buffer);
+        // instance counts of buffers written by compute passes start from zero
+        const uint minInstanceCount = gpuBuffer->usage & BufferUsageBit::STORAGE ? 0u : 1u;
         if (drawInfoCount > 0) {
             if (drawInfo->indexCount) {
                 for (size_t i = 0; i < drawInfoCount; i++) {
                     gpuBuffer->indexedIndirectCmds[i].indexCount = drawInfo->indexCount;
-                    gpuBuffer->indexedIndirectCmds[i].instanceCount = std::max(drawInfo->instanceCount, 1u);
+                    gpuBuffer->indexedIndirectCmds[i].instanceCount = std::max(drawInfo->instanceCount, minInstanceCount);
                     gpuBuffer->indexedIndirectCmds[i].firstIndex = drawInfo->firstIndex;
                     gpuBuffer->indexedIndirectCmds[i].vertexOffset = drawInfo->vertexOffset;
                     gpuBuffer->indexedIndirectCmds[i].firstInstance = drawInfo->firstInstance;
@@ -881,6 +950,140 @@ void CCVKCmdFuncCopyBuffersToTexture(CCVKDevice *device, const uint8_t *const *b
     gpuTexture->currentLayout = gpuTexture->layout;
 }
 
+bool CCVKCmdFuncUpdateBufferAsync(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint size, const UploadCallback &callback) {
+    CCVKGPUAsyncTransportHub *hub = device->gpuAsyncTransportHub();
+    // indirect and per-back-buffer instanced buffers are rewritten on the host side first,
+    // partial updates would need the rest of the buffer acquired by the transfer queue too.
+    // Like textures, only fill buffers the graphics queue has never seen: the transfer queue
+    // doesn't wait for frames in flight, so overwriting a buffer they read would race them
+    if (!gpuBuffer || !hub->isLinked() || size != gpuBuffer->size || gpuBuffer->instanceSize || gpuBuffer->isWritten ||
+        gpuBuffer->usage & (BufferUsageBit::INDIRECT | BufferUsageBit::STORAGE)) {
+        return false;
+    }
+    gpuBuffer->isWritten = true;
+
+    VkBuffer stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceSize stagingOffset = 0u;
+    uint8_t *mappedData = hub->allocStaging(size, 4u, &stagingBuffer, &stagingOffset);
+    memcpy(mappedData, buffer, size);
+
+    VkCommandBuffer cmdBuffer = hub->record();
+    VkBufferCopy region{stagingOffset, gpuBuffer->startOffset, size};
+    vkCmdCopyBuffer(cmdBuffer, stagingBuffer, gpuBuffer->vkBuffer, 1, &region);
+
+    // queue family ownership transfer, the graphics queue acquires it once the batch is done
+    VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.srcQueueFamilyIndex = hub->getQueueFamilyIndex();
+    barrier.dstQueueFamilyIndex = hub->getGraphicsQueueFamilyIndex();
+    barrier.buffer = gpuBuffer->vkBuffer;
+    barrier.offset = gpuBuffer->startOffset;
+    barrier.size = size;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    barrier.srcAccessMask = 0u;
+    barrier.dstAccessMask = gpuBuffer->accessMask;
+    hub->acquire(barrier, gpuBuffer->targetStage);
+    hub->addCallback(callback);
+    return true;
+}
+
+bool CCVKCmdFuncCopyBuffersToTextureAsync(CCVKDevice *device, const uint8_t *const *buffers, CCVKGPUTexture *gpuTexture,
+                                          const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    CCVKGPUAsyncTransportHub *hub = device->gpuAsyncTransportHub();
+    // the image is transitioned from undefined on the transfer queue, so only fill textures
+    // nothing has been written to yet, mipmap generation needs blits on the graphics queue
+    if (!hub->isLinked() || gpuTexture->currentLayout != VK_IMAGE_LAYOUT_UNDEFINED || hub->isAcquiring(gpuTexture) ||
+        gpuTexture->flags & TextureFlags::GEN_MIPMAP) {
+        return false;
+    }
+
+    const VkExtent3D &granularity = hub->getImageGranularity();
+    auto isAligned = [](uint offset, uint extent, uint size, uint granularity) {
+        if (!granularity) return offset == 0u && extent == size;
+        return offset % granularity == 0u && (extent % granularity == 0u || offset + extent == size);
+    };
+    for (uint i = 0u; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        uint mipLevel = region.texSubres.mipLevel;
+        if (!isAligned(region.texOffset.x, region.texExtent.width, std::max(gpuTexture->width >> mipLevel, 1u), granularity.width) ||
+            !isAligned(region.texOffset.y, region.texExtent.height, std::max(gpuTexture->height >> mipLevel, 1u), granularity.height) ||
+            !isAligned(region.texOffset.z, region.texExtent.depth, std::max(gpuTexture->depth >> mipLevel, 1u), granularity.depth)) {
+            return false;
+        }
+    }
+
+    // buffer offsets need to be multiples of both the texel size and 4 on transfer-only queues
+    const uint texelSize = GFX_FORMAT_INFOS[(uint)gpuTexture->format].size;
+    VkDeviceSize alignment = texelSize;
+    while (alignment % 4u) alignment += texelSize;
+
+    VkDeviceSize totalSize = 0u;
+    vector<VkDeviceSize> regionOffsets(count);
+    vector<uint> regionSizes(count);
+    for (uint i = 0u; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        uint w = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+        uint h = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+        regionOffsets[i] = roundUp(totalSize, alignment);
+        regionSizes[i] = FormatSize(gpuTexture->format, w, h, region.texExtent.depth);
+        totalSize = regionOffsets[i] + regionSizes[i];
+    }
+
+    VkBuffer stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceSize stagingOffset = 0u;
+    uint8_t *mappedData = hub->allocStaging(totalSize, alignment, &stagingBuffer, &stagingOffset);
+
+    vector<VkBufferImageCopy> stagingRegions(count);
+    for (uint i = 0u; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        VkBufferImageCopy &stagingRegion = stagingRegions[i];
+        stagingRegion.bufferOffset = stagingOffset + regionOffsets[i];
+        stagingRegion.bufferRowLength = region.buffStride;
+        stagingRegion.bufferImageHeight = region.buffTexHeight;
+        stagingRegion.imageSubresource = {gpuTexture->aspectMask, region.texSubres.mipLevel, region.texSubres.baseArrayLayer, region.texSubres.layerCount};
+        stagingRegion.imageOffset = {region.texOffset.x, region.texOffset.y, region.texOffset.z};
+        stagingRegion.imageExtent = {region.texExtent.width, region.texExtent.height, region.texExtent.depth};
+
+        memcpy(mappedData + regionOffsets[i], buffers[i], regionSizes[i]);
+    }
+
+    VkCommandBuffer cmdBuffer = hub->record();
+
+    VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    barrier.image = gpuTexture->vkImage;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer, gpuTexture->vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           count, stagingRegions.data());
+
+    // release to the graphics queue, the layout transition happens as part of the transfer
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0u;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = gpuTexture->layout;
+    barrier.srcQueueFamilyIndex = hub->getQueueFamilyIndex();
+    barrier.dstQueueFamilyIndex = hub->getGraphicsQueueFamilyIndex();
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    barrier.srcAccessMask = 0u;
+    barrier.dstAccessMask = gpuTexture->accessMask;
+    hub->acquire(gpuTexture, barrier, gpuTexture->targetStage);
+    hub->addCallback(callback);
+    return true;
+}
+
 void CCVKCmdFuncDestroyRenderPass(CCVKGPUDevice *gpuDevice, CCVKGPURenderPass *gpuRenderPass) {
     if (gpuRenderPass->vkRenderPass != VK_NULL_HANDLE) {
         vkDestroyRenderPass(gpuDevice->vkDevice, gpuRenderPass->vkRenderPass, nullptr);
@@ -153,6 +153,9 @@ bool CCVKContext::initialize(const ContextInfo &info) {
         requestedExtensions.push_back(VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
         requestedExtensions.push_back(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
+#elif (CC_PLATFORM == CC_PLATFORM_LINUX)
+        // no window system, render into a headless surface (e.g. lavapipe on CI machines)
+        requestedExtensions.push_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
 #else
     #pragma error Platform not supported
 #endif
@@ -339,6 +342,9 @@ bool CCVKContext::initialize(const ContextInfo &info) {
         surfaceCreateInfo.connection = nullptr; // TODO
         surfaceCreateInfo.window = (xcb_window_t)_windowHandle;
         VK_CHECK(vkCreateXcbSurfaceKHR(_gpuContext->vkInstance, &surfaceCreateInfo, nullptr, &_gpuContext->vkSurface));
+#elif (CC_PLATFORM == CC_PLATFORM_LINUX)
+        VkHeadlessSurfaceCreateInfoEXT surfaceCreateInfo{VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+        VK_CHECK(vkCreateHeadlessSurfaceEXT(_gpuContext->vkInstance, &surfaceCreateInfo, nullptr, &_gpuContext->vkSurface));
 #else
     #pragma error Platform not supported
 #endif
@@ -189,9 +189,11 @@ bool CCVKDevice::initialize(const DeviceInfo &info) {
     _features[(uint)Feature::STENCIL_COMPARE_MASK] = true;
     _features[(uint)Feature::STENCIL_WRITE_MASK] = true;
     _features[(uint)Feature::MULTITHREADED_SUBMISSION] = true;
+    _features[(uint)Feature::COMPUTE_SHADER] = true;
 
     _gpuDevice->useMultiDrawIndirect = deviceFeatures.multiDrawIndirect;
     _gpuDevice->useDescriptorUpdateTemplate = checkExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+    _gpuDevice->useDebugUtils = context->checkExtension(VK_EXT_DEBUG_UTILS_EXTENSION_NAME) && vkCmdBeginDebugUtilsLabelEXT;
 
     VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
     VkFormatProperties formatProperties;
@@ -287,6 +289,8 @@ bool CCVKDevice::initialize(const DeviceInfo &info) {
     QueueInfo queueInfo;
     queueInfo.type = QueueType::GRAPHICS;
     _queue = createQueue(queueInfo);
+    queueInfo.type = QueueType::TRANSFER;
+    _transferQueue = createQueue(queueInfo);
 
     uint backBufferCount = gpuContext->swapchainCreateInfo.minImageCount;
     for (uint i = 0u; i < backBufferCount; i++) {
@@ -298,12 +302,24 @@ bool CCVKDevice::initialize(const DeviceInfo &info) {
     _gpuBufferHub = CC_NEW(CCVKGPUBufferHub(_gpuDevice));
     _gpuTransportHub = CC_NEW(CCVKGPUTransportHub(_gpuDevice));
     _gpuTransportHub->link(((CCVKQueue *)_queue)->gpuQueue());
+    _gpuAsyncTransportHub = CC_NEW(CCVKGPUAsyncTransportHub(_gpuDevice));
+    CCVKGPUQueue *transferQueue = ((CCVKQueue *)_transferQueue)->gpuQueue();
+    if (transferQueue->queueFamilyIndex != ((CCVKQueue *)_queue)->gpuQueue()->queueFamilyIndex) {
+        const VkQueueFamilyProperties &properties = gpuContext->queueFamilyProperties[transferQueue->queueFamilyIndex];
+        _gpuAsyncTransportHub->link(transferQueue, ((CCVKQueue *)_queue)->gpuQueue(), properties.minImageTransferGranularity);
+    }
     _gpuDescriptorHub = CC_NEW(CCVKGPUDescriptorHub(_gpuDevice));
     _gpuSemaphorePool = CC_NEW(CCVKGPUSemaphorePool(_gpuDevice));
     _gpuDescriptorSetHub = CC_NEW(CCVKGPUDescriptorSetHub(_gpuDevice));
 
     _gpuDescriptorHub->link(_gpuDescriptorSetHub);
 
+    uint timestampValidBits = gpuContext->queueFamilyProperties[((CCVKQueue *)_queue)->gpuQueue()->queueFamilyIndex].timestampValidBits;
+    if (timestampValidBits && limits.timestampPeriod > 0.0f) {
+        _gpuTimestampPool = CC_NEW(CCVKGPUTimestampPool(_gpuDevice, limits.timestampPeriod, timestampValidBits));
+        _features[(uint)Feature::TIMESTAMP_QUERY] = true;
+    }
+
     CommandBufferInfo cmdBuffInfo;
     cmdBuffInfo.type = CommandBufferType::PRIMARY;
     cmdBuffInfo.queue = _queue;
@@ -392,6 +408,9 @@ void CCVKDevice::destroy() {
     }
     _depthStencilTextures.clear();
 
+    CC_SAFE_DELETE(_gpuAsyncTransportHub);
+    CC_SAFE_DELETE(_gpuTimestampPool);
+    CC_SAFE_DESTROY(_transferQueue);
     CC_SAFE_DESTROY(_queue);
     CC_SAFE_DESTROY(_cmdBuff);
 
@@ -484,6 +503,10 @@ void CCVKDevice::acquire() {
 
     _gpuBufferHub->flush();
     _gpuDescriptorSetHub->flush();
+    _gpuAsyncTransportHub->update(_gpuTransportHub);
+    if (_gpuTimestampPool) {
+        _gpuTimestampPool->reset(_gpuTransportHub, _frameIndex);
+    }
 
     _gpuSemaphorePool->reset();
     VkSemaphore acquireSemaphore = _gpuSemaphorePool->alloc();
@@ -502,6 +525,8 @@ void CCVKDevice::present() {
     _numInstances = queue->_numInstances;
     _numTriangles = queue->_numTriangles;
 
+    _gpuAsyncTransportHub->flush();
+
     if (queue->gpuQueue()->nextWaitSemaphore) { // don't present if not acquired
         VkPresentInfoKHR presentInfo{VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
         presentInfo.waitSemaphoreCount = 1;
@@ -526,13 +551,35 @@ void CCVKDevice::present() {
         gpuFencePool()->reset();
         gpuRecycleBin()->clear();
         gpuStagingBufferPool()->reset();
+
+        // the frame which last used this back buffer has completed
+        if (_gpuTimestampPool) {
+            uint64_t nanoseconds[MAX_TIMESTAMPS];
+            uint count = 0u;
+            uint64_t frameIndex = _gpuTimestampPool->readback(nanoseconds, &count);
+            if (frameIndex) resolveTimestamps(frameIndex, nanoseconds, count);
+        }
     }
+
+    ++_frameIndex;
 }
 
 CCVKGPUFencePool *CCVKDevice::gpuFencePool() { return _gpuFencePools[_gpuDevice->curBackBufferIndex]; }
 CCVKGPURecycleBin *CCVKDevice::gpuRecycleBin() { return _gpuRecycleBins[_gpuDevice->curBackBufferIndex]; }
 CCVKGPUStagingBufferPool *CCVKDevice::gpuStagingBufferPool() { return _gpuStagingBufferPools[_gpuDevice->curBackBufferIndex]; }
 
+void CCVKDevice::recycle(CCVKGPUBuffer *gpuBuffer) {
+    if (!_gpuAsyncTransportHub || !_gpuAsyncTransportHub->retire(gpuBuffer)) {
+        gpuRecycleBin()->collect(gpuBuffer);
+    }
+}
+
+void CCVKDevice::recycle(CCVKGPUTexture *gpuTexture) {
+    if (!_gpuAsyncTransportHub || !_gpuAsyncTransportHub->retire(gpuTexture)) {
+        gpuRecycleBin()->collect(gpuTexture);
+    }
+}
+
 CommandBuffer *CCVKDevice::doCreateCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
     return CC_NEW(CCVKCommandBuffer(this));
 }
@@ -595,6 +642,18 @@ void CCVKDevice::copyBuffersToTexture(const uint8_t *const *buffers, Texture *ds
     CCVKCmdFuncCopyBuffersToTexture(this, buffers, ((CCVKTexture *)dst)->gpuTexture(), regions, count, gpuCommandBuffer);
 }
 
+void CCVKDevice::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) {
+    if (!CCVKCmdFuncCopyBuffersToTextureAsync(this, buffers, ((CCVKTexture *)dst)->gpuTexture(), regions, count, callback)) {
+        Device::copyBuffersToTextureAsync(buffers, dst, regions, count, callback);
+    }
+}
+
+void CCVKDevice::updateBufferAsync(Buffer *buffer, const void *data, uint size, const UploadCallback &callback) {
+    if (!CCVKCmdFuncUpdateBufferAsync(this, ((CCVKBuffer *)buffer)->gpuBuffer(), data, size, callback)) {
+        Device::updateBufferAsync(buffer, data, size, callback);
+    }
+}
+
 bool CCVKDevice::checkSwapchainStatus() {
     CCVKGPUContext *context = ((CCVKContext *)_context)->gpuContext();
 
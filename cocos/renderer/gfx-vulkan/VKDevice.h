@@ -32,9 +32,13 @@ class CCVKTexture;
 class CCVKGPUDevice;
 class CCVKGPUContext;
 class CCVKGPUSwapchain;
+class CCVKGPUBuffer;
+class CCVKGPUTexture;
 
 class CCVKGPUBufferHub;
 class CCVKGPUTransportHub;
+class CCVKGPUAsyncTransportHub;
+class CCVKGPUTimestampPool;
 class CCVKGPUDescriptorHub;
 class CCVKGPUSemaphorePool;
 class CCVKGPUDescriptorSetHub;
@@ -50,6 +54,7 @@ public:
 
     friend class CCVKContext;
     using Device::copyBuffersToTexture;
+    using Device::copyBuffersToTextureAsync;
     using Device::createBuffer;
     using Device::createCommandBuffer;
     using Device::createDescriptorSet;
@@ -70,6 +75,7 @@ public:
     virtual void resize(uint width, uint height) override;
     virtual void acquire() override;
     virtual void present() override;
+    virtual void updateBufferAsync(Buffer *buffer, const void *data, uint size, const UploadCallback &callback) override;
     CC_INLINE bool checkExtension(const String &extension) const {
         return std::find_if(_extensions.begin(), _extensions.end(),
                             [extension](const char *device_extension) {
@@ -83,6 +89,8 @@ public:
 
     CC_INLINE CCVKGPUBufferHub *gpuBufferHub() { return _gpuBufferHub; }
     CC_INLINE CCVKGPUTransportHub *gpuTransportHub() { return _gpuTransportHub; }
+    CC_INLINE CCVKGPUAsyncTransportHub *gpuAsyncTransportHub() { return _gpuAsyncTransportHub; }
+    CC_INLINE CCVKGPUTimestampPool *gpuTimestampPool() { return _gpuTimestampPool; }
     CC_INLINE CCVKGPUDescriptorHub *gpuDescriptorHub() { return _gpuDescriptorHub; }
     CC_INLINE CCVKGPUSemaphorePool *gpuSemaphorePool() { return _gpuSemaphorePool; }
     CC_INLINE CCVKGPUDescriptorSetHub *gpuDescriptorSetHub() { return _gpuDescriptorSetHub; }
@@ -91,6 +99,10 @@ public:
     CCVKGPURecycleBin *gpuRecycleBin();
     CCVKGPUStagingBufferPool *gpuStagingBufferPool();
 
+    // releases the memory once the GPU is done with it, including in-flight async uploads
+    void recycle(CCVKGPUBuffer *gpuBuffer);
+    void recycle(CCVKGPUTexture *gpuTexture);
+
 private:
     virtual CommandBuffer *doCreateCommandBuffer(const CommandBufferInfo &info, bool hasAgent) override;
     virtual Fence *createFence() override;
@@ -107,6 +119,7 @@ private:
     virtual PipelineLayout *createPipelineLayout() override;
     virtual PipelineState *createPipelineState() override;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
+    virtual void copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count, const UploadCallback &callback) override;
 
     void destroySwapchain();
     bool checkSwapchainStatus();
@@ -114,6 +127,7 @@ private:
     CCVKGPUDevice *_gpuDevice = nullptr;
     CCVKGPUSwapchain *_gpuSwapchain = nullptr;
     vector<CCVKTexture *> _depthStencilTextures;
+    Queue *_transferQueue = nullptr;
 
     vector<CCVKGPUFencePool *> _gpuFencePools;
     vector<CCVKGPURecycleBin *> _gpuRecycleBins;
@@ -121,6 +135,8 @@ private:
 
     CCVKGPUBufferHub *_gpuBufferHub = nullptr;
     CCVKGPUTransportHub *_gpuTransportHub = nullptr;
+    CCVKGPUAsyncTransportHub *_gpuAsyncTransportHub = nullptr;
+    CCVKGPUTimestampPool *_gpuTimestampPool = nullptr;
     CCVKGPUDescriptorHub *_gpuDescriptorHub = nullptr;
     CCVKGPUSemaphorePool *_gpuSemaphorePool = nullptr;
     CCVKGPUDescriptorSetHub *_gpuDescriptorSetHub = nullptr;
@@ -141,6 +141,8 @@ public:
     VkDeviceSize size = 0u;
 
     VkDeviceSize instanceSize = 0u; // per-back-buffer instance
+    // set by the first upload, the graphics queue may read the buffer from then on
+    bool isWritten = false;
 };
 typedef vector<CCVKGPUBuffer *> CCVKGPUBufferList;
 
@@ -215,6 +217,8 @@ public:
     AttributeList attributes;
     UniformBlockList blocks;
     UniformSamplerList samplers;
+    UniformStorageBufferList buffers;
+    UniformStorageImageList images;
     CCVKGPUShaderStageList gpuStages;
 };
 
@@ -272,6 +276,7 @@ public:
 
 class CCVKGPUPipelineState final : public Object {
 public:
+    PipelineBindPoint bindPoint = PipelineBindPoint::GRAPHICS;
     PrimitiveMode primitive = PrimitiveMode::TRIANGLE_LIST;
     CCVKGPUShader *gpuShader = nullptr;
     CCVKGPUPipelineLayout *gpuPipelineLayout = nullptr;
@@ -303,6 +308,7 @@ public:
 
     bool useDescriptorUpdateTemplate = false;
     bool useMultiDrawIndirect = false;
+    bool useDebugUtils = false;
 
     // for default backup usages
     CCVKGPUSampler defaultSampler;
@@ -921,6 +927,9 @@ private:
 
     void _doUpdate(const CCVKGPUTextureView *texture, VkDescriptorImageInfo *descriptor) {
         descriptor->imageView = texture->vkImageView;
+        descriptor->imageLayout = texture->gpuTexture->usage & TextureUsage::STORAGE
+                                      ? VK_IMAGE_LAYOUT_GENERAL
+                                      : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
 
     void _doUpdate(const CCVKGPUSampler *sampler, VkDescriptorImageInfo *descriptor) {
@@ -1152,6 +1161,420 @@ private:
     VkFence _fence = VK_NULL_HANDLE;
 };
 
+/**
+ * Timestamp queries with one pool per back buffer.
+ * A pool is reset through the transport hub when its back buffer is acquired,
+ * and read back once the fences of that back buffer have been waited on.
+ */
+class CCVKGPUTimestampPool final : public Object {
+public:
+    CCVKGPUTimestampPool(CCVKGPUDevice *device, float period, uint validBits)
+    : _device(device), _period(period) {
+        _validMask = validBits >= 64u ? ~0ull : (1ull << validBits) - 1ull;
+
+        VkQueryPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = Device::MAX_TIMESTAMPS;
+
+        _pools.resize(device->backBufferCount);
+        for (Pool &pool : _pools) {
+            VK_CHECK(vkCreateQueryPool(_device->vkDevice, &createInfo, nullptr, &pool.vkQueryPool));
+        }
+    }
+
+    ~CCVKGPUTimestampPool() {
+        for (Pool &pool : _pools) {
+            vkDestroyQueryPool(_device->vkDevice, pool.vkQueryPool, nullptr);
+        }
+        _pools.clear();
+    }
+
+    void reset(CCVKGPUTransportHub *transportHub, uint64_t frameIndex) {
+        Pool &pool = _pools[_device->curBackBufferIndex];
+        pool.frameIndex = frameIndex;
+        memset(pool.written, 0, sizeof(pool.written));
+
+        VkQueryPool vkQueryPool = pool.vkQueryPool;
+        transportHub->checkIn([vkQueryPool](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+            vkCmdResetQueryPool(gpuCommandBuffer->vkCommandBuffer, vkQueryPool, 0u, Device::MAX_TIMESTAMPS);
+        });
+    }
+
+    void write(VkCommandBuffer vkCommandBuffer, uint64_t frameIndex, uint slot) {
+        Pool &pool = _pools[_device->curBackBufferIndex];
+        // skip frames whose pool was never reset, e.g. when acquire bailed out
+        if (pool.frameIndex != frameIndex || slot >= Device::MAX_TIMESTAMPS) return;
+
+        vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool.vkQueryPool, slot);
+        pool.written[slot] = true;
+    }
+
+    // returns the index of the frame read back, or 0 if the current pool holds nothing
+    uint64_t readback(uint64_t *nanoseconds, uint *count) {
+        Pool &pool = _pools[_device->curBackBufferIndex];
+        uint64_t frameIndex = pool.frameIndex;
+        if (!frameIndex) return 0u;
+        pool.frameIndex = 0u;
+
+        // value and availability pairs, unwritten queries stay unavailable
+        uint64_t results[Device::MAX_TIMESTAMPS * 2];
+        vkGetQueryPoolResults(_device->vkDevice, pool.vkQueryPool, 0u, Device::MAX_TIMESTAMPS, sizeof(results), results,
+                              sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        *count = 0u;
+        for (uint slot = 0u; slot < Device::MAX_TIMESTAMPS; ++slot) {
+            nanoseconds[slot] = 0u;
+            if (!pool.written[slot] || !results[slot * 2 + 1]) continue;
+            nanoseconds[slot] = static_cast<uint64_t>(static_cast<double>(results[slot * 2] & _validMask) * _period);
+            *count = slot + 1;
+        }
+        return frameIndex;
+    }
+
+private:
+    struct Pool {
+        VkQueryPool vkQueryPool = VK_NULL_HANDLE;
+        uint64_t frameIndex = 0u;
+        bool written[Device::MAX_TIMESTAMPS] = {};
+    };
+
+    CCVKGPUDevice *_device = nullptr;
+    float _period = 1.0f;
+    uint64_t _validMask = ~0ull;
+    vector<Pool> _pools;
+};
+
+/**
+ * Streams uploads through a dedicated transfer queue so they overlap frame rendering.
+ * Staging data goes through a persistently mapped ring, each batch is submitted with a fence.
+ * Once the fence signals, the ring range is reclaimed, ownership of the destinations is
+ * acquired on the graphics queue through the transport hub, and the batch's callbacks run.
+ */
+class CCVKGPUAsyncTransportHub final : public Object {
+public:
+    static constexpr VkDeviceSize RING_SIZE = 32 * 1024 * 1024;
+
+    CCVKGPUAsyncTransportHub(CCVKGPUDevice *device)
+    : _device(device) {
+    }
+
+    ~CCVKGPUAsyncTransportHub() {
+        destroy();
+    }
+
+    void link(CCVKGPUQueue *queue, CCVKGPUQueue *graphicsQueue, const VkExtent3D &imageGranularity) {
+        _queue = queue;
+        _graphicsQueue = graphicsQueue;
+        _imageGranularity = imageGranularity;
+
+        VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        poolInfo.queueFamilyIndex = _queue->queueFamilyIndex;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        VK_CHECK(vkCreateCommandPool(_device->vkDevice, &poolInfo, nullptr, &_vkCommandPool));
+
+        VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = RING_SIZE;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+        VmaAllocationInfo res;
+        VK_CHECK(vmaCreateBuffer(_device->memoryAllocator, &bufferInfo, &allocInfo, &_ring.vkBuffer, &_ring.vmaAllocation, &res));
+        _ring.mappedData = (uint8_t *)res.pMappedData;
+    }
+
+    void destroy() {
+        if (!_queue) return;
+
+        if (_batch.vkCommandBuffer) {
+            VK_CHECK(vkEndCommandBuffer(_batch.vkCommandBuffer));
+            _freeCommandBuffers.push_back(_batch.vkCommandBuffer);
+        }
+        // nothing is going to use the destinations anymore, drop the acquisitions and callbacks,
+        // dropped callbacks release whatever they hold when the batches are cleared
+        for (Batch &batch : _pending) {
+            VK_CHECK(vkWaitForFences(_device->vkDevice, 1, &batch.vkFence, VK_TRUE, DEFAULT_TIMEOUT));
+            recycle(batch);
+        }
+        recycle(_batch);
+        _pending.clear();
+        _batch = Batch();
+
+        for (VkFence fence : _freeFences) {
+            vkDestroyFence(_device->vkDevice, fence, nullptr);
+        }
+        _freeFences.clear();
+        vkDestroyCommandPool(_device->vkDevice, _vkCommandPool, nullptr);
+        _vkCommandPool = VK_NULL_HANDLE;
+        _freeCommandBuffers.clear();
+        vmaDestroyBuffer(_device->memoryAllocator, _ring.vkBuffer, _ring.vmaAllocation);
+        _ring = {};
+        _queue = nullptr;
+    }
+
+    CC_INLINE bool isLinked() const { return _queue != nullptr; }
+    CC_INLINE uint getQueueFamilyIndex() const { return _queue->queueFamilyIndex; }
+    CC_INLINE uint getGraphicsQueueFamilyIndex() const { return _graphicsQueue->queueFamilyIndex; }
+    CC_INLINE const VkExtent3D &getImageGranularity() const { return _imageGranularity; }
+
+    // staging memory for the open batch, uploads bigger than the ring get their own buffer
+    uint8_t *allocStaging(VkDeviceSize size, VkDeviceSize alignment, VkBuffer *vkBuffer, VkDeviceSize *offset) {
+        if (size > RING_SIZE) {
+            StagingBuffer dedicated;
+            VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            bufferInfo.size = size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+            VmaAllocationInfo res;
+            VK_CHECK(vmaCreateBuffer(_device->memoryAllocator, &bufferInfo, &allocInfo, &dedicated.vkBuffer, &dedicated.vmaAllocation, &res));
+            dedicated.mappedData = (uint8_t *)res.pMappedData;
+            _batch.dedicatedBuffers.push_back(dedicated);
+            *vkBuffer = dedicated.vkBuffer;
+            *offset = 0u;
+            return dedicated.mappedData;
+        }
+
+        while (true) {
+            if (!_ringUsed) _ringHead = _ringTail = 0u;
+
+            const VkDeviceSize start = roundUp(_ringHead, alignment);
+            VkDeviceSize consumed = 0u;
+            if (_ringHead >= _ringTail && _ringUsed < RING_SIZE) {
+                if (start + size <= RING_SIZE) {
+                    *offset = start;
+                    consumed = start + size - _ringHead;
+                } else if (size <= _ringTail) { // wrap around
+                    *offset = 0u;
+                    consumed = RING_SIZE - _ringHead + size;
+                }
+            } else if (_ringHead < _ringTail && start + size <= _ringTail) {
+                *offset = start;
+                consumed = start + size - _ringHead;
+            }
+
+            if (consumed) {
+                _ringHead = *offset + size;
+                _ringUsed += consumed;
+                _batch.ringBytes += consumed;
+                _batch.ringEnd = _ringHead;
+                *vkBuffer = _ring.vkBuffer;
+                return _ring.mappedData + *offset;
+            }
+
+            // the ring is full, the oldest batch in flight has to finish first
+            if (!reclaimOldest()) {
+                flush();
+                reclaimOldest();
+            }
+        }
+    }
+
+    VkCommandBuffer record() {
+        if (!_batch.vkCommandBuffer) {
+            if (_freeCommandBuffers.empty()) {
+                VkCommandBufferAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+                allocateInfo.commandPool = _vkCommandPool;
+                allocateInfo.commandBufferCount = 1;
+                allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                VK_CHECK(vkAllocateCommandBuffers(_device->vkDevice, &allocateInfo, &_batch.vkCommandBuffer));
+            } else {
+                _batch.vkCommandBuffer = _freeCommandBuffers.back();
+                _freeCommandBuffers.pop_back();
+            }
+            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            VK_CHECK(vkBeginCommandBuffer(_batch.vkCommandBuffer, &beginInfo));
+        }
+        return _batch.vkCommandBuffer;
+    }
+
+    // the matching half of a release barrier recorded on the transfer queue
+    void acquire(const VkBufferMemoryBarrier &barrier, VkPipelineStageFlags dstStage) {
+        _batch.bufferBarriers.push_back(barrier);
+        _batch.dstStageMask |= dstStage;
+    }
+
+    // the texture layout is only updated once the acquisition is recorded on the graphics queue
+    void acquire(CCVKGPUTexture *gpuTexture, const VkImageMemoryBarrier &barrier, VkPipelineStageFlags dstStage) {
+        _batch.imageBarriers.push_back(barrier);
+        _batch.textures.push_back(gpuTexture);
+        _batch.dstStageMask |= dstStage;
+    }
+
+    bool isAcquiring(const CCVKGPUTexture *gpuTexture) const {
+        auto contains = [gpuTexture](const Batch &batch) {
+            return std::find(batch.textures.begin(), batch.textures.end(), gpuTexture) != batch.textures.end();
+        };
+        return contains(_batch) || std::any_of(_pending.begin(), _pending.end(), contains);
+    }
+
+    // destinations destroyed or resized while an upload is in flight are released together
+    // with their batch, returns false if the resource isn't referenced by any batch
+    bool retire(CCVKGPUBuffer *gpuBuffer) {
+        auto retireIn = [gpuBuffer](Batch &batch) {
+            auto iter = std::find_if(batch.bufferBarriers.begin(), batch.bufferBarriers.end(), [gpuBuffer](const VkBufferMemoryBarrier &barrier) {
+                return barrier.buffer == gpuBuffer->vkBuffer;
+            });
+            if (iter == batch.bufferBarriers.end()) return false;
+            batch.bufferBarriers.erase(iter);
+            batch.retiredBuffers.push_back({gpuBuffer->vkBuffer, gpuBuffer->vmaAllocation});
+            return true;
+        };
+        return retireIn(_batch) || std::any_of(_pending.begin(), _pending.end(), retireIn);
+    }
+
+    bool retire(CCVKGPUTexture *gpuTexture) {
+        auto retireIn = [gpuTexture](Batch &batch) {
+            auto iter = std::find(batch.textures.begin(), batch.textures.end(), gpuTexture);
+            if (iter == batch.textures.end()) return false;
+            batch.imageBarriers.erase(batch.imageBarriers.begin() + (iter - batch.textures.begin()));
+            batch.textures.erase(iter);
+            batch.retiredImages.push_back({gpuTexture->vkImage, gpuTexture->vmaAllocation});
+            return true;
+        };
+        return retireIn(_batch) || std::any_of(_pending.begin(), _pending.end(), retireIn);
+    }
+
+    void addCallback(const UploadCallback &callback) {
+        if (callback) _batch.callbacks.push_back(callback);
+    }
+
+    void flush() {
+        if (!_batch.vkCommandBuffer) return;
+
+        VK_CHECK(vkEndCommandBuffer(_batch.vkCommandBuffer));
+
+        if (_freeFences.empty()) {
+            VkFenceCreateInfo createInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            VK_CHECK(vkCreateFence(_device->vkDevice, &createInfo, nullptr, &_batch.vkFence));
+        } else {
+            _batch.vkFence = _freeFences.back();
+            _freeFences.pop_back();
+        }
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &_batch.vkCommandBuffer;
+        VK_CHECK(vkQueueSubmit(_queue->vkQueue, 1, &submitInfo, _batch.vkFence));
+
+        _pending.push_back(std::move(_batch));
+        _batch = Batch();
+    }
+
+    // acquires and reports the batches the transfer queue has finished
+    void update(CCVKGPUTransportHub *transportHub) {
+        while (!_pending.empty()) {
+            Batch &batch = _pending.front();
+            if (!batch.ringReclaimed && vkGetFenceStatus(_device->vkDevice, batch.vkFence) != VK_SUCCESS) break;
+
+            if (!batch.bufferBarriers.empty() || !batch.imageBarriers.empty()) {
+                transportHub->checkIn([&batch](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+                    vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, batch.dstStageMask, 0, 0, nullptr,
+                                         toUint(batch.bufferBarriers.size()), batch.bufferBarriers.data(),
+                                         toUint(batch.imageBarriers.size()), batch.imageBarriers.data());
+                });
+                for (CCVKGPUTexture *gpuTexture : batch.textures) {
+                    gpuTexture->currentLayout = gpuTexture->layout;
+                }
+            }
+            vector<UploadCallback> callbacks = std::move(batch.callbacks);
+            recycle(batch);
+            _pending.pop_front();
+
+            // callbacks may start new uploads
+            for (const UploadCallback &callback : callbacks) {
+                callback();
+            }
+        }
+    }
+
+private:
+    struct StagingBuffer {
+        VkBuffer vkBuffer = VK_NULL_HANDLE;
+        VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        uint8_t *mappedData = nullptr;
+    };
+
+    struct Batch {
+        VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
+        VkFence vkFence = VK_NULL_HANDLE;
+        VkDeviceSize ringBytes = 0u;
+        VkDeviceSize ringEnd = 0u;
+        bool ringReclaimed = false;
+        vector<StagingBuffer> dedicatedBuffers;
+        vector<VkBufferMemoryBarrier> bufferBarriers;
+        vector<VkImageMemoryBarrier> imageBarriers;
+        vector<CCVKGPUTexture *> textures; // parallel to imageBarriers
+        VkPipelineStageFlags dstStageMask = 0u;
+        vector<UploadCallback> callbacks;
+        vector<std::pair<VkBuffer, VmaAllocation>> retiredBuffers;
+        vector<std::pair<VkImage, VmaAllocation>> retiredImages;
+    };
+
+    void reclaimRing(Batch &batch) {
+        if (batch.ringReclaimed) return;
+        batch.ringReclaimed = true;
+        if (batch.ringBytes) {
+            _ringTail = batch.ringEnd;
+            _ringUsed -= batch.ringBytes;
+        }
+    }
+
+    bool reclaimOldest() {
+        for (Batch &batch : _pending) {
+            if (batch.ringReclaimed) continue;
+            VK_CHECK(vkWaitForFences(_device->vkDevice, 1, &batch.vkFence, VK_TRUE, DEFAULT_TIMEOUT));
+            reclaimRing(batch);
+            return true;
+        }
+        return false;
+    }
+
+    void recycle(Batch &batch) {
+        reclaimRing(batch);
+        for (StagingBuffer &buffer : batch.dedicatedBuffers) {
+            vmaDestroyBuffer(_device->memoryAllocator, buffer.vkBuffer, buffer.vmaAllocation);
+        }
+        batch.dedicatedBuffers.clear();
+        for (const auto &buffer : batch.retiredBuffers) {
+            vmaDestroyBuffer(_device->memoryAllocator, buffer.first, buffer.second);
+        }
+        batch.retiredBuffers.clear();
+        for (const auto &image : batch.retiredImages) {
+            vmaDestroyImage(_device->memoryAllocator, image.first, image.second);
+        }
+        batch.retiredImages.clear();
+        if (batch.vkFence) {
+            VK_CHECK(vkResetFences(_device->vkDevice, 1, &batch.vkFence));
+            _freeFences.push_back(batch.vkFence);
+            batch.vkFence = VK_NULL_HANDLE;
+        }
+        if (batch.vkCommandBuffer) {
+            VK_CHECK(vkResetCommandBuffer(batch.vkCommandBuffer, 0));
+            _freeCommandBuffers.push_back(batch.vkCommandBuffer);
+            batch.vkCommandBuffer = VK_NULL_HANDLE;
+        }
+    }
+
+    CCVKGPUDevice *_device = nullptr;
+    CCVKGPUQueue *_queue = nullptr;
+    CCVKGPUQueue *_graphicsQueue = nullptr;
+    VkExtent3D _imageGranularity{1u, 1u, 1u};
+    VkCommandPool _vkCommandPool = VK_NULL_HANDLE;
+
+    StagingBuffer _ring;
+    VkDeviceSize _ringHead = 0u;
+    VkDeviceSize _ringTail = 0u;
+    VkDeviceSize _ringUsed = 0u;
+
+    Batch _batch;
+    std::deque<Batch> _pending;
+    vector<VkFence> _freeFences;
+    vector<VkCommandBuffer> _freeCommandBuffers;
+};
+
 } // namespace gfx
 } // namespace cc
 
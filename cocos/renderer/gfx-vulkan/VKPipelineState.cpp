@@ -50,6 +50,7 @@ bool CCVKPipelineState::initialize(const PipelineStateInfo &info) {
     _dynamicStates = info.dynamicStates;
     _renderPass = info.renderPass;
     _pipelineLayout = info.pipelineLayout;
+    _bindPoint = info.bindPoint;
 
     _gpuPipelineState = CC_NEW(CCVKGPUPipelineState);
     _gpuPipelineState->primitive = _primitive;
@@ -58,7 +59,9 @@ bool CCVKPipelineState::initialize(const PipelineStateInfo &info) {
     _gpuPipelineState->rs = _rasterizerState;
     _gpuPipelineState->dss = _depthStencilState;
     _gpuPipelineState->bs = _blendState;
-    _gpuPipelineState->gpuRenderPass = ((CCVKRenderPass *)_renderPass)->gpuRenderPass();
+    _gpuPipelineState->bindPoint = _bindPoint;
+    // compute pipelines are not tied to any render pass
+    _gpuPipelineState->gpuRenderPass = _renderPass ? ((CCVKRenderPass *)_renderPass)->gpuRenderPass() : nullptr;
     _gpuPipelineState->gpuPipelineLayout = ((CCVKPipelineLayout *)_pipelineLayout)->gpuPipelineLayout();
 
     for (uint i = 0; i < 31; i++) {
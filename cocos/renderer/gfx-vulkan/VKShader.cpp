@@ -43,12 +43,16 @@ bool CCVKShader::initialize(const ShaderInfo &info) {
     _attributes = info.attributes;
     _blocks = info.blocks;
     _samplers = info.samplers;
+    _buffers = info.buffers;
+    _images = info.images;
 
     _gpuShader = CC_NEW(CCVKGPUShader);
     _gpuShader->name = _name;
     _gpuShader->attributes = _attributes;
     _gpuShader->blocks = _blocks;
     _gpuShader->samplers = _samplers;
+    _gpuShader->buffers = _buffers;
+    _gpuShader->images = _images;
     for (ShaderStage &stage : _stages) {
         _gpuShader->gpuStages.push_back({stage.stage, stage.source});
     }
@@ -162,7 +162,7 @@ void CCVKTexture::destroy() {
 
     if (_gpuTexture) {
         if (!_isTextureView) {
-            ((CCVKDevice *)_device)->gpuRecycleBin()->collect(_gpuTexture);
+            ((CCVKDevice *)_device)->recycle(_gpuTexture);
             _device->getMemoryStatus().textureSize -= _size;
             CC_DELETE(_gpuTexture);
         }
@@ -187,7 +187,7 @@ void CCVKTexture::resize(uint width, uint height) {
         _size = size;
 
         ((CCVKDevice *)_device)->gpuRecycleBin()->collect(_gpuTextureView);
-        ((CCVKDevice *)_device)->gpuRecycleBin()->collect(_gpuTexture);
+        ((CCVKDevice *)_device)->recycle(_gpuTexture);
 
         MemoryStatus &status = _device->getMemoryStatus();
         _gpuTexture->width = _width;
@@ -247,6 +247,7 @@ VkAccessFlags MapVkAccessFlags(TextureLayout layout) {
 }
 
 VkAccessFlags MapVkAccessFlags(TextureUsage usage, Format format) {
+    if (usage & TextureUsage::STORAGE) return VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
     if (usage & TextureUsage::COLOR_ATTACHMENT) return VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
     if (usage & TextureUsage::DEPTH_STENCIL_ATTACHMENT) return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
     if (usage & TextureUsage::INPUT_ATTACHMENT) return VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
@@ -345,7 +346,6 @@ VkFormatFeatureFlags MapVkFormatFeatureFlags(TextureUsage usage) {
     if (usage & TextureUsage::STORAGE) flags |= VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
     if (usage & TextureUsage::COLOR_ATTACHMENT) flags |= VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
     if (usage & TextureUsage::DEPTH_STENCIL_ATTACHMENT) flags |= VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    if (usage & TextureUsage::TRANSIENT_ATTACHMENT) flags |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
     if (usage & TextureUsage::INPUT_ATTACHMENT) flags |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
     return (VkFormatFeatureFlags)flags;
 }
@@ -365,6 +365,8 @@ VkImageUsageFlagBits MapVkImageUsageFlagBits(TextureUsage usage) {
 
 VkImageLayout MapVkImageLayout(TextureUsage usage, Format format) {
     const FormatInfo &info = GFX_FORMAT_INFOS[(uint)format];
+    // storage images stay in the general layout for their whole lifetime
+    if (usage & TextureUsage::STORAGE) return VK_IMAGE_LAYOUT_GENERAL;
     if (usage & TextureUsage::SAMPLED) {
         if (info.hasDepth && info.hasStencil)
             return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
@@ -398,6 +400,7 @@ VkImageAspectFlags MapVkImageAspectFlags(Format format) {
 }
 
 VkPipelineStageFlags MapVkPipelineStageFlags(TextureUsage usage) {
+    if (usage & TextureUsage::STORAGE) return VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     if (usage & TextureUsage::COLOR_ATTACHMENT) return VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     if (usage & TextureUsage::DEPTH_STENCIL_ATTACHMENT) return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
     if (usage & TextureUsage::SAMPLED) return VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
@@ -458,6 +461,7 @@ VkDescriptorType MapVkDescriptorType(DescriptorType type) {
         case DescriptorType::DYNAMIC_STORAGE_BUFFER: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
         case DescriptorType::STORAGE_BUFFER: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         case DescriptorType::SAMPLER: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        case DescriptorType::STORAGE_IMAGE: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
         default: {
             CCASSERT(false, "Unsupported DescriptorType, convert to VkDescriptorType failed.");
             return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
@@ -669,6 +673,65 @@ const VkAccessFlags FULL_ACCESS_FLAGS = VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
                                         VK_ACCESS_HOST_READ_BIT |
                                         VK_ACCESS_HOST_WRITE_BIT;
 
+struct CCVKAccessInfo {
+    VkPipelineStageFlags stageMask;
+    VkAccessFlags accessMask;
+};
+
+const CCVKAccessInfo VK_ACCESS_INFOS[] = {
+    {0, 0}, // NONE
+
+    {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT},                                                             // INDIRECT_BUFFER
+    {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT},                                                                         // INDEX_BUFFER
+    {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT},                                                              // VERTEX_BUFFER
+    {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT},                                                                      // VERTEX_SHADER_READ_UNIFORM_BUFFER
+    {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                       // VERTEX_SHADER_READ_TEXTURE
+    {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                       // VERTEX_SHADER_READ_OTHER
+    {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT},                                                                    // FRAGMENT_SHADER_READ_UNIFORM_BUFFER
+    {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                     // FRAGMENT_SHADER_READ_TEXTURE
+    {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                     // FRAGMENT_SHADER_READ_OTHER
+    {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT},                                                   // COLOR_ATTACHMENT_READ
+    {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT},   // DEPTH_STENCIL_ATTACHMENT_READ
+    {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_UNIFORM_READ_BIT},                                                                     // COMPUTE_SHADER_READ_UNIFORM_BUFFER
+    {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                      // COMPUTE_SHADER_READ_TEXTURE
+    {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT},                                                                      // COMPUTE_SHADER_READ_OTHER
+    {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT},                                                                          // TRANSFER_READ
+    {VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT},                                                                                  // HOST_READ
+    {0, 0},                                                                                                                                 // PRESENT
+
+    {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT},                                                                      // VERTEX_SHADER_WRITE
+    {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT},                                                                    // FRAGMENT_SHADER_WRITE
+    {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT},                                                  // COLOR_ATTACHMENT_WRITE
+    {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT},  // DEPTH_STENCIL_ATTACHMENT_WRITE
+    {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT},                                                                     // COMPUTE_SHADER_WRITE
+    {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT},                                                                         // TRANSFER_WRITE
+    {VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_WRITE_BIT},                                                                                 // HOST_WRITE
+};
+
+CC_INLINE bool isWriteAccess(AccessType type) {
+    return type >= AccessType::VERTEX_SHADER_WRITE;
+}
+
+// only writes need to be made available, reads are merely made visible
+void MapVkGlobalBarrier(const GlobalBarrier &barrier, VkPipelineStageFlags &srcStageMask, VkPipelineStageFlags &dstStageMask, VkMemoryBarrier &memoryBarrier) {
+    srcStageMask = dstStageMask = 0u;
+    memoryBarrier.srcAccessMask = memoryBarrier.dstAccessMask = 0u;
+
+    for (AccessType type : barrier.prevAccesses) {
+        const CCVKAccessInfo &info = VK_ACCESS_INFOS[(uint)type];
+        srcStageMask |= info.stageMask;
+        if (isWriteAccess(type)) memoryBarrier.srcAccessMask |= info.accessMask;
+    }
+    for (AccessType type : barrier.nextAccesses) {
+        const CCVKAccessInfo &info = VK_ACCESS_INFOS[(uint)type];
+        dstStageMask |= info.stageMask;
+        if (memoryBarrier.srcAccessMask) memoryBarrier.dstAccessMask |= info.accessMask;
+    }
+
+    if (!srcStageMask) srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    if (!dstStageMask) dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+}
+
 void fullPipelineBarrier(VkCommandBuffer cmdBuff) {
 #if CC_DEBUG > 0
     VkMemoryBarrier memoryBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
@@ -41,6 +41,19 @@ BatchedBuffer *BatchedBuffer::get(uint pass, uint extraKey) {
     return buffer;
 }
 
+void BatchedBuffer::destroyBatchedBuffer() {
+    for (auto &record : _buffers) {
+        for (auto &pair : record.second) {
+            auto *batchedBuffer = pair.second;
+            if (batchedBuffer) {
+                batchedBuffer->destroy();
+                CC_DELETE(batchedBuffer);
+            }
+        }
+    }
+    _buffers.clear();
+}
+
 BatchedBuffer::BatchedBuffer(const PassView *pass)
 : _pass(pass),
   _device(gfx::Device::getInstance()) {
@@ -51,6 +51,7 @@ class CC_DLL BatchedBuffer : public Object {
 public:
     static BatchedBuffer *get(uint pass);
     static BatchedBuffer *get(uint pass, uint extraKey);
+    static void destroyBatchedBuffer();
 
     BatchedBuffer(const PassView *pass);
     virtual ~BatchedBuffer();
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include "../core/CoreStd.h"
 #include "base/Value.h"
+#include "base/memory/FrameAllocator.h"
 
 namespace cc {
 namespace pipeline {
@@ -48,7 +49,8 @@ struct CC_DLL RenderObject {
     float depth = 0;
     const ModelView *model = nullptr;
 };
-typedef vector<struct RenderObject> RenderObjectList;
+// rebuilt every frame, so it lives in frame memory
+typedef FrameVector<struct RenderObject> RenderObjectList;
 
 struct CC_DLL RenderTargetInfo {
     uint width = 0;
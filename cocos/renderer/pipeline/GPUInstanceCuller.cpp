@@ -0,0 +1,292 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "GPUInstanceCuller.h"
+#include "InstancedBuffer.h"
+#include "gfx/GFXBuffer.h"
+#include "gfx/GFXCommandBuffer.h"
+#include "gfx/GFXDescriptorSet.h"
+#include "gfx/GFXDescriptorSetLayout.h"
+#include "gfx/GFXDevice.h"
+#include "gfx/GFXInputAssembler.h"
+#include "gfx/GFXPipelineLayout.h"
+#include "gfx/GFXPipelineState.h"
+#include "gfx/GFXShader.h"
+#include "helper/SharedMemory.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+enum class CullBinding : uint8_t {
+    PARAMS,
+    SOURCE,
+    BOUNDS,
+    OUTPUT,
+    ARGS,
+    COUNT,
+};
+
+struct CullParams {
+    float planes[PLANE_LENGTH * 4];
+    uint counts[4]; // instance count, instance stride in uints
+};
+
+// Vulkan needs the set index in the layout qualifiers, GLES 3.1 does not know it
+const char *CULL_SHADER_SOURCE = R"(
+layout(local_size_x = 64) in;
+
+layout(CC_BINDING(0), std140) uniform CCInstanceCullParams {
+    vec4 cc_frustumPlanes[6];
+    uvec4 cc_cullCounts;
+};
+layout(CC_BINDING(1), std430) readonly buffer CCInstanceSource { uint cc_source[]; };
+layout(CC_BINDING(2), std430) readonly buffer CCInstanceBounds { vec4 cc_bounds[]; };
+layout(CC_BINDING(3), std430) writeonly buffer CCInstanceOutput { uint cc_output[]; };
+layout(CC_BINDING(4), std430) buffer CCInstanceDrawArgs { uint cc_drawArgs[]; };
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= cc_cullCounts.x) return;
+
+    // a negative radius marks instances without bounds, they are always drawn
+    vec4 sphere = cc_bounds[index];
+    if (sphere.w >= 0.0) {
+        for (int i = 0; i < 6; ++i) {
+            vec4 plane = cc_frustumPlanes[i];
+            if (dot(plane.xyz, sphere.xyz) + sphere.w * length(plane.xyz) < plane.w) return;
+        }
+    }
+
+    // instanceCount sits at the same offset in indexed and non-indexed indirect commands
+    uint slot = atomicAdd(cc_drawArgs[1], 1u);
+    uint stride = cc_cullCounts.y;
+    for (uint i = 0u; i < stride; ++i) {
+        cc_output[slot * stride + i] = cc_source[index * stride + i];
+    }
+}
+)";
+} // namespace
+
+void GPUInstanceCuller::destroyCullData(InstancedCullData *cullData) {
+    if (!cullData) return;
+
+    CC_SAFE_DESTROY(cullData->descriptorSet);
+    CC_SAFE_DESTROY(cullData->ia);
+    CC_SAFE_DESTROY(cullData->paramsBuffer);
+    CC_SAFE_DESTROY(cullData->sourceBuffer);
+    CC_SAFE_DESTROY(cullData->boundsBuffer);
+    CC_SAFE_DESTROY(cullData->outputBuffer);
+    CC_SAFE_DESTROY(cullData->indirectBuffer);
+    CC_DELETE(cullData);
+}
+
+GPUInstanceCuller::GPUInstanceCuller(gfx::Device *device)
+: _device(device) {
+}
+
+GPUInstanceCuller::~GPUInstanceCuller() {
+}
+
+bool GPUInstanceCuller::initialize() {
+    if (!_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) {
+        CC_LOG_WARNING("GPU instance culling needs compute shader support.");
+        return false;
+    }
+
+    const String binding = _device->getGfxAPI() == gfx::API::VULKAN ? "set = 0, binding = b" : "binding = b";
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name = "instance-cull";
+    shaderInfo.stages.push_back({gfx::ShaderStageFlagBit::COMPUTE, "#define CC_BINDING(b) " + binding + "\n" + CULL_SHADER_SOURCE});
+    shaderInfo.blocks.push_back({0, static_cast<uint>(CullBinding::PARAMS), "CCInstanceCullParams",
+                                 {{"cc_frustumPlanes", gfx::Type::FLOAT4, PLANE_LENGTH}, {"cc_cullCounts", gfx::Type::UINT4, 1}}, 1});
+    shaderInfo.buffers.push_back({0, static_cast<uint>(CullBinding::SOURCE), "CCInstanceSource", 1});
+    shaderInfo.buffers.push_back({0, static_cast<uint>(CullBinding::BOUNDS), "CCInstanceBounds", 1});
+    shaderInfo.buffers.push_back({0, static_cast<uint>(CullBinding::OUTPUT), "CCInstanceOutput", 1});
+    shaderInfo.buffers.push_back({0, static_cast<uint>(CullBinding::ARGS), "CCInstanceDrawArgs", 1});
+    _shader = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo layoutInfo;
+    for (uint i = 0; i < static_cast<uint>(CullBinding::COUNT); ++i) {
+        const auto type = i == static_cast<uint>(CullBinding::PARAMS) ? gfx::DescriptorType::UNIFORM_BUFFER : gfx::DescriptorType::STORAGE_BUFFER;
+        layoutInfo.bindings.push_back({i, type, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    }
+    _descriptorSetLayout = _device->createDescriptorSetLayout(layoutInfo);
+    _pipelineLayout = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    gfx::PipelineStateInfo psoInfo;
+    psoInfo.shader = _shader;
+    psoInfo.pipelineLayout = _pipelineLayout;
+    psoInfo.bindPoint = gfx::PipelineBindPoint::COMPUTE;
+    _pipelineState = _device->createPipelineState(psoInfo);
+
+    // the previous camera's culling and draws must be done with the buffers before they are refilled
+    _uploadBarrier.prevAccesses = {gfx::AccessType::COMPUTE_SHADER_READ_UNIFORM_BUFFER, gfx::AccessType::COMPUTE_SHADER_READ_OTHER,
+                                   gfx::AccessType::INDIRECT_BUFFER, gfx::AccessType::VERTEX_BUFFER};
+    _uploadBarrier.nextAccesses = {gfx::AccessType::TRANSFER_WRITE};
+    _cullBarrier.prevAccesses = {gfx::AccessType::TRANSFER_WRITE};
+    _cullBarrier.nextAccesses = {gfx::AccessType::COMPUTE_SHADER_READ_UNIFORM_BUFFER, gfx::AccessType::COMPUTE_SHADER_READ_OTHER};
+    _drawBarrier.prevAccesses = {gfx::AccessType::COMPUTE_SHADER_WRITE};
+    _drawBarrier.nextAccesses = {gfx::AccessType::INDIRECT_BUFFER, gfx::AccessType::VERTEX_BUFFER};
+
+    return true;
+}
+
+void GPUInstanceCuller::destroy() {
+    CC_SAFE_DESTROY(_pipelineState);
+    CC_SAFE_DESTROY(_pipelineLayout);
+    CC_SAFE_DESTROY(_descriptorSetLayout);
+    CC_SAFE_DESTROY(_shader);
+}
+
+InstancedCullData *GPUInstanceCuller::createCullData(const InstancedItem &instance) {
+    auto *cullData = CC_NEW(InstancedCullData);
+    cullData->capacity = instance.capacity;
+
+    const auto size = instance.stride * instance.capacity;
+    // cull() runs once per camera, device only buffers are filled by copies recorded in the
+    // command buffer so every dispatch sees its own camera's data, host visible ones would
+    // be overwritten in place by the last camera
+    cullData->paramsBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(CullParams),
+        sizeof(CullParams),
+    });
+    cullData->sourceBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        size,
+        instance.stride,
+    });
+    cullData->boundsBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        static_cast<uint>(sizeof(float) * 4 * instance.capacity),
+        sizeof(float) * 4,
+    });
+    cullData->outputBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::STORAGE,
+        gfx::MemoryUsageBit::DEVICE,
+        size,
+        instance.stride,
+    });
+    cullData->indirectBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::INDIRECT | gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(gfx::DrawInfo),
+        sizeof(gfx::DrawInfo),
+    });
+
+    // same layout as the instanced input assembler, with the compacted instances as the last stream
+    auto vertexBuffers = instance.ia->getVertexBuffers();
+    vertexBuffers.back() = cullData->outputBuffer;
+    gfx::InputAssemblerInfo iaInfo = {instance.ia->getAttributes(), vertexBuffers, instance.ia->getIndexBuffer(), cullData->indirectBuffer};
+    cullData->ia = _device->createInputAssembler(iaInfo);
+
+    cullData->descriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+    cullData->descriptorSet->bindBuffer(static_cast<uint>(CullBinding::PARAMS), cullData->paramsBuffer);
+    cullData->descriptorSet->bindBuffer(static_cast<uint>(CullBinding::SOURCE), cullData->sourceBuffer);
+    cullData->descriptorSet->bindBuffer(static_cast<uint>(CullBinding::BOUNDS), cullData->boundsBuffer);
+    cullData->descriptorSet->bindBuffer(static_cast<uint>(CullBinding::OUTPUT), cullData->outputBuffer);
+    cullData->descriptorSet->bindBuffer(static_cast<uint>(CullBinding::ARGS), cullData->indirectBuffer);
+    cullData->descriptorSet->update();
+
+    return cullData;
+}
+
+void GPUInstanceCuller::resizeCullData(const InstancedItem &instance) {
+    auto *cullData = instance.cullData;
+    cullData->capacity = instance.capacity;
+
+    // descriptors follow the resized buffers
+    const auto size = instance.stride * instance.capacity;
+    cullData->sourceBuffer->resize(size);
+    cullData->boundsBuffer->resize(static_cast<uint>(sizeof(float) * 4 * instance.capacity));
+    cullData->outputBuffer->resize(size);
+}
+
+void GPUInstanceCuller::cull(gfx::CommandBuffer *cmdBuffer, const Frustum *frustum, const vector<InstancedBuffer *> &buffers) {
+    CullParams params;
+    for (uint i = 0; i < PLANE_LENGTH; ++i) {
+        const auto &plane = frustum->planes[i];
+        params.planes[i * 4 + 0] = plane.normal.x;
+        params.planes[i * 4 + 1] = plane.normal.y;
+        params.planes[i * 4 + 2] = plane.normal.z;
+        params.planes[i * 4 + 3] = plane.distance;
+    }
+
+    cmdBuffer->pipelineBarrier(&_uploadBarrier);
+
+    for (auto *buffer : buffers) {
+        for (auto &instance : buffer->getInstances()) {
+            if (!instance.count) continue;
+
+            // instances are copied as whole uints, odd layouts are drawn unculled
+            if (instance.stride % sizeof(uint)) {
+                cmdBuffer->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
+                instance.ia->setInstanceCount(instance.count);
+                continue;
+            }
+
+            if (!instance.cullData) {
+                instance.cullData = createCullData(instance);
+            } else if (instance.cullData->capacity != instance.capacity) {
+                resizeCullData(instance);
+            }
+            const auto *cullData = instance.cullData;
+
+            params.counts[0] = instance.count;
+            params.counts[1] = instance.stride / sizeof(uint);
+            cmdBuffer->updateBuffer(cullData->paramsBuffer, &params, sizeof(params));
+            cmdBuffer->updateBuffer(cullData->sourceBuffer, instance.data, instance.stride * instance.count);
+            cmdBuffer->updateBuffer(cullData->boundsBuffer, instance.bounds, static_cast<uint>(sizeof(float) * 4 * instance.count));
+
+            // visible instances are counted up from zero by the culling pass
+            const auto *ia = instance.ia;
+            gfx::DrawInfo drawInfo;
+            drawInfo.vertexCount = ia->getVertexCount();
+            drawInfo.firstVertex = ia->getFirstVertex();
+            drawInfo.indexCount = ia->getIndexCount();
+            drawInfo.firstIndex = ia->getFirstIndex();
+            drawInfo.vertexOffset = ia->getVertexOffset();
+            cmdBuffer->updateBuffer(cullData->indirectBuffer, &drawInfo, sizeof(drawInfo));
+        }
+    }
+
+    cmdBuffer->pipelineBarrier(&_cullBarrier);
+    cmdBuffer->bindPipelineState(_pipelineState);
+
+    for (auto *buffer : buffers) {
+        for (const auto &instance : buffer->getInstances()) {
+            if (!instance.count || !instance.cullData) continue;
+
+            cmdBuffer->bindDescriptorSet(0, instance.cullData->descriptorSet);
+            cmdBuffer->dispatch({(instance.count + GROUP_SIZE - 1) / GROUP_SIZE, 1, 1});
+        }
+    }
+
+    cmdBuffer->pipelineBarrier(&_drawBarrier);
+}
+
+} // namespace pipeline
+} // namespace cc
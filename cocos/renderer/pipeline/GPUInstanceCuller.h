@@ -0,0 +1,79 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "core/CoreStd.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+}
+namespace pipeline {
+class InstancedBuffer;
+struct InstancedItem;
+struct Frustum;
+
+// per batch resources of the culling pass, owned by the instanced item
+struct CC_DLL InstancedCullData {
+    uint capacity = 0;
+    gfx::Buffer *paramsBuffer = nullptr;
+    gfx::Buffer *sourceBuffer = nullptr;
+    gfx::Buffer *boundsBuffer = nullptr;
+    gfx::Buffer *outputBuffer = nullptr; // compacted instances, the vertex buffer of ia
+    gfx::Buffer *indirectBuffer = nullptr;
+    gfx::InputAssembler *ia = nullptr;
+    gfx::DescriptorSet *descriptorSet = nullptr;
+};
+
+// Frustum culls instanced batches per instance in a compute pass. Visible instances
+// are compacted into a vertex buffer and counted into the indirect draw arguments,
+// so the CPU only appends instances and never tests them one by one.
+class CC_DLL GPUInstanceCuller : public Object {
+public:
+    static constexpr uint GROUP_SIZE = 64;
+    static void destroyCullData(InstancedCullData *cullData);
+
+    GPUInstanceCuller(gfx::Device *device);
+    ~GPUInstanceCuller();
+
+    bool initialize();
+    void destroy();
+    void cull(gfx::CommandBuffer *cmdBuffer, const Frustum *frustum, const vector<InstancedBuffer *> &buffers);
+
+private:
+    InstancedCullData *createCullData(const InstancedItem &instance);
+    void resizeCullData(const InstancedItem &instance);
+
+    gfx::Device *_device = nullptr;
+    gfx::Shader *_shader = nullptr;
+    gfx::DescriptorSetLayout *_descriptorSetLayout = nullptr;
+    gfx::PipelineLayout *_pipelineLayout = nullptr;
+    gfx::PipelineState *_pipelineState = nullptr;
+    gfx::GlobalBarrier _uploadBarrier;
+    gfx::GlobalBarrier _cullBarrier;
+    gfx::GlobalBarrier _drawBarrier;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "InstancedBuffer.h"
+#include "GPUInstanceCuller.h"
 #include "gfx/GFXBuffer.h"
 #include "gfx/GFXCommandBuffer.h"
 #include "gfx/GFXDescriptorSet.h"
@@ -43,6 +44,19 @@ InstancedBuffer *InstancedBuffer::get(uint pass, uint extraKey) {
     return buffer;
 }
 
+void InstancedBuffer::destroyInstancedBuffer() {
+    for (auto &record : _buffers) {
+        for (auto &pair : record.second) {
+            auto *instancedBuffer = pair.second;
+            if (instancedBuffer) {
+                instancedBuffer->destroy();
+                CC_DELETE(instancedBuffer);
+            }
+        }
+    }
+    _buffers.clear();
+}
+
 InstancedBuffer::InstancedBuffer(const PassView *pass)
 : _pass(pass),
   _device(gfx::Device::getInstance()) {
@@ -56,10 +70,26 @@ void InstancedBuffer::destroy() {
         instance.vb->destroy();
         instance.ia->destroy();
         CC_FREE(instance.data);
+        CC_FREE(instance.bounds);
+        GPUInstanceCuller::destroyCullData(instance.cullData);
     }
     _instances.clear();
 }
 
+namespace {
+void writeBounds(float *bounds, const ModelView *model) {
+    if (!model->worldBoundsID) {
+        bounds[3] = -1.0f; // never culled
+        return;
+    }
+    const auto *aabb = model->getWorldBounds();
+    bounds[0] = aabb->center.x;
+    bounds[1] = aabb->center.y;
+    bounds[2] = aabb->center.z;
+    bounds[3] = aabb->halfExtents.length();
+}
+} // namespace
+
 void InstancedBuffer::merge(const ModelView *model, const SubModelView *subModel, uint passIdx) {
     uint stride = 0;
     const auto instancedBuffer = model->getInstancedBuffer(&stride);
@@ -91,6 +121,11 @@ void InstancedBuffer::merge(const ModelView *model, const SubModelView *subModel
             memcpy(instance.data, oldData, instance.vb->getSize());
             instance.vb->resize(newSize);
             CC_FREE(oldData);
+
+            const auto oldBounds = instance.bounds;
+            instance.bounds = (float *)CC_MALLOC(sizeof(float) * 4 * instance.capacity);
+            memcpy(instance.bounds, oldBounds, sizeof(float) * 4 * instance.count);
+            CC_FREE(oldBounds);
         }
         if (instance.shader != shader) {
             instance.shader = shader;
@@ -98,6 +133,7 @@ void InstancedBuffer::merge(const ModelView *model, const SubModelView *subModel
         if (instance.descriptorSet != descriptorSet) {
             instance.descriptorSet = descriptorSet;
         }
+        writeBounds(instance.bounds + 4 * instance.count, model);
         memcpy(instance.data + instance.stride * instance.count++, instancedBuffer, stride);
         _hasPendingModels = true;
         return;
@@ -129,7 +165,9 @@ void InstancedBuffer::merge(const ModelView *model, const SubModelView *subModel
     vertexBuffers.emplace_back(vb);
     gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto ia = _device->createInputAssembler(iaInfo);
-    InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap};
+    float *bounds = (float *)CC_MALLOC(sizeof(float) * 4 * INITIAL_CAPACITY);
+    writeBounds(bounds, model);
+    InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap, bounds};
     _instances.emplace_back(std::move(item));
     _hasPendingModels = true;
 }
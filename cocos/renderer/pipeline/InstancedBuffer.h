@@ -35,6 +35,7 @@ struct SubModelView;
 struct PassView;
 struct InstancedAttributeBlock;
 struct PSOInfo;
+struct InstancedCullData;
 
 #if defined(INITIAL_CAPACITY)
 #undef INITIAL_CAPACITY
@@ -50,6 +51,8 @@ struct CC_DLL InstancedItem {
     gfx::Shader *shader = nullptr;
     gfx::DescriptorSet *descriptorSet = nullptr;
     gfx::Texture *lightingMap = nullptr;
+    float *bounds = nullptr; // bounding sphere per instance, center and radius
+    InstancedCullData *cullData = nullptr;
 };
 typedef vector<InstancedItem> InstancedItemList;
 typedef vector<uint> DynamicOffsetList;
@@ -60,6 +63,7 @@ public:
     static constexpr uint MAX_CAPACITY = 1024;
     static InstancedBuffer *get(uint pass);
     static InstancedBuffer *get(uint pass, uint extraKey);
+    static void destroyInstancedBuffer();
 
     InstancedBuffer(const PassView *pass);
     virtual ~InstancedBuffer();
@@ -71,6 +75,7 @@ public:
     void setDynamicOffset(uint idx, uint value);
 
     CC_INLINE const InstancedItemList &getInstances() const { return _instances; }
+    CC_INLINE InstancedItemList &getInstances() { return _instances; }
     CC_INLINE const PassView *getPass() const { return _pass; }
     CC_INLINE bool hasPendingModels() const { return _hasPendingModels; }
     CC_INLINE const DynamicOffsetList &dynamicOffsets() const { return _dynamicOffsets; }
@@ -0,0 +1,262 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "OcclusionBuffer.h"
+#include "base/JobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+// clip w below this counts as touching the near plane
+constexpr float MIN_CLIP_W = 1e-5f;
+// candidates are tested against at most this many texels per axis of a pyramid level
+constexpr uint MAX_TEST_TEXELS = 4;
+
+struct ClipPos {
+    float x, y, z, w;
+};
+
+CC_INLINE ClipPos toClip(const Mat4 &mat, float x, float y, float z) {
+    const float *m = mat.m;
+    return {m[0] * x + m[4] * y + m[8] * z + m[12],
+            m[1] * x + m[5] * y + m[9] * z + m[13],
+            m[2] * x + m[6] * y + m[10] * z + m[14],
+            m[3] * x + m[7] * y + m[11] * z + m[15]};
+}
+
+CC_INLINE int clampInt(int value, int minValue, int maxValue) {
+    return std::min(std::max(value, minValue), maxValue);
+}
+} // namespace
+
+OcclusionBuffer::OcclusionBuffer(uint width, uint height)
+: _width(width),
+  _height(height) {
+    uint w = width;
+    uint h = height;
+    while (true) {
+        _levels.emplace_back(w * h, FLT_MAX);
+        _levelWidths.push_back(w);
+        _levelHeights.push_back(h);
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+void OcclusionBuffer::clear() {
+    _triangles.clear();
+    for (auto &level : _levels) {
+        std::fill(level.begin(), level.end(), FLT_MAX);
+    }
+}
+
+void OcclusionBuffer::addOccluder(const Mat4 &worldViewProj, const float *positions, const uint *indices, uint indexCount) {
+    const float halfWidth = _width * 0.5f;
+    const float halfHeight = _height * 0.5f;
+
+    for (uint i = 0; i + 2 < indexCount; i += 3) {
+        Triangle triangle;
+        float depth = -FLT_MAX;
+        bool clipped = false;
+        for (uint v = 0; v < 3; ++v) {
+            const float *p = positions + indices[i + v] * 3;
+            const ClipPos clip = toClip(worldViewProj, p[0], p[1], p[2]);
+            // dropping the triangle only loses occlusion, clipping it is not worth the cost
+            if (clip.w < MIN_CLIP_W) {
+                clipped = true;
+                break;
+            }
+            const float invW = 1.0f / clip.w;
+            triangle.x[v] = (clip.x * invW + 1.0f) * halfWidth;
+            triangle.y[v] = (clip.y * invW + 1.0f) * halfHeight;
+            depth = std::max(depth, clip.z * invW);
+        }
+        if (clipped) continue;
+
+        // keep a consistent winding so inside tests are all positive
+        const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                           (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+        if (area == 0.0f) continue;
+        if (area < 0.0f) {
+            std::swap(triangle.x[1], triangle.x[2]);
+            std::swap(triangle.y[1], triangle.y[2]);
+        }
+
+        // pixels are covered when their center is inside
+        const float minX = std::min(std::min(triangle.x[0], triangle.x[1]), triangle.x[2]);
+        const float maxX = std::max(std::max(triangle.x[0], triangle.x[1]), triangle.x[2]);
+        const float minY = std::min(std::min(triangle.y[0], triangle.y[1]), triangle.y[2]);
+        const float maxY = std::max(std::max(triangle.y[0], triangle.y[1]), triangle.y[2]);
+        if (maxX < 0.0f || maxY < 0.0f || minX > _width || minY > _height) continue;
+
+        triangle.minX = clampInt(static_cast<int>(std::ceil(minX - 0.5f)), 0, _width - 1);
+        triangle.maxX = clampInt(static_cast<int>(std::floor(maxX - 0.5f)), 0, _width - 1);
+        triangle.minY = clampInt(static_cast<int>(std::ceil(minY - 0.5f)), 0, _height - 1);
+        triangle.maxY = clampInt(static_cast<int>(std::floor(maxY - 0.5f)), 0, _height - 1);
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) continue;
+
+        triangle.depth = depth;
+        _triangles.push_back(triangle);
+    }
+}
+
+void OcclusionBuffer::rasterize(JobSystem *jobSystem) {
+    // bands own disjoint rows, so workers never touch the same texels
+    const uint bandCount = (_height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    if (jobSystem) {
+        jobSystem->parallelFor(0, bandCount, 1, [this](uint begin, uint end) {
+            for (uint band = begin; band < end; ++band) rasterizeBand(band);
+        });
+    } else {
+        for (uint band = 0; band < bandCount; ++band) rasterizeBand(band);
+    }
+
+    buildPyramid();
+}
+
+void OcclusionBuffer::rasterizeBand(uint band) {
+    const int bandMinY = static_cast<int>(band * BAND_HEIGHT);
+    const int bandMaxY = std::min(bandMinY + static_cast<int>(BAND_HEIGHT), static_cast<int>(_height)) - 1;
+    float *depthBuffer = _levels[0].data();
+
+    for (const Triangle &triangle : _triangles) {
+        const int minY = std::max(triangle.minY, bandMinY);
+        const int maxY = std::min(triangle.maxY, bandMaxY);
+        if (minY > maxY) continue;
+
+        // edge functions, stepping one pixel right adds the negated y delta of the edge
+        float stepX[3];
+        float stepY[3];
+        float rowStart[3];
+        const float startX = triangle.minX + 0.5f;
+        const float startY = minY + 0.5f;
+        for (uint e = 0; e < 3; ++e) {
+            const uint a = e;
+            const uint b = (e + 1) % 3;
+            stepX[e] = triangle.y[a] - triangle.y[b];
+            stepY[e] = triangle.x[b] - triangle.x[a];
+            rowStart[e] = (triangle.x[b] - triangle.x[a]) * (startY - triangle.y[a]) -
+                          (triangle.y[b] - triangle.y[a]) * (startX - triangle.x[a]);
+        }
+
+        const float depth = triangle.depth;
+        const int count = triangle.maxX - triangle.minX + 1;
+        for (int y = minY; y <= maxY; ++y) {
+            float *row = depthBuffer + y * _width + triangle.minX;
+            const float e0 = rowStart[0];
+            const float e1 = rowStart[1];
+            const float e2 = rowStart[2];
+            // branchless so compilers can vectorize the span
+            for (int x = 0; x < count; ++x) {
+                const bool inside = (e0 + stepX[0] * x) >= 0.0f &&
+                                    (e1 + stepX[1] * x) >= 0.0f &&
+                                    (e2 + stepX[2] * x) >= 0.0f;
+                row[x] = inside ? std::min(row[x], depth) : row[x];
+            }
+            rowStart[0] += stepY[0];
+            rowStart[1] += stepY[1];
+            rowStart[2] += stepY[2];
+        }
+    }
+}
+
+void OcclusionBuffer::buildPyramid() {
+    for (size_t l = 1; l < _levels.size(); ++l) {
+        const vector<float> &src = _levels[l - 1];
+        vector<float> &dst = _levels[l];
+        const uint srcWidth = _levelWidths[l - 1];
+        const uint srcHeight = _levelHeights[l - 1];
+        const uint dstWidth = _levelWidths[l];
+        const uint dstHeight = _levelHeights[l];
+        for (uint y = 0; y < dstHeight; ++y) {
+            const uint y0 = y * 2;
+            const uint y1 = std::min(y0 + 1, srcHeight - 1);
+            for (uint x = 0; x < dstWidth; ++x) {
+                const uint x0 = x * 2;
+                const uint x1 = std::min(x0 + 1, srcWidth - 1);
+                dst[y * dstWidth + x] = std::max(std::max(src[y0 * srcWidth + x0], src[y0 * srcWidth + x1]),
+                                                 std::max(src[y1 * srcWidth + x0], src[y1 * srcWidth + x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const Mat4 &viewProj, const Vec3 &minPos, const Vec3 &maxPos) const {
+    float minX = FLT_MAX;
+    float maxX = -FLT_MAX;
+    float minY = FLT_MAX;
+    float maxY = -FLT_MAX;
+    float minZ = FLT_MAX;
+    for (uint i = 0; i < 8; ++i) {
+        const ClipPos clip = toClip(viewProj, i & 1 ? maxPos.x : minPos.x, i & 2 ? maxPos.y : minPos.y, i & 4 ? maxPos.z : minPos.z);
+        if (clip.w < MIN_CLIP_W) return false; // reaches behind the camera
+        const float invW = 1.0f / clip.w;
+        const float x = clip.x * invW;
+        const float y = clip.y * invW;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, clip.z * invW);
+    }
+
+    minX = (minX + 1.0f) * 0.5f * _width;
+    maxX = (maxX + 1.0f) * 0.5f * _width;
+    minY = (minY + 1.0f) * 0.5f * _height;
+    maxY = (maxY + 1.0f) * 0.5f * _height;
+    // off screen candidates are the frustum test's business
+    if (maxX < 0.0f || maxY < 0.0f || minX > _width || minY > _height) return false;
+
+    int x0 = clampInt(static_cast<int>(std::floor(minX)), 0, _width - 1);
+    int x1 = clampInt(static_cast<int>(std::floor(maxX)), 0, _width - 1);
+    int y0 = clampInt(static_cast<int>(std::floor(minY)), 0, _height - 1);
+    int y1 = clampInt(static_cast<int>(std::floor(maxY)), 0, _height - 1);
+
+    // coarsen until the footprint is a handful of texels, every level is conservative
+    size_t level = 0;
+    while (level + 1 < _levels.size() && (x1 - x0 >= static_cast<int>(MAX_TEST_TEXELS) || y1 - y0 >= static_cast<int>(MAX_TEST_TEXELS))) {
+        x0 >>= 1;
+        x1 >>= 1;
+        y0 >>= 1;
+        y1 >>= 1;
+        ++level;
+    }
+
+    const vector<float> &depths = _levels[level];
+    const uint levelWidth = _levelWidths[level];
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            if (depths[y * levelWidth + x] >= minZ) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,76 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "core/CoreStd.h"
+#include "math/Mat4.h"
+
+namespace cc {
+class JobSystem;
+namespace pipeline {
+
+// Low resolution depth buffer rasterized on the CPU. Each occluder triangle writes its
+// farthest depth so the buffer never ends up in front of the real surface, candidates
+// are tested against a max-depth pyramid of it. Nothing is read back from the GPU.
+class CC_DLL OcclusionBuffer : public Object {
+public:
+    static constexpr uint BAND_HEIGHT = 16;
+
+    OcclusionBuffer(uint width = 256, uint height = 128);
+
+    void clear();
+    // positions are xyz triples, triangles crossing the near plane are dropped
+    void addOccluder(const Mat4 &worldViewProj, const float *positions, const uint *indices, uint indexCount);
+    // rasterizes the queued triangles in horizontal bands and rebuilds the depth pyramid
+    void rasterize(JobSystem *jobSystem = nullptr);
+    bool isOccluded(const Mat4 &viewProj, const Vec3 &minPos, const Vec3 &maxPos) const;
+
+    CC_INLINE uint getWidth() const { return _width; }
+    CC_INLINE uint getHeight() const { return _height; }
+    CC_INLINE uint getTriangleCount() const { return static_cast<uint>(_triangles.size()); }
+    CC_INLINE float getDepth(uint x, uint y) const { return _levels[0][y * _width + x]; }
+
+private:
+    struct Triangle {
+        float x[3];
+        float y[3];
+        float depth;
+        int minX, maxX;
+        int minY, maxY;
+    };
+
+    void rasterizeBand(uint band);
+    void buildPyramid();
+
+    uint _width = 0;
+    uint _height = 0;
+    vector<Triangle> _triangles;
+    // level 0 is the depth buffer, every next level keeps the max of 2x2 texels
+    vector<vector<float>> _levels;
+    vector<uint> _levelWidths;
+    vector<uint> _levelHeights;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,93 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "OcclusionCuller.h"
+#include "base/JobSystem.h"
+#include "helper/SharedMemory.h"
+
+namespace cc {
+namespace pipeline {
+
+void OcclusionCuller::setOccluder(uint modelID, const vector<float> &positions, const vector<uint> &indices) {
+    const uint vertexCount = static_cast<uint>(positions.size() / 3);
+    for (uint index : indices) {
+        if (index >= vertexCount) {
+            CC_LOG_WARNING("OcclusionCuller: occluder index %u out of range, model %u ignored.", index, modelID);
+            return;
+        }
+    }
+    removeDestroyedOccluders();
+    _occluders[modelID] = {positions, indices};
+}
+
+void OcclusionCuller::removeOccluder(uint modelID) {
+    _occluders.erase(modelID);
+}
+
+void OcclusionCuller::removeDestroyedOccluders() {
+    // the model pool resets freed entries, a live model always has its sub model array
+    for (auto iter = _occluders.begin(); iter != _occluders.end();) {
+        const auto model = GET_MODEL(iter->first);
+        if (!model || !model->subModelsID) {
+            iter = _occluders.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void OcclusionCuller::update(const Camera *camera) {
+    removeDestroyedOccluders();
+    _buffer.clear();
+    _viewProj = camera->matViewProj;
+
+    const auto visibility = camera->visibility;
+    Mat4 worldViewProj;
+    for (const auto &pair : _occluders) {
+        const auto model = GET_MODEL(pair.first);
+        if (!model || !model->enabled || !model->transformID) continue;
+
+        const auto node = model->getNode();
+        if (!((model->nodeID && ((visibility & node->layer) == node->layer)) || (visibility & model->visFlags))) continue;
+        if (model->worldBoundsID && !aabb_frustum(model->getWorldBounds(), camera->getFrustum())) continue;
+
+        Mat4::multiply(_viewProj, model->getTransform()->worldMatrix, &worldViewProj);
+        const Occluder &occluder = pair.second;
+        _buffer.addOccluder(worldViewProj, occluder.positions.data(), occluder.indices.data(), static_cast<uint>(occluder.indices.size()));
+    }
+
+    _buffer.rasterize(JobSystem::getInstance());
+}
+
+bool OcclusionCuller::isOccluded(uint modelID, const ModelView *model) const {
+    // occluders would only end up testing against themselves
+    if (!model->worldBoundsID || !_buffer.getTriangleCount() || _occluders.count(modelID)) return false;
+
+    Vec3 minPos;
+    Vec3 maxPos;
+    model->getWorldBounds()->getBoundary(minPos, maxPos);
+    return _buffer.isOccluded(_viewProj, minPos, maxPos);
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,61 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "OcclusionBuffer.h"
+
+namespace cc {
+namespace pipeline {
+struct Camera;
+struct ModelView;
+
+// Keeps the occluder meshes flagged on models and culls scene models behind them.
+class CC_DLL OcclusionCuller : public Object {
+public:
+    void setOccluder(uint modelID, const vector<float> &positions, const vector<uint> &indices);
+    void removeOccluder(uint modelID);
+    CC_INLINE void clearOccluders() { _occluders.clear(); }
+    // drops the occluders of destroyed models, the handle may be taken by a model that is no occluder
+    void removeDestroyedOccluders();
+
+    // rasterizes the occluders visible to the camera, called once before culling the models
+    void update(const Camera *camera);
+    // safe to call from several threads between updates
+    bool isOccluded(uint modelID, const ModelView *model) const;
+
+    CC_INLINE const OcclusionBuffer &getBuffer() const { return _buffer; }
+
+private:
+    struct Occluder {
+        vector<float> positions;
+        vector<uint> indices;
+    };
+
+    unordered_map<uint, Occluder> _occluders;
+    OcclusionBuffer _buffer;
+    Mat4 _viewProj;
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,206 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "PipelineProfiler.h"
+#include "base/StringUtil.h"
+#include "gfx/GFXCommandBuffer.h"
+#include "gfx/GFXDevice.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+constexpr uint NO_SLOT = ~0u;
+
+void appendEscaped(String &out, const String &str) {
+    for (char c : str) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            default: out += static_cast<unsigned char>(c) < 0x20 ? ' ' : c; break;
+        }
+    }
+}
+
+// trace event times are in microseconds
+void appendEvent(String &out, const String &name, uint tid, double start, double duration) {
+    out += ",\n{\"name\":\"";
+    appendEscaped(out, name);
+    out += StringUtil::Format("\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", tid, start * 1000.0, duration * 1000.0);
+}
+} // namespace
+
+constexpr uint PipelineProfiler::MAX_FRAMES;
+
+PipelineProfiler *PipelineProfiler::getInstance() {
+    static PipelineProfiler instance;
+    return &instance;
+}
+
+PipelineProfiler::PipelineProfiler()
+: _epoch(std::chrono::steady_clock::now()) {
+    _frames.resize(MAX_FRAMES);
+}
+
+void PipelineProfiler::setEnabled(bool enabled) {
+    // a frame in flight still ends normally so markers stay balanced
+    if (enabled && !_enabled) _frameCount = 0;
+    _enabled = enabled;
+}
+
+void PipelineProfiler::beginFrame(gfx::Device *device, gfx::CommandBuffer *cmdBuff) {
+    if (!_enabled || _inFrame) return;
+
+    _device = device;
+    _cmdBuff = cmdBuff;
+    _useTimestamps = device && cmdBuff && device->hasFeature(gfx::Feature::TIMESTAMP_QUERY);
+    resolveFrames();
+
+    ProfileFrame &frame = _frames[_head];
+    _head = (_head + 1) % MAX_FRAMES;
+    _frameCount = std::min(_frameCount + 1, MAX_FRAMES);
+
+    frame.frameIndex = device ? device->getFrameIndex() : 0u;
+    frame.cpuStart = now();
+    frame.cpuTime = 0.0;
+    frame.gpuTime = -1.0;
+    frame.gpuResolved = !_useTimestamps;
+    frame.samples.clear();
+
+    _inFrame = true;
+    _nextSlot = 0;
+    _openScopes.clear();
+    beginScope("Frame");
+}
+
+void PipelineProfiler::endFrame() {
+    if (!_inFrame) return;
+
+    while (!_openScopes.empty()) endScope();
+    ProfileFrame &frame = frameAt(_frameCount - 1);
+    frame.cpuTime = frame.samples[0].cpuEnd;
+    _inFrame = false;
+}
+
+void PipelineProfiler::beginScope(const String &name) {
+    if (!_inFrame) return;
+
+    ProfileFrame &frame = frameAt(_frameCount - 1);
+    frame.samples.emplace_back();
+    ProfileSample &sample = frame.samples.back();
+    sample.name = name;
+    sample.depth = static_cast<uint>(_openScopes.size());
+    sample.cpuBegin = sample.cpuEnd = now() - frame.cpuStart;
+
+    if (_cmdBuff) _cmdBuff->beginMarker(name);
+    if (_useTimestamps && _nextSlot + 2 <= gfx::Device::MAX_TIMESTAMPS) {
+        sample.slot = _nextSlot;
+        _cmdBuff->writeTimestamp(_nextSlot);
+        _nextSlot += 2;
+    }
+    _openScopes.push_back(static_cast<uint>(frame.samples.size() - 1));
+}
+
+void PipelineProfiler::endScope() {
+    if (!_inFrame || _openScopes.empty()) return;
+
+    ProfileFrame &frame = frameAt(_frameCount - 1);
+    ProfileSample &sample = frame.samples[_openScopes.back()];
+    _openScopes.pop_back();
+
+    if (sample.slot != NO_SLOT) _cmdBuff->writeTimestamp(sample.slot + 1);
+    if (_cmdBuff) _cmdBuff->endMarker();
+    sample.cpuEnd = now() - frame.cpuStart;
+}
+
+void PipelineProfiler::resolveFrames() {
+    if (!_device) return;
+
+    uint64_t nanoseconds[gfx::Device::MAX_TIMESTAMPS];
+    const uint64_t currentFrame = _device->getFrameIndex();
+    for (uint i = 0; i < _frameCount; ++i) {
+        ProfileFrame &frame = frameAt(i);
+        if (frame.gpuResolved) continue;
+
+        if (_device->getTimestamps(frame.frameIndex, nanoseconds, gfx::Device::MAX_TIMESTAMPS)) {
+            // GPU times are relative to the frame scope, slot 0
+            const uint64_t origin = nanoseconds[0];
+            for (ProfileSample &sample : frame.samples) {
+                if (sample.slot == NO_SLOT || !origin) continue;
+                const uint64_t begin = nanoseconds[sample.slot];
+                const uint64_t end = nanoseconds[sample.slot + 1];
+                if (begin < origin || end < begin) continue;
+                sample.gpuBegin = static_cast<double>(begin - origin) * 1e-6;
+                sample.gpuEnd = static_cast<double>(end - origin) * 1e-6;
+            }
+            frame.gpuTime = frame.samples[0].gpuEnd;
+            frame.gpuResolved = true;
+        } else if (currentFrame > frame.frameIndex + 2 * gfx::Device::TIMESTAMP_HISTORY) {
+            // the backend dropped the results, e.g. on a disjoint timer event
+            frame.gpuResolved = true;
+        }
+    }
+}
+
+const ProfileFrame *PipelineProfiler::getLastFrame() const {
+    for (uint i = _frameCount; i > 0; --i) {
+        if (_inFrame && i == _frameCount) continue;
+        const ProfileFrame &frame = getFrame(i - 1);
+        if (frame.gpuResolved) return &frame;
+    }
+    return nullptr;
+}
+
+String PipelineProfiler::exportChromeTrace() const {
+    String out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    const uint frameCount = _inFrame ? _frameCount - 1 : _frameCount;
+    for (uint i = 0; i < frameCount; ++i) {
+        const ProfileFrame &frame = getFrame(i);
+        for (const ProfileSample &sample : frame.samples) {
+            appendEvent(out, sample.name, 1, frame.cpuStart + sample.cpuBegin, sample.cpuEnd - sample.cpuBegin);
+        }
+        // the GPU clock is not calibrated against the CPU one, GPU spans start with their frame
+        for (const ProfileSample &sample : frame.samples) {
+            if (sample.gpuBegin < 0.0) continue;
+            appendEvent(out, sample.name, 2, frame.cpuStart + sample.gpuBegin, sample.gpuEnd - sample.gpuBegin);
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool PipelineProfiler::saveChromeTrace(const String &path) const {
+    return FileUtils::getInstance()->writeStringToFile(exportChromeTrace(), path);
+}
+
+double PipelineProfiler::now() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,117 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "core/CoreStd.h"
+
+#include <chrono>
+
+namespace cc {
+namespace gfx {
+class CommandBuffer;
+class Device;
+} // namespace gfx
+
+namespace pipeline {
+
+// Times are in milliseconds relative to the beginning of the frame,
+// GPU times stay negative until the timestamps arrive or when they are not supported.
+struct CC_DLL ProfileSample {
+    String name;
+    uint depth = 0;
+    double cpuBegin = 0.0;
+    double cpuEnd = 0.0;
+    double gpuBegin = -1.0;
+    double gpuEnd = -1.0;
+    uint slot = ~0u; // first of the two timestamp slots, ~0u if none was left
+};
+
+struct CC_DLL ProfileFrame {
+    uint64_t frameIndex = 0;
+    double cpuStart = 0.0; // milliseconds since the profiler was created
+    double cpuTime = 0.0;
+    double gpuTime = -1.0;
+    bool gpuResolved = false;
+    vector<ProfileSample> samples;
+};
+
+// Per frame CPU and GPU timings of the pipeline scopes. Scopes nest, wrap the same span of
+// the command buffer with debug markers and must be recorded on the thread rendering the frame.
+// GPU results are resolved a few frames late, see gfx::Device::getTimestamps.
+class CC_DLL PipelineProfiler : public Object {
+public:
+    static constexpr uint MAX_FRAMES = 120;
+
+    static PipelineProfiler *getInstance();
+
+    PipelineProfiler();
+
+    void setEnabled(bool enabled);
+    CC_INLINE bool isEnabled() const { return _enabled; }
+
+    // the device may be null, which only records CPU times
+    void beginFrame(gfx::Device *device, gfx::CommandBuffer *cmdBuff);
+    void endFrame();
+    void beginScope(const String &name);
+    void endScope();
+
+    // most recent frame with its GPU times resolved, nullptr if there is none yet
+    const ProfileFrame *getLastFrame() const;
+    // frames are kept from oldest to newest
+    uint getFrameCount() const { return _frameCount; }
+    const ProfileFrame &getFrame(uint index) const { return _frames[(_head + MAX_FRAMES - _frameCount + index) % MAX_FRAMES]; }
+
+    // the recorded history in the Chrome trace event format, for chrome://tracing or Perfetto
+    String exportChromeTrace() const;
+    bool saveChromeTrace(const String &path) const;
+
+private:
+    CC_INLINE ProfileFrame &frameAt(uint index) { return _frames[(_head + MAX_FRAMES - _frameCount + index) % MAX_FRAMES]; }
+    double now() const;
+    void resolveFrames();
+
+    bool _enabled = false;
+    bool _inFrame = false;
+    gfx::Device *_device = nullptr;
+    gfx::CommandBuffer *_cmdBuff = nullptr;
+    bool _useTimestamps = false;
+    uint _nextSlot = 0;
+    vector<uint> _openScopes;
+
+    std::chrono::steady_clock::time_point _epoch;
+    vector<ProfileFrame> _frames;
+    uint _head = 0;
+    uint _frameCount = 0;
+};
+
+class CC_DLL ProfileScope {
+public:
+    explicit ProfileScope(const String &name) { PipelineProfiler::getInstance()->beginScope(name); }
+    ~ProfileScope() { PipelineProfiler::getInstance()->endScope(); }
+};
+
+#define CC_PROFILE_SCOPE(name) ::cc::pipeline::ProfileScope __profileScope(name)
+
+} // namespace pipeline
+} // namespace cc
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "PipelineStateManager.h"
 #include "gfx/GFXDevice.h"
 #include "gfx/GFXInputAssembler.h"
+#include "gfx/GFXPipelineState.h"
 #include "gfx/GFXRenderPass.h"
 #include "gfx/GFXShader.h"
 #include "helper/SharedMemory.h"
@@ -71,5 +72,12 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineStateByJS(uint32_t
     return PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass);
 }
 
+void PipelineStateManager::destroyAll() {
+    for (auto &pair : _PSOHashMap) {
+        CC_SAFE_DESTROY(pair.second);
+    }
+    _PSOHashMap.clear();
+}
+
 } // namespace pipeline
 } // namespace cc
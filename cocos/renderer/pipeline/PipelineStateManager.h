@@ -45,6 +45,7 @@ public:
                                                             gfx::Shader *shader,
                                                             gfx::InputAssembler *inputAssembler,
                                                             gfx::RenderPass *renderPass);
+    static void destroyAll();
 
 private:
     static map<uint, gfx::PipelineState *> _PSOHashMap;
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include <array>
+#include <climits>
 
 #include "BatchedBuffer.h"
 #include "InstancedBuffer.h"
@@ -60,7 +61,6 @@ namespace {
 RenderAdditiveLightQueue::RenderAdditiveLightQueue(RenderPipeline *pipeline) : _pipeline(static_cast<ForwardPipeline *>(pipeline)),
                                                                                _instancedQueue(CC_NEW(RenderInstancedQueue)),
                                                                                _batchedQueue(CC_NEW(RenderBatchedQueue)) {
-    _renderObjects = _pipeline->getRenderObjects();
     _fpScale = _pipeline->getFpScale();
     _isHDR = _pipeline->isHDR();
     auto *device = gfx::Device::getInstance();
@@ -108,7 +108,7 @@ void RenderAdditiveLightQueue::recordCommandBuffer(gfx::Device *device, gfx::Ren
         const auto pass = lightPass.pass;
         const auto &dynamicOffsets = lightPass.dynamicOffsets;
         auto *shader = lightPass.shader;
-        const auto lights = lightPass.lights;
+        const auto &lights = lightPass.lights;
         auto *ia = subModel->getInputAssembler();
         auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
         auto *descriptorSet = subModel->getDescriptorSet();
@@ -169,7 +169,11 @@ void RenderAdditiveLightQueue::gatherLightPasses(const Camera *camera, gfx::Comm
             addRenderQueue(pass, subModel, model, lightPassIdx);
         }
     }
-    _instancedQueue->uploadBuffers(cmdBufferer);
+    if (auto culler = _pipeline->getGPUInstanceCuller()) {
+        _instancedQueue->uploadBuffers(cmdBufferer, culler, camera->getFrustum());
+    } else {
+        _instancedQueue->uploadBuffers(cmdBufferer);
+    }
     _batchedQueue->uploadBuffers(cmdBufferer);
 }
 
@@ -191,11 +195,6 @@ void RenderAdditiveLightQueue::clear() {
     _instancedQueue->clear();
     _batchedQueue->clear();
     _validLights.clear();
-
-    for (auto lightPass : _lightPasses) {
-        lightPass.dynamicOffsets.clear();
-        lightPass.lights.clear();
-    }
     _lightPasses.clear();
 }
 
@@ -46,8 +46,8 @@ struct AdditiveLightPass {
     const SubModelView *subModel = nullptr;
     const PassView *pass = nullptr;
     gfx::Shader *shader = nullptr;
-    vector<uint> dynamicOffsets;
-    vector<const Light *> lights;
+    FrameVector<uint> dynamicOffsets;
+    FrameVector<const Light *> lights;
 };
 
 class RenderAdditiveLightQueue : public Object {
@@ -78,7 +78,6 @@ private:
     vector<const Light *> _validLights;
     vector<uint> _lightIndices;
     vector<AdditiveLightPass> _lightPasses;
-    vector<RenderObject> _renderObjects;
     vector<uint> _dynamicOffsets;
     vector<float> _lightBufferData;
     RenderInstancedQueue *_instancedQueue = nullptr;
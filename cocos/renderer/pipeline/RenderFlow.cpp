@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "RenderFlow.h"
+#include "PipelineProfiler.h"
 #include "RenderStage.h"
 
 namespace cc {
@@ -50,8 +51,10 @@ void RenderFlow::activate(RenderPipeline *pipeline) {
 }
 
 void RenderFlow::render(Camera *camera) {
-    for (const auto stage : _stages)
+    for (const auto stage : _stages) {
+        CC_PROFILE_SCOPE(stage->getName());
         stage->render(camera);
+    }
 }
 
 void RenderFlow::destroy() {
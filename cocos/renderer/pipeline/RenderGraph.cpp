@@ -0,0 +1,623 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "RenderGraph.h"
+#include "RenderTargetPool.h"
+#include "gfx/GFXCommandBuffer.h"
+#include "gfx/GFXDevice.h"
+#include "gfx/GFXFramebuffer.h"
+#include "gfx/GFXRenderPass.h"
+#include "gfx/GFXTexture.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+bool isSameRenderPass(const gfx::RenderPassInfo &lhs, const gfx::RenderPassInfo &rhs) {
+    if (lhs.colorAttachments.size() != rhs.colorAttachments.size()) return false;
+    for (size_t i = 0; i < lhs.colorAttachments.size(); ++i) {
+        const auto &a = lhs.colorAttachments[i];
+        const auto &b = rhs.colorAttachments[i];
+        if (a.format != b.format || a.sampleCount != b.sampleCount || a.loadOp != b.loadOp || a.storeOp != b.storeOp ||
+            a.beginLayout != b.beginLayout || a.endLayout != b.endLayout) {
+            return false;
+        }
+    }
+    const auto &a = lhs.depthStencilAttachment;
+    const auto &b = rhs.depthStencilAttachment;
+    return a.format == b.format && a.sampleCount == b.sampleCount &&
+           a.depthLoadOp == b.depthLoadOp && a.depthStoreOp == b.depthStoreOp &&
+           a.stencilLoadOp == b.stencilLoadOp && a.stencilStoreOp == b.stencilStoreOp &&
+           a.beginLayout == b.beginLayout && a.endLayout == b.endLayout;
+}
+
+bool isAttachmentAccess(gfx::AccessType access) {
+    return access == gfx::AccessType::COLOR_ATTACHMENT_READ ||
+           access == gfx::AccessType::COLOR_ATTACHMENT_WRITE ||
+           access == gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_READ ||
+           access == gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE;
+}
+
+void addUnique(gfx::AccessTypeList &list, gfx::AccessType access) {
+    if (std::find(list.begin(), list.end(), access) == list.end()) {
+        list.push_back(access);
+    }
+}
+} // namespace
+
+constexpr RenderGraphHandle RenderGraph::INVALID_HANDLE;
+
+gfx::Texture *RenderGraphContext::getTexture(RenderGraphHandle handle) const {
+    return graph->getTexture(handle);
+}
+
+void RenderGraphBuilder::read(RenderGraphHandle texture, gfx::AccessType access) {
+    _graph->_passes[_pass].reads.push_back({texture, access});
+}
+
+void RenderGraphBuilder::write(RenderGraphHandle texture, gfx::AccessType access) {
+    _graph->_passes[_pass].writes.push_back({texture, access});
+}
+
+void RenderGraphBuilder::writeColor(RenderGraphHandle texture, gfx::LoadOp loadOp, const gfx::Color &clearColor) {
+    auto &pass = _graph->_passes[_pass];
+    pass.colors.push_back({texture, loadOp});
+    pass.clearColors.push_back(clearColor);
+    if (loadOp == gfx::LoadOp::LOAD) {
+        pass.reads.push_back({texture, gfx::AccessType::COLOR_ATTACHMENT_READ});
+    }
+    pass.writes.push_back({texture, gfx::AccessType::COLOR_ATTACHMENT_WRITE});
+}
+
+void RenderGraphBuilder::writeDepthStencil(RenderGraphHandle texture, gfx::LoadOp loadOp, float clearDepth, int clearStencil) {
+    auto &pass = _graph->_passes[_pass];
+    pass.depthStencil = {texture, loadOp};
+    pass.clearDepth = clearDepth;
+    pass.clearStencil = clearStencil;
+    if (loadOp == gfx::LoadOp::LOAD) {
+        pass.reads.push_back({texture, gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_READ});
+    }
+    pass.writes.push_back({texture, gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE});
+}
+
+void RenderGraphBuilder::setRenderArea(const gfx::Rect &area) {
+    _graph->_passes[_pass].renderArea = area;
+}
+
+void RenderGraphBuilder::sideEffect() {
+    _graph->_passes[_pass].sideEffect = true;
+}
+
+RenderGraph::RenderGraph(gfx::Device *device, RenderTargetPool *pool)
+: _device(device),
+  _pool(pool) {
+}
+
+RenderGraph::~RenderGraph() {
+    destroy();
+}
+
+RenderGraphHandle RenderGraph::createTexture(const String &name, const gfx::TextureInfo &info) {
+    Resource resource;
+    resource.name = name;
+    resource.info = info;
+    resource.usage = info.usage;
+    _resources.push_back(resource);
+    _compiled = false;
+    return static_cast<RenderGraphHandle>(_resources.size() - 1);
+}
+
+RenderGraphHandle RenderGraph::importTexture(const String &name, gfx::Texture *texture, gfx::TextureLayout layout) {
+    Resource resource;
+    resource.name = name;
+    resource.texture = texture;
+    resource.importLayout = layout;
+    resource.imported = true;
+    if (texture) {
+        resource.info = {
+            texture->getType(),
+            texture->getUsage(),
+            texture->getFormat(),
+            texture->getWidth(),
+            texture->getHeight(),
+            texture->getFlags(),
+            texture->getLayerCount(),
+            texture->getLevelCount(),
+            texture->getSamples(),
+            texture->getDepth(),
+        };
+    }
+    _resources.push_back(resource);
+    _compiled = false;
+    return static_cast<RenderGraphHandle>(_resources.size() - 1);
+}
+
+uint RenderGraph::addPass(const String &name, const SetupFunc &setup, const ExecuteFunc &execute) {
+    const uint index = static_cast<uint>(_passes.size());
+    _passes.emplace_back();
+    _passes.back().name = name;
+    _passes.back().execute = execute;
+
+    RenderGraphBuilder builder(this, index);
+    setup(builder);
+    _compiled = false;
+    return index;
+}
+
+void RenderGraph::compile() {
+    cullPasses();
+    computeLifetimes();
+    mergePasses();
+    buildRenderPasses();
+    buildBarriers();
+    _compiled = true;
+}
+
+void RenderGraph::cullPasses() {
+    for (auto &resource : _resources) {
+        // whatever lands in an imported texture is consumed outside of the graph
+        resource.readerCount = resource.imported ? 1 : 0;
+    }
+    for (auto &pass : _passes) {
+        pass.culled = false;
+        pass.refCount = static_cast<uint>(pass.writes.size());
+        for (const auto &read : pass.reads) {
+            ++_resources[read.handle].readerCount;
+        }
+    }
+
+    vector<RenderGraphHandle> unused;
+    auto cull = [&](Pass &pass) {
+        pass.culled = true;
+        for (const auto &read : pass.reads) {
+            if (!--_resources[read.handle].readerCount) {
+                unused.push_back(read.handle);
+            }
+        }
+    };
+
+    for (auto &pass : _passes) {
+        if (!pass.refCount && !pass.sideEffect) cull(pass);
+    }
+    for (uint i = 0; i < _resources.size(); ++i) {
+        if (!_resources[i].readerCount) unused.push_back(i);
+    }
+
+    while (!unused.empty()) {
+        const RenderGraphHandle handle = unused.back();
+        unused.pop_back();
+        for (auto &pass : _passes) {
+            if (pass.culled || pass.sideEffect) continue;
+            for (const auto &write : pass.writes) {
+                if (write.handle == handle && !--pass.refCount) {
+                    cull(pass);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void RenderGraph::computeLifetimes() {
+    vector<gfx::TextureUsage> usages(_resources.size(), gfx::TextureUsageBit::NONE);
+    for (auto &resource : _resources) {
+        resource.firstPass = INVALID_HANDLE;
+        resource.lastPass = INVALID_HANDLE;
+    }
+
+    for (uint i = 0; i < _passes.size(); ++i) {
+        const auto &pass = _passes[i];
+        if (pass.culled) continue;
+        for (const auto *accesses : {&pass.reads, &pass.writes}) {
+            for (const auto &access : *accesses) {
+                auto &resource = _resources[access.handle];
+                if (resource.firstPass == INVALID_HANDLE) resource.firstPass = i;
+                resource.lastPass = i;
+                usages[access.handle] |= getUsage(access.type);
+            }
+        }
+    }
+
+    for (uint i = 0; i < _resources.size(); ++i) {
+        auto &resource = _resources[i];
+        if (!resource.imported) resource.info.usage = resource.usage | usages[i];
+    }
+}
+
+bool RenderGraph::canMerge(const Pass &prev, const Pass &next) const {
+    if (prev.colors.size() != next.colors.size() || prev.depthStencil.handle != next.depthStencil.handle) return false;
+    for (size_t i = 0; i < next.colors.size(); ++i) {
+        if (prev.colors[i].handle != next.colors[i].handle || next.colors[i].loadOp != gfx::LoadOp::LOAD) return false;
+    }
+    if (next.depthStencil.handle != INVALID_HANDLE && next.depthStencil.loadOp != gfx::LoadOp::LOAD) return false;
+
+    // anything but the shared attachments needs the render pass to end first
+    for (const auto &write : next.writes) {
+        if (!isAttachmentAccess(write.type)) return false;
+    }
+    const uint first = prev.group;
+    const uint last = static_cast<uint>(&next - _passes.data());
+    for (const auto &read : next.reads) {
+        if (isAttachmentAccess(read.type)) continue;
+        for (uint i = first; i < last; ++i) {
+            if (_passes[i].culled) continue;
+            for (const auto &write : _passes[i].writes) {
+                if (write.handle == read.handle) return false;
+            }
+        }
+    }
+    return true;
+}
+
+void RenderGraph::mergePasses() {
+    _renderPassCount = 0;
+    const Pass *prev = nullptr;
+    for (uint i = 0; i < _passes.size(); ++i) {
+        auto &pass = _passes[i];
+        pass.group = i;
+        pass.groupEnd = i;
+        if (pass.culled) continue;
+
+        if (!hasAttachments(pass)) {
+            prev = nullptr;
+            continue;
+        }
+        if (prev && canMerge(*prev, pass)) {
+            pass.group = prev->group;
+        } else {
+            ++_renderPassCount;
+        }
+        _passes[pass.group].groupEnd = i;
+        prev = &pass;
+    }
+    for (auto &pass : _passes) {
+        pass.groupEnd = _passes[pass.group].groupEnd;
+    }
+
+    // attachments living inside a single render pass never need to reach memory
+    const gfx::TextureUsage memoryUsage = gfx::TextureUsageBit::SAMPLED |
+                                          gfx::TextureUsageBit::STORAGE |
+                                          gfx::TextureUsageBit::TRANSFER_SRC |
+                                          gfx::TextureUsageBit::TRANSFER_DST;
+    for (auto &resource : _resources) {
+        resource.transient = !resource.imported && resource.firstPass != INVALID_HANDLE &&
+                             _passes[resource.firstPass].group == _passes[resource.lastPass].group &&
+                             hasAttachments(_passes[resource.firstPass]) &&
+                             !(resource.info.usage & memoryUsage);
+        if (resource.transient) resource.info.usage |= gfx::TextureUsageBit::TRANSIENT_ATTACHMENT;
+    }
+}
+
+gfx::TextureLayout RenderGraph::getLayoutAfter(RenderGraphHandle handle, uint pass) const {
+    for (uint i = pass + 1; i < _passes.size(); ++i) {
+        if (_passes[i].culled) continue;
+        for (const auto *accesses : {&_passes[i].reads, &_passes[i].writes}) {
+            for (const auto &access : *accesses) {
+                if (access.handle == handle) return getLayout(access.type);
+            }
+        }
+    }
+    const auto &resource = _resources[handle];
+    if (resource.imported && resource.importLayout != gfx::TextureLayout::UNDEFINED) {
+        return resource.importLayout;
+    }
+    return gfx::GFX_FORMAT_INFOS[(uint)resource.info.format].hasDepth ? gfx::TextureLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+                                                                  : gfx::TextureLayout::COLOR_ATTACHMENT_OPTIMAL;
+}
+
+void RenderGraph::buildRenderPasses() {
+    auto getBeginLayout = [&](const Attachment &attachment, uint pass, gfx::TextureLayout layout) {
+        if (attachment.loadOp != gfx::LoadOp::LOAD) return gfx::TextureLayout::UNDEFINED;
+        const auto &resource = _resources[attachment.handle];
+        // the previous render pass already left it in the attachment layout
+        if (resource.firstPass < pass) return layout;
+        return resource.imported ? resource.importLayout : gfx::TextureLayout::UNDEFINED;
+    };
+    auto getStoreOp = [&](const Attachment &attachment, uint groupEnd) {
+        const auto &resource = _resources[attachment.handle];
+        return resource.imported || resource.lastPass > groupEnd ? gfx::StoreOp::STORE : gfx::StoreOp::DISCARD;
+    };
+
+    for (uint i = 0; i < _passes.size(); ++i) {
+        auto &pass = _passes[i];
+        pass.renderPassInfo = {};
+        if (pass.culled || pass.group != i || !hasAttachments(pass)) continue;
+
+        for (const auto &attachment : pass.colors) {
+            const auto &info = _resources[attachment.handle].info;
+            gfx::ColorAttachment color;
+            color.format = info.format;
+            color.sampleCount = 1u << static_cast<uint>(info.samples);
+            color.loadOp = attachment.loadOp;
+            color.storeOp = getStoreOp(attachment, pass.groupEnd);
+            color.beginLayout = getBeginLayout(attachment, i, gfx::TextureLayout::COLOR_ATTACHMENT_OPTIMAL);
+            color.endLayout = getLayoutAfter(attachment.handle, pass.groupEnd);
+            pass.renderPassInfo.colorAttachments.push_back(color);
+        }
+
+        auto &depthStencil = pass.renderPassInfo.depthStencilAttachment;
+        if (pass.depthStencil.handle != INVALID_HANDLE) {
+            const auto &info = _resources[pass.depthStencil.handle].info;
+            depthStencil.format = info.format;
+            depthStencil.sampleCount = 1u << static_cast<uint>(info.samples);
+            depthStencil.depthLoadOp = depthStencil.stencilLoadOp = pass.depthStencil.loadOp;
+            depthStencil.depthStoreOp = depthStencil.stencilStoreOp = getStoreOp(pass.depthStencil, pass.groupEnd);
+            depthStencil.beginLayout = getBeginLayout(pass.depthStencil, i, gfx::TextureLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+            depthStencil.endLayout = getLayoutAfter(pass.depthStencil.handle, pass.groupEnd);
+        } else {
+            depthStencil.format = gfx::Format::UNKNOWN;
+        }
+    }
+}
+
+void RenderGraph::buildBarriers() {
+    vector<gfx::AccessType> lastAccesses(_resources.size(), gfx::AccessType::NONE);
+    for (uint i = 0; i < _passes.size(); ++i) {
+        auto &pass = _passes[i];
+        pass.barrier.prevAccesses.clear();
+        pass.barrier.nextAccesses.clear();
+        if (pass.culled) continue;
+
+        // merged passes only share attachments, the hazards are all resolved before the render pass
+        auto &barrier = _passes[pass.group].barrier;
+        for (const auto *accesses : {&pass.reads, &pass.writes}) {
+            for (const auto &access : *accesses) {
+                const gfx::AccessType prev = lastAccesses[access.handle];
+                if (needsBarrier(prev, access.type)) {
+                    addUnique(barrier.prevAccesses, prev);
+                    addUnique(barrier.nextAccesses, access.type);
+                }
+            }
+        }
+        for (const auto &read : pass.reads) {
+            lastAccesses[read.handle] = read.type;
+        }
+        for (const auto &write : pass.writes) {
+            lastAccesses[write.handle] = write.type;
+        }
+    }
+}
+
+void RenderGraph::execute(gfx::CommandBuffer *cmdBuffer) {
+    if (!_compiled) compile();
+
+    // pooled textures carry the hazards of the resources they backed before
+    unordered_map<gfx::Texture *, gfx::AccessType> textureAccesses;
+    RenderGraphContext context;
+    context.cmdBuffer = cmdBuffer;
+    context.graph = this;
+
+    for (uint i = 0; i < _passes.size(); ++i) {
+        auto &pass = _passes[i];
+        if (pass.culled) continue;
+
+        if (pass.group == i) {
+            gfx::GlobalBarrier barrier = pass.barrier;
+            for (auto &resource : _resources) {
+                if (resource.imported || resource.firstPass < i || resource.firstPass > pass.groupEnd) continue;
+                resource.texture = _pool->acquire(resource.info);
+                auto iter = textureAccesses.find(resource.texture);
+                if (iter == textureAccesses.end()) continue;
+
+                const auto &firstPass = _passes[resource.firstPass];
+                const RenderGraphHandle handle = static_cast<RenderGraphHandle>(&resource - _resources.data());
+                for (const auto *accesses : {&firstPass.reads, &firstPass.writes}) {
+                    for (const auto &access : *accesses) {
+                        if (access.handle == handle && needsBarrier(iter->second, access.type)) {
+                            addUnique(barrier.prevAccesses, iter->second);
+                            addUnique(barrier.nextAccesses, access.type);
+                        }
+                    }
+                }
+            }
+            if (!barrier.prevAccesses.empty()) {
+                cmdBuffer->pipelineBarrier(&barrier);
+            }
+
+            if (hasAttachments(pass)) {
+                gfx::FramebufferInfo framebufferInfo;
+                framebufferInfo.renderPass = getOrCreateRenderPass(pass.renderPassInfo);
+                for (const auto &attachment : pass.colors) {
+                    framebufferInfo.colorTextures.push_back(_resources[attachment.handle].texture);
+                }
+                if (pass.depthStencil.handle != INVALID_HANDLE) {
+                    framebufferInfo.depthStencilTexture = _resources[pass.depthStencil.handle].texture;
+                }
+                auto *framebuffer = getOrCreateFramebuffer(framebufferInfo);
+
+                gfx::Rect renderArea = pass.renderArea;
+                if (!renderArea.width || !renderArea.height) {
+                    const auto *target = pass.colors.empty() ? framebufferInfo.depthStencilTexture : framebufferInfo.colorTextures[0];
+                    renderArea = {0, 0, target ? target->getWidth() : 1u, target ? target->getHeight() : 1u};
+                }
+                cmdBuffer->beginRenderPass(framebufferInfo.renderPass, framebuffer, renderArea,
+                                           pass.clearColors, pass.clearDepth, pass.clearStencil);
+                context.renderPass = framebufferInfo.renderPass;
+                context.framebuffer = framebuffer;
+            }
+        }
+
+        pass.execute(context);
+
+        if (pass.groupEnd == i && context.renderPass) {
+            cmdBuffer->endRenderPass();
+            context.renderPass = nullptr;
+            context.framebuffer = nullptr;
+        }
+
+        for (const auto *accesses : {&pass.reads, &pass.writes}) {
+            for (const auto &access : *accesses) {
+                auto *texture = _resources[access.handle].texture;
+                if (texture) textureAccesses[texture] = access.type;
+            }
+        }
+        for (auto &resource : _resources) {
+            if (!resource.imported && resource.lastPass == i) {
+                _pool->release(resource.texture);
+                resource.texture = nullptr;
+            }
+        }
+    }
+}
+
+void RenderGraph::reset() {
+    _passes.clear();
+    _resources.clear();
+    _renderPassCount = 0;
+    _compiled = false;
+}
+
+void RenderGraph::destroy() {
+    reset();
+    destroyFramebuffers();
+    for (auto &pair : _renderPasses) {
+        pair.second->destroy();
+        CC_DELETE(pair.second);
+    }
+    _renderPasses.clear();
+}
+
+gfx::RenderPass *RenderGraph::getOrCreateRenderPass(const gfx::RenderPassInfo &info) {
+    for (const auto &pair : _renderPasses) {
+        if (isSameRenderPass(pair.first, info)) return pair.second;
+    }
+    auto *renderPass = _device->createRenderPass(info);
+    _renderPasses.emplace_back(info, renderPass);
+    return renderPass;
+}
+
+gfx::Framebuffer *RenderGraph::getOrCreateFramebuffer(const gfx::FramebufferInfo &info) {
+    // a texture destroyed by the pool may come back at the same address, the cached ones can't be trusted then
+    if (_pool->getGeneration() != _poolGeneration) {
+        destroyFramebuffers();
+        _poolGeneration = _pool->getGeneration();
+    }
+    for (const auto &pair : _framebuffers) {
+        if (pair.first.renderPass == info.renderPass &&
+            pair.first.colorTextures == info.colorTextures &&
+            pair.first.depthStencilTexture == info.depthStencilTexture) {
+            return pair.second;
+        }
+    }
+    auto *framebuffer = _device->createFramebuffer(info);
+    _framebuffers.emplace_back(info, framebuffer);
+    return framebuffer;
+}
+
+void RenderGraph::invalidateTexture(const gfx::Texture *texture) {
+    for (uint i = 0; i < _framebuffers.size();) {
+        const auto &info = _framebuffers[i].first;
+        const auto &colors = info.colorTextures;
+        if (info.depthStencilTexture == texture || std::find(colors.begin(), colors.end(), texture) != colors.end()) {
+            _framebuffers[i].second->destroy();
+            CC_DELETE(_framebuffers[i].second);
+            _framebuffers.erase(_framebuffers.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void RenderGraph::destroyFramebuffers() {
+    for (auto &pair : _framebuffers) {
+        pair.second->destroy();
+        CC_DELETE(pair.second);
+    }
+    _framebuffers.clear();
+}
+
+bool RenderGraph::isWrite(gfx::AccessType access) {
+    return access >= gfx::AccessType::VERTEX_SHADER_WRITE && access < gfx::AccessType::COUNT;
+}
+
+bool RenderGraph::needsBarrier(gfx::AccessType prev, gfx::AccessType next) {
+    if (prev == gfx::AccessType::NONE || (!isWrite(prev) && !isWrite(next))) return false;
+
+    // the external dependencies of the render passes cover these
+    switch (prev) {
+        case gfx::AccessType::COLOR_ATTACHMENT_WRITE:
+            return next != gfx::AccessType::COLOR_ATTACHMENT_READ &&
+                   next != gfx::AccessType::COLOR_ATTACHMENT_WRITE &&
+                   next != gfx::AccessType::FRAGMENT_SHADER_READ_TEXTURE;
+        case gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE:
+            return next != gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_READ &&
+                   next != gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE;
+        case gfx::AccessType::FRAGMENT_SHADER_READ_TEXTURE:
+            return next != gfx::AccessType::COLOR_ATTACHMENT_WRITE;
+        default:
+            return true;
+    }
+}
+
+gfx::TextureLayout RenderGraph::getLayout(gfx::AccessType access) {
+    switch (access) {
+        case gfx::AccessType::COLOR_ATTACHMENT_READ:
+        case gfx::AccessType::COLOR_ATTACHMENT_WRITE:
+            return gfx::TextureLayout::COLOR_ATTACHMENT_OPTIMAL;
+        case gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_READ:
+        case gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE:
+            return gfx::TextureLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        case gfx::AccessType::VERTEX_SHADER_READ_TEXTURE:
+        case gfx::AccessType::FRAGMENT_SHADER_READ_TEXTURE:
+        case gfx::AccessType::COMPUTE_SHADER_READ_TEXTURE:
+            return gfx::TextureLayout::SHADER_READONLY_OPTIMAL;
+        case gfx::AccessType::TRANSFER_READ:
+            return gfx::TextureLayout::TRANSFER_SRC_OPTIMAL;
+        case gfx::AccessType::TRANSFER_WRITE:
+            return gfx::TextureLayout::TRANSFER_DST_OPTIMAL;
+        case gfx::AccessType::PRESENT:
+            return gfx::TextureLayout::PRESENT_SRC;
+        default:
+            return gfx::TextureLayout::GENERAL;
+    }
+}
+
+gfx::TextureUsage RenderGraph::getUsage(gfx::AccessType access) {
+    switch (access) {
+        case gfx::AccessType::COLOR_ATTACHMENT_READ:
+        case gfx::AccessType::COLOR_ATTACHMENT_WRITE:
+            return gfx::TextureUsageBit::COLOR_ATTACHMENT;
+        case gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_READ:
+        case gfx::AccessType::DEPTH_STENCIL_ATTACHMENT_WRITE:
+            return gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT;
+        case gfx::AccessType::VERTEX_SHADER_READ_TEXTURE:
+        case gfx::AccessType::FRAGMENT_SHADER_READ_TEXTURE:
+        case gfx::AccessType::COMPUTE_SHADER_READ_TEXTURE:
+            return gfx::TextureUsageBit::SAMPLED;
+        case gfx::AccessType::VERTEX_SHADER_READ_OTHER:
+        case gfx::AccessType::FRAGMENT_SHADER_READ_OTHER:
+        case gfx::AccessType::COMPUTE_SHADER_READ_OTHER:
+        case gfx::AccessType::VERTEX_SHADER_WRITE:
+        case gfx::AccessType::FRAGMENT_SHADER_WRITE:
+        case gfx::AccessType::COMPUTE_SHADER_WRITE:
+            return gfx::TextureUsageBit::STORAGE;
+        case gfx::AccessType::TRANSFER_READ:
+            return gfx::TextureUsageBit::TRANSFER_SRC;
+        case gfx::AccessType::TRANSFER_WRITE:
+            return gfx::TextureUsageBit::TRANSFER_DST;
+        default:
+            return gfx::TextureUsageBit::NONE;
+    }
+}
+
+} // namespace pipeline
+} // namespace cc
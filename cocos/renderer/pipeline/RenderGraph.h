@@ -0,0 +1,203 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "core/CoreStd.h"
+#include "gfx/GFXDef.h"
+
+#include <functional>
+
+namespace cc {
+namespace gfx {
+class CommandBuffer;
+class Device;
+class Framebuffer;
+class RenderPass;
+class Texture;
+} // namespace gfx
+
+namespace pipeline {
+
+class RenderGraph;
+class RenderTargetPool;
+
+typedef uint RenderGraphHandle;
+
+struct CC_DLL RenderGraphContext {
+    gfx::CommandBuffer *cmdBuffer = nullptr;
+    // both stay null for passes without attachments
+    gfx::RenderPass *renderPass = nullptr;
+    gfx::Framebuffer *framebuffer = nullptr;
+    const RenderGraph *graph = nullptr;
+
+    gfx::Texture *getTexture(RenderGraphHandle handle) const;
+};
+
+// Declares what a pass reads and writes while it is being added to the graph.
+class CC_DLL RenderGraphBuilder {
+public:
+    void read(RenderGraphHandle texture, gfx::AccessType access = gfx::AccessType::FRAGMENT_SHADER_READ_TEXTURE);
+    void write(RenderGraphHandle texture, gfx::AccessType access);
+    // attachments of the render pass begun for the pass, LOAD also reads the previous content
+    void writeColor(RenderGraphHandle texture, gfx::LoadOp loadOp = gfx::LoadOp::CLEAR, const gfx::Color &clearColor = {});
+    void writeDepthStencil(RenderGraphHandle texture, gfx::LoadOp loadOp = gfx::LoadOp::CLEAR, float clearDepth = 1.0f, int clearStencil = 0);
+    // defaults to the whole attachment, merged passes use the area of the first one
+    void setRenderArea(const gfx::Rect &area);
+    // keeps the pass alive even if none of its outputs is consumed
+    void sideEffect();
+
+private:
+    friend class RenderGraph;
+    RenderGraphBuilder(RenderGraph *graph, uint pass) : _graph(graph), _pass(pass) {}
+
+    RenderGraph *_graph = nullptr;
+    uint _pass = 0;
+};
+
+// A frame graph over virtual textures. Passes are recorded in declaration order, so every
+// read has to refer to a texture written by an earlier pass or imported into the graph.
+// Compiling the graph
+// - culls the passes whose outputs are never consumed, writes to imported textures count as consumed,
+// - computes the lifetime of the graph owned textures, they are acquired from the render target
+//   pool right before their first use and returned right after their last one, so textures
+//   with disjoint lifetimes alias the same allocation,
+// - flags attachments which never leave a single render pass as transient and discards them,
+// - merges consecutive passes loading the same attachments into one render pass,
+// - collects the barriers needed between passes, skipping the hazards the render pass
+//   dependencies already cover.
+// Framebuffers are cached by their attachments across executions and dropped once the pool
+// destroys any of its textures. Imported textures are not tracked by the pool, their owners
+// have to invalidate them before destroying or resizing them.
+class CC_DLL RenderGraph : public Object {
+public:
+    typedef std::function<void(RenderGraphBuilder &)> SetupFunc;
+    typedef std::function<void(const RenderGraphContext &)> ExecuteFunc;
+
+    static constexpr RenderGraphHandle INVALID_HANDLE = ~0u;
+
+    RenderGraph(gfx::Device *device, RenderTargetPool *pool);
+    ~RenderGraph();
+
+    // the usage of the texture is derived from the declared accesses
+    RenderGraphHandle createTexture(const String &name, const gfx::TextureInfo &info);
+    // layout is the one the texture is in outside of the graph
+    RenderGraphHandle importTexture(const String &name, gfx::Texture *texture, gfx::TextureLayout layout = gfx::TextureLayout::UNDEFINED);
+    uint addPass(const String &name, const SetupFunc &setup, const ExecuteFunc &execute);
+    // drops the cached framebuffers referring to an imported texture about to be destroyed or resized
+    void invalidateTexture(const gfx::Texture *texture);
+
+    void compile();
+    void execute(gfx::CommandBuffer *cmdBuffer);
+    // drops the passes and textures declared for the frame
+    void reset();
+    void destroy();
+
+    CC_INLINE uint getPassCount() const { return static_cast<uint>(_passes.size()); }
+    CC_INLINE bool isPassCulled(uint pass) const { return _passes[pass].culled; }
+    // index of the first pass of the render pass the pass got merged into
+    CC_INLINE uint getPassGroup(uint pass) const { return _passes[pass].group; }
+    CC_INLINE const gfx::GlobalBarrier &getPassBarrier(uint pass) const { return _passes[pass].barrier; }
+    CC_INLINE uint getRenderPassCount() const { return _renderPassCount; }
+    CC_INLINE bool isTransient(RenderGraphHandle handle) const { return _resources[handle].transient; }
+    CC_INLINE const gfx::TextureInfo &getTextureInfo(RenderGraphHandle handle) const { return _resources[handle].info; }
+    CC_INLINE gfx::Texture *getTexture(RenderGraphHandle handle) const { return _resources[handle].texture; }
+    CC_INLINE uint getFramebufferCount() const { return static_cast<uint>(_framebuffers.size()); }
+
+private:
+    friend class RenderGraphBuilder;
+
+    struct Resource {
+        String name;
+        gfx::TextureInfo info;
+        gfx::TextureUsage usage = gfx::TextureUsageBit::NONE; // declared by the creator
+        gfx::Texture *texture = nullptr;
+        gfx::TextureLayout importLayout = gfx::TextureLayout::UNDEFINED;
+        bool imported = false;
+        bool transient = false;
+        uint readerCount = 0;
+        uint firstPass = INVALID_HANDLE;
+        uint lastPass = INVALID_HANDLE;
+    };
+
+    struct Access {
+        RenderGraphHandle handle = INVALID_HANDLE;
+        gfx::AccessType type = gfx::AccessType::NONE;
+    };
+
+    struct Attachment {
+        RenderGraphHandle handle = INVALID_HANDLE;
+        gfx::LoadOp loadOp = gfx::LoadOp::CLEAR;
+    };
+
+    struct Pass {
+        String name;
+        ExecuteFunc execute;
+        vector<Access> reads;
+        vector<Access> writes;
+        vector<Attachment> colors;
+        Attachment depthStencil;
+        gfx::ColorList clearColors;
+        float clearDepth = 1.0f;
+        int clearStencil = 0;
+        gfx::Rect renderArea;
+        bool sideEffect = false;
+        bool culled = false;
+        uint refCount = 0;
+        uint group = 0;
+        uint groupEnd = 0;
+        gfx::RenderPassInfo renderPassInfo;
+        gfx::GlobalBarrier barrier;
+    };
+
+    static bool isWrite(gfx::AccessType access);
+    static bool needsBarrier(gfx::AccessType prev, gfx::AccessType next);
+    static gfx::TextureLayout getLayout(gfx::AccessType access);
+    static gfx::TextureUsage getUsage(gfx::AccessType access);
+
+    CC_INLINE bool hasAttachments(const Pass &pass) const { return !pass.colors.empty() || pass.depthStencil.handle != INVALID_HANDLE; }
+    void cullPasses();
+    void computeLifetimes();
+    void mergePasses();
+    bool canMerge(const Pass &prev, const Pass &next) const;
+    void buildRenderPasses();
+    gfx::TextureLayout getLayoutAfter(RenderGraphHandle handle, uint pass) const;
+    void buildBarriers();
+    gfx::RenderPass *getOrCreateRenderPass(const gfx::RenderPassInfo &info);
+    gfx::Framebuffer *getOrCreateFramebuffer(const gfx::FramebufferInfo &info);
+    void destroyFramebuffers();
+
+    gfx::Device *_device = nullptr;
+    RenderTargetPool *_pool = nullptr;
+    vector<Resource> _resources;
+    vector<Pass> _passes;
+    uint _renderPassCount = 0;
+    bool _compiled = false;
+
+    vector<std::pair<gfx::RenderPassInfo, gfx::RenderPass *>> _renderPasses;
+    vector<std::pair<gfx::FramebufferInfo, gfx::Framebuffer *>> _framebuffers;
+    uint _poolGeneration = 0;
+};
+
+} // namespace pipeline
+} // namespace cc
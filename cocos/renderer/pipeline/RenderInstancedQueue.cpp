@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "RenderInstancedQueue.h"
+#include "GPUInstanceCuller.h"
 #include "InstancedBuffer.h"
 #include "PipelineStateManager.h"
 #include "gfx/GFXCommandBuffer.h"
@@ -35,6 +36,7 @@ void RenderInstancedQueue::clear() {
         it->clear();
     }
     _queues.clear();
+    _culler = nullptr;
 }
 
 void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
@@ -45,6 +47,19 @@ void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
     }
 }
 
+void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer, GPUInstanceCuller *culler, const Frustum *frustum) {
+    _culledQueues.clear();
+    for (auto instanceBuffer : _queues) {
+        if (instanceBuffer->hasPendingModels()) {
+            _culledQueues.emplace_back(instanceBuffer);
+        }
+    }
+    if (_culledQueues.empty()) return;
+
+    culler->cull(cmdBuffer, frustum, _culledQueues);
+    _culler = culler;
+}
+
 void RenderInstancedQueue::recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
     for (auto instanceBuffer : _queues) {
         if (!instanceBuffer->hasPendingModels()) continue;
@@ -58,14 +73,16 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device *device, gfx::RenderP
             if (!instance.count) {
                 continue;
             }
-            auto pso = PipelineStateManager::getOrCreatePipelineState(pass, instance.shader, instance.ia, renderPass);
+            // culled batches draw the compacted instances with the count left by the culling pass
+            auto ia = _culler && instance.cullData ? instance.cullData->ia : instance.ia;
+            auto pso = PipelineStateManager::getOrCreatePipelineState(pass, instance.shader, ia, renderPass);
             if (lastPSO != pso) {
                 cmdBuffer->bindPipelineState(pso);
                 lastPSO = pso;
             }
             cmdBuffer->bindDescriptorSet(LOCAL_SET, instance.descriptorSet, instanceBuffer->dynamicOffsets());
-            cmdBuffer->bindInputAssembler(instance.ia);
-            cmdBuffer->draw(instance.ia);
+            cmdBuffer->bindInputAssembler(ia);
+            cmdBuffer->draw(ia);
         }
     }
 }
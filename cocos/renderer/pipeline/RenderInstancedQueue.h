@@ -29,6 +29,8 @@ namespace cc {
 namespace pipeline {
 
 class InstancedBuffer;
+class GPUInstanceCuller;
+struct Frustum;
 
 class CC_DLL RenderInstancedQueue : public Object {
 public:
@@ -38,10 +40,13 @@ public:
     void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer);
     void add(InstancedBuffer *instancedBuffer);
     void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
+    void uploadBuffers(gfx::CommandBuffer *cmdBuffer, GPUInstanceCuller *culler, const Frustum *frustum);
     void clear();
 
 private:
     unordered_set<InstancedBuffer *> _queues;
+    vector<InstancedBuffer *> _culledQueues;
+    GPUInstanceCuller *_culler = nullptr;
 };
 
 } // namespace pipeline
@@ -0,0 +1,170 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "RenderTargetPool.h"
+#include "gfx/GFXDevice.h"
+#include "gfx/GFXTexture.h"
+
+namespace cc {
+namespace pipeline {
+
+constexpr uint RenderTargetPool::EVICT_AFTER_FRAMES;
+
+RenderTargetPool::RenderTargetPool(gfx::Device *device)
+: _device(device) {
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    destroy();
+}
+
+bool RenderTargetPool::isCompatible(const gfx::TextureInfo &lhs, const gfx::TextureInfo &rhs) {
+    return lhs.type == rhs.type &&
+           lhs.usage == rhs.usage &&
+           lhs.format == rhs.format &&
+           lhs.width == rhs.width &&
+           lhs.height == rhs.height &&
+           lhs.flags == rhs.flags &&
+           lhs.layerCount == rhs.layerCount &&
+           lhs.levelCount == rhs.levelCount &&
+           lhs.samples == rhs.samples &&
+           lhs.depth == rhs.depth;
+}
+
+gfx::Texture *RenderTargetPool::acquire(const gfx::TextureInfo &info) {
+    for (auto &entry : _entries) {
+        if (!entry.transient && !entry.refCount && isCompatible(entry.info, info)) {
+            entry.refCount = 1;
+            entry.lastUsedFrame = _frame;
+            return entry.texture;
+        }
+    }
+    return allocate(info, false);
+}
+
+gfx::Texture *RenderTargetPool::acquireTransient(const gfx::TextureInfo &info) {
+    const gfx::TextureUsage otherUsage = gfx::TextureUsageBit::TRANSFER_SRC |
+                                         gfx::TextureUsageBit::TRANSFER_DST |
+                                         gfx::TextureUsageBit::SAMPLED |
+                                         gfx::TextureUsageBit::STORAGE;
+    if (info.usage & otherUsage) {
+        CC_LOG_ERROR("RenderTargetPool: transient targets can only be used as attachments.");
+        return acquire(info);
+    }
+
+    gfx::TextureInfo transientInfo = info;
+    transientInfo.usage |= gfx::TextureUsageBit::TRANSIENT_ATTACHMENT;
+    for (auto &entry : _entries) {
+        if (entry.transient && isCompatible(entry.info, transientInfo)) {
+            ++entry.refCount;
+            entry.lastUsedFrame = _frame;
+            return entry.texture;
+        }
+    }
+    return allocate(transientInfo, true);
+}
+
+void RenderTargetPool::release(gfx::Texture *texture) {
+    for (auto &entry : _entries) {
+        if (entry.texture == texture) {
+            if (entry.refCount) --entry.refCount;
+            entry.lastUsedFrame = _frame;
+            return;
+        }
+    }
+    CC_LOG_WARNING("RenderTargetPool: releasing a texture the pool does not own.");
+}
+
+void RenderTargetPool::update() {
+    ++_frame;
+    for (uint i = 0; i < _entries.size();) {
+        const auto &entry = _entries[i];
+        if (!entry.refCount && _frame - entry.lastUsedFrame > EVICT_AFTER_FRAMES) {
+            destroyEntry(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void RenderTargetPool::destroy() {
+    for (auto &entry : _entries) {
+        entry.texture->destroy();
+        CC_DELETE(entry.texture);
+    }
+    _entries.clear();
+    _allocatedSize = 0;
+    ++_generation;
+}
+
+gfx::Texture *RenderTargetPool::allocate(const gfx::TextureInfo &info, bool transient) {
+    const uint size = gfx::FormatSize(info.format, info.width, info.height, info.depth) *
+                      info.layerCount * (1u << static_cast<uint>(info.samples)); // SampleCount::X1 is 0
+    if (_budget && _allocatedSize + size > _budget) {
+        evict(size);
+        if (_allocatedSize + size > _budget && !_overBudgetReported) {
+            CC_LOG_WARNING("RenderTargetPool: %u bytes of render targets exceed the budget of %u bytes.", _allocatedSize + size, _budget);
+            _overBudgetReported = true;
+        }
+    }
+
+    Entry entry;
+    entry.texture = _device->createTexture(info);
+    entry.info = info;
+    entry.size = size;
+    entry.refCount = 1;
+    entry.lastUsedFrame = _frame;
+    entry.transient = transient;
+    _entries.push_back(entry);
+
+    _allocatedSize += size;
+    _peakSize = std::max(_peakSize, _allocatedSize);
+    return entry.texture;
+}
+
+void RenderTargetPool::evict(uint size) {
+    // least recently used first, until the new target fits
+    while (_allocatedSize + size > _budget) {
+        uint oldest = static_cast<uint>(_entries.size());
+        for (uint i = 0; i < _entries.size(); ++i) {
+            const auto &entry = _entries[i];
+            if (!entry.refCount && (oldest == _entries.size() || entry.lastUsedFrame < _entries[oldest].lastUsedFrame)) {
+                oldest = i;
+            }
+        }
+        if (oldest == _entries.size()) break;
+        destroyEntry(oldest);
+    }
+}
+
+void RenderTargetPool::destroyEntry(uint index) {
+    auto &entry = _entries[index];
+    _allocatedSize -= entry.size;
+    entry.texture->destroy();
+    CC_DELETE(entry.texture);
+    _entries.erase(_entries.begin() + index);
+    ++_generation;
+}
+
+} // namespace pipeline
+} // namespace cc
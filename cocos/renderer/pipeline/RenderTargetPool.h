@@ -0,0 +1,94 @@
+/****************************************************************************
+Copyright (c) 2020 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "core/CoreStd.h"
+#include "gfx/GFXDef.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+class Texture;
+} // namespace gfx
+namespace pipeline {
+
+// Hands out render targets by descriptor so passes with matching attachments share
+// one allocation instead of creating their own. Released textures stay cached until
+// they are reused or have been idle for EVICT_AFTER_FRAMES frames.
+// Transient targets are attachment-only scratch buffers whose content never outlives
+// a render pass, holders of the same descriptor alias the very same texture, and the
+// backends may keep them in tile memory without any physical backing at all.
+class CC_DLL RenderTargetPool : public Object {
+public:
+    static constexpr uint EVICT_AFTER_FRAMES = 8;
+
+    RenderTargetPool(gfx::Device *device);
+    ~RenderTargetPool();
+
+    // the texture belongs to the caller until it is released
+    gfx::Texture *acquire(const gfx::TextureInfo &info);
+    // the texture is shared with every other holder of the same descriptor
+    gfx::Texture *acquireTransient(const gfx::TextureInfo &info);
+    void release(gfx::Texture *texture);
+    // call once per frame, evicts the textures idle for too long
+    void update();
+    void destroy();
+
+    // 0 means unlimited, going over budget evicts idle textures first
+    CC_INLINE void setBudget(uint bytes) { _budget = bytes; }
+    CC_INLINE uint getBudget() const { return _budget; }
+    CC_INLINE uint getAllocatedSize() const { return _allocatedSize; }
+    CC_INLINE uint getPeakSize() const { return _peakSize; }
+    CC_INLINE uint getTextureCount() const { return static_cast<uint>(_entries.size()); }
+    // changes whenever a texture is destroyed, objects referring to pooled textures may be stale then
+    CC_INLINE uint getGeneration() const { return _generation; }
+
+private:
+    struct Entry {
+        gfx::Texture *texture = nullptr;
+        gfx::TextureInfo info;
+        uint size = 0;
+        uint refCount = 0;
+        uint lastUsedFrame = 0;
+        bool transient = false;
+    };
+
+    static bool isCompatible(const gfx::TextureInfo &lhs, const gfx::TextureInfo &rhs);
+
+    gfx::Texture *allocate(const gfx::TextureInfo &info, bool transient);
+    void evict(uint size);
+    void destroyEntry(uint index);
+
+    gfx::Device *_device = nullptr;
+    vector<Entry> _entries;
+    uint _frame = 0;
+    uint _budget = 0;
+    uint _allocatedSize = 0;
+    uint _peakSize = 0;
+    uint _generation = 0;
+    bool _overBudgetReported = false;
+};
+
+} // namespace pipeline
+} // namespace cc
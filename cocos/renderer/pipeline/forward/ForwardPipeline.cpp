@@ -22,9 +22,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "ForwardPipeline.h"
+#include "../BatchedBuffer.h"
+#include "../GPUInstanceCuller.h"
+#include "../OcclusionCuller.h"
+#include "../InstancedBuffer.h"
+#include "../PipelineProfiler.h"
+#include "../PipelineStateManager.h"
+#include "../RenderGraph.h"
+#include "../RenderTargetPool.h"
 #include "../shadow/ShadowFlow.h"
 #include "ForwardFlow.h"
 #include "SceneCulling.h"
+#include "base/memory/AllocProfiler.h"
 #include "gfx/GFXBuffer.h"
 #include "gfx/GFXCommandBuffer.h"
 #include "gfx/GFXDescriptorSet.h"
@@ -87,6 +96,38 @@ gfx::RenderPass *ForwardPipeline::getOrCreateRenderPass(gfx::ClearFlags clearFla
     return renderPass;
 }
 
+void ForwardPipeline::setGPUInstanceCulling(bool enabled) {
+    // the culler stays alive once created, culled batches keep descriptor sets of its layout
+    if (enabled && !_gpuInstanceCuller) {
+        _gpuInstanceCuller = CC_NEW(GPUInstanceCuller(_device));
+        if (!_gpuInstanceCuller->initialize()) {
+            CC_SAFE_DESTROY(_gpuInstanceCuller);
+        }
+    }
+    _gpuInstanceCulling = enabled && _gpuInstanceCuller;
+}
+
+void ForwardPipeline::setOcclusionCulling(bool enabled) {
+    if (enabled && !_occlusionCuller) {
+        _occlusionCuller = CC_NEW(OcclusionCuller);
+    }
+    _occlusionCulling = enabled;
+}
+
+void ForwardPipeline::setOccluder(uint modelID, const vector<float> &positions, const vector<uint> &indices) {
+    // occluders can be registered before the culling gets enabled
+    if (!_occlusionCuller) {
+        _occlusionCuller = CC_NEW(OcclusionCuller);
+    }
+    _occlusionCuller->setOccluder(modelID, positions, indices);
+}
+
+void ForwardPipeline::removeOccluder(uint modelID) {
+    if (_occlusionCuller) {
+        _occlusionCuller->removeOccluder(modelID);
+    }
+}
+
 void ForwardPipeline::setFog(uint fog) {
     _fog = GET_FOG(fog);
 }
@@ -103,8 +144,21 @@ void ForwardPipeline::setShadows(uint shadows) {
     _shadows = GET_SHADOWS(shadows);
 }
 
+void ForwardPipeline::setRenderTargetBudget(uint bytes) {
+    // may be called before initialize creates the pool
+    _renderTargetBudget = bytes;
+    if (_renderTargetPool) _renderTargetPool->setBudget(bytes);
+}
+
 void ForwardPipeline::destroyShadowFrameBuffers() {
     for (auto &pair : _shadowFrameBufferMap) {
+        // the attachments are pooled and may be shared by other framebuffers
+        for (auto *texture : pair.second->getColorTextures()) {
+            _renderTargetPool->release(texture);
+        }
+        if (pair.second->getDepthStencilTexture()) {
+            _renderTargetPool->release(pair.second->getDepthStencilTexture());
+        }
         pair.second->destroy();
         delete pair.second;
     }
@@ -124,6 +178,11 @@ bool ForwardPipeline::initialize(const RenderPipelineInfo &info) {
         _flows.emplace_back(forwardFlow);
     }
     _sphere = CC_NEW(Sphere);
+    if (!_renderTargetPool) {
+        _renderTargetPool = CC_NEW(RenderTargetPool(_device));
+        _renderTargetPool->setBudget(_renderTargetBudget);
+        _renderGraph = CC_NEW(RenderGraph(_device, _renderTargetPool));
+    }
 
     return true;
 }
@@ -143,17 +202,40 @@ bool ForwardPipeline::activate() {
 }
 
 void ForwardPipeline::render(const vector<uint> &cameras) {
+    CC_MEM_TAG_SCOPE(PIPELINE);
+    auto *profiler = PipelineProfiler::getInstance();
     _commandBuffers[0]->begin();
+    profiler->beginFrame(_device, _commandBuffers[0]);
+    _renderTargetPool->update();
     updateGlobalUBO();
     for (const auto cameraId : cameras) {
         Camera *camera = GET_CAMERA(cameraId);
         updateCameraUBO(camera);
         for (const auto flow : _flows) {
-            flow->render(camera);
+            // stages declare their graph passes while the flow renders, they run before the next flow
+            _renderGraph->reset();
+            {
+                CC_PROFILE_SCOPE(flow->getName());
+                flow->render(camera);
+            }
+            if (_renderGraph->getPassCount()) {
+                CC_PROFILE_SCOPE("RenderGraph");
+                _renderGraph->compile();
+                _renderGraph->execute(_commandBuffers[0]);
+            }
         }
     }
+    profiler->endFrame();
     _commandBuffers[0]->end();
-    _device->getQueue()->submit(_commandBuffers);
+    {
+        CC_MEM_TAG_SCOPE(GFX);
+        _device->getQueue()->submit(_commandBuffers);
+    }
+
+    // frame memory is recycled below, drop the lists pointing into it
+    _renderObjects = RenderObjectList();
+    _shadowObjects = RenderObjectList();
+    FrameAllocator::resetAll();
 }
 
 void ForwardPipeline::updateCameraUBO(Camera *camera) {
@@ -413,9 +495,22 @@ void ForwardPipeline::destroy() {
 
     CC_SAFE_DELETE(_sphere);
 
-    _shadowFrameBufferMap.clear();
+    destroyShadowFrameBuffers();
+
+    // the cached batches and PSOs point at objects owned by this pipeline's scene
+    InstancedBuffer::destroyInstancedBuffer();
+    BatchedBuffer::destroyBatchedBuffer();
+    PipelineStateManager::destroyAll();
+    CC_SAFE_DESTROY(_gpuInstanceCuller);
+    _gpuInstanceCulling = false;
+    CC_SAFE_DELETE(_occlusionCuller);
+    _occlusionCulling = false;
 
     RenderPipeline::destroy();
+
+    // the flows release their targets while being destroyed
+    CC_SAFE_DESTROY(_renderGraph);
+    CC_SAFE_DESTROY(_renderTargetPool);
 }
 
 } // namespace pipeline
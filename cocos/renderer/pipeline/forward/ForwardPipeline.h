@@ -40,6 +40,10 @@ struct Shadows;
 struct Sphere;
 struct Camera;
 class Framebuffer;
+class GPUInstanceCuller;
+class OcclusionCuller;
+class RenderGraph;
+class RenderTargetPool;
 
 class CC_DLL ForwardPipeline : public RenderPipeline {
 public:
@@ -55,6 +59,13 @@ public:
     void updateCameraUBO(Camera *camera);
     void updateShadowUBO(Camera *camera);
     CC_INLINE void setHDR(bool isHDR) { _isHDR = isHDR; }
+    void setGPUInstanceCulling(bool enabled);
+    void setOcclusionCulling(bool enabled);
+    // positions are model space xyz triples of a simplified mesh hiding what is behind the model
+    void setOccluder(uint modelID, const vector<float> &positions, const vector<uint> &indices);
+    void removeOccluder(uint modelID);
+    // 0 lifts the limit, the pool evicts idle render targets to stay below it
+    void setRenderTargetBudget(uint bytes);
 
     gfx::RenderPass *getOrCreateRenderPass(gfx::ClearFlags clearFlags);
     void setFog(uint);
@@ -81,6 +92,10 @@ public:
     CC_INLINE const Skybox *getSkybox() const { return _skybox; }
     CC_INLINE Shadows *getShadows() const { return _shadows; }
     CC_INLINE Sphere *getSphere() const { return _sphere; }
+    CC_INLINE GPUInstanceCuller *getGPUInstanceCuller() const { return _gpuInstanceCulling ? _gpuInstanceCuller : nullptr; }
+    CC_INLINE OcclusionCuller *getOcclusionCuller() const { return _occlusionCulling ? _occlusionCuller : nullptr; }
+    CC_INLINE RenderTargetPool *getRenderTargetPool() const { return _renderTargetPool; }
+    CC_INLINE RenderGraph *getRenderGraph() const { return _renderGraph; }
     CC_INLINE std::array<float, UBOShadow::COUNT> getShadowUBO() const { return _shadowUBO; }
 
     CC_INLINE void setRenderObjects(RenderObjectList &&ro) { _renderObjects = std::forward<RenderObjectList>(ro); }
@@ -107,9 +122,16 @@ private:
     std::array<float, UBOCamera::COUNT> _cameraUBO;
     std::array<float, UBOShadow::COUNT> _shadowUBO;
     Sphere *_sphere = nullptr;
+    GPUInstanceCuller *_gpuInstanceCuller = nullptr;
+    OcclusionCuller *_occlusionCuller = nullptr;
+    RenderTargetPool *_renderTargetPool = nullptr;
+    RenderGraph *_renderGraph = nullptr;
 
     float _shadingScale = 1.0f;
+    uint _renderTargetBudget = 0;
     bool _isHDR = false;
+    bool _gpuInstanceCulling = false;
+    bool _occlusionCulling = false;
     float _fpScale = 1.0f / 1024.0f;
 
     std::unordered_map<const Light *, gfx::Framebuffer *> _shadowFrameBufferMap;
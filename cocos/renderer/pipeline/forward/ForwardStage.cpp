@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "ForwardStage.h"
 #include "../BatchedBuffer.h"
 #include "../InstancedBuffer.h"
+#include "../PipelineProfiler.h"
 #include "../PlanarShadowQueue.h"
 #include "../RenderAdditiveLightQueue.h"
 #include "../RenderBatchedQueue.h"
@@ -159,7 +160,11 @@ void ForwardStage::render(Camera *camera) {
 
     auto cmdBuff = pipeline->getCommandBuffers()[0];
 
-    _instancedQueue->uploadBuffers(cmdBuff);
+    if (auto culler = pipeline->getGPUInstanceCuller()) {
+        _instancedQueue->uploadBuffers(cmdBuff, culler, camera->getFrustum());
+    } else {
+        _instancedQueue->uploadBuffers(cmdBuff);
+    }
     _batchedQueue->uploadBuffers(cmdBuff);
     _additiveLightQueue->gatherLightPasses(camera, cmdBuff);
     _planarShadowQueue->gatherShadowPasses(camera, cmdBuff);
@@ -202,7 +207,10 @@ void ForwardStage::render(Camera *camera) {
     _additiveLightQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
     _planarShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
     _renderQueues[1]->recordCommandBuffer(_device, renderPass, cmdBuff);
-    _uiPhase->render(camera, renderPass);
+    {
+        CC_PROFILE_SCOPE("UIPhase");
+        _uiPhase->render(camera, renderPass);
+    }
     
     cmdBuff->endRenderPass();
 }
@@ -25,9 +25,11 @@ THE SOFTWARE.
 #include <vector>
 
 #include "../Define.h"
+#include "../OcclusionCuller.h"
 #include "../helper/SharedMemory.h"
 #include "ForwardPipeline.h"
 #include "SceneCulling.h"
+#include "base/JobSystem.h"
 #include "gfx/GFXBuffer.h"
 #include "gfx/GFXDescriptorSet.h"
 #include "math/Quaternion.h"
@@ -38,6 +40,26 @@ namespace pipeline {
 bool castBoundsInitialized = false;
 AABB castWorldBounds;
 
+namespace {
+// below this the cost of waking workers outweighs the culling itself
+constexpr uint PARALLEL_CULLING_THRESHOLD = 512;
+constexpr uint CULLING_CHUNK_SIZE = 128;
+
+// models drawn only through instanced passes are tested per instance by the GPU instance culler
+bool isInstancedOnly(const ModelView *model) {
+    const auto subModelID = model->getSubModelID();
+    const auto subModelCount = subModelID ? subModelID[0] : 0;
+    if (!subModelCount) return false;
+    for (uint m = 1; m <= subModelCount; ++m) {
+        const auto subModel = model->getSubModelView(subModelID[m]);
+        for (uint p = 0; p < subModel->passCount; ++p) {
+            if (subModel->getPassView(p)->getBatchingScheme() != BatchingSchemes::INSTANCING) return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
 RenderObject genRenderObject(const ModelView *model, const Camera *camera) {
     float depth = 0;
     if (model->nodeID) {
@@ -138,7 +160,7 @@ void updateDirLight(Shadows *shadows, const Light *light, std::array<float, UBOS
 
 void lightCollecting(Camera *camera, std::vector<const Light *> &validLights) {
     validLights.clear();
-    auto *sphere = CC_NEW(Sphere);
+    Sphere sphere;
     const auto scene = camera->getScene();
     const Light *mainLight = nullptr;
     if (scene->mainLightID) mainLight = scene->getMainLight();
@@ -148,14 +170,12 @@ void lightCollecting(Camera *camera, std::vector<const Light *> &validLights) {
     const auto count = spotLightArrayID ? spotLightArrayID[0] : 0;
     for (uint32_t i = 1; i <= count; ++i) {
         const auto *spotLight = scene->getSpotLight(spotLightArrayID[i]);
-        sphere->center.set(spotLight->position);
-        sphere->radius = spotLight->range;
-        if (sphere->interset(*camera->getFrustum())) {
+        sphere.center.set(spotLight->position);
+        sphere.radius = spotLight->range;
+        if (sphere.interset(*camera->getFrustum())) {
             validLights.emplace_back(spotLight);
         }
     }
-
-    CC_SAFE_DELETE(sphere);
 }
 
 void shadowCollecting(ForwardPipeline *pipeline, Camera *camera) {
@@ -209,24 +229,54 @@ void sceneCulling(ForwardPipeline *pipeline, Camera *camera) {
 
     const auto models = scene->getModels();
     const auto modelCount = models[0];
-    for (size_t i = 1; i <= modelCount; i++) {
-        const auto model = scene->getModelView(models[i]);
+    const bool gpuInstanceCulling = pipeline->getGPUInstanceCuller() != nullptr;
+    OcclusionCuller *occlusionCuller = pipeline->getOcclusionCuller();
+    if (occlusionCuller) {
+        occlusionCuller->update(camera);
+    }
+    auto cullModels = [&](uint begin, uint end, RenderObjectList &objects) {
+        for (uint i = begin; i < end; i++) {
+            const auto model = scene->getModelView(models[i]);
+
+            // filter model by view visibility
+            if (model->enabled) {
+                const auto visibility = camera->visibility;
+                const auto node = model->getNode();
+                if ((model->nodeID && ((visibility & node->layer) == node->layer)) ||
+                    (visibility & model->visFlags)) {
+
+                    // frustum culling
+                    if ((model->worldBoundsID) && !(gpuInstanceCulling && isInstancedOnly(model)) &&
+                        !aabb_frustum(model->getWorldBounds(), camera->getFrustum())) {
+                        continue;
+                    }
 
-        // filter model by view visibility
-        if (model->enabled) {
-            const auto visibility = camera->visibility;
-            const auto node = model->getNode();
-            if ((model->nodeID && ((visibility & node->layer) == node->layer)) ||
-                (visibility & model->visFlags)) {
+                    // hidden behind the occluders rasterized for this camera
+                    if (occlusionCuller && occlusionCuller->isOccluded(models[i], model)) {
+                        continue;
+                    }
 
-                // frustum culling
-                if ((model->worldBoundsID) && !aabb_frustum(model->getWorldBounds(), camera->getFrustum())) {
-                    continue;
+                    objects.emplace_back(genRenderObject(model, camera));
                 }
-
-                renderObjects.emplace_back(genRenderObject(model, camera));
             }
         }
+    };
+
+    if (modelCount < PARALLEL_CULLING_THRESHOLD) {
+        cullModels(1, modelCount + 1, renderObjects);
+    } else {
+        // cull chunks in parallel, then join them in model order so the result stays deterministic
+        const uint chunkCount = (modelCount + CULLING_CHUNK_SIZE - 1) / CULLING_CHUNK_SIZE;
+        std::vector<RenderObjectList> chunks(chunkCount);
+        JobSystem::getInstance()->parallelFor(1, modelCount + 1, CULLING_CHUNK_SIZE, [&](uint begin, uint end) {
+            // constructed here to use the frame allocator of the worker thread
+            RenderObjectList objects;
+            cullModels(begin, end, objects);
+            chunks[(begin - 1) / CULLING_CHUNK_SIZE] = std::move(objects);
+        });
+        for (const auto &chunk : chunks) {
+            renderObjects.insert(renderObjects.end(), chunk.begin(), chunk.end());
+        }
     }
 
     pipeline->setRenderObjects(std::move(renderObjects));
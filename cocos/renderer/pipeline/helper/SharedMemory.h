@@ -89,7 +89,7 @@ extern gfx::BlendState *getBlendStateImpl(uint index);
 #define GET_RAW_BUFFER(index, size) SharedMemory::getRawBuffer<uint8_t>(se::PoolType::RAW_BUFFER, index, size)
 
 static const float SHADOW_CAMERA_MAX_FAR = 2000.0f;
-static const float COEFFICIENT_OF_EXPANSION = 2.0f * std::sqrtf(3.0f);
+static const float COEFFICIENT_OF_EXPANSION = 2.0f * std::sqrt(3.0f);
 
 class CC_DLL SharedMemory : public Object {
 public:
@@ -24,6 +24,9 @@ THE SOFTWARE.
 #include "ShadowFlow.h"
 
 #include "../Define.h"
+#include "../PipelineProfiler.h"
+#include "../RenderGraph.h"
+#include "../RenderTargetPool.h"
 #include "../forward/ForwardPipeline.h"
 #include "../helper/SharedMemory.h"
 #include "ShadowStage.h"
@@ -87,13 +90,17 @@ void ShadowFlow::render(Camera *camera) {
         for (auto *_stage : _stages) {
             auto *shadowStage = static_cast<ShadowStage *>(_stage);
             shadowStage->setUseData(light, shadowFrameBuffer);
+            CC_PROFILE_SCOPE(shadowStage->getName());
             shadowStage->render(camera);
         }
     }
 
     // After the shadowMap rendering of all lights is completed,
     // restore the ShadowUBO data of the main light.
-    pipeline->updateShadowUBO(camera);
+    // The light passes write the UBO while the graph executes, so the restore runs there too.
+    pipeline->getRenderGraph()->addPass(
+        "ShadowRestore", [](RenderGraphBuilder &builder) { builder.sideEffect(); },
+        [pipeline, camera](const RenderGraphContext &) { pipeline->updateShadowUBO(camera); });
 }
 
 void ShadowFlow::clearShadowMap(Camera *camera) {
@@ -113,6 +120,16 @@ void ShadowFlow::clearShadowMap(Camera *camera) {
     }
 }
 
+gfx::TextureInfo ShadowFlow::getColorTargetInfo(uint width, uint height) {
+    return {
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::Format::RGBA8,
+        width,
+        height,
+    };
+}
+
 void ShadowFlow::resizeShadowMap(const Light *light, const uint width, const uint height) const {
     auto *pipeline = static_cast<ForwardPipeline *>(_pipeline);
 
@@ -123,21 +140,19 @@ void ShadowFlow::resizeShadowMap(const Light *light, const uint width, const uin
             return;
         }
 
-        auto &renderTargets = framebuffer->getColorTextures();
-        for (auto *renderTarget : renderTargets) {
-            renderTarget->resize(width, height);
-        }
-
-        auto *depth = framebuffer->getDepthStencilTexture();
-        if (depth) {
-            depth->resize(width, height);
+        // the old targets go back to the pool
+        auto *renderTargetPool = pipeline->getRenderTargetPool();
+        vector<gfx::Texture *> renderTargets;
+        for (auto *renderTarget : framebuffer->getColorTextures()) {
+            renderTargetPool->release(renderTarget);
+            renderTargets.emplace_back(renderTargetPool->acquire(getColorTargetInfo(width, height)));
         }
 
         framebuffer->destroy();
         framebuffer->initialize({
             _renderPass,
             renderTargets,
-            depth,
+            nullptr,
             {},
         });
     }
@@ -160,39 +175,19 @@ void ShadowFlow::initShadowFrameBuffer(ForwardPipeline *pipeline, const Light *l
                 gfx::TextureLayout::PRESENT_SRC,
             }},
             {
-                device->getDepthStencilFormat(),
-                1,
-                gfx::LoadOp::CLEAR,
-                gfx::StoreOp::DISCARD,
-                gfx::LoadOp::CLEAR,
-                gfx::StoreOp::DISCARD,
-                gfx::TextureLayout::UNDEFINED,
-                gfx::TextureLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                gfx::Format::UNKNOWN, // the depth buffer is owned by the render graph pass
             },
         });
     }
 
+    auto *renderTargetPool = pipeline->getRenderTargetPool();
     vector<gfx::Texture *> renderTargets;
-    renderTargets.emplace_back(device->createTexture({
-        gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
-        gfx::Format::RGBA8,
-        width,
-        height,
-    }));
-
-    gfx::Texture *depth = device->createTexture({
-        gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT,
-        device->getDepthStencilFormat(),
-        width,
-        height,
-    });
+    renderTargets.emplace_back(renderTargetPool->acquire(getColorTargetInfo(width, height)));
 
     gfx::Framebuffer *framebuffer = device->createFramebuffer({
         _renderPass,
         renderTargets,
-        depth,
+        nullptr,
         {}, //colorMipmapLevels
     });
 
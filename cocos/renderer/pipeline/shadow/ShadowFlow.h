@@ -45,6 +45,8 @@ public:
     virtual void destroy() override;
 
 private:
+    static gfx::TextureInfo getColorTargetInfo(uint width, uint height);
+
     void clearShadowMap(Camera *camera);
 
     void resizeShadowMap(const Light *light, const uint width, const uint height) const;
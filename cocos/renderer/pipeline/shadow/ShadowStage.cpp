@@ -23,11 +23,13 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "ShadowStage.h"
 #include "../Define.h"
+#include "../RenderGraph.h"
 #include "../ShadowMapBatchedQueue.h"
 #include "../forward/ForwardPipeline.h"
 #include "../helper/SharedMemory.h"
 #include "gfx/GFXCommandBuffer.h"
 #include "gfx/GFXDescriptorSet.h"
+#include "gfx/GFXDevice.h"
 #include "gfx/GFXFramebuffer.h"
 #include "gfx/GFXTexture.h"
 #include "math/Vec2.h"
@@ -69,25 +71,42 @@ void ShadowStage::render(Camera *camera) {
         return;
     }
 
-    auto cmdBuffer = pipeline->getCommandBuffers()[0];
-
-    _additiveShadowQueue->gatherLightPasses(_light, cmdBuffer);
-
     const auto shadowMapSize = shadowInfo->size;
     _renderArea.x = (int)(camera->viewportX * shadowMapSize.x);
     _renderArea.y = (int)(camera->viewportY * shadowMapSize.y);
     _renderArea.width = (uint)(camera->viewportWidth * shadowMapSize.x * pipeline->getShadingScale());
     _renderArea.height = (uint)(camera->viewportHeight * shadowMapSize.y * pipeline->getShadingScale());
 
-    _clearColors[0] = {1.0f, 1.0f, 1.0f, 1.0f};
-    auto* renderPass = _framebuffer->getRenderPass();
-
-    cmdBuffer->beginRenderPass(renderPass, _framebuffer, _renderArea,
-                               _clearColors, camera->clearDepth, camera->clearStencil);
-    cmdBuffer->bindDescriptorSet(GLOBAL_SET, pipeline->getDescriptorSet());
-    _additiveShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuffer);
-
-    cmdBuffer->endRenderPass();
+    auto *renderGraph = pipeline->getRenderGraph();
+    const auto *light = _light;
+    // the queue and the shadow UBO only hold one light, gather it right before its pass records
+    renderGraph->addPass(
+        "ShadowGather", [](RenderGraphBuilder &builder) { builder.sideEffect(); },
+        [this, light](const RenderGraphContext &context) {
+            _additiveShadowQueue->gatherLightPasses(light, context.cmdBuffer);
+        });
+
+    auto *shadowMap = _framebuffer->getColorTextures()[0];
+    const auto colorHandle = renderGraph->importTexture("ShadowMap", shadowMap, gfx::TextureLayout::SHADER_READONLY_OPTIMAL);
+    // only alive while the shadow map renders, lights rendered one after another alias one depth buffer
+    gfx::TextureInfo depthInfo;
+    depthInfo.format = _device->getDepthStencilFormat();
+    depthInfo.width = shadowMap->getWidth();
+    depthInfo.height = shadowMap->getHeight();
+    const auto depthHandle = renderGraph->createTexture("ShadowDepth", depthInfo);
+    const gfx::Color clearColor{1.0f, 1.0f, 1.0f, 1.0f};
+    const float clearDepth = camera->clearDepth;
+    const int clearStencil = static_cast<int>(camera->clearStencil);
+    renderGraph->addPass(
+        "ShadowMap", [&](RenderGraphBuilder &builder) {
+            builder.writeColor(colorHandle, gfx::LoadOp::CLEAR, clearColor);
+            builder.writeDepthStencil(depthHandle, gfx::LoadOp::CLEAR, clearDepth, clearStencil);
+            builder.setRenderArea(_renderArea);
+        },
+        [this, pipeline](const RenderGraphContext &context) {
+            context.cmdBuffer->bindDescriptorSet(GLOBAL_SET, pipeline->getDescriptorSet());
+            _additiveShadowQueue->recordCommandBuffer(_device, context.renderPass, context.cmdBuffer);
+        });
 }
 
 void ShadowStage::destroy() {	
@@ -29,12 +29,10 @@
 
 #include <stdio.h>
 #include <errno.h>
-
-#ifdef MINIZIP_FROM_SYSTEM
-    #include <minizip/unzip.h>
-#else // from our embedded sources
-    #include "unzip/unzip.h"
-#endif
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
 
 NS_CC_EXT_BEGIN
 
@@ -43,8 +41,7 @@ NS_CC_EXT_BEGIN
 #define TEMP_PACKAGE_SUFFIX    "_temp"
 #define MANIFEST_FILENAME      "project.manifest"
 
-#define BUFFER_SIZE  8192
-#define MAX_FILENAME 512
+#define MAX_DECOMPRESS_THREADS 4U
 
 #define DEFAULT_CONNECTION_TIMEOUT 45
 
@@ -374,116 +371,81 @@ bool AssetsManagerEx::decompress(const std::string &zip) {
     }
     const std::string rootPath = zip.substr(0, pos + 1);
 
-    // Open the zip file
-    unzFile zipfile = unzOpen(FileUtils::getInstance()->getSuitableFOpen(zip).c_str());
-    if (!zipfile) {
+    // Map the zip file, its entries are indexed once and can be read from any thread
+    auto archive = FileArchive::open(zip);
+    if (!archive) {
         CC_LOG_DEBUG("AssetsManagerEx : can not open downloaded zip file %s\n", zip.c_str());
         return false;
     }
-
-    // Get info about the zip file
-    unz_global_info global_info;
-    if (unzGetGlobalInfo(zipfile, &global_info) != UNZ_OK) {
-        CC_LOG_DEBUG("AssetsManagerEx : can not read file global info of %s\n", zip.c_str());
-        unzClose(zipfile);
+    // Skipping them would report a successful update with files missing
+    if (!archive->getUnsupportedEntries().empty()) {
+        CC_LOG_DEBUG("AssetsManagerEx : %s is encrypted or uses an unsupported compression method in %s\n", archive->getUnsupportedEntries().front().c_str(), zip.c_str());
         return false;
     }
 
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
-    // Loop to extract all files.
-    uLong i;
-    for (i = 0; i < global_info.number_entry; ++i) {
-        // Get info about current file.
-        unz_file_info fileInfo;
-        char fileName[MAX_FILENAME];
-        if (unzGetCurrentFileInfo(zipfile,
-                                  &fileInfo,
-                                  fileName,
-                                  MAX_FILENAME,
-                                  NULL,
-                                  0,
-                                  NULL,
-                                  0) != UNZ_OK) {
-            CC_LOG_DEBUG("AssetsManagerEx : can not read compressed file info\n");
-            unzClose(zipfile);
-            return false;
-        }
-        const std::string fullPath = rootPath + fileName;
-
-        // Check if this entry is a directory or a file.
-        const size_t filenameLength = strlen(fileName);
-        if (fileName[filenameLength - 1] == '/') {
-            //There are not directory entry in some case.
-            //So we need to create directory when decompressing file entry
-            if (!_fileUtils->createDirectory(basename(fullPath))) {
+    // Create all directories in advance, so the workers only write files
+    std::vector<ExtractTask> tasks;
+    tasks.reserve(archive->getEntryCount());
+    std::unordered_set<std::string> dirs;
+    for (const auto &entry : archive->getEntries()) {
+        std::string fullPath = rootPath + entry.first;
+        std::string dir = basename(fullPath);
+        if (dirs.insert(dir).second && !_fileUtils->isDirectoryExist(dir)) {
+            if (!_fileUtils->createDirectory(dir)) {
                 // Failed to create directory
                 CC_LOG_DEBUG("AssetsManagerEx : can not create directory %s\n", fullPath.c_str());
-                unzClose(zipfile);
-                return false;
-            }
-        } else {
-            // Create all directories in advance to avoid issue
-            std::string dir = basename(fullPath);
-            if (!_fileUtils->isDirectoryExist(dir)) {
-                if (!_fileUtils->createDirectory(dir)) {
-                    // Failed to create directory
-                    CC_LOG_DEBUG("AssetsManagerEx : can not create directory %s\n", fullPath.c_str());
-                    unzClose(zipfile);
-                    return false;
-                }
-            }
-            // Entry is a file, so extract it.
-            // Open current file.
-            if (unzOpenCurrentFile(zipfile) != UNZ_OK) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not extract file %s\n", fileName);
-                unzClose(zipfile);
                 return false;
             }
+        }
+        tasks.push_back({std::move(fullPath), &entry.second});
+    }
+    // Largest entries first, so a big file doesn't end up alone on one thread at the end
+    std::sort(tasks.begin(), tasks.end(), [](const ExtractTask &a, const ExtractTask &b) {
+        return a.entry->uncompressedSize > b.entry->uncompressedSize;
+    });
 
-            // Create a file to store current file.
-            FILE *out = fopen(FileUtils::getInstance()->getSuitableFOpen(fullPath).c_str(), "wb");
-            if (!out) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not create decompress destination file %s (errno: %d)\n", fullPath.c_str(), errno);
-                unzCloseCurrentFile(zipfile);
-                unzClose(zipfile);
-                return false;
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto worker = [&]() {
+        for (size_t i = next++; i < tasks.size() && !failed.load(std::memory_order_relaxed); i = next++) {
+            if (!extractFile(*archive, tasks[i])) {
+                failed = true;
             }
+        }
+    };
 
-            // Write current file content to destinate file.
-            int error = UNZ_OK;
-            do {
-                error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
-                if (error < 0) {
-                    CC_LOG_DEBUG("AssetsManagerEx : can not read zip file %s, error code is %d\n", fileName, error);
-                    fclose(out);
-                    unzCloseCurrentFile(zipfile);
-                    unzClose(zipfile);
-                    return false;
-                }
+    size_t threadNum = std::min<size_t>(tasks.size(), std::min(MAX_DECOMPRESS_THREADS, std::max(1U, std::thread::hardware_concurrency())));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadNum; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
 
-                if (error > 0) {
-                    fwrite(readBuffer, error, 1, out);
-                }
-            } while (error > 0);
+    return !failed;
+}
 
-            fclose(out);
-        }
+bool AssetsManagerEx::extractFile(const FileArchive &archive, const ExtractTask &task) {
+    // Create a file to store current file.
+    FILE *out = fopen(FileUtils::getInstance()->getSuitableFOpen(task.fullPath).c_str(), "wb");
+    if (!out) {
+        CC_LOG_DEBUG("AssetsManagerEx : can not create decompress destination file %s (errno: %d)\n", task.fullPath.c_str(), errno);
+        return false;
+    }
 
-        unzCloseCurrentFile(zipfile);
+    // Inflate, verify the crc and write in a single pass over the entry
+    bool ok = archive.extract(task.entry, [out](const unsigned char *data, size_t size) {
+        return fwrite(data, 1, size, out) == size;
+    });
+    ok = fclose(out) == 0 && ok;
 
-        // Goto next entry listed in the zip file.
-        if ((i + 1) < global_info.number_entry) {
-            if (unzGoToNextFile(zipfile) != UNZ_OK) {
-                CC_LOG_DEBUG("AssetsManagerEx : can not read next file for decompressing\n");
-                unzClose(zipfile);
-                return false;
-            }
-        }
+    if (!ok) {
+        CC_LOG_DEBUG("AssetsManagerEx : can not extract file %s\n", task.fullPath.c_str());
+        remove(FileUtils::getInstance()->getSuitableFOpen(task.fullPath).c_str());
     }
-
-    unzClose(zipfile);
-    return true;
+    return ok;
 }
 
 void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const std::string &storagePath) {
@@ -498,8 +460,13 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
     asyncData->zipFile = storagePath;
     asyncData->succeed = false;
 
+    // The download slot is handed to the next download while this package is extracted,
+    // fileSuccess and fileError release it again when extraction is done
+    _currConcurrentTask = std::max(0, _currConcurrentTask - 1);
+
     std::function<void(void *)> decompressFinished = [this](void *param) {
         auto dataInner = reinterpret_cast<AsyncData *>(param);
+        _currConcurrentTask++;
         if (dataInner->succeed) {
             fileSuccess(dataInner->customId, dataInner->zipFile);
         } else {
@@ -518,6 +485,8 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
         }
         _fileUtils->removeFile(asyncData->zipFile);
     });
+
+    queueDowload();
 }
 
 void AssetsManagerEx::dispatchUpdateEvent(EventAssetsManagerEx::EventCode code, const std::string &assetId /* = ""*/, const std::string &message /* = ""*/, int curle_code /* = CURLE_OK*/, int curlm_code /* = CURLM_OK*/) {
@@ -729,6 +698,7 @@ void AssetsManagerEx::startUpdate() {
     if (_updateState == State::READY_TO_UPDATE) {
         _totalSize = 0;
         _updateState = State::UPDATING;
+        _updateStartTime = std::chrono::steady_clock::now();
         std::string msg;
         if (_downloadResumed) {
             msg = StringUtils::format("Resuming from previous unfinished update, %d files remains to be finished.", _totalToDownload);
@@ -1125,6 +1095,11 @@ void AssetsManagerEx::onDownloadUnitsFinished() {
     // Always save current download manifest information for resuming
     _tempManifest->saveToFile(_tempManifestPath);
 
+    if (_updateState == State::UPDATING) {
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _updateStartTime).count();
+        CC_LOG_DEBUG("AssetsManagerEx : %d files downloaded and extracted in %.2f s\n", _totalToDownload, elapsed);
+    }
+
     // Finished with error check
     if (_failedUnits.size() > 0) {
         _updateState = State::FAIL_TO_UPDATE;
@@ -27,10 +27,12 @@
 #ifndef __AssetsManagerEx__
 #define __AssetsManagerEx__
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "platform/FileArchive.h"
 #include "platform/FileUtils.h"
 #include "network/Downloader.h"
 
@@ -236,7 +238,15 @@ protected:
     void parseManifest();
     void startUpdate();
     void updateSucceed();
+    struct ExtractTask {
+        std::string fullPath;
+        const FileArchive::Entry *entry;
+    };
+
+    /** @brief Extracts all entries of a zip file next to it, entries are spread over several threads
+     */
     bool decompress(const std::string &filename);
+    static bool extractFile(const FileArchive &archive, const ExtractTask &task);
     void decompressDownloadedZip(const std::string &customId, const std::string &storagePath);
 
     /** @brief Update a list of assets under the current AssetsManagerEx context
@@ -397,6 +407,9 @@ private:
     //! Next target percent for saving the manifest file
     float _nextSavePoint = 0.f;
 
+    //! When the current update started downloading
+    std::chrono::steady_clock::time_point _updateStartTime;
+
     //! Handle function to compare versions between different manifests
     VersionCompareHandle _versionCompareHandle = nullptr;
 
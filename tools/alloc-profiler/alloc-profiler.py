@@ -0,0 +1,204 @@
+#!/usr/bin/env python
+#coding=utf-8
+
+'''
+Convert a trace written by cc::AllocProfiler into folded stacks.
+
+  alloc-profiler.py app.ccap > alloc.folded
+  flamegraph.pl alloc.folded > alloc.svg
+
+--inuse only keeps samples that were not freed when the trace ended,
+--snapshots prints the periodic per-tag counters as csv instead.
+Pcs are symbolized with llvm-symbolizer (or addr2line) using the module
+records of the trace, --symbols-dir remaps device paths to unstripped copies.
+'''
+
+import argparse, math, os, struct, subprocess, sys
+from collections import defaultdict
+
+class Trace(object):
+  def __init__(self):
+    self.interval = 0
+    self.tags = []
+    self.modules = []
+    self.samples = {}
+    self.freed = []
+    self.snapshots = []
+
+def read_trace(path):
+  trace = Trace()
+  with open(path, 'rb') as f:
+    data = f.read()
+
+  if data[:4] != b'CCAP':
+    raise ValueError('%s is not an allocation trace' % path)
+  version, tag_count, _, trace.interval = struct.unpack_from('<HBBI', data, 4)
+  if version != 1:
+    raise ValueError('unsupported trace version %d' % version)
+  pos = 12
+  for _ in range(tag_count):
+    length = data[pos] if isinstance(data[pos], int) else ord(data[pos])
+    trace.tags.append(data[pos + 1:pos + 1 + length].decode('utf-8'))
+    pos += 1 + length
+
+  modules = set()
+  sample_id = 0
+  while pos < len(data):
+    kind = data[pos:pos + 1]
+    pos += 1
+    try:
+      if kind == b'M':
+        bias, begin, end, length = struct.unpack_from('<QQQH', data, pos)
+        pos += 26
+        module = (begin, end, bias, data[pos:pos + length].decode('utf-8', 'replace'))
+        pos += length
+        modules.add(module)
+      elif kind == b'S':
+        time, ptr, size, tag, depth = struct.unpack_from('<QQQBB', data, pos)
+        pos += 26
+        pcs = struct.unpack_from('<%dQ' % depth, data, pos)
+        pos += depth * 8
+        # untracked samples can not be matched with frees
+        key = ptr if not tag & 0x80 else ('untracked', sample_id)
+        sample_id += 1
+        trace.samples[key] = (size, tag & 0x7f, pcs)
+      elif kind == b'F':
+        time, ptr = struct.unpack_from('<QQ', data, pos)
+        pos += 16
+        sample = trace.samples.pop(ptr, None)
+        if sample:
+          trace.freed.append(sample)
+      elif kind == b'N':
+        time, count = struct.unpack_from('<QB', data, pos)
+        pos += 9
+        counters = struct.unpack_from('<%dQ' % (count * 3), data, pos)
+        pos += count * 24
+        trace.snapshots.append((time, counters))
+      else:
+        sys.stderr.write('unknown record at offset %d, trace truncated?\n' % (pos - 1))
+        break
+    except struct.error:
+      # the process may have died while writing the last record
+      break
+
+  trace.modules = sorted(modules)
+  return trace
+
+class Symbolizer(object):
+  def __init__(self, modules, symbols_dir):
+    self.modules = modules
+    self.symbols_dir = symbols_dir
+    self.cache = {}
+    self.tool = None
+    for tool in ('llvm-symbolizer', 'addr2line'):
+      if self._which(tool):
+        self.tool = tool
+        break
+
+  @staticmethod
+  def _which(tool):
+    for directory in os.environ.get('PATH', '').split(os.pathsep):
+      if os.access(os.path.join(directory, tool), os.X_OK):
+        return True
+    return False
+
+  def _find_module(self, pc):
+    found = None
+    for module in self.modules:
+      if module[0] > pc:
+        break
+      if module[1] == 0 or pc < module[1]:
+        found = module
+    return found
+
+  def _local_path(self, path):
+    if self.symbols_dir:
+      candidate = os.path.join(self.symbols_dir, os.path.basename(path))
+      if os.path.exists(candidate):
+        return candidate
+    return path
+
+  def resolve_all(self, pcs):
+    by_module = defaultdict(set)
+    for pc in pcs:
+      if pc in self.cache:
+        continue
+      module = self._find_module(pc)
+      if not module:
+        self.cache[pc] = '0x%x' % pc
+        continue
+      by_module[module].add(pc)
+
+    for module, module_pcs in by_module.items():
+      module_pcs = sorted(module_pcs)
+      path = self._local_path(module[3])
+      name = os.path.basename(module[3]) or '?'
+      # return addresses point after the call, step back into it
+      offsets = ['0x%x' % (pc - module[2] - 1) for pc in module_pcs]
+      names = self._run(path, offsets)
+      for pc, offset, symbol in zip(module_pcs, offsets, names):
+        self.cache[pc] = symbol if symbol and symbol != '??' else '%s+%s' % (name, offset)
+
+  def _run(self, path, offsets):
+    if not self.tool or not os.path.exists(path):
+      return [None] * len(offsets)
+    if self.tool == 'llvm-symbolizer':
+      cmd = ['llvm-symbolizer', '--obj=' + path, '--functions=linkage', '--demangle', '--no-inlines', '--output-style=GNU']
+    else:
+      cmd = ['addr2line', '-f', '-C', '-e', path]
+    try:
+      proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, universal_newlines=True)
+      out, _ = proc.communicate('\n'.join(offsets) + '\n')
+    except OSError:
+      return [None] * len(offsets)
+    lines = [line for line in out.split('\n')]
+    # both tools print a function line and a location line per address
+    return [lines[i * 2].strip() if i * 2 < len(lines) else None for i in range(len(offsets))]
+
+  def __call__(self, pc):
+    return self.cache.get(pc, '0x%x' % pc)
+
+def sample_weight(size, interval):
+  # undo the size bias of the exponential sampling
+  if interval <= 1:
+    return size
+  return size / (1.0 - math.exp(-float(size) / interval))
+
+def fold(trace, samples, symbols_dir):
+  symbolize = Symbolizer(trace.modules, symbols_dir)
+  symbolize.resolve_all(set(pc for sample in samples for pc in sample[2]))
+
+  stacks = defaultdict(float)
+  for size, tag, pcs in samples:
+    frames = [symbolize(pc).replace(';', ':') for pc in reversed(pcs)]
+    tag_name = trace.tags[tag] if tag < len(trace.tags) else str(tag)
+    stacks[';'.join(['[%s]' % tag_name] + frames)] += sample_weight(size, trace.interval)
+  return stacks
+
+def main():
+  parser = argparse.ArgumentParser(description='Convert allocation profiler traces into folded stacks.')
+  parser.add_argument('trace')
+  parser.add_argument('--inuse', action='store_true', help='only samples which were never freed')
+  parser.add_argument('--snapshots', action='store_true', help='print the per-tag counters as csv')
+  parser.add_argument('--symbols-dir', help='directory holding unstripped copies of the traced libraries')
+  args = parser.parse_args()
+
+  trace = read_trace(args.trace)
+
+  if args.snapshots:
+    columns = ['time_ms']
+    for tag in trace.tags:
+      columns += ['%s_allocs' % tag, '%s_bytes' % tag, '%s_frees' % tag]
+    print(','.join(columns))
+    for time, counters in trace.snapshots:
+      print(','.join(['%.3f' % (time / 1e6)] + [str(c) for c in counters]))
+    return
+
+  samples = list(trace.samples.values())
+  if not args.inuse:
+    samples += trace.freed
+  for stack, weight in sorted(fold(trace, samples, args.symbols_dir).items()):
+    print('%s %d' % (stack, int(round(weight))))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/memory/FrameAllocator.h"
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+using cc::FrameAllocator;
+
+TEST(baseFrameAllocatorTest, allocationsAreAligned) {
+    FrameAllocator allocator;
+    for (size_t alignment = 1; alignment <= 256; alignment <<= 1) {
+        // odd sizes leave the offset unaligned for the next allocation
+        void *ptr = allocator.allocate(alignment + 3, alignment);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u) << "alignment " << alignment;
+    }
+    auto *value = static_cast<double *>(allocator.allocate(sizeof(double)));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(value) % alignof(std::max_align_t), 0u);
+
+    EXPECT_EQ(allocator.getStats().allocations, 10u);
+}
+
+TEST(baseFrameAllocatorTest, resetRecyclesTheMemory) {
+    FrameAllocator allocator;
+    void *first = allocator.allocate(128, 16);
+    allocator.allocate(256, 16);
+    EXPECT_EQ(allocator.getStats().usedBytes, 384u);
+    const size_t capacity = allocator.getStats().capacity;
+
+    allocator.reset();
+    EXPECT_EQ(allocator.getStats().allocations, 0u);
+    EXPECT_EQ(allocator.getStats().usedBytes, 0u);
+    EXPECT_EQ(allocator.getStats().capacity, capacity);
+    EXPECT_EQ(allocator.allocate(128, 16), first);
+}
+
+TEST(baseFrameAllocatorTest, overflowGrowsAndResetMergesTheBlocks) {
+    FrameAllocator allocator;
+    const size_t chunk = 40 * 1024;
+    // allocations must stay writable when a new block is linked
+    uint8_t *ptrs[4];
+    for (uint8_t i = 0; i < 4; ++i) {
+        ptrs[i] = static_cast<uint8_t *>(allocator.allocate(chunk, 16));
+        memset(ptrs[i], i, chunk);
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(ptrs[i][0], i);
+        EXPECT_EQ(ptrs[i][chunk - 1], i);
+    }
+    const size_t capacity = allocator.getStats().capacity;
+    EXPECT_GE(capacity, chunk * 4);
+
+    // the next frame of the same size fits into the merged block
+    allocator.reset();
+    EXPECT_EQ(allocator.getStats().capacity, capacity);
+    auto *base = static_cast<uint8_t *>(allocator.allocate(chunk, 16));
+    for (int i = 1; i < 4; ++i) {
+        auto *ptr = static_cast<uint8_t *>(allocator.allocate(chunk, 16));
+        EXPECT_LT(static_cast<size_t>(ptr - base), capacity);
+    }
+    EXPECT_EQ(allocator.getStats().capacity, capacity);
+
+    // larger than any block
+    auto *large = static_cast<uint8_t *>(allocator.allocate(capacity * 4, 64));
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0u);
+    memset(large, 0xff, capacity * 4);
+    EXPECT_GE(allocator.getStats().capacity, capacity * 5);
+}
+
+TEST(baseFrameAllocatorTest, resetAllCollectsTheStatsOfEveryThread) {
+    FrameAllocator::resetAll();
+
+    FrameAllocator *mainAllocator = FrameAllocator::getThreadLocal();
+    EXPECT_EQ(FrameAllocator::getThreadLocal(), mainAllocator);
+    mainAllocator->allocate(100);
+
+    std::thread worker([&]() {
+        FrameAllocator *allocator = FrameAllocator::getThreadLocal();
+        EXPECT_NE(allocator, mainAllocator);
+        allocator->allocate(50);
+        allocator->allocate(50);
+        // the worker's allocator goes away with the thread, collect before that
+        FrameAllocator::resetAll();
+    });
+    worker.join();
+
+    const FrameAllocator::Stats stats = FrameAllocator::getLastFrameStats();
+    EXPECT_EQ(stats.allocations, 3u);
+    EXPECT_EQ(stats.usedBytes, 200u);
+    EXPECT_EQ(mainAllocator->getStats().allocations, 0u);
+}
+
+TEST(baseFrameAllocatorTest, frameVectorAllocatesFromTheFrame) {
+    FrameAllocator allocator;
+    cc::FrameVector<int> values{cc::FrameStlAllocator<int>(&allocator)};
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values[999], 999);
+    EXPECT_GT(allocator.getStats().allocations, 0u);
+    EXPECT_GE(allocator.getStats().usedBytes, 1000 * sizeof(int));
+}
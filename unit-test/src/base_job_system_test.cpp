@@ -0,0 +1,92 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(baseJobSystemTest, parallelFor) {
+    cc::JobSystem jobSystem(3);
+    std::vector<int> values(100000, 0);
+    jobSystem.parallelFor(0, static_cast<uint32_t>(values.size()), 64, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            values[i] += static_cast<int>(i);
+        }
+    });
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int>(i));
+    }
+}
+
+TEST(baseJobSystemTest, nestedGroups) {
+    cc::JobSystem jobSystem(3);
+    std::atomic<int> count{0};
+    cc::TaskGroup parent;
+    std::vector<std::unique_ptr<cc::TaskGroup>> children;
+    for (int i = 0; i < 8; ++i) {
+        children.emplace_back(new cc::TaskGroup(&parent));
+    }
+    for (auto &child : children) {
+        auto *group = child.get();
+        jobSystem.run(*group, [&jobSystem, &count, group]() {
+            // tasks spawned by workers go to their own deque and get stolen by others
+            for (int j = 0; j < 100; ++j) {
+                jobSystem.run(*group, [&count]() { ++count; });
+            }
+        });
+    }
+    jobSystem.wait(parent);
+    EXPECT_EQ(count.load(), 800);
+    for (auto &child : children) {
+        EXPECT_TRUE(child->isDone());
+    }
+}
+
+TEST(baseJobSystemTest, workerCounts) {
+    // timings per worker count are in the jobSystem micro benchmark
+    const uint32_t size = 1 << 16;
+    std::vector<float> values(size);
+    uint32_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+
+    for (uint32_t workers = 0; workers < cores; ++workers) {
+        cc::JobSystem jobSystem(workers);
+        std::fill(values.begin(), values.end(), -1.F);
+        std::atomic<uint32_t> processed{0};
+        jobSystem.parallelFor(0, size, 1024, [&](uint32_t first, uint32_t last) {
+            for (uint32_t i = first; i < last; ++i) {
+                values[i] = std::sqrt(static_cast<float>(i));
+            }
+            processed += last - first;
+        });
+        // every element is visited exactly once whatever the number of workers
+        EXPECT_EQ(processed.load(), size) << workers << " worker(s)";
+        for (uint32_t i = 0; i < size; ++i) {
+            ASSERT_FLOAT_EQ(values[i], std::sqrt(static_cast<float>(i))) << workers << " worker(s), index " << i;
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/LoadScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using cc::LoadScheduler;
+
+namespace {
+constexpr auto TIMEOUT = std::chrono::seconds(5);
+
+// takes a slot of the stage until release() is called
+class SlotHolder {
+public:
+    SlotHolder(LoadScheduler *scheduler, LoadScheduler::Stage stage) {
+        LoadScheduler::RequestId id = scheduler->createRequest(1000);
+        scheduler->submitAsync(id, stage, [this](const std::function<void()> &done) {
+            _done = done;
+            _started.set_value();
+        });
+    }
+
+    bool waitStarted() { return _started.get_future().wait_for(TIMEOUT) == std::future_status::ready; }
+    void release() { _done(); }
+
+private:
+    std::promise<void> _started;
+    std::function<void()> _done;
+};
+} // namespace
+
+TEST(baseLoadSchedulerTest, higherPriorityRunsFirst) {
+    auto *scheduler = LoadScheduler::getInstance();
+    scheduler->setConcurrency(LoadScheduler::Stage::DECODE, 1);
+
+    SlotHolder holder(scheduler, LoadScheduler::Stage::DECODE);
+    ASSERT_TRUE(holder.waitStarted());
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> finished;
+    const int priorities[] = {1, 5, 3, 5, -2};
+    int remaining = 5;
+    for (int i = 0; i < 5; ++i) {
+        LoadScheduler::RequestId id = scheduler->createRequest(priorities[i]);
+        scheduler->submit(id, LoadScheduler::Stage::DECODE, [&, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            if (--remaining == 0) finished.set_value();
+        });
+    }
+    EXPECT_EQ(scheduler->getPendingJobNum(), 5);
+
+    holder.release();
+    ASSERT_EQ(finished.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    // equal priorities keep their submission order
+    EXPECT_EQ(order, (std::vector<int>{1, 3, 2, 0, 4}));
+
+    LoadScheduler::destroyInstance();
+}
+
+TEST(baseLoadSchedulerTest, setPriorityReordersPendingJobs) {
+    auto *scheduler = LoadScheduler::getInstance();
+    scheduler->setConcurrency(LoadScheduler::Stage::IO, 1);
+
+    SlotHolder holder(scheduler, LoadScheduler::Stage::IO);
+    ASSERT_TRUE(holder.waitStarted());
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> finished;
+    int remaining = 3;
+    LoadScheduler::RequestId ids[3];
+    for (int i = 0; i < 3; ++i) {
+        ids[i] = scheduler->createRequest(0);
+        scheduler->submit(ids[i], LoadScheduler::Stage::IO, [&, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            if (--remaining == 0) finished.set_value();
+        });
+    }
+    scheduler->setPriority(ids[2], 10);
+
+    holder.release();
+    ASSERT_EQ(finished.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(order, (std::vector<int>{2, 0, 1}));
+
+    LoadScheduler::destroyInstance();
+}
+
+TEST(baseLoadSchedulerTest, stageLimitsAreIndependent) {
+    auto *scheduler = LoadScheduler::getInstance();
+    scheduler->setConcurrency(LoadScheduler::Stage::IO, 2);
+    EXPECT_EQ(scheduler->getConcurrency(LoadScheduler::Stage::IO), 2);
+
+    SlotHolder first(scheduler, LoadScheduler::Stage::IO);
+    SlotHolder second(scheduler, LoadScheduler::Stage::IO);
+    ASSERT_TRUE(first.waitStarted());
+    ASSERT_TRUE(second.waitStarted());
+
+    // the IO stage is full, another IO job waits while the other stages keep running
+    std::promise<void> ioRan;
+    std::promise<void> networkRan;
+    scheduler->submit(scheduler->createRequest(100), LoadScheduler::Stage::IO, [&]() { ioRan.set_value(); });
+    scheduler->submit(scheduler->createRequest(0), LoadScheduler::Stage::NETWORK, [&]() { networkRan.set_value(); });
+
+    auto ioFuture = ioRan.get_future();
+    ASSERT_EQ(networkRan.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    EXPECT_EQ(ioFuture.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    EXPECT_EQ(scheduler->getPendingJobNum(), 1);
+
+    first.release();
+    EXPECT_EQ(ioFuture.wait_for(TIMEOUT), std::future_status::ready);
+    second.release();
+
+    LoadScheduler::destroyInstance();
+}
+
+TEST(baseLoadSchedulerTest, concurrencyNeverExceedsTheLimit) {
+    auto *scheduler = LoadScheduler::getInstance();
+    scheduler->setConcurrency(LoadScheduler::Stage::DECODE, 2);
+
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> remaining{16};
+    std::promise<void> finished;
+    for (int i = 0; i < 16; ++i) {
+        scheduler->submit(scheduler->createRequest(i % 3), LoadScheduler::Stage::DECODE, [&]() {
+            int current = ++running;
+            int expected = peak.load();
+            while (current > expected && !peak.compare_exchange_weak(expected, current)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            --running;
+            if (--remaining == 0) finished.set_value();
+        });
+    }
+    ASSERT_EQ(finished.get_future().wait_for(TIMEOUT), std::future_status::ready);
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_GE(peak.load(), 1);
+
+    LoadScheduler::destroyInstance();
+}
+
+TEST(baseLoadSchedulerTest, cancelDropsPendingJobs) {
+    auto *scheduler = LoadScheduler::getInstance();
+    scheduler->setConcurrency(LoadScheduler::Stage::DECODE, 1);
+
+    SlotHolder holder(scheduler, LoadScheduler::Stage::DECODE);
+    ASSERT_TRUE(holder.waitStarted());
+
+    bool canceled = false;
+    std::atomic<bool> ran{false};
+    LoadScheduler::RequestId id = scheduler->createRequest(0, [&]() { canceled = true; });
+    scheduler->submit(id, LoadScheduler::Stage::DECODE, [&]() { ran = true; });
+    EXPECT_TRUE(scheduler->isAlive(id));
+
+    scheduler->cancel(id);
+    EXPECT_TRUE(canceled);
+    EXPECT_FALSE(scheduler->isAlive(id));
+    EXPECT_EQ(scheduler->getPendingJobNum(), 0);
+
+    // jobs of a canceled request are discarded on submit too
+    scheduler->submit(id, LoadScheduler::Stage::DECODE, [&]() { ran = true; });
+    EXPECT_EQ(scheduler->getPendingJobNum(), 0);
+
+    holder.release();
+    LoadScheduler::destroyInstance();
+    EXPECT_FALSE(ran.load());
+}
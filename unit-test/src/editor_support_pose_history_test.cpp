@@ -0,0 +1,82 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/editor-support/PoseHistory.h"
+
+using cc::middleware::PoseHistory;
+
+namespace {
+// renders one frame of a single vertex slot, x is the pose of this frame
+float renderFrame(PoseHistory &history, int framesSincePose, int interval, float x, bool reset = false) {
+    float y = -x;
+    history.begin(1, reset, framesSincePose == 0);
+    history.blend(0, PoseHistory::getBlend(framesSincePose, interval), x, y);
+    EXPECT_FLOAT_EQ(y, -x);
+    return x;
+}
+} // namespace
+
+TEST(editorSupportPoseHistoryTest, blendReachesTheLastPoseBeforeTheNextEvaluation) {
+    EXPECT_FLOAT_EQ(PoseHistory::getBlend(0, 4), 0.25f);
+    EXPECT_FLOAT_EQ(PoseHistory::getBlend(2, 4), 0.75f);
+    EXPECT_FLOAT_EQ(PoseHistory::getBlend(3, 4), 1.0f);
+    // frames beyond the interval hold the last pose
+    EXPECT_FLOAT_EQ(PoseHistory::getBlend(5, 4), 1.0f);
+    EXPECT_FLOAT_EQ(PoseHistory::getBlend(0, 1), 1.0f);
+}
+
+TEST(editorSupportPoseHistoryTest, framesBetweenEvaluationsBlendThePoses) {
+    PoseHistory history;
+    // the first pose has nothing to blend with
+    EXPECT_FLOAT_EQ(renderFrame(history, 0, 4, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 1, 4, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 2, 4, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 3, 4, 0.0f), 0.0f);
+
+    // the pose is only taken on evaluation, skipped frames don't touch the history
+    EXPECT_FLOAT_EQ(renderFrame(history, 0, 4, 8.0f), 2.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 1, 4, -1.0f), 4.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 2, 4, -1.0f), 6.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 3, 4, -1.0f), 8.0f);
+
+    EXPECT_FLOAT_EQ(renderFrame(history, 0, 4, 0.0f), 6.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 1, 4, -1.0f), 4.0f);
+}
+
+TEST(editorSupportPoseHistoryTest, resetStartsOverFromTheCurrentPose) {
+    PoseHistory history;
+    renderFrame(history, 0, 2, 0.0f);
+    renderFrame(history, 0, 2, 10.0f);
+
+    EXPECT_FLOAT_EQ(renderFrame(history, 1, 2, 20.0f, true), 20.0f);
+    EXPECT_FLOAT_EQ(renderFrame(history, 0, 2, 30.0f), 25.0f);
+
+    // a changed vertex count resets too
+    float x = 100.0f;
+    float y = 100.0f;
+    history.begin(2, false, true);
+    history.blend(1, 0.5f, x, y);
+    EXPECT_FLOAT_EQ(x, 100.0f);
+    EXPECT_FLOAT_EQ(y, 100.0f);
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/editor-support/IOTypedArray.h"
+#include "cocos/editor-support/TypedArrayPool.h"
+
+using cc::middleware::IOTypedArray;
+using cc::middleware::TypedArrayPool;
+using ArrayType = se::Object::TypedArrayType;
+
+namespace {
+class editorSupportTypedArrayPoolTest : public testing::Test {
+protected:
+    static void SetUpTestCase() {
+        se::ScriptEngine::getInstance()->start();
+    }
+
+    static void TearDownTestCase() {
+        TypedArrayPool::destroyInstance();
+        se::ScriptEngine::destroyInstance();
+    }
+};
+} // namespace
+
+TEST_F(editorSupportTypedArrayPoolTest, deferredArraysAreReusedAfterRecycle) {
+    auto *pool = TypedArrayPool::getInstance();
+    se::Object *array = pool->pop(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE);
+    pool->pushDeferred(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE, array);
+
+    se::Object *other = pool->pop(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE);
+    EXPECT_NE(other, array);
+    pool->push(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE, other);
+
+    pool->recycleDeferred();
+    EXPECT_EQ(pool->pop(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE), array);
+    pool->push(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE, array);
+}
+
+TEST_F(editorSupportTypedArrayPoolTest, replacedChunksAreNotReusedWithinTheFrame) {
+    auto *pool = TypedArrayPool::getInstance();
+    IOTypedArray buffer(ArrayType::UINT32, MIN_TYPE_ARRAY_SIZE, true, true);
+
+    // first frame links a second chunk
+    buffer.writeUint32(0);
+    buffer.beginRecord();
+    buffer.checkSpace(MIN_TYPE_ARRAY_SIZE);
+    ASSERT_EQ(buffer.getChunkCount(), 2u);
+    se::Object *replaced = buffer.getChunk(1);
+    const std::size_t replacedSize = buffer.getCapacity();
+
+    // a larger record next frame replaces it while js may still view it
+    buffer.rewind();
+    buffer.beginRecord();
+    buffer.checkSpace(replacedSize * 2);
+    ASSERT_EQ(buffer.getChunkCount(), 2u);
+    EXPECT_NE(buffer.getChunk(1), replaced);
+    EXPECT_EQ(buffer.getChunkIndex(), 1u);
+
+    se::Object *other = pool->pop(ArrayType::UINT32, replacedSize);
+    EXPECT_NE(other, replaced);
+    pool->push(ArrayType::UINT32, replacedSize, other);
+
+    pool->recycleDeferred();
+    EXPECT_EQ(pool->pop(ArrayType::UINT32, replacedSize), replaced);
+    pool->push(ArrayType::UINT32, replacedSize, replaced);
+}
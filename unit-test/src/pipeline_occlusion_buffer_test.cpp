@@ -0,0 +1,119 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/base/JobSystem.h"
+#include "cocos/renderer/pipeline/OcclusionBuffer.h"
+
+using cc::Mat4;
+using cc::Vec3;
+using cc::pipeline::OcclusionBuffer;
+
+namespace {
+// quad facing the camera at depth z, identity view projection maps world xy to ndc
+void addQuad(OcclusionBuffer &buffer, const Mat4 &viewProj, float minX, float minY, float maxX, float maxY, float z) {
+    const float positions[] = {minX, minY, z, maxX, minY, z, maxX, maxY, z, minX, maxY, z};
+    const uint indices[] = {0, 1, 2, 0, 2, 3};
+    buffer.addOccluder(viewProj, positions, indices, 6);
+}
+} // namespace
+
+TEST(pipelineOcclusionBufferTest, emptyBufferOccludesNothing) {
+    OcclusionBuffer buffer(64, 32);
+    buffer.clear();
+    buffer.rasterize();
+    EXPECT_FALSE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.1f, -0.1f, 0.5f), Vec3(0.1f, 0.1f, 0.6f)));
+}
+
+TEST(pipelineOcclusionBufferTest, quadOccludesBoxesBehindIt) {
+    OcclusionBuffer buffer(64, 32);
+    buffer.clear();
+    addQuad(buffer, Mat4::IDENTITY, -0.5f, -0.5f, 0.5f, 0.5f, 0.0f);
+    buffer.rasterize();
+
+    EXPECT_EQ(buffer.getTriangleCount(), 2u);
+    EXPECT_FLOAT_EQ(buffer.getDepth(32, 16), 0.0f);
+    EXPECT_GT(buffer.getDepth(0, 0), 1.0f);
+
+    // behind and fully covered
+    EXPECT_TRUE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.3f, -0.3f, 0.2f), Vec3(0.3f, 0.3f, 0.8f)));
+    // in front of the quad
+    EXPECT_FALSE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.3f, -0.3f, -0.5f), Vec3(0.3f, 0.3f, -0.2f)));
+    // crossing the quad
+    EXPECT_FALSE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.3f, -0.3f, -0.1f), Vec3(0.3f, 0.3f, 0.1f)));
+    // sticking out at the side
+    EXPECT_FALSE(buffer.isOccluded(Mat4::IDENTITY, Vec3(0.3f, -0.3f, 0.2f), Vec3(0.7f, 0.3f, 0.8f)));
+}
+
+TEST(pipelineOcclusionBufferTest, occluderDepthIsConservative) {
+    OcclusionBuffer buffer(64, 32);
+    buffer.clear();
+    // tilted quad going from z 0 to z 0.6, every texel keeps the farthest depth of its triangle
+    const float positions[] = {-0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.5f, 0.5f, 0.6f, -0.5f, 0.5f, 0.6f};
+    const uint indices[] = {0, 1, 2, 0, 2, 3};
+    buffer.addOccluder(Mat4::IDENTITY, positions, indices, 6);
+    buffer.rasterize();
+
+    EXPECT_FALSE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.2f, -0.4f, 0.3f), Vec3(0.2f, -0.3f, 0.4f)));
+    EXPECT_TRUE(buffer.isOccluded(Mat4::IDENTITY, Vec3(-0.2f, -0.4f, 0.7f), Vec3(0.2f, -0.3f, 0.8f)));
+}
+
+TEST(pipelineOcclusionBufferTest, nearPlaneIsNeverOccluded) {
+    Mat4 proj;
+    Mat4::createPerspective(60.0f, 2.0f, 0.1f, 100.0f, &proj);
+
+    OcclusionBuffer buffer;
+    buffer.clear();
+    addQuad(buffer, proj, -10.0f, -10.0f, 10.0f, 10.0f, -5.0f);
+    // a triangle behind the camera is dropped instead of being projected
+    addQuad(buffer, proj, -10.0f, -10.0f, 10.0f, 10.0f, 5.0f);
+    buffer.rasterize();
+
+    EXPECT_EQ(buffer.getTriangleCount(), 2u);
+    EXPECT_TRUE(buffer.isOccluded(proj, Vec3(-1.0f, -1.0f, -20.0f), Vec3(1.0f, 1.0f, -10.0f)));
+    EXPECT_FALSE(buffer.isOccluded(proj, Vec3(-1.0f, -1.0f, -20.0f), Vec3(1.0f, 1.0f, 1.0f)));
+}
+
+TEST(pipelineOcclusionBufferTest, parallelRasterizationMatchesSerial) {
+    Mat4 proj;
+    Mat4::createPerspective(60.0f, 2.0f, 0.1f, 100.0f, &proj);
+
+    OcclusionBuffer serial;
+    OcclusionBuffer parallel;
+    serial.clear();
+    parallel.clear();
+    for (int i = 0; i < 20; ++i) {
+        const float x = -20.0f + i * 2.0f;
+        addQuad(serial, proj, x, -3.0f + i * 0.2f, x + 3.0f, 4.0f, -10.0f - i);
+        addQuad(parallel, proj, x, -3.0f + i * 0.2f, x + 3.0f, 4.0f, -10.0f - i);
+    }
+    cc::JobSystem jobSystem(3);
+    serial.rasterize();
+    parallel.rasterize(&jobSystem);
+
+    for (uint y = 0; y < serial.getHeight(); ++y) {
+        for (uint x = 0; x < serial.getWidth(); ++x) {
+            EXPECT_EQ(serial.getDepth(x, y), parallel.getDepth(x, y));
+        }
+    }
+}
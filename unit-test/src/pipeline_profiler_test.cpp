@@ -0,0 +1,102 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/renderer/pipeline/PipelineProfiler.h"
+
+using cc::pipeline::PipelineProfiler;
+using cc::pipeline::ProfileFrame;
+
+namespace {
+void recordFrame(PipelineProfiler &profiler) {
+    profiler.beginFrame(nullptr, nullptr);
+    {
+        CC_PROFILE_SCOPE("ForwardFlow");
+        {
+            CC_PROFILE_SCOPE("ForwardStage");
+        }
+    }
+    CC_PROFILE_SCOPE("Shadow \"Flow\"");
+    profiler.endFrame();
+}
+} // namespace
+
+TEST(pipelineProfilerTest, disabledProfilerRecordsNothing) {
+    PipelineProfiler *profiler = PipelineProfiler::getInstance();
+    profiler->setEnabled(false);
+    recordFrame(*profiler);
+    EXPECT_EQ(profiler->getLastFrame(), nullptr);
+}
+
+TEST(pipelineProfilerTest, scopesNestInsideTheFrame) {
+    PipelineProfiler *profiler = PipelineProfiler::getInstance();
+    profiler->setEnabled(true);
+    recordFrame(*profiler);
+
+    const ProfileFrame *frame = profiler->getLastFrame();
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->samples.size(), 4u);
+    EXPECT_EQ(frame->samples[0].name, "Frame");
+    EXPECT_EQ(frame->samples[0].depth, 0u);
+    EXPECT_EQ(frame->samples[1].name, "ForwardFlow");
+    EXPECT_EQ(frame->samples[1].depth, 1u);
+    EXPECT_EQ(frame->samples[2].depth, 2u);
+    // the scope left open is closed by endFrame
+    EXPECT_EQ(frame->samples[3].depth, 1u);
+    EXPECT_LE(frame->samples[3].cpuEnd, frame->cpuTime);
+    EXPECT_LE(frame->samples[1].cpuBegin, frame->samples[2].cpuBegin);
+    EXPECT_LE(frame->samples[2].cpuEnd, frame->samples[1].cpuEnd);
+    // no device, no GPU times
+    EXPECT_LT(frame->gpuTime, 0.0);
+    EXPECT_LT(frame->samples[1].gpuBegin, 0.0);
+
+    profiler->setEnabled(false);
+}
+
+TEST(pipelineProfilerTest, historyIsBounded) {
+    PipelineProfiler *profiler = PipelineProfiler::getInstance();
+    profiler->setEnabled(true);
+    for (uint i = 0; i < PipelineProfiler::MAX_FRAMES + 10; ++i) {
+        recordFrame(*profiler);
+    }
+    EXPECT_EQ(profiler->getFrameCount(), PipelineProfiler::MAX_FRAMES);
+    EXPECT_LE(profiler->getFrame(0).cpuStart, profiler->getFrame(PipelineProfiler::MAX_FRAMES - 1).cpuStart);
+
+    profiler->setEnabled(false);
+}
+
+TEST(pipelineProfilerTest, chromeTraceHasCompleteEvents) {
+    PipelineProfiler *profiler = PipelineProfiler::getInstance();
+    profiler->setEnabled(true);
+    recordFrame(*profiler);
+
+    const cc::String trace = profiler->exportChromeTrace();
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_NE(trace.find("\"name\":\"ForwardStage\",\"ph\":\"X\",\"pid\":1,\"tid\":1"), cc::String::npos);
+    EXPECT_NE(trace.find("Shadow \\\"Flow\\\""), cc::String::npos);
+    // CPU only, nothing on the GPU lane besides its name
+    EXPECT_EQ(trace.find("\"tid\":2,\"ts\""), cc::String::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+    profiler->setEnabled(false);
+}
@@ -0,0 +1,222 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/renderer/gfx-empty/GFXEmpty.h"
+#include "cocos/renderer/pipeline/RenderGraph.h"
+#include "cocos/renderer/pipeline/RenderTargetPool.h"
+
+using cc::gfx::AccessType;
+using cc::gfx::Format;
+using cc::gfx::LoadOp;
+using cc::gfx::TextureInfo;
+using cc::gfx::TextureUsageBit;
+using cc::pipeline::RenderGraph;
+using cc::pipeline::RenderGraphBuilder;
+using cc::pipeline::RenderGraphContext;
+using cc::pipeline::RenderGraphHandle;
+using cc::pipeline::RenderTargetPool;
+
+namespace {
+TextureInfo targetInfo(Format format) {
+    TextureInfo info;
+    info.format = format;
+    info.width = 256;
+    info.height = 256;
+    return info;
+}
+
+void noop(const RenderGraphContext &) {}
+} // namespace
+
+TEST(pipelineRenderGraphTest, passesWithoutConsumersAreCulled) {
+    RenderGraph graph(nullptr, nullptr);
+    RenderGraphHandle backBuffer = graph.importTexture("backBuffer", nullptr);
+    RenderGraphHandle unused = graph.createTexture("unused", targetInfo(Format::RGBA8));
+    RenderGraphHandle scene = graph.createTexture("scene", targetInfo(Format::RGBA8));
+
+    uint unusedPass = graph.addPass("unused", [&](RenderGraphBuilder &builder) { builder.writeColor(unused); }, noop);
+    uint scenePass = graph.addPass("scene", [&](RenderGraphBuilder &builder) { builder.writeColor(scene); }, noop);
+    uint blitPass = graph.addPass(
+        "blit", [&](RenderGraphBuilder &builder) {
+            builder.read(scene);
+            builder.writeColor(backBuffer);
+        },
+        noop);
+    uint debugPass = graph.addPass("debug", [&](RenderGraphBuilder &builder) { builder.sideEffect(); }, noop);
+    graph.compile();
+
+    EXPECT_TRUE(graph.isPassCulled(unusedPass));
+    EXPECT_FALSE(graph.isPassCulled(scenePass));
+    EXPECT_FALSE(graph.isPassCulled(blitPass));
+    EXPECT_FALSE(graph.isPassCulled(debugPass));
+    EXPECT_EQ(graph.getRenderPassCount(), 2u);
+    // usage comes from the declared accesses
+    EXPECT_TRUE(graph.getTextureInfo(scene).usage & TextureUsageBit::COLOR_ATTACHMENT);
+    EXPECT_TRUE(graph.getTextureInfo(scene).usage & TextureUsageBit::SAMPLED);
+}
+
+TEST(pipelineRenderGraphTest, loadingPassesMergeAndKeepAttachmentsTransient) {
+    RenderGraph graph(nullptr, nullptr);
+    RenderGraphHandle backBuffer = graph.importTexture("backBuffer", nullptr);
+    RenderGraphHandle color = graph.createTexture("color", targetInfo(Format::RGBA16F));
+    RenderGraphHandle depth = graph.createTexture("depth", targetInfo(Format::D24S8));
+
+    uint opaquePass = graph.addPass(
+        "opaque", [&](RenderGraphBuilder &builder) {
+            builder.writeColor(color);
+            builder.writeDepthStencil(depth);
+        },
+        noop);
+    uint transparentPass = graph.addPass(
+        "transparent", [&](RenderGraphBuilder &builder) {
+            builder.writeColor(color, LoadOp::LOAD);
+            builder.writeDepthStencil(depth, LoadOp::LOAD);
+        },
+        noop);
+    uint resolvePass = graph.addPass(
+        "resolve", [&](RenderGraphBuilder &builder) {
+            builder.read(color);
+            builder.writeColor(backBuffer);
+        },
+        noop);
+    graph.compile();
+
+    EXPECT_EQ(graph.getPassGroup(transparentPass), opaquePass);
+    EXPECT_EQ(graph.getPassGroup(resolvePass), resolvePass);
+    EXPECT_EQ(graph.getRenderPassCount(), 2u);
+    EXPECT_TRUE(graph.isTransient(depth));
+    EXPECT_TRUE(graph.getTextureInfo(depth).usage & TextureUsageBit::TRANSIENT_ATTACHMENT);
+    EXPECT_FALSE(graph.isTransient(color));
+    EXPECT_FALSE(graph.isTransient(backBuffer));
+}
+
+TEST(pipelineRenderGraphTest, barriersOnlyWhereRenderPassesDoNotSynchronize) {
+    RenderGraph graph(nullptr, nullptr);
+    RenderGraphHandle backBuffer = graph.importTexture("backBuffer", nullptr);
+    RenderGraphHandle lut = graph.createTexture("lut", targetInfo(Format::RGBA8));
+    RenderGraphHandle scene = graph.createTexture("scene", targetInfo(Format::RGBA8));
+
+    graph.addPass("bake", [&](RenderGraphBuilder &builder) { builder.write(lut, AccessType::COMPUTE_SHADER_WRITE); }, noop);
+    uint scenePass = graph.addPass("scene", [&](RenderGraphBuilder &builder) { builder.writeColor(scene); }, noop);
+    uint gradePass = graph.addPass(
+        "grade", [&](RenderGraphBuilder &builder) {
+            builder.read(scene);
+            builder.read(lut);
+            builder.writeColor(backBuffer);
+        },
+        noop);
+    graph.compile();
+
+    EXPECT_TRUE(graph.getPassBarrier(scenePass).prevAccesses.empty());
+    const auto &barrier = graph.getPassBarrier(gradePass);
+    // the scene attachment is handed over by the render pass dependencies
+    ASSERT_EQ(barrier.prevAccesses.size(), 1u);
+    EXPECT_EQ(barrier.prevAccesses[0], AccessType::COMPUTE_SHADER_WRITE);
+    ASSERT_EQ(barrier.nextAccesses.size(), 1u);
+    EXPECT_EQ(barrier.nextAccesses[0], AccessType::FRAGMENT_SHADER_READ_TEXTURE);
+    EXPECT_TRUE(graph.getTextureInfo(lut).usage & TextureUsageBit::STORAGE);
+}
+
+TEST(pipelineRenderGraphTest, framebuffersAreCachedUntilThePoolDestroysTargets) {
+    auto *device = CC_NEW(cc::gfx::EmptyDevice);
+    device->initialize({0, 64, 64, 64, 64, nullptr});
+    RenderTargetPool pool(device);
+    RenderGraph graph(device, &pool);
+
+    TextureInfo backBufferInfo = targetInfo(Format::RGBA8);
+    backBufferInfo.usage = TextureUsageBit::COLOR_ATTACHMENT;
+    cc::gfx::Texture *backBufferTexture = pool.acquire(backBufferInfo);
+
+    cc::vector<cc::gfx::Framebuffer *> framebuffers;
+    auto record = [&]() {
+        framebuffers.clear();
+        graph.reset();
+        RenderGraphHandle backBuffer = graph.importTexture("backBuffer", backBufferTexture);
+        RenderGraphHandle scene = graph.createTexture("scene", targetInfo(Format::RGBA8));
+        graph.addPass(
+            "scene", [&](RenderGraphBuilder &builder) { builder.writeColor(scene); },
+            [&](const RenderGraphContext &context) { framebuffers.push_back(context.framebuffer); });
+        graph.addPass(
+            "blit", [&](RenderGraphBuilder &builder) {
+                builder.read(scene);
+                builder.writeColor(backBuffer);
+            },
+            [&](const RenderGraphContext &context) { framebuffers.push_back(context.framebuffer); });
+        graph.execute(device->getCommandBuffer());
+    };
+
+    pool.update();
+    record();
+    ASSERT_EQ(framebuffers.size(), 2u);
+    EXPECT_NE(framebuffers[0], nullptr);
+    EXPECT_NE(framebuffers[0], framebuffers[1]);
+    const cc::vector<cc::gfx::Framebuffer *> firstFramebuffers = framebuffers;
+    for (uint frame = 0; frame < 3; ++frame) {
+        pool.update();
+        record();
+        EXPECT_EQ(framebuffers, firstFramebuffers);
+        EXPECT_EQ(graph.getFramebufferCount(), 2u);
+    }
+
+    // the idle scene target gets evicted, a new one may reuse its address
+    for (uint frame = 0; frame <= RenderTargetPool::EVICT_AFTER_FRAMES; ++frame) {
+        pool.update();
+    }
+    record();
+    EXPECT_EQ(graph.getFramebufferCount(), 2u);
+
+    graph.destroy();
+    EXPECT_EQ(graph.getFramebufferCount(), 0u);
+    pool.destroy();
+    device->destroy();
+    CC_DELETE(device);
+}
+
+TEST(pipelineRenderGraphTest, invalidatedImportedTexturesDropTheirFramebuffers) {
+    auto *device = CC_NEW(cc::gfx::EmptyDevice);
+    device->initialize({0, 64, 64, 64, 64, nullptr});
+    RenderTargetPool pool(device);
+    RenderGraph graph(device, &pool);
+
+    TextureInfo windowInfo = targetInfo(Format::RGBA8);
+    windowInfo.usage = TextureUsageBit::COLOR_ATTACHMENT;
+    // not owned by the pool, so the graph can't tell when it goes away
+    cc::gfx::Texture *windowTexture = device->createTexture(windowInfo);
+
+    graph.addPass(
+        "present", [&](RenderGraphBuilder &builder) { builder.writeColor(graph.importTexture("window", windowTexture)); },
+        noop);
+    graph.execute(device->getCommandBuffer());
+    EXPECT_EQ(graph.getFramebufferCount(), 1u);
+
+    graph.invalidateTexture(windowTexture);
+    EXPECT_EQ(graph.getFramebufferCount(), 0u);
+    windowTexture->destroy();
+    CC_DELETE(windowTexture);
+
+    graph.destroy();
+    pool.destroy();
+    device->destroy();
+    CC_DELETE(device);
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/renderer/gfx-empty/GFXEmpty.h"
+#include "cocos/renderer/pipeline/RenderTargetPool.h"
+
+using cc::gfx::Format;
+using cc::gfx::Texture;
+using cc::gfx::TextureInfo;
+using cc::gfx::TextureUsageBit;
+using cc::pipeline::RenderTargetPool;
+
+namespace {
+TextureInfo targetInfo(Format format) {
+    TextureInfo info;
+    info.usage = TextureUsageBit::COLOR_ATTACHMENT | TextureUsageBit::SAMPLED;
+    info.format = format;
+    info.width = 256;
+    info.height = 256;
+    return info;
+}
+
+class pipelineRenderTargetPoolTest : public testing::Test {
+protected:
+    void SetUp() override {
+        device = CC_NEW(cc::gfx::EmptyDevice);
+        device->initialize({0, 64, 64, 64, 64, nullptr});
+    }
+
+    void TearDown() override {
+        device->destroy();
+        CC_DELETE(device);
+    }
+
+    cc::gfx::Device *device = nullptr;
+};
+} // namespace
+
+TEST_F(pipelineRenderTargetPoolTest, releasedTargetsAreReused) {
+    RenderTargetPool pool(device);
+    Texture *color = pool.acquire(targetInfo(Format::RGBA8));
+    ASSERT_NE(color, nullptr);
+
+    // a held target is never handed out twice
+    Texture *other = pool.acquire(targetInfo(Format::RGBA8));
+    EXPECT_NE(other, color);
+    EXPECT_EQ(pool.getTextureCount(), 2u);
+
+    pool.release(color);
+    EXPECT_EQ(pool.acquire(targetInfo(Format::RGBA8)), color);
+    // descriptors have to match
+    Texture *hdr = pool.acquire(targetInfo(Format::RGBA16F));
+    EXPECT_NE(hdr, color);
+    EXPECT_NE(hdr, other);
+    EXPECT_EQ(pool.getTextureCount(), 3u);
+
+    TextureInfo attachmentInfo = targetInfo(Format::D24S8);
+    attachmentInfo.usage = TextureUsageBit::DEPTH_STENCIL_ATTACHMENT;
+    Texture *depth = pool.acquireTransient(attachmentInfo);
+    EXPECT_EQ(pool.acquireTransient(attachmentInfo), depth);
+    EXPECT_EQ(pool.getTextureCount(), 4u);
+
+    pool.destroy();
+    EXPECT_EQ(pool.getTextureCount(), 0u);
+    EXPECT_EQ(pool.getAllocatedSize(), 0u);
+}
+
+TEST_F(pipelineRenderTargetPoolTest, generationChangesOnlyWhenTargetsAreDestroyed) {
+    RenderTargetPool pool(device);
+    Texture *held = pool.acquire(targetInfo(Format::RGBA8));
+    const uint heldSize = pool.getAllocatedSize();
+    Texture *idle = pool.acquire(targetInfo(Format::RGBA16F));
+    pool.release(idle);
+    const uint generation = pool.getGeneration();
+
+    // reuse and staying idle for a while leave the generation alone
+    EXPECT_EQ(pool.acquire(targetInfo(Format::RGBA16F)), idle);
+    pool.release(idle);
+    for (uint frame = 0; frame < RenderTargetPool::EVICT_AFTER_FRAMES; ++frame) {
+        pool.update();
+    }
+    EXPECT_EQ(pool.getTextureCount(), 2u);
+    EXPECT_EQ(pool.getGeneration(), generation);
+
+    // only the idle target is evicted
+    pool.update();
+    EXPECT_EQ(pool.getTextureCount(), 1u);
+    EXPECT_EQ(pool.getGeneration(), generation + 1);
+    EXPECT_EQ(pool.getAllocatedSize(), heldSize);
+
+    pool.release(held);
+    pool.destroy();
+    EXPECT_NE(pool.getGeneration(), generation + 1);
+}
+
+TEST_F(pipelineRenderTargetPoolTest, budgetEvictsTheLeastRecentlyUsedTargets) {
+    RenderTargetPool pool(device);
+    Texture *first = pool.acquire(targetInfo(Format::RGBA8));
+    const uint targetSize = pool.getAllocatedSize();
+    ASSERT_GT(targetSize, 0u);
+    pool.setBudget(targetSize * 2);
+
+    Texture *second = pool.acquire(targetInfo(Format::BGRA8));
+    pool.release(first);
+    pool.update();
+    pool.release(second);
+    pool.update();
+
+    // the first target has been idle the longest
+    const uint generation = pool.getGeneration();
+    Texture *third = pool.acquire(targetInfo(Format::R32F));
+    EXPECT_EQ(pool.getTextureCount(), 2u);
+    EXPECT_EQ(pool.getAllocatedSize(), targetSize * 2);
+    EXPECT_EQ(pool.getGeneration(), generation + 1);
+    EXPECT_EQ(pool.acquire(targetInfo(Format::BGRA8)), second);
+
+    // held targets are never evicted, the pool goes over budget instead
+    Texture *fourth = pool.acquire(targetInfo(Format::RGBA8));
+    EXPECT_NE(fourth, nullptr);
+    EXPECT_EQ(pool.getTextureCount(), 3u);
+    EXPECT_EQ(pool.getAllocatedSize(), targetSize * 3);
+    EXPECT_EQ(pool.getPeakSize(), targetSize * 3);
+    EXPECT_EQ(pool.getGeneration(), generation + 1);
+
+    pool.release(third);
+    pool.release(second);
+    pool.release(fourth);
+    pool.destroy();
+}
@@ -0,0 +1,72 @@
+/****************************************************************************
+Copyright (c) 2021 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "cocos/platform/Image.h"
+#include "cocos/renderer/core/Core.h"
+
+using cc::Image;
+
+namespace {
+// 2x1 8-bit RGB: (255, 0, 0), (0, 128, 255)
+const unsigned char RGB_PNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01,
+    0x08, 0x02, 0x00, 0x00, 0x00, 0x7b, 0x40, 0xe8, 0xdd, 0x00, 0x00, 0x00,
+    0x0f, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xc0,
+    0xd0, 0xf0, 0x1f, 0x00, 0x08, 0x00, 0x02, 0x7f, 0x9c, 0x45, 0x40, 0x4e,
+    0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82};
+
+// 2x1 8-bit gray: 16, 240
+const unsigned char GRAY_PNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0xd1, 0x49, 0x20, 0x56, 0x00, 0x00, 0x00,
+    0x0b, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0x10, 0xf8, 0x00, 0x00,
+    0x01, 0x13, 0x01, 0x01, 0x75, 0x5b, 0x66, 0xfc, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82};
+
+void expectRGBA8(const unsigned char *png, ssize_t size, const unsigned char (&expected)[8]) {
+    auto *image = new Image();
+    image->setForceRGBA8(true);
+    ASSERT_TRUE(image->initWithImageData(png, size));
+    EXPECT_EQ(image->getWidth(), 2);
+    EXPECT_EQ(image->getHeight(), 1);
+    EXPECT_EQ(image->getRenderFormat(), cc::gfx::Format::RGBA8);
+    ASSERT_EQ(image->getDataLen(), 8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(image->getData()[i], expected[i]) << "byte " << i;
+    }
+    image->release();
+}
+} // namespace
+
+TEST(platformImageTest, forceRGBA8FromRGB) {
+    const unsigned char expected[8] = {255, 0, 0, 255, 0, 128, 255, 255};
+    expectRGBA8(RGB_PNG, sizeof(RGB_PNG), expected);
+}
+
+TEST(platformImageTest, forceRGBA8FromGray) {
+    const unsigned char expected[8] = {16, 16, 16, 255, 240, 240, 240, 255};
+    expectRGBA8(GRAY_PNG, sizeof(GRAY_PNG), expected);
+}